@@ -46,6 +46,9 @@
 // Only support simpler HID descriptors on SAMD21.
 #define CIRCUITPY_USB_HID_MAX_REPORT_IDS_PER_DESCRIPTOR (1)
 
+// Each cached external flash sector is 4 kiB of the 32 kiB of RAM.
+#define CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS (1)
+
 // Avoid linker error:
 // <artificial>:(.text.nlr_push+0x20): relocation truncated to fit: R_ARM_THM_JUMP11 against symbol `nlr_push_tail' defined in .text.nlr_push_tail section in /tmp/ccvHNpPQ.ltrans0.ltrans.o
 // See https://github.com/micropython/micropython/pull/11353
@@ -24,6 +24,8 @@ typedef struct {
     uint8_t polarity;
     uint8_t phase;
     uint8_t bits;
+    // DMA channel of a write started by common_hal_busio_spi_start_write(), or -1.
+    int8_t write_dma_channel;
 } busio_spi_obj_t;
 
 void reset_spi(void);
@@ -261,6 +261,39 @@ static mp_obj_t extra_coverage(void) {
         mp_state_ctx.mem = mp_state_mem_orig;
     }
 
+    // CIRCUITPY-CHANGE: an old object grown in place into the nursery keeps
+    // what its new tail refers to alive through a nursery collection
+    #if MICROPY_GC_NURSERY
+    {
+        mp_printf(&mp_plat_print, "# GC nursery\n");
+
+        assert(MP_STATE_THREAD(gc_lock_depth) == 0);
+        mp_state_mem_t mp_state_mem_orig = mp_state_ctx.mem;
+
+        unsigned heap_size = 256 * MICROPY_BYTES_PER_GC_BLOCK;
+        char *heap = calloc(heap_size, 1);
+        gc_init(heap, heap + heap_size);
+
+        // an old object that ends just before the nursery, then grows two
+        // blocks into it
+        size_t nursery_start = MP_STATE_MEM(gc_nursery_start);
+        void **old = m_malloc(8 * MICROPY_BYTES_PER_GC_BLOCK);
+        size_t old_blocks = nursery_start - ((byte *)old - MP_STATE_MEM(area).gc_pool_start) / MICROPY_BYTES_PER_GC_BLOCK;
+        old = gc_realloc(old, old_blocks * MICROPY_BYTES_PER_GC_BLOCK, false);
+        void **grown = gc_realloc(old, (old_blocks + 2) * MICROPY_BYTES_PER_GC_BLOCK, false);
+        mp_printf(&mp_plat_print, "%d\n", grown == old);
+
+        // a young object referred to only from the grown tail
+        size_t last = (old_blocks + 2) * MICROPY_BYTES_PER_GC_BLOCK / sizeof(void *) - 1;
+        old[last] = m_malloc(MICROPY_BYTES_PER_GC_BLOCK);
+        gc_collect_nursery();
+        mp_printf(&mp_plat_print, "%d\n", gc_nbytes(old[last]) == MICROPY_BYTES_PER_GC_BLOCK);
+
+        free(heap);
+        mp_state_ctx.mem = mp_state_mem_orig;
+    }
+    #endif
+
     // tracked allocation
     {
         #define NUM_PTRS (8)
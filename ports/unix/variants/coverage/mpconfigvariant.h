@@ -36,6 +36,10 @@
 // Enable testing of split heap.
 #define MICROPY_GC_SPLIT_HEAP          (1)
 #define MICROPY_GC_SPLIT_HEAP_N_HEAPS  (4)
+#define MICROPY_GC_INCREMENTAL         (1)
+#define MICROPY_GC_FREE_LISTS          (1)
+#define MICROPY_GC_NURSERY             (1)
+#define MICROPY_GC_ALLOC_PROFILE       (1)
 
 // Enable additional features.
 #define MICROPY_DEBUG_PARSE_RULE_NAME  (1)
@@ -32,7 +32,12 @@ SRC_BITMAP := \
 	shared-bindings/aesio/__init__.c \
 	shared-bindings/audiocore/__init__.c \
 	shared-bindings/audiocore/RawSample.c \
+	shared-bindings/audiocore/Resampler.c \
 	shared-bindings/audiocore/WaveFile.c \
+	shared-bindings/audiodelays/__init__.c \
+	shared-bindings/audiodelays/Echo.c \
+	shared-bindings/audiofilters/__init__.c \
+	shared-bindings/audiofilters/Filter.c \
 	shared-bindings/audiomixer/__init__.c \
 	shared-bindings/audiomixer/Mixer.c \
 	shared-bindings/audiomixer/MixerVoice.c \
@@ -48,10 +53,14 @@ SRC_BITMAP := \
 	shared-bindings/jpegio/__init__.c \
 	shared-bindings/jpegio/JpegDecoder.c \
 	shared-bindings/locale/__init__.c \
+	shared-bindings/msgpack/__init__.c \
+	shared-bindings/msgpack/ExtType.c \
+	shared-bindings/msgpack/Unpacker.c \
 	shared-bindings/rainbowio/__init__.c \
 	shared-bindings/struct/__init__.c \
 	shared-bindings/synthio/__init__.c \
 	shared-bindings/synthio/Math.c \
+	shared-bindings/synthio/MidiFile.c \
 	shared-bindings/synthio/MidiTrack.c \
 	shared-bindings/synthio/LFO.c \
 	shared-bindings/synthio/Note.c \
@@ -69,7 +78,12 @@ SRC_BITMAP := \
 	shared-module/aesio/__init__.c \
 	shared-module/audiocore/__init__.c \
 	shared-module/audiocore/RawSample.c \
+	shared-module/audiocore/Resampler.c \
 	shared-module/audiocore/WaveFile.c \
+	shared-module/audiodelays/__init__.c \
+	shared-module/audiodelays/Echo.c \
+	shared-module/audiofilters/__init__.c \
+	shared-module/audiofilters/Filter.c \
 	shared-module/audiomixer/__init__.c \
 	shared-module/audiomp3/MP3Decoder.c \
 	shared-module/audiomixer/Mixer.c \
@@ -83,11 +97,14 @@ SRC_BITMAP := \
 	shared-module/floppyio/__init__.c \
 	shared-module/jpegio/__init__.c \
 	shared-module/jpegio/JpegDecoder.c \
+	shared-module/msgpack/__init__.c \
+	shared-module/msgpack/Unpacker.c \
 	shared-module/os/getenv.c \
 	shared-module/rainbowio/__init__.c \
 	shared-module/struct/__init__.c \
 	shared-module/synthio/__init__.c \
 	shared-module/synthio/Math.c \
+	shared-module/synthio/MidiFile.c \
 	shared-module/synthio/MidiTrack.c \
 	shared-module/synthio/LFO.c \
 	shared-module/synthio/Note.c \
@@ -127,6 +144,8 @@ $(BUILD)/lib/mp3/src/buffers.o: CFLAGS += -include "shared-module/audiomp3/__ini
 CFLAGS += \
 	-DCIRCUITPY_AESIO=1 \
 	-DCIRCUITPY_AUDIOCORE=1 \
+	-DCIRCUITPY_AUDIODELAYS=1 \
+	-DCIRCUITPY_AUDIOFILTERS=1 \
 	-DCIRCUITPY_AUDIOMIXER=1 \
 	-DCIRCUITPY_AUDIOMP3=1 \
 	-DCIRCUITPY_AUDIOMP3_USE_PORT_ALLOCATOR=0 \
@@ -139,6 +158,7 @@ CFLAGS += \
 	-DCIRCUITPY_GIFIO=1 \
 	-DCIRCUITPY_JPEGIO=1 \
 	-DCIRCUITPY_LOCALE=1 \
+	-DCIRCUITPY_MSGPACK=1 \
 	-DCIRCUITPY_OS_GETENV=1 \
 	-DCIRCUITPY_RAINBOWIO=1 \
 	-DCIRCUITPY_STRUCT=1 \
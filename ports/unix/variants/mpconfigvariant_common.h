@@ -79,6 +79,13 @@
 // Enable a small performance boost for the VM.
 #define MICROPY_OPT_COMPUTED_GOTO      (1)
 
+// CIRCUITPY-CHANGE: Give attribute opcodes inline caches.
+#define MICROPY_OPT_ATTR_INLINE_CACHE  (1)
+
+// CIRCUITPY-CHANGE: Specialise binary ops for small ints and floats, except
+// when sys.settrace may be looking at the bytecode.
+#define MICROPY_OPT_BINARY_OP_QUICKEN  (!MICROPY_PY_SYS_SETTRACE)
+
 // Return number of collected objects from gc.collect().
 #define MICROPY_PY_GC_COLLECT_RETVAL   (1)
 
@@ -0,0 +1,414 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include <string.h>
+
+#include "py/attrcache.h"
+#include "py/gc.h"
+
+#if MICROPY_OPT_ATTR_INLINE_CACHE
+
+// Each attribute opcode has its own cache, in the mp_attr_cache_t of the
+// function object it is run from.  A cache holds where the attribute was
+// found for the last two types (or modules) the opcode was run on, as an
+// index into the map that held it.  On a hit, the entry at that index is used
+// if it still has the attribute's name as its key, which also copes with the
+// map having grown, shrunk or been rehashed since.  So a cache is never
+// wrong, only missed.
+//
+// Python classes are guarded by their version rather than their address.  A
+// class gets a new version when it is made, when one of its attributes is
+// stored or deleted, and when an instance first hides one of its methods with
+// a member.  After that, methods of the class are no longer cached, which is
+// what lets a method hit skip looking in the members of the instance.
+// Versions are never reused, so a class made where a freed one was can't
+// match its caches.  Native types are only cached if they aren't on the heap,
+// so they are never freed.  Modules and classes loaded from directly are
+// guarded by their address and kept alive by the cache.
+
+// Set in the version of a class once an instance has hidden one of its methods.
+// Versions are otherwise even.
+#define VERSION_HIDES_METHOD (1)
+
+// The first number of entries in a function's cache.
+#define ATTR_CACHE_FIRST_ALLOC (4)
+
+void mp_attr_cache_new_version(mp_obj_type_t *type) {
+    uintptr_t version = MP_STATE_VM(attr_cache_version);
+    if (version < UINTPTR_MAX - 2) {
+        version += 2;
+        MP_STATE_VM(attr_cache_version) = version;
+    } else {
+        // out of versions, so classes from now on aren't cached
+        version = 0;
+    }
+    type->slots[0] = (void *)(version | (mp_obj_class_version(type) & VERSION_HIDES_METHOD));
+}
+
+// The version to cache type under, or 0 if it can't be cached.
+static uintptr_t attr_cache_version(const mp_obj_type_t *type) {
+    uintptr_t version = mp_obj_class_version(type);
+    return (version & ~VERSION_HIDES_METHOD) != 0 ? version : 0;
+}
+
+// Whether value, found in the locals of a Python class, binds self and so
+// loads from an instance as (value, self) whatever accessors the class has.
+static bool attr_cache_is_method(mp_obj_t value) {
+    if (!mp_obj_is_obj(value)) {
+        return false;
+    }
+    const mp_obj_type_t *type = ((mp_obj_base_t *)MP_OBJ_TO_PTR(value))->type;
+    return (type->flags & (MP_TYPE_FLAG_BINDS_SELF | MP_TYPE_FLAG_BUILTIN_FUN)) == MP_TYPE_FLAG_BINDS_SELF;
+}
+
+void mp_attr_cache_member_added(const mp_obj_type_t *type, mp_obj_t key) {
+    if (mp_obj_class_version(type) & VERSION_HIDES_METHOD) {
+        return;
+    }
+    mp_map_elem_t *elem = mp_map_lookup(&MP_OBJ_TYPE_GET_SLOT(type, locals_dict)->map, key, MP_MAP_LOOKUP);
+    if (elem != NULL && attr_cache_is_method(elem->value)) {
+        // a Python class is on the heap, not const
+        mp_obj_type_t *self = (mp_obj_type_t *)type;
+        self->slots[0] = (void *)(mp_obj_class_version(type) | VERSION_HIDES_METHOD);
+        mp_attr_cache_new_version(self);
+    }
+}
+
+// The caches aren't the program's own allocations, so they are left out of
+// micropython.alloc_profile().
+static void *attr_cache_renew(void *ptr, size_t old_size, size_t new_size) {
+    #if MICROPY_GC_ALLOC_PROFILE
+    bool profile = MP_STATE_MEM(gc_alloc_profile_enabled);
+    MP_STATE_MEM(gc_alloc_profile_enabled) = false;
+    #endif
+    ptr = m_renew_maybe(byte, ptr, old_size, new_size, true);
+    #if MICROPY_GC_ALLOC_PROFILE
+    MP_STATE_MEM(gc_alloc_profile_enabled) = profile;
+    #endif
+    return ptr;
+}
+
+static size_t attr_cache_size(size_t alloc) {
+    return sizeof(mp_attr_cache_t) + alloc * sizeof(mp_attr_cache_entry_t);
+}
+
+// The cache of the opcode ending at ip, made empty if it doesn't have one yet.
+// Returns NULL if there's no memory for it.
+static mp_attr_cache_entry_t *attr_cache_site(mp_obj_fun_bc_t *fun, const byte *ip) {
+    mp_attr_cache_entry_t *entry = mp_attr_cache_entry(fun, ip);
+    if (entry != NULL) {
+        return entry;
+    }
+    size_t offset = ip - fun->bytecode;
+    if (offset >= UINT16_MAX) {
+        return NULL;
+    }
+    mp_attr_cache_t *cache = fun->attr_cache;
+    if (cache == NULL) {
+        cache = attr_cache_renew(NULL, 0, attr_cache_size(ATTR_CACHE_FIRST_ALLOC));
+        if (cache == NULL) {
+            return NULL;
+        }
+        cache->site = NULL;
+        cache->site_len = 0;
+        cache->used = 0;
+        cache->alloc = ATTR_CACHE_FIRST_ALLOC;
+        fun->attr_cache = cache;
+    } else if (cache->used == cache->alloc) {
+        if (cache->alloc == UINT8_MAX) {
+            return NULL;
+        }
+        size_t alloc = MIN(2 * cache->alloc, UINT8_MAX);
+        cache = attr_cache_renew(cache, attr_cache_size(cache->alloc), attr_cache_size(alloc));
+        if (cache == NULL) {
+            return NULL;
+        }
+        cache->alloc = alloc;
+        fun->attr_cache = cache;
+    }
+    if (offset >= cache->site_len) {
+        // grow by a little more than needed, as later opcodes are likely to follow
+        size_t len = MIN((offset + 32) & ~(size_t)31, UINT16_MAX);
+        uint8_t *site = attr_cache_renew(cache->site, cache->site_len, len);
+        if (site == NULL) {
+            return NULL;
+        }
+        memset(site + cache->site_len, 0, len - cache->site_len);
+        cache->site = site;
+        cache->site_len = len;
+    }
+    entry = &cache->entry[cache->used++];
+    memset(entry, 0, sizeof(*entry));
+    cache->site[offset] = cache->used;
+    return entry;
+}
+
+// The element of map at index, if it is still attr.
+static mp_map_elem_t *attr_cache_elem(mp_map_t *map, size_t index, qstr attr) {
+    if (index < map->alloc && map->table[index].key == MP_OBJ_NEW_QSTR(attr)) {
+        return &map->table[index];
+    }
+    return NULL;
+}
+
+// Whether way caches base, whose type is type.  Instances of Python classes
+// are guarded by the version of their class, modules and classes by
+// themselves and everything else by its type.
+static bool attr_cache_matches(const mp_attr_cache_way_t *way, mp_obj_t base, const mp_obj_type_t *type) {
+    switch (way->kind) {
+        case MP_ATTR_CACHE_MEMBER:
+        case MP_ATTR_CACHE_METHOD:
+            return mp_obj_is_instance_type(type) && way->guard == mp_obj_class_version(type);
+        case MP_ATTR_CACHE_NATIVE:
+            return way->guard == (uintptr_t)type;
+        case MP_ATTR_CACHE_MODULE:
+            return type == &mp_type_module && way->guard == (uintptr_t)MP_OBJ_TO_PTR(base);
+        case MP_ATTR_CACHE_CLASS:
+            return type == &mp_type_type && way->guard == (uintptr_t)MP_OBJ_TO_PTR(base);
+    }
+    return false;
+}
+
+static void attr_cache_fill(mp_obj_fun_bc_t *fun, const byte *ip, uintptr_t guard, uint8_t kind, mp_map_t *map, mp_map_elem_t *elem) {
+    size_t index = elem - map->table;
+    if (index > UINT16_MAX) {
+        return;
+    }
+    mp_attr_cache_entry_t *entry = attr_cache_site(fun, ip);
+    if (entry == NULL) {
+        return;
+    }
+    if (entry->way[0].guard != guard || entry->way[0].kind != kind) {
+        // keep the most recently used way
+        entry->way[1] = entry->way[0];
+    }
+    entry->way[0].guard = guard;
+    entry->way[0].index = index;
+    entry->way[0].kind = kind;
+}
+
+// Like mp_load_method_maybe, if base is cached for this ip.
+static bool attr_cache_load(mp_obj_fun_bc_t *fun, const byte *ip, mp_obj_t base, qstr attr, mp_obj_t *dest) {
+    const mp_attr_cache_entry_t *entry = mp_attr_cache_entry(fun, ip);
+    if (entry == NULL) {
+        return false;
+    }
+    const mp_obj_type_t *type = mp_obj_get_type(base);
+    for (size_t i = 0; i < MP_ARRAY_SIZE(entry->way); i++) {
+        const mp_attr_cache_way_t *way = &entry->way[i];
+        if (!attr_cache_matches(way, base, type)) {
+            continue;
+        }
+        mp_map_elem_t *elem;
+        switch (way->kind) {
+            case MP_ATTR_CACHE_MEMBER: {
+                mp_obj_instance_t *self = MP_OBJ_TO_PTR(base);
+                elem = attr_cache_elem(&self->members, way->index, attr);
+                if (elem == NULL) {
+                    continue;
+                }
+                dest[0] = elem->value;
+                dest[1] = MP_OBJ_NULL;
+                return true;
+            }
+            case MP_ATTR_CACHE_METHOD: {
+                elem = attr_cache_elem(&MP_OBJ_TYPE_GET_SLOT(type, locals_dict)->map, way->index, attr);
+                if (elem == NULL || !attr_cache_is_method(elem->value)) {
+                    continue;
+                }
+                dest[0] = elem->value;
+                dest[1] = base;
+                return true;
+            }
+            case MP_ATTR_CACHE_NATIVE: {
+                elem = attr_cache_elem(&MP_OBJ_TYPE_GET_SLOT(type, locals_dict)->map, way->index, attr);
+                if (elem == NULL) {
+                    continue;
+                }
+                #if MICROPY_PY_BUILTINS_PROPERTY
+                if (mp_obj_is_type(elem->value, &mp_type_property) && (type->flags & MP_TYPE_FLAG_HAS_SPECIAL_ACCESSORS) == 0) {
+                    continue;
+                }
+                #endif
+                dest[0] = MP_OBJ_NULL;
+                dest[1] = MP_OBJ_NULL;
+                mp_convert_member_lookup(base, type, elem->value, dest);
+                return true;
+            }
+            case MP_ATTR_CACHE_MODULE: {
+                elem = attr_cache_elem(&mp_obj_module_get_globals(base)->map, way->index, attr);
+                if (elem == NULL) {
+                    continue;
+                }
+                dest[0] = elem->value;
+                dest[1] = MP_OBJ_NULL;
+                return true;
+            }
+            case MP_ATTR_CACHE_CLASS: {
+                const mp_obj_type_t *self = MP_OBJ_TO_PTR(base);
+                elem = attr_cache_elem(&MP_OBJ_TYPE_GET_SLOT(self, locals_dict)->map, way->index, attr);
+                if (elem == NULL) {
+                    continue;
+                }
+                dest[0] = MP_OBJ_NULL;
+                dest[1] = MP_OBJ_NULL;
+                mp_convert_member_lookup(MP_OBJ_NULL, self, elem->value, dest);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Look attr up as mp_load_method does, caching where it was found if it's one
+// of the cases above.
+static void attr_cache_load_miss(mp_obj_fun_bc_t *fun, const byte *ip, mp_obj_t base, qstr attr, mp_obj_t *dest) {
+    const mp_obj_type_t *type = mp_obj_get_type(base);
+    mp_obj_t key = MP_OBJ_NEW_QSTR(attr);
+    // mp_load_method_maybe handles these before looking in any map
+    if (attr != MP_QSTR___class__ && attr != MP_QSTR___next__) {
+        if (mp_obj_is_instance_type(type)) {
+            // instance members come first, see mp_obj_instance_load_attr
+            uintptr_t version = attr_cache_version(type);
+            mp_obj_instance_t *self = MP_OBJ_TO_PTR(base);
+            mp_map_elem_t *elem = mp_map_lookup(&self->members, key, MP_MAP_LOOKUP);
+            if (elem != NULL) {
+                if (version != 0) {
+                    attr_cache_fill(fun, ip, version, MP_ATTR_CACHE_MEMBER, &self->members, elem);
+                }
+                dest[0] = elem->value;
+                dest[1] = MP_OBJ_NULL;
+                return;
+            }
+            if (version != 0 && !(version & VERSION_HIDES_METHOD)) {
+                mp_map_t *locals_map = &MP_OBJ_TYPE_GET_SLOT(type, locals_dict)->map;
+                elem = mp_map_lookup(locals_map, key, MP_MAP_LOOKUP);
+                if (elem != NULL && attr_cache_is_method(elem->value)) {
+                    attr_cache_fill(fun, ip, version, MP_ATTR_CACHE_METHOD, locals_map, elem);
+                }
+            }
+        #if !CIRCUITPY_8_9_WARNINGS
+        // (otherwise some module attributes warn each time they are loaded)
+        } else if (type == &mp_type_module) {
+            mp_map_t *globals_map = &mp_obj_module_get_globals(base)->map;
+            mp_map_elem_t *elem = mp_map_lookup(globals_map, key, MP_MAP_LOOKUP);
+            if (elem != NULL) {
+                attr_cache_fill(fun, ip, (uintptr_t)MP_OBJ_TO_PTR(base), MP_ATTR_CACHE_MODULE, globals_map, elem);
+                dest[0] = elem->value;
+                dest[1] = MP_OBJ_NULL;
+                return;
+            }
+        #endif
+        } else if (type == &mp_type_type) {
+            // see type_attr, which handles these names itself
+            const mp_obj_type_t *self = MP_OBJ_TO_PTR(base);
+            if (attr != MP_QSTR___name__ && attr != MP_QSTR___dict__ && attr != MP_QSTR___bases__
+                && MP_OBJ_TYPE_HAS_SLOT(self, locals_dict)) {
+                mp_map_t *locals_map = &MP_OBJ_TYPE_GET_SLOT(self, locals_dict)->map;
+                mp_map_elem_t *elem = mp_map_lookup(locals_map, key, MP_MAP_LOOKUP);
+                if (elem != NULL) {
+                    attr_cache_fill(fun, ip, (uintptr_t)self, MP_ATTR_CACHE_CLASS, locals_map, elem);
+                }
+            }
+        } else if (!MP_OBJ_TYPE_HAS_SLOT(type, attr) && MP_OBJ_TYPE_HAS_SLOT(type, locals_dict)
+                   && !gc_ptr_on_heap((void *)type)) {
+            mp_map_t *locals_map = &MP_OBJ_TYPE_GET_SLOT(type, locals_dict)->map;
+            mp_map_elem_t *elem = mp_map_lookup(locals_map, key, MP_MAP_LOOKUP);
+            if (elem != NULL) {
+                attr_cache_fill(fun, ip, (uintptr_t)type, MP_ATTR_CACHE_NATIVE, locals_map, elem);
+            }
+        }
+    }
+    mp_load_method(base, attr, dest);
+}
+
+mp_obj_t mp_attr_cache_load_attr_slow(mp_obj_fun_bc_t *fun, const byte *ip, mp_obj_t base, qstr attr) {
+    mp_obj_t dest[2];
+    if (!attr_cache_load(fun, ip, base, attr, dest)) {
+        attr_cache_load_miss(fun, ip, base, attr, dest);
+    }
+    if (dest[1] == MP_OBJ_NULL) {
+        return dest[0];
+    } else {
+        return mp_obj_new_bound_meth(dest[0], dest[1]);
+    }
+}
+
+void mp_attr_cache_load_method_slow(mp_obj_fun_bc_t *fun, const byte *ip, mp_obj_t base, qstr attr, mp_obj_t *dest) {
+    if (!attr_cache_load(fun, ip, base, attr, dest)) {
+        attr_cache_load_miss(fun, ip, base, attr, dest);
+    }
+}
+
+void mp_attr_cache_store_attr_slow(mp_obj_fun_bc_t *fun, const byte *ip, mp_obj_t base, qstr attr, mp_obj_t value) {
+    if (value == MP_OBJ_NULL) {
+        // the compiler emits del as a store of MP_OBJ_NULL
+        mp_store_attr(base, attr, value);
+        return;
+    }
+
+    const mp_obj_type_t *type = mp_obj_get_type(base);
+    const mp_attr_cache_entry_t *entry = mp_attr_cache_entry(fun, ip);
+    for (size_t i = 0; entry != NULL && i < MP_ARRAY_SIZE(entry->way); i++) {
+        const mp_attr_cache_way_t *way = &entry->way[i];
+        if (!attr_cache_matches(way, base, type)) {
+            continue;
+        }
+        if (way->kind == MP_ATTR_CACHE_MEMBER) {
+            if (!(type->flags & MP_TYPE_FLAG_HAS_SPECIAL_ACCESSORS)) {
+                mp_obj_instance_t *self = MP_OBJ_TO_PTR(base);
+                mp_map_elem_t *elem = attr_cache_elem(&self->members, way->index, attr);
+                if (elem != NULL) {
+                    elem->value = value;
+                    return;
+                }
+            }
+        #if MICROPY_PY_BUILTINS_PROPERTY
+        } else if (way->kind == MP_ATTR_CACHE_NATIVE) {
+            mp_map_elem_t *elem = attr_cache_elem(&MP_OBJ_TYPE_GET_SLOT(type, locals_dict)->map, way->index, attr);
+            if (elem != NULL && mp_obj_is_type(elem->value, &mp_type_property)) {
+                size_t n_proxy;
+                const mp_obj_t *proxy = mp_obj_property_get(elem->value, &n_proxy);
+                if (n_proxy >= 2 && proxy[1] != mp_const_none) {
+                    mp_obj_t dest[2] = {base, value};
+                    mp_call_function_n_kw(proxy[1], 2, 0, dest);
+                    return;
+                }
+            }
+        #endif
+        }
+    }
+
+    mp_obj_t key = MP_OBJ_NEW_QSTR(attr);
+    if (mp_obj_is_instance_type(type) && !(type->flags & MP_TYPE_FLAG_HAS_SPECIAL_ACCESSORS)) {
+        // as mp_obj_instance_store_attr does for a class without accessors
+        mp_obj_instance_t *self = MP_OBJ_TO_PTR(base);
+        size_t used = self->members.used;
+        mp_map_elem_t *elem = mp_map_lookup(&self->members, key, MP_MAP_LOOKUP_ADD_IF_NOT_FOUND);
+        elem->value = value;
+        if (self->members.used != used) {
+            mp_attr_cache_member_added(type, key);
+        }
+        uintptr_t version = attr_cache_version(type);
+        if (version != 0) {
+            attr_cache_fill(fun, ip, version, MP_ATTR_CACHE_MEMBER, &self->members, elem);
+        }
+        return;
+    }
+    #if MICROPY_PY_BUILTINS_PROPERTY
+    if (!MP_OBJ_TYPE_HAS_SLOT(type, attr) && MP_OBJ_TYPE_HAS_SLOT(type, locals_dict)
+        && !gc_ptr_on_heap((void *)type)) {
+        mp_map_t *locals_map = &MP_OBJ_TYPE_GET_SLOT(type, locals_dict)->map;
+        mp_map_elem_t *elem = mp_map_lookup(locals_map, key, MP_MAP_LOOKUP);
+        if (elem != NULL && mp_obj_is_type(elem->value, &mp_type_property)) {
+            attr_cache_fill(fun, ip, (uintptr_t)type, MP_ATTR_CACHE_NATIVE, locals_map, elem);
+        }
+    }
+    #endif
+    mp_store_attr(base, attr, value);
+}
+
+#endif // MICROPY_OPT_ATTR_INLINE_CACHE
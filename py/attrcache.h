@@ -0,0 +1,134 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "py/runtime.h"
+
+#if MICROPY_OPT_ATTR_INLINE_CACHE
+
+#include "py/objfun.h"
+#include "py/objtype.h"
+
+// Where an attribute was found, see py/attrcache.c.
+enum {
+    MP_ATTR_CACHE_EMPTY,
+    // in the members of an instance of a Python class
+    MP_ATTR_CACHE_MEMBER,
+    // a function in the locals of the Python class itself, not a base
+    MP_ATTR_CACHE_METHOD,
+    // in the locals of a native type with no attr slot
+    MP_ATTR_CACHE_NATIVE,
+    // in the globals of a module
+    MP_ATTR_CACHE_MODULE,
+    // in the locals of a class (Python or native) loaded from the class itself
+    MP_ATTR_CACHE_CLASS,
+};
+
+// The inline cache of one attribute opcode, for up to two types.
+typedef struct _mp_attr_cache_way_t {
+    // the version of a Python class, or the address of a native type, module or class
+    uintptr_t guard;
+    uint16_t index;
+    uint8_t kind;
+} mp_attr_cache_way_t;
+
+typedef struct _mp_attr_cache_entry_t {
+    mp_attr_cache_way_t way[2];
+} mp_attr_cache_entry_t;
+
+// The inline caches of the attribute opcodes of one function, made when the
+// first of them misses.
+typedef struct _mp_attr_cache_t {
+    // For each offset into the bytecode, one more than the index in entry of
+    // the cache of the opcode ending there, or 0 if it has none.
+    uint8_t *site;
+    uint16_t site_len;
+    uint8_t used;
+    uint8_t alloc;
+    mp_attr_cache_entry_t entry[];
+} mp_attr_cache_t;
+
+// Inline caches for the attribute opcodes.  Each takes the function being run
+// and the ip of the opcode (just past its qstr operand), which identify the
+// cache to use, and otherwise behaves like the runtime function of the same
+// name.
+mp_obj_t mp_attr_cache_load_attr_slow(mp_obj_fun_bc_t *fun, const byte *ip, mp_obj_t base, qstr attr);
+void mp_attr_cache_load_method_slow(mp_obj_fun_bc_t *fun, const byte *ip, mp_obj_t base, qstr attr, mp_obj_t *dest);
+void mp_attr_cache_store_attr_slow(mp_obj_fun_bc_t *fun, const byte *ip, mp_obj_t base, qstr attr, mp_obj_t value);
+
+// Give a Python class a new version, so that no cache matches it until filled again.
+void mp_attr_cache_new_version(mp_obj_type_t *type);
+
+// Called when an instance of the Python class type gains a member named key.
+void mp_attr_cache_member_added(const mp_obj_type_t *type, mp_obj_t key);
+
+static inline mp_attr_cache_entry_t *mp_attr_cache_entry(const mp_obj_fun_bc_t *fun, const byte *ip) {
+    mp_attr_cache_t *cache = fun->attr_cache;
+    if (cache != NULL) {
+        size_t offset = ip - fun->bytecode;
+        if (offset < cache->site_len && cache->site[offset] != 0) {
+            return &cache->entry[cache->site[offset] - 1];
+        }
+    }
+    return NULL;
+}
+
+// The member of base that this opcode's cache most recently found attr in,
+// or NULL.  This is the common case and is checked inline in the VM.
+static inline mp_map_elem_t *mp_attr_cache_member(const mp_obj_fun_bc_t *fun, const byte *ip, mp_obj_t base, qstr attr) {
+    const mp_attr_cache_entry_t *entry = mp_attr_cache_entry(fun, ip);
+    if (entry != NULL && entry->way[0].kind == MP_ATTR_CACHE_MEMBER && mp_obj_is_obj(base)) {
+        mp_obj_instance_t *self = MP_OBJ_TO_PTR(base);
+        size_t index = entry->way[0].index;
+        if (mp_obj_is_instance_type(self->base.type) && entry->way[0].guard == mp_obj_class_version(self->base.type)
+            && index < self->members.alloc && self->members.table[index].key == MP_OBJ_NEW_QSTR(attr)) {
+            return &self->members.table[index];
+        }
+    }
+    return NULL;
+}
+
+static inline mp_obj_t mp_attr_cache_load_attr(mp_obj_fun_bc_t *fun, const byte *ip, mp_obj_t base, qstr attr) {
+    mp_map_elem_t *elem = mp_attr_cache_member(fun, ip, base, attr);
+    if (elem != NULL) {
+        return elem->value;
+    }
+    return mp_attr_cache_load_attr_slow(fun, ip, base, attr);
+}
+
+// A method found in the class of base needs no lookup in the members of
+// base: the class's version changes if any instance hides a method.
+static inline void mp_attr_cache_load_method(mp_obj_fun_bc_t *fun, const byte *ip, mp_obj_t base, qstr attr, mp_obj_t *dest) {
+    const mp_attr_cache_entry_t *entry = mp_attr_cache_entry(fun, ip);
+    if (entry != NULL && entry->way[0].kind == MP_ATTR_CACHE_METHOD && mp_obj_is_obj(base)) {
+        const mp_obj_type_t *type = ((mp_obj_base_t *)MP_OBJ_TO_PTR(base))->type;
+        if (mp_obj_is_instance_type(type) && entry->way[0].guard == mp_obj_class_version(type)) {
+            mp_map_t *locals_map = &MP_OBJ_TYPE_GET_SLOT(type, locals_dict)->map;
+            size_t index = entry->way[0].index;
+            if (index < locals_map->alloc && locals_map->table[index].key == MP_OBJ_NEW_QSTR(attr)
+                && mp_obj_is_obj(locals_map->table[index].value)
+                && (((mp_obj_base_t *)MP_OBJ_TO_PTR(locals_map->table[index].value))->type->flags
+                    & (MP_TYPE_FLAG_BINDS_SELF | MP_TYPE_FLAG_BUILTIN_FUN)) == MP_TYPE_FLAG_BINDS_SELF) {
+                dest[0] = locals_map->table[index].value;
+                dest[1] = base;
+                return;
+            }
+        }
+    }
+    mp_attr_cache_load_method_slow(fun, ip, base, attr, dest);
+}
+
+static inline void mp_attr_cache_store_attr(mp_obj_fun_bc_t *fun, const byte *ip, mp_obj_t base, qstr attr, mp_obj_t value) {
+    mp_map_elem_t *elem = mp_attr_cache_member(fun, ip, base, attr);
+    if (elem != NULL && value != MP_OBJ_NULL && !(((mp_obj_base_t *)MP_OBJ_TO_PTR(base))->type->flags & MP_TYPE_FLAG_HAS_SPECIAL_ACCESSORS)) {
+        elem->value = value;
+        return;
+    }
+    mp_attr_cache_store_attr_slow(fun, ip, base, attr, value);
+}
+
+#endif
@@ -332,6 +332,9 @@ void mp_setup_code_state(mp_code_state_t *code_state, size_t n_args, size_t n_kw
     #if MICROPY_PY_SYS_SETTRACE
     code_state->prev_state = NULL;
     code_state->frame = NULL;
+    // CIRCUITPY-CHANGE
+    #elif MICROPY_GC_ALLOC_PROFILE
+    code_state->prev_state = NULL;
     #endif
     mp_setup_code_state_helper(code_state, n_args, n_kw, args);
 }
@@ -68,7 +68,10 @@
 #define MP_BC_UNARY_OP_MULTI                (0xd0) // OOOOOOO
 #define MP_BC_BINARY_OP_MULTI               (0xd7) //        OOOOOOOOO
 //                                          (0xe0) // OOOOOOOOOOOOOOOO
-//                                          (0xf0) // OOOOOOOOOO------
+//                                          (0xf0) // OOOOOOOOOOQQQQQQ
+// CIRCUITPY-CHANGE: quickened binary ops, wrapping round to 0x00-0x0f.  These
+// are never emitted by the compiler, see MICROPY_OPT_BINARY_OP_QUICKEN.
+#define MP_BC_BINARY_OP_QUICK               (0xfa)
 
 #define MP_BC_LOAD_CONST_SMALL_INT_MULTI_NUM (64)
 #define MP_BC_LOAD_CONST_SMALL_INT_MULTI_EXCESS (16)
@@ -76,6 +79,8 @@
 #define MP_BC_STORE_FAST_MULTI_NUM          (16)
 #define MP_BC_UNARY_OP_MULTI_NUM            (MP_UNARY_OP_NUM_BYTECODE)
 #define MP_BC_BINARY_OP_MULTI_NUM           (MP_BINARY_OP_NUM_BYTECODE)
+// CIRCUITPY-CHANGE
+#define MP_BC_BINARY_OP_QUICK_NUM           (22)
 
 #define MP_BC_LOAD_CONST_FALSE              (MP_BC_BASE_BYTE_O + 0x00)
 #define MP_BC_LOAD_CONST_NONE               (MP_BC_BASE_BYTE_O + 0x01)
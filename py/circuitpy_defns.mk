@@ -621,6 +621,7 @@ SRC_SHARED_MODULE_ALL = \
 	aesio/aes.c \
 	atexit/__init__.c \
 	audiocore/RawSample.c \
+	audiocore/Resampler.c \
 	audiocore/WaveFile.c \
 	audiocore/__init__.c \
 	audiodelays/Echo.c \
@@ -696,6 +697,7 @@ SRC_SHARED_MODULE_ALL = \
 	memorymonitor/AllocationSize.c \
 	network/__init__.c \
 	msgpack/__init__.c \
+	msgpack/Unpacker.c \
 	onewireio/__init__.c \
 	onewireio/OneWire.c \
 	os/__init__.c \
@@ -719,6 +721,7 @@ SRC_SHARED_MODULE_ALL = \
 	synthio/Biquad.c \
 	synthio/LFO.c \
 	synthio/Math.c \
+	synthio/MidiFile.c \
 	synthio/MidiTrack.c \
 	synthio/Note.c \
 	synthio/Synthesizer.c \
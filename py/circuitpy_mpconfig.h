@@ -79,6 +79,10 @@ extern void common_hal_mcu_enable_interrupts(void);
 #define MICROPY_GC_ALLOC_THRESHOLD       (0)
 #define MICROPY_GC_SPLIT_HEAP            (1)
 #define MICROPY_GC_SPLIT_HEAP_AUTO       (1)
+#define MICROPY_GC_INCREMENTAL           (CIRCUITPY_GC_INCREMENTAL)
+#define MICROPY_GC_FREE_LISTS            (CIRCUITPY_GC_FREE_LISTS)
+#define MICROPY_GC_NURSERY               (CIRCUITPY_GC_NURSERY)
+#define MICROPY_GC_ALLOC_PROFILE         (CIRCUITPY_GC_ALLOC_PROFILE)
 #define MP_PLAT_ALLOC_HEAP(size) port_malloc(size, false)
 #define MP_PLAT_FREE_HEAP(ptr) port_free(ptr)
 #include "supervisor/port_heap.h"
@@ -93,6 +97,9 @@ extern void common_hal_mcu_enable_interrupts(void);
 #define MICROPY_OPT_COMPUTED_GOTO_SAVE_SPACE (CIRCUITPY_COMPUTED_GOTO_SAVE_SPACE)
 #define MICROPY_OPT_LOAD_ATTR_FAST_PATH  (CIRCUITPY_OPT_LOAD_ATTR_FAST_PATH)
 #define MICROPY_OPT_MAP_LOOKUP_CACHE  (CIRCUITPY_OPT_MAP_LOOKUP_CACHE)
+#define MICROPY_OPT_ATTR_INLINE_CACHE (CIRCUITPY_OPT_ATTR_INLINE_CACHE)
+#define MICROPY_OPT_BINARY_OP_QUICKEN (CIRCUITPY_OPT_BINARY_OP_QUICKEN)
+#define MICROPY_OPT_QSTR_INDEX        (CIRCUITPY_OPT_QSTR_INDEX)
 #define MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE (CIRCUITPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE)
 #define MICROPY_PERSISTENT_CODE_LOAD     (1)
 
@@ -424,6 +431,12 @@ void background_callback_run_all(void);
 #define CIRCUITPY_FILESYSTEM_FLUSH_INTERVAL_MS 1000
 #endif
 
+// Number of external flash erase sectors whose writes are held in RAM until they are flushed or
+// evicted. Each takes 4 kiB while the filesystem is being written. Flushing frees all but one.
+#ifndef CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS
+#define CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS (4)
+#endif
+
 #ifndef CIRCUITPY_PYSTACK_SIZE
 #define CIRCUITPY_PYSTACK_SIZE 1536
 #endif
@@ -445,6 +458,13 @@ void background_callback_run_all(void);
 #define CIRCUITPY_WORKFLOW_CONNECTION_SLEEP_DELAY 5
 #endif
 
+// Bytes of a file the web workflow reads and sends, or receives and writes, at a time. It is borrowed
+// from the port heap only during the transfer. Keep it a multiple of 512 so that file accesses cover
+// whole sectors.
+#ifndef CIRCUITPY_WEB_WORKFLOW_TRANSFER_SIZE
+#define CIRCUITPY_WEB_WORKFLOW_TRANSFER_SIZE (4096)
+#endif
+
 #ifndef CIRCUITPY_PROCESSOR_COUNT
 #define CIRCUITPY_PROCESSOR_COUNT (1)
 #endif
@@ -301,6 +301,25 @@ CFLAGS += -DCIRCUITPY_FREQUENCYIO=$(CIRCUITPY_FREQUENCYIO)
 CIRCUITPY_FUTURE ?= 1
 CFLAGS += -DCIRCUITPY_FUTURE=$(CIRCUITPY_FUTURE)
 
+# Sweep the heap in slices from the background task loop instead of all at once
+# at the end of each collection.
+CIRCUITPY_GC_INCREMENTAL ?= 0
+CFLAGS += -DCIRCUITPY_GC_INCREMENTAL=$(CIRCUITPY_GC_INCREMENTAL)
+
+# Keep lists of small free runs, built by the sweep, so that small allocations
+# don't have to scan the allocation table of a fragmented heap.
+CIRCUITPY_GC_FREE_LISTS ?= 0
+CFLAGS += -DCIRCUITPY_GC_FREE_LISTS=$(CIRCUITPY_GC_FREE_LISTS)
+
+# Allocate small objects in a nursery that can be collected without tracing or
+# sweeping the rest of the heap.
+CIRCUITPY_GC_NURSERY ?= 0
+CFLAGS += -DCIRCUITPY_GC_NURSERY=$(CIRCUITPY_GC_NURSERY)
+
+# Record the source line of each allocation, for micropython.alloc_profile().
+CIRCUITPY_GC_ALLOC_PROFILE ?= 0
+CFLAGS += -DCIRCUITPY_GC_ALLOC_PROFILE=$(CIRCUITPY_GC_ALLOC_PROFILE)
+
 CIRCUITPY_GETPASS ?= $(CIRCUITPY_FULL_BUILD)
 CFLAGS += -DCIRCUITPY_GETPASS=$(CIRCUITPY_GETPASS)
 
@@ -397,9 +416,22 @@ CFLAGS += -DCIRCUITPY_ONEWIREIO=$(CIRCUITPY_ONEWIREIO)
 CIRCUITPY_OPT_LOAD_ATTR_FAST_PATH ?= 1
 CFLAGS += -DCIRCUITPY_OPT_LOAD_ATTR_FAST_PATH=$(CIRCUITPY_OPT_LOAD_ATTR_FAST_PATH)
 
+# Per-opcode caches for attribute loads and stores, kept on the heap with each
+# function that runs them.
+CIRCUITPY_OPT_ATTR_INLINE_CACHE ?= 0
+CFLAGS += -DCIRCUITPY_OPT_ATTR_INLINE_CACHE=$(CIRCUITPY_OPT_ATTR_INLINE_CACHE)
+
+# Rewrite binary ops in bytecode on the heap into versions specialised for
+# small ints and floats.
+CIRCUITPY_OPT_BINARY_OP_QUICKEN ?= 0
+CFLAGS += -DCIRCUITPY_OPT_BINARY_OP_QUICKEN=$(CIRCUITPY_OPT_BINARY_OP_QUICKEN)
+
 CIRCUITPY_OPT_MAP_LOOKUP_CACHE ?= $(CIRCUITPY_FULL_BUILD)
 CFLAGS += -DCIRCUITPY_OPT_MAP_LOOKUP_CACHE=$(CIRCUITPY_OPT_MAP_LOOKUP_CACHE)
 
+CIRCUITPY_OPT_QSTR_INDEX ?= $(CIRCUITPY_FULL_BUILD)
+CFLAGS += -DCIRCUITPY_OPT_QSTR_INDEX=$(CIRCUITPY_OPT_QSTR_INDEX)
+
 CIRCUITPY_OS ?= 1
 CFLAGS += -DCIRCUITPY_OS=$(CIRCUITPY_OS)
 
@@ -31,6 +31,11 @@
 
 #include "py/gc.h"
 #include "py/runtime.h"
+// CIRCUITPY-CHANGE
+#if MICROPY_GC_ALLOC_PROFILE
+#include "py/bc.h"
+#include "py/objfun.h"
+#endif
 
 #if MICROPY_DEBUG_VALGRIND
 #include <valgrind/memcheck.h>
@@ -103,6 +108,14 @@
 #define ATB_HEAD_TO_MARK(area, block) do { area->gc_alloc_table_start[(block) / BLOCKS_PER_ATB] |= (AT_MARK << BLOCK_SHIFT(block)); } while (0)
 #define ATB_MARK_TO_HEAD(area, block) do { area->gc_alloc_table_start[(block) / BLOCKS_PER_ATB] &= (~(AT_TAIL << BLOCK_SHIFT(block))); } while (0)
 
+// CIRCUITPY-CHANGE: while an incremental sweep is pending, live objects that it
+// hasn't reached yet are still marked.
+#if MICROPY_GC_INCREMENTAL
+#define ATB_IS_ALLOCATED_HEAD(area, block) (ATB_GET_KIND(area, block) == AT_HEAD || ATB_GET_KIND(area, block) == AT_MARK)
+#else
+#define ATB_IS_ALLOCATED_HEAD(area, block) (ATB_GET_KIND(area, block) == AT_HEAD)
+#endif
+
 #define BLOCK_FROM_PTR(area, ptr) (((byte *)(ptr) - area->gc_pool_start) / BYTES_PER_BLOCK)
 #define PTR_FROM_BLOCK(area, block) (((block) * BYTES_PER_BLOCK + (uintptr_t)area->gc_pool_start))
 
@@ -233,6 +246,28 @@ void gc_init(void *start, void *end) {
     MP_STATE_MEM(gc_alloc_amount) = 0;
     #endif
 
+    // CIRCUITPY-CHANGE
+    #if MICROPY_GC_INCREMENTAL
+    MP_STATE_MEM(gc_sweep_area) = NULL;
+    #endif
+    #if MICROPY_GC_FREE_LISTS
+    memset(MP_STATE_MEM(gc_free_list), 0, sizeof(MP_STATE_MEM(gc_free_list)));
+    #endif
+    #if MICROPY_GC_NURSERY
+    // the heap is empty, so the nursery can go at the end of it
+    size_t n_blocks = MP_STATE_MEM(area).gc_alloc_table_byte_len * BLOCKS_PER_ATB;
+    MP_STATE_MEM(gc_nursery_area) = &MP_STATE_MEM(area);
+    MP_STATE_MEM(gc_nursery_start) = n_blocks - n_blocks / MICROPY_GC_NURSERY_DIVISOR;
+    MP_STATE_MEM(gc_nursery_end) = MP_STATE_MEM(gc_nursery_start) < n_blocks ? n_blocks : 0;
+    MP_STATE_MEM(gc_nursery_next) = MP_STATE_MEM(gc_nursery_start);
+    MP_STATE_MEM(gc_nursery_only) = false;
+    MP_STATE_MEM(gc_nursery_collections) = 0;
+    MP_STATE_MEM(gc_full_collections) = 0;
+    #endif
+    #if MICROPY_GC_ALLOC_PROFILE
+    MP_STATE_MEM(gc_alloc_profile_enabled) = false;
+    #endif
+
     #if MICROPY_PY_THREAD && !MICROPY_PY_THREAD_GIL
     mp_thread_mutex_init(&MP_STATE_MEM(gc_mutex));
     #endif
@@ -358,6 +393,9 @@ void gc_deinit(void) {
     // any additional heap areas (but not the first.)
     gc_sweep_all();
     memset(&MP_STATE_MEM(area), 0, sizeof(MP_STATE_MEM(area)));
+    #if MICROPY_GC_NURSERY
+    MP_STATE_MEM(gc_nursery_end) = 0;
+    #endif
 }
 
 void gc_lock(void) {
@@ -420,6 +458,21 @@ static inline mp_state_mem_area_t *gc_get_ptr_area(const void *ptr) {
 #endif
 #endif
 
+// CIRCUITPY-CHANGE
+#if MICROPY_GC_NURSERY
+static inline bool gc_in_nursery(mp_state_mem_area_t *area, size_t block) {
+    return area == MP_STATE_MEM(gc_nursery_area)
+           && block >= MP_STATE_MEM(gc_nursery_start) && block < MP_STATE_MEM(gc_nursery_end);
+}
+
+// A nursery collection only marks objects in the nursery.  Those outside it
+// are all treated as live, and anything they refer to in the nursery is found
+// by gc_nursery_scan_old rather than by tracing.
+#define GC_MAY_MARK(area, block) (!MP_STATE_MEM(gc_nursery_only) || gc_in_nursery(area, block))
+#else
+#define GC_MAY_MARK(area, block) (true)
+#endif
+
 // Take the given block as the topmost block on the stack. Check all it's
 // children: mark the unmarked child blocks and put those newly marked
 // blocks on the stack. When all children have been checked, pop off the
@@ -471,6 +524,10 @@ static void MP_NO_INSTRUMENT PLACE_IN_ITCM(gc_mark_subtree)(size_t block)
                 // This block is already marked.
                 continue;
             }
+            // CIRCUITPY-CHANGE
+            if (!GC_MAY_MARK(ptr_area, ptr_block)) {
+                continue;
+            }
             // An unmarked head. Mark it, and push it on gc stack.
             TRACE_MARK(ptr_block, ptr);
             ATB_HEAD_TO_MARK(ptr_area, ptr_block);
@@ -520,6 +577,553 @@ static void gc_deal_with_stack_overflow(void) {
     }
 }
 
+// CIRCUITPY-CHANGE: factored out of gc_sweep so that it can also be used by
+// the incremental sweep.
+#if MICROPY_ENABLE_FINALISER
+// Run the finaliser, if any, of an unmarked head block that is to be freed.
+static void gc_run_finaliser(mp_state_mem_area_t *area, size_t block) {
+    if (FTB_GET(area, block)) {
+        mp_obj_base_t *obj = (mp_obj_base_t *)PTR_FROM_BLOCK(area, block);
+        if (obj->type != NULL) {
+            // if the object has a type then see if it has a __del__ method
+            mp_obj_t dest[2];
+            mp_load_method_maybe(MP_OBJ_FROM_PTR(obj), MP_QSTR___del__, dest);
+            if (dest[0] != MP_OBJ_NULL) {
+                // load_method returned a method, execute it in a protected environment
+                #if MICROPY_ENABLE_SCHEDULER
+                mp_sched_lock();
+                #endif
+                mp_call_function_1_protected(dest[0], dest[1]);
+                #if MICROPY_ENABLE_SCHEDULER
+                mp_sched_unlock();
+                #endif
+            }
+        }
+        // clear finaliser flag
+        FTB_CLEAR(area, block);
+    }
+}
+#endif
+
+// Run the finaliser, if any, of an unmarked head block that is about to be freed.
+static void gc_sweep_free_head(mp_state_mem_area_t *area, size_t block) {
+    #if MICROPY_ENABLE_FINALISER
+    gc_run_finaliser(area, block);
+    #endif
+    DEBUG_printf("gc_sweep(%p)\n", (void *)PTR_FROM_BLOCK(area, block));
+    #if MICROPY_PY_GC_COLLECT_RETVAL
+    MP_STATE_MEM(gc_collected)++;
+    #endif
+}
+
+// CIRCUITPY-CHANGE
+#if MICROPY_GC_FREE_LISTS
+
+// A run of free blocks on one of the free lists.  It is stored in the first
+// block of the run itself, which is free and so never scanned.  Only the sweep
+// lists runs: gc_free must leave the freed memory alone, because callers may
+// still read from a buffer that gc_realloc has just moved.
+typedef struct _gc_free_run_t {
+    struct _gc_free_run_t *next;
+    size_t len;
+} gc_free_run_t;
+
+#define GC_FREE_LIST_CLASSES MP_ARRAY_SIZE(MP_STATE_MEM(gc_free_list))
+
+static void gc_free_lists_clear(void) {
+    for (size_t c = 0; c < GC_FREE_LIST_CLASSES; c++) {
+        MP_STATE_MEM(gc_free_list)[c] = NULL;
+        MP_STATE_MEM(gc_free_list_tail)[c] = NULL;
+    }
+}
+
+// Put a run of n_blocks free blocks, starting at block, at the front of the
+// list for its size.
+static void gc_free_list_add(mp_state_mem_area_t *area, size_t block, size_t n_blocks) {
+    if (n_blocks == 0) {
+        return;
+    }
+    size_t c = MIN(n_blocks, GC_FREE_LIST_CLASSES) - 1;
+    gc_free_run_t *run = (gc_free_run_t *)PTR_FROM_BLOCK(area, block);
+    run->next = MP_STATE_MEM(gc_free_list)[c];
+    run->len = n_blocks;
+    MP_STATE_MEM(gc_free_list)[c] = run;
+    if (run->next == NULL) {
+        MP_STATE_MEM(gc_free_list_tail)[c] = run;
+    }
+}
+
+// Returns the area of a listed run if its first n_blocks blocks are still
+// free, or NULL.  Runs can go stale because the ATB scan, gc_realloc and the
+// freeing of empty areas don't maintain the lists, so the pointer is checked
+// before anything is read through it.
+static mp_state_mem_area_t *gc_free_run_area(gc_free_run_t *run, size_t n_blocks) {
+    mp_state_mem_area_t *area;
+    #if MICROPY_GC_SPLIT_HEAP
+    area = gc_get_ptr_area(run);
+    if (area == NULL) {
+        return NULL;
+    }
+    #else
+    if (!VERIFY_PTR((void *)run)) {
+        return NULL;
+    }
+    area = &MP_STATE_MEM(area);
+    #endif
+    size_t block = BLOCK_FROM_PTR(area, run);
+    if (block + n_blocks > area->gc_alloc_table_byte_len * BLOCKS_PER_ATB) {
+        return NULL;
+    }
+    for (size_t bl = block; bl < block + n_blocks; bl++) {
+        if (ATB_GET_KIND(area, bl) != AT_FREE) {
+            return NULL;
+        }
+    }
+    return area;
+}
+
+// Put a run found by the sweep at the end of the list for its size, so that
+// the lists hand out the lowest free blocks first, as the ATB scan would.
+static void gc_free_list_append(mp_state_mem_area_t *area, size_t block, size_t n_blocks) {
+    if (n_blocks == 0) {
+        return;
+    }
+    size_t c = MIN(n_blocks, GC_FREE_LIST_CLASSES) - 1;
+    gc_free_run_t *tail = MP_STATE_MEM(gc_free_list_tail)[c];
+    if (MP_STATE_MEM(gc_free_list)[c] == NULL || gc_free_run_area(tail, 1) == NULL) {
+        // the tail has been allocated since the last slice of the sweep
+        gc_free_list_add(area, block, n_blocks);
+        return;
+    }
+    gc_free_run_t *run = (gc_free_run_t *)PTR_FROM_BLOCK(area, block);
+    run->next = NULL;
+    run->len = n_blocks;
+    tail->next = run;
+    MP_STATE_MEM(gc_free_list_tail)[c] = run;
+}
+
+// Take n_blocks free blocks from the free lists, preferring a run of exactly
+// that size and otherwise splitting a longer one.
+static bool gc_free_list_take(size_t n_blocks, mp_state_mem_area_t **area_out, size_t *block_out) {
+    for (size_t c = n_blocks - 1; c < GC_FREE_LIST_CLASSES; c++) {
+        gc_free_run_t *run = MP_STATE_MEM(gc_free_list)[c];
+        if (run == NULL) {
+            continue;
+        }
+        mp_state_mem_area_t *area = gc_free_run_area(run, n_blocks);
+        if (area == NULL) {
+            // the rest of a stale list can't be followed, so drop it
+            MP_STATE_MEM(gc_free_list)[c] = NULL;
+            continue;
+        }
+        MP_STATE_MEM(gc_free_list)[c] = run->next;
+        size_t len = run->len;
+        run->next = NULL;
+        run->len = 0;
+        size_t block = BLOCK_FROM_PTR(area, run);
+        size_t rest = block + n_blocks;
+        if (len > n_blocks
+            && rest < area->gc_alloc_table_byte_len * BLOCKS_PER_ATB
+            && ATB_GET_KIND(area, rest) == AT_FREE) {
+            gc_free_list_add(area, rest, len - n_blocks);
+        }
+        *area_out = area;
+        *block_out = block;
+        return true;
+    }
+    return false;
+}
+
+// List the free run that ends the swept part of an area; everything after
+// the area's last used block is free too.
+static void gc_free_list_add_last(mp_state_mem_area_t *area, size_t end_block, size_t free_run) {
+    gc_free_list_append(area, end_block - free_run,
+        free_run + area->gc_alloc_table_byte_len * BLOCKS_PER_ATB - end_block);
+}
+
+#endif // MICROPY_GC_FREE_LISTS
+
+// CIRCUITPY-CHANGE
+#if MICROPY_GC_NURSERY
+
+// Move the nursery to the end of the largest free run in the heap, which
+// leaves whatever survived in the old one to full collections.  There is no
+// nursery until the next full collection if no run is big enough.
+static void gc_nursery_place(void) {
+    size_t total_blocks = 0;
+    size_t best_run = 0;
+    size_t best_end = 0;
+    mp_state_mem_area_t *best_area = NULL;
+    for (mp_state_mem_area_t *area = &MP_STATE_MEM(area); area != NULL; area = NEXT_AREA(area)) {
+        size_t n_blocks = area->gc_alloc_table_byte_len * BLOCKS_PER_ATB;
+        size_t end_block = MIN(n_blocks, area->gc_last_used_block + 1);
+        size_t run = 0;
+        total_blocks += n_blocks;
+        for (size_t block = 0; block < end_block; block++) {
+            MICROPY_GC_HOOK_LOOP(block);
+            if (ATB_GET_KIND(area, block) != AT_FREE) {
+                run = 0;
+            } else if (++run > best_run) {
+                best_run = run;
+                best_end = block + 1;
+                best_area = area;
+            }
+        }
+        // everything after the last used block is free
+        if (run + n_blocks - end_block > best_run) {
+            best_run = run + n_blocks - end_block;
+            best_end = n_blocks;
+            best_area = area;
+        }
+    }
+    size_t size = MIN(best_run, total_blocks / MICROPY_GC_NURSERY_DIVISOR);
+    if (size == 0 || size < total_blocks / MICROPY_GC_NURSERY_DIVISOR / 4) {
+        MP_STATE_MEM(gc_nursery_end) = 0;
+        return;
+    }
+    MP_STATE_MEM(gc_nursery_area) = best_area;
+    MP_STATE_MEM(gc_nursery_start) = best_end - size;
+    MP_STATE_MEM(gc_nursery_end) = best_end;
+    MP_STATE_MEM(gc_nursery_next) = best_end - size;
+}
+
+// Find n_blocks free blocks in the part of the nursery not yet allocated from.
+static bool gc_nursery_take(size_t n_blocks, size_t *block_out) {
+    mp_state_mem_area_t *area = MP_STATE_MEM(gc_nursery_area);
+    size_t n_free = 0;
+    for (size_t block = MP_STATE_MEM(gc_nursery_next); block < MP_STATE_MEM(gc_nursery_end); block++) {
+        if (ATB_GET_KIND(area, block) != AT_FREE) {
+            n_free = 0;
+        } else if (++n_free == n_blocks) {
+            *block_out = block + 1 - n_blocks;
+            MP_STATE_MEM(gc_nursery_next) = block + 1;
+            return true;
+        }
+    }
+    MP_STATE_MEM(gc_nursery_next) = MP_STATE_MEM(gc_nursery_end);
+    return false;
+}
+
+// Mark the objects in the nursery that are referenced from outside it.  There
+// is no write barrier, and so no remembered set of such references, so every
+// block in use outside the nursery is scanned for them.  This is a linear
+// pass with a range check per word over the whole heap, which is why a nursery
+// collection isn't a generational minor collection: it saves tracing and
+// sweeping the rest of the heap, but not reading it.  It also keeps alive
+// nursery objects referenced only by garbage until the next full collection.
+static void gc_nursery_scan_old(void) {
+    mp_state_mem_area_t *nursery_area = MP_STATE_MEM(gc_nursery_area);
+    uintptr_t nursery_ptr = (uintptr_t)PTR_FROM_BLOCK(nursery_area, MP_STATE_MEM(gc_nursery_start));
+    uintptr_t nursery_len = (MP_STATE_MEM(gc_nursery_end) - MP_STATE_MEM(gc_nursery_start)) * BYTES_PER_BLOCK;
+    for (mp_state_mem_area_t *area = &MP_STATE_MEM(area); area != NULL; area = NEXT_AREA(area)) {
+        size_t end_block = area->gc_alloc_table_byte_len * BLOCKS_PER_ATB;
+        if (area->gc_last_used_block < end_block) {
+            end_block = area->gc_last_used_block + 1;
+        }
+        // whether the object the current block belongs to is in the nursery
+        bool young = false;
+        for (size_t block = 0; block < end_block; block++) {
+            MICROPY_GC_HOOK_LOOP(block);
+            if (area == nursery_area && gc_in_nursery(area, block) && ATB_GET_KIND(area, block) != AT_TAIL) {
+                // young objects are traced if they're reachable; skip the
+                // window and any tails of its last object that follow it.
+                // gc_realloc may have grown an old object in place into the
+                // start of the window, so its tails are scanned like the rest
+                // of it before this is reached.
+                block = MP_STATE_MEM(gc_nursery_end) - 1;
+                young = true;
+                continue;
+            }
+            if ((block & (BLOCKS_PER_ATB - 1)) == 0
+                && area->gc_alloc_table_start[block / BLOCKS_PER_ATB] == 0
+                && !gc_in_nursery(area, block + BLOCKS_PER_ATB - 1)) {
+                // four free blocks
+                block += BLOCKS_PER_ATB - 1;
+                continue;
+            }
+            int kind = ATB_GET_KIND(area, block);
+            if (kind == AT_FREE) {
+                continue;
+            }
+            if (kind != AT_TAIL) {
+                young = false;
+            }
+            if (young) {
+                continue;
+            }
+            void **ptrs = (void **)PTR_FROM_BLOCK(area, block);
+            for (size_t i = 0; i < BYTES_PER_BLOCK / sizeof(void *); i++) {
+                if ((uintptr_t)ptrs[i] - nursery_ptr < nursery_len) {
+                    gc_collect_ptr(ptrs[i]);
+                }
+            }
+        }
+    }
+}
+
+// Free the unmarked objects in the nursery, including any tails they have
+// grown beyond its end.
+static void gc_nursery_sweep(void) {
+    #if MICROPY_PY_GC_COLLECT_RETVAL
+    MP_STATE_MEM(gc_collected) = 0;
+    #endif
+    mp_state_mem_area_t *area = MP_STATE_MEM(gc_nursery_area);
+    size_t n_blocks = area->gc_alloc_table_byte_len * BLOCKS_PER_ATB;
+    size_t start = MP_STATE_MEM(gc_nursery_start);
+    size_t end = MP_STATE_MEM(gc_nursery_end);
+    size_t n_free = 0;
+    int free_tail = 0;
+    for (size_t block = start; block < n_blocks; block++) {
+        MICROPY_GC_HOOK_LOOP(block);
+        int kind = ATB_GET_KIND(area, block);
+        if (block >= end && kind != AT_TAIL) {
+            break;
+        }
+        switch (kind) {
+            case AT_HEAD:
+                gc_sweep_free_head(area, block);
+                free_tail = 1;
+                MP_FALLTHROUGH
+
+            case AT_TAIL:
+                if (free_tail) {
+                    ATB_ANY_TO_FREE(area, block);
+                    #if CLEAR_ON_SWEEP
+                    memset((void *)PTR_FROM_BLOCK(area, block), 0, BYTES_PER_BLOCK);
+                    #endif
+                }
+                break;
+
+            case AT_MARK:
+                ATB_MARK_TO_HEAD(area, block);
+                free_tail = 0;
+                break;
+        }
+        if (block < end && ATB_GET_KIND(area, block) == AT_FREE) {
+            n_free++;
+        }
+    }
+
+    #if MICROPY_GC_SPLIT_HEAP
+    MP_STATE_MEM(gc_last_free_area) = &MP_STATE_MEM(area);
+    #endif
+    if (start / BLOCKS_PER_ATB < area->gc_last_free_atb_index) {
+        area->gc_last_free_atb_index = start / BLOCKS_PER_ATB;
+    }
+
+    MP_STATE_MEM(gc_nursery_next) = start;
+    if (n_free < (end - start) / 2) {
+        // mostly survivors: promote them by moving on
+        gc_nursery_place();
+    }
+}
+
+void gc_collect_nursery(void) {
+    GC_ENTER();
+    MP_STATE_MEM(gc_nursery_only) = MP_STATE_MEM(gc_nursery_end) != 0;
+    GC_EXIT();
+    gc_collect();
+}
+
+#endif // MICROPY_GC_NURSERY
+
+#if MICROPY_GC_INCREMENTAL
+
+#if MICROPY_ENABLE_FINALISER
+// Run the finalisers of everything the collection found to be garbage before
+// any of it is swept.  The sweep itself runs from allocations and background
+// tasks, which aren't safe places to run Python code, so by the time it
+// reaches these objects their finaliser flags are clear.  Only the finaliser
+// table is read, a byte per eight blocks, so this is short next to a sweep.
+static void gc_run_finalisers(void) {
+    for (mp_state_mem_area_t *area = &MP_STATE_MEM(area); area != NULL; area = NEXT_AREA(area)) {
+        size_t n_blocks = area->gc_alloc_table_byte_len * BLOCKS_PER_ATB;
+        for (size_t i = 0; i * BLOCKS_PER_FTB < n_blocks; i++) {
+            if (area->gc_finaliser_table_start[i] == 0) {
+                continue;
+            }
+            size_t end_block = MIN((i + 1) * BLOCKS_PER_FTB, n_blocks);
+            for (size_t block = i * BLOCKS_PER_FTB; block < end_block; block++) {
+                if (ATB_GET_KIND(area, block) == AT_HEAD) {
+                    gc_run_finaliser(area, block);
+                }
+            }
+        }
+    }
+}
+#endif
+
+// Begin a deferred sweep of the whole heap.
+static void gc_sweep_start(void) {
+    #if MICROPY_PY_GC_COLLECT_RETVAL
+    MP_STATE_MEM(gc_collected) = 0;
+    #endif
+    #if MICROPY_GC_FREE_LISTS
+    gc_free_lists_clear();
+    #endif
+    MP_STATE_MEM(gc_sweep_area) = &MP_STATE_MEM(area);
+    MP_STATE_MEM(gc_sweep_block) = 0;
+    MP_STATE_MEM(gc_sweep_last_used_block) = 0;
+    #if MICROPY_GC_SPLIT_HEAP_AUTO
+    MP_STATE_MEM(gc_sweep_prev_area) = NULL;
+    #endif
+}
+
+// Whether the given block is yet to be reached by the pending sweep.
+static bool gc_sweep_is_pending_at(mp_state_mem_area_t *area, size_t block) {
+    for (mp_state_mem_area_t *a = MP_STATE_MEM(gc_sweep_area); a != NULL; a = NEXT_AREA(a)) {
+        if (a == area) {
+            return a != MP_STATE_MEM(gc_sweep_area) || block >= MP_STATE_MEM(gc_sweep_block);
+        }
+    }
+    return false;
+}
+
+// Continue the pending sweep, stopping at the first object boundary after at
+// least n_blocks blocks have been visited.  Because it only stops between
+// objects, the state of a partly freed object never has to be carried over.
+// Must be called with the GC mutex held and the GC locked.  Returns true once
+// the whole heap has been swept.
+static bool gc_sweep_run(size_t n_blocks) {
+    mp_state_mem_area_t *area = MP_STATE_MEM(gc_sweep_area);
+    size_t block = MP_STATE_MEM(gc_sweep_block);
+    size_t last_used_block = MP_STATE_MEM(gc_sweep_last_used_block);
+    int free_tail = 0;
+    #if MICROPY_GC_FREE_LISTS
+    size_t free_run = 0;
+    #endif
+    while (area != NULL) {
+        size_t end_block = area->gc_alloc_table_byte_len * BLOCKS_PER_ATB;
+        if (area->gc_last_used_block < end_block) {
+            end_block = area->gc_last_used_block + 1;
+        }
+
+        for (; block < end_block; block++) {
+            MICROPY_GC_HOOK_LOOP(block);
+            int kind = ATB_GET_KIND(area, block);
+            if (kind != AT_TAIL) {
+                if (n_blocks == 0) {
+                    #if MICROPY_GC_FREE_LISTS
+                    gc_free_list_append(area, block - free_run, free_run);
+                    #endif
+                    MP_STATE_MEM(gc_sweep_area) = area;
+                    MP_STATE_MEM(gc_sweep_block) = block;
+                    MP_STATE_MEM(gc_sweep_last_used_block) = last_used_block;
+                    return false;
+                }
+            }
+            if (n_blocks > 0) {
+                n_blocks--;
+            }
+            switch (kind) {
+                case AT_HEAD:
+                    gc_sweep_free_head(area, block);
+                    free_tail = 1;
+                    // allocations may have moved the free pointers past this block
+                    #if MICROPY_GC_SPLIT_HEAP
+                    MP_STATE_MEM(gc_last_free_area) = &MP_STATE_MEM(area);
+                    #endif
+                    if (block / BLOCKS_PER_ATB < area->gc_last_free_atb_index) {
+                        area->gc_last_free_atb_index = block / BLOCKS_PER_ATB;
+                    }
+                    MP_FALLTHROUGH
+
+                case AT_TAIL:
+                    if (free_tail) {
+                        ATB_ANY_TO_FREE(area, block);
+                        #if CLEAR_ON_SWEEP
+                        memset((void *)PTR_FROM_BLOCK(area, block), 0, BYTES_PER_BLOCK);
+                        #endif
+                    } else {
+                        last_used_block = block;
+                    }
+                    break;
+
+                case AT_MARK:
+                    ATB_MARK_TO_HEAD(area, block);
+                    free_tail = 0;
+                    last_used_block = block;
+                    break;
+            }
+            #if MICROPY_GC_FREE_LISTS
+            if (kind == AT_FREE || (kind != AT_MARK && free_tail)) {
+                free_run++;
+            } else if (free_run > 0) {
+                gc_free_list_append(area, block - free_run, free_run);
+                free_run = 0;
+            }
+            #endif
+        }
+
+        area->gc_last_used_block = last_used_block;
+        #if MICROPY_GC_FREE_LISTS
+        gc_free_list_add_last(area, end_block, free_run);
+        free_run = 0;
+        #endif
+
+        #if MICROPY_GC_SPLIT_HEAP_AUTO
+        // Free any empty area, aside from the first one
+        mp_state_mem_area_t *prev_area = MP_STATE_MEM(gc_sweep_prev_area);
+        if (last_used_block == 0 && prev_area != NULL) {
+            DEBUG_printf("gc_sweep free empty area %p\n", area);
+            NEXT_AREA(prev_area) = NEXT_AREA(area);
+            #if MICROPY_GC_SPLIT_HEAP
+            if (MP_STATE_MEM(gc_last_free_area) == area) {
+                MP_STATE_MEM(gc_last_free_area) = &MP_STATE_MEM(area);
+            }
+            #endif
+            #if MICROPY_GC_NURSERY
+            if (MP_STATE_MEM(gc_nursery_area) == area) {
+                MP_STATE_MEM(gc_nursery_end) = 0;
+            }
+            #endif
+            MP_PLAT_FREE_HEAP(area);
+            area = prev_area;
+        }
+        MP_STATE_MEM(gc_sweep_prev_area) = area;
+        #endif
+
+        area = NEXT_AREA(area);
+        block = 0;
+        last_used_block = 0;
+    }
+    MP_STATE_MEM(gc_sweep_area) = NULL;
+    return true;
+}
+
+// Sweep whatever the last collection left, regardless of the GC lock.
+static void gc_sweep_complete(void) {
+    GC_ENTER();
+    if (MP_STATE_MEM(gc_sweep_area) != NULL) {
+        MP_STATE_THREAD(gc_lock_depth)++;
+        gc_sweep_run(SIZE_MAX);
+        MP_STATE_THREAD(gc_lock_depth)--;
+    }
+    GC_EXIT();
+}
+
+bool gc_sweep_step(size_t n_blocks) {
+    // Don't sweep from inside a finaliser, or while the heap is locked.
+    if (MP_STATE_MEM(gc_sweep_area) == NULL || MP_STATE_THREAD(gc_lock_depth) > 0) {
+        return MP_STATE_MEM(gc_sweep_area) != NULL;
+    }
+    GC_ENTER();
+    bool done = true;
+    if (MP_STATE_MEM(gc_sweep_area) != NULL) {
+        MP_STATE_THREAD(gc_lock_depth)++;
+        done = gc_sweep_run(n_blocks);
+        MP_STATE_THREAD(gc_lock_depth)--;
+    }
+    GC_EXIT();
+    return !done;
+}
+
+void gc_sweep_finish(void) {
+    gc_sweep_complete();
+}
+
+#else
+
 static void gc_sweep(void) {
     #if MICROPY_PY_GC_COLLECT_RETVAL
     MP_STATE_MEM(gc_collected) = 0;
@@ -529,6 +1133,9 @@ static void gc_sweep(void) {
     #if MICROPY_GC_SPLIT_HEAP_AUTO
     mp_state_mem_area_t *prev_area = NULL;
     #endif
+    #if MICROPY_GC_FREE_LISTS
+    gc_free_lists_clear();
+    #endif
     for (mp_state_mem_area_t *area = &MP_STATE_MEM(area); area != NULL; area = NEXT_AREA(area)) {
         size_t end_block = area->gc_alloc_table_byte_len * BLOCKS_PER_ATB;
         if (area->gc_last_used_block < end_block) {
@@ -536,38 +1143,17 @@ static void gc_sweep(void) {
         }
 
         size_t last_used_block = 0;
+        #if MICROPY_GC_FREE_LISTS
+        size_t free_run = 0;
+        #endif
 
         for (size_t block = 0; block < end_block; block++) {
             MICROPY_GC_HOOK_LOOP(block);
-            switch (ATB_GET_KIND(area, block)) {
+            int kind = ATB_GET_KIND(area, block);
+            switch (kind) {
                 case AT_HEAD:
-                    #if MICROPY_ENABLE_FINALISER
-                    if (FTB_GET(area, block)) {
-                        mp_obj_base_t *obj = (mp_obj_base_t *)PTR_FROM_BLOCK(area, block);
-                        if (obj->type != NULL) {
-                            // if the object has a type then see if it has a __del__ method
-                            mp_obj_t dest[2];
-                            mp_load_method_maybe(MP_OBJ_FROM_PTR(obj), MP_QSTR___del__, dest);
-                            if (dest[0] != MP_OBJ_NULL) {
-                                // load_method returned a method, execute it in a protected environment
-                                #if MICROPY_ENABLE_SCHEDULER
-                                mp_sched_lock();
-                                #endif
-                                mp_call_function_1_protected(dest[0], dest[1]);
-                                #if MICROPY_ENABLE_SCHEDULER
-                                mp_sched_unlock();
-                                #endif
-                            }
-                        }
-                        // clear finaliser flag
-                        FTB_CLEAR(area, block);
-                    }
-                    #endif
+                    gc_sweep_free_head(area, block);
                     free_tail = 1;
-                    DEBUG_printf("gc_sweep(%p)\n", (void *)PTR_FROM_BLOCK(area, block));
-                    #if MICROPY_PY_GC_COLLECT_RETVAL
-                    MP_STATE_MEM(gc_collected)++;
-                    #endif
                     // fall through to free the head
                     MP_FALLTHROUGH
 
@@ -588,15 +1174,31 @@ static void gc_sweep(void) {
                     last_used_block = block;
                     break;
             }
+            #if MICROPY_GC_FREE_LISTS
+            if (kind == AT_FREE || (kind != AT_MARK && free_tail)) {
+                free_run++;
+            } else if (free_run > 0) {
+                gc_free_list_append(area, block - free_run, free_run);
+                free_run = 0;
+            }
+            #endif
         }
 
         area->gc_last_used_block = last_used_block;
+        #if MICROPY_GC_FREE_LISTS
+        gc_free_list_add_last(area, end_block, free_run);
+        #endif
 
         #if MICROPY_GC_SPLIT_HEAP_AUTO
         // Free any empty area, aside from the first one
         if (last_used_block == 0 && prev_area != NULL) {
             DEBUG_printf("gc_sweep free empty area %p\n", area);
             NEXT_AREA(prev_area) = NEXT_AREA(area);
+            #if MICROPY_GC_NURSERY
+            if (MP_STATE_MEM(gc_nursery_area) == area) {
+                MP_STATE_MEM(gc_nursery_end) = 0;
+            }
+            #endif
             MP_PLAT_FREE_HEAP(area);
             area = prev_area;
         }
@@ -605,14 +1207,36 @@ static void gc_sweep(void) {
     }
 }
 
+#endif // MICROPY_GC_INCREMENTAL
+
 void gc_collect_start(void) {
     GC_ENTER();
     MP_STATE_THREAD(gc_lock_depth)++;
+    // CIRCUITPY-CHANGE: marking relies on every live object being an unmarked
+    // head, so finish any sweep left over from the previous collection.  Only
+    // an explicit collection gets here with much of it left: gc_alloc sweeps
+    // all of it before collecting for lack of memory, and leaves threshold and
+    // nursery collections until it is done.
+    #if MICROPY_GC_INCREMENTAL
+    if (MP_STATE_MEM(gc_sweep_area) != NULL) {
+        gc_sweep_run(SIZE_MAX);
+    }
+    #endif
     #if MICROPY_GC_ALLOC_THRESHOLD
     MP_STATE_MEM(gc_alloc_amount) = 0;
     #endif
     MP_STATE_MEM(gc_stack_overflow) = 0;
 
+    // CIRCUITPY-CHANGE
+    #if MICROPY_GC_NURSERY
+    if (MP_STATE_MEM(gc_nursery_only)) {
+        MP_STATE_MEM(gc_nursery_collections)++;
+        gc_nursery_scan_old();
+    } else {
+        MP_STATE_MEM(gc_full_collections)++;
+    }
+    #endif
+
     // Trace root pointers.  This relies on the root pointers being organised
     // correctly in the mp_state_ctx structure.  We scan nlr_top, dict_locals,
     // dict_globals, then the root pointer section of mp_state_vm.
@@ -668,7 +1292,8 @@ void gc_collect_root(void **ptrs, size_t len) {
         }
         #endif
         size_t block = BLOCK_FROM_PTR(area, ptr);
-        if (ATB_GET_KIND(area, block) == AT_HEAD) {
+        // CIRCUITPY-CHANGE
+        if (ATB_GET_KIND(area, block) == AT_HEAD && GC_MAY_MARK(area, block)) {
             // An unmarked head: mark it, and mark all its children
             ATB_HEAD_TO_MARK(area, block);
             #if MICROPY_GC_SPLIT_HEAP
@@ -682,13 +1307,34 @@ void gc_collect_root(void **ptrs, size_t len) {
 
 void gc_collect_end(void) {
     gc_deal_with_stack_overflow();
+    // CIRCUITPY-CHANGE
+    #if MICROPY_GC_NURSERY
+    if (MP_STATE_MEM(gc_nursery_only)) {
+        gc_nursery_sweep();
+        MP_STATE_MEM(gc_nursery_only) = false;
+        MP_STATE_THREAD(gc_lock_depth)--;
+        GC_EXIT();
+        return;
+    }
+    #endif
+    // CIRCUITPY-CHANGE
+    #if MICROPY_GC_INCREMENTAL
+    #if MICROPY_ENABLE_FINALISER
+    gc_run_finalisers();
+    #endif
+    gc_sweep_start();
+    #else
     gc_sweep();
+    #endif
     #if MICROPY_GC_SPLIT_HEAP
     MP_STATE_MEM(gc_last_free_area) = &MP_STATE_MEM(area);
     #endif
     for (mp_state_mem_area_t *area = &MP_STATE_MEM(area); area != NULL; area = NEXT_AREA(area)) {
         area->gc_last_free_atb_index = 0;
     }
+    #if MICROPY_GC_NURSERY
+    gc_nursery_place();
+    #endif
     MP_STATE_THREAD(gc_lock_depth)--;
     GC_EXIT();
 }
@@ -696,8 +1342,17 @@ void gc_collect_end(void) {
 void gc_sweep_all(void) {
     GC_ENTER();
     MP_STATE_THREAD(gc_lock_depth)++;
+    // CIRCUITPY-CHANGE
+    #if MICROPY_GC_INCREMENTAL
+    if (MP_STATE_MEM(gc_sweep_area) != NULL) {
+        gc_sweep_run(SIZE_MAX);
+    }
+    #endif
     MP_STATE_MEM(gc_stack_overflow) = 0;
     gc_collect_end();
+    #if MICROPY_GC_INCREMENTAL
+    gc_sweep_complete();
+    #endif
 }
 
 void gc_info(gc_info_t *info) {
@@ -722,6 +1377,15 @@ void gc_info(gc_info_t *info) {
                     len = 0;
                     break;
 
+                case AT_MARK:
+                    // CIRCUITPY-CHANGE: only seen while an incremental sweep is pending
+                    #if MICROPY_GC_INCREMENTAL
+                    MP_FALLTHROUGH
+                    #else
+                    // shouldn't happen
+                    break;
+                    #endif
+
                 case AT_HEAD:
                     info->used += 1;
                     len = 1;
@@ -731,10 +1395,6 @@ void gc_info(gc_info_t *info) {
                     info->used += 1;
                     len += 1;
                     break;
-
-                case AT_MARK:
-                    // shouldn't happen
-                    break;
             }
 
             block++;
@@ -744,7 +1404,7 @@ void gc_info(gc_info_t *info) {
                 kind = ATB_GET_KIND(area, block);
             }
 
-            if (finish || kind == AT_FREE || kind == AT_HEAD) {
+            if (finish || kind == AT_FREE || kind == AT_HEAD || kind == AT_MARK) {
                 if (len == 1) {
                     info->num_1block += 1;
                 } else if (len == 2) {
@@ -753,7 +1413,7 @@ void gc_info(gc_info_t *info) {
                 if (len > info->max_block) {
                     info->max_block = len;
                 }
-                if (finish || kind == AT_HEAD) {
+                if (finish || kind == AT_HEAD || kind == AT_MARK) {
                     if (len_free > info->max_free) {
                         info->max_free = len_free;
                     }
@@ -773,6 +1433,80 @@ void gc_info(gc_info_t *info) {
     GC_EXIT();
 }
 
+// CIRCUITPY-CHANGE
+static inline void gc_note_used_block(mp_state_mem_area_t *area, size_t block) {
+    area->gc_last_used_block = MAX(area->gc_last_used_block, block);
+    #if MICROPY_GC_INCREMENTAL
+    // a pending sweep recomputes gc_last_used_block, so it needs to know too
+    if (area == MP_STATE_MEM(gc_sweep_area)) {
+        MP_STATE_MEM(gc_sweep_last_used_block) = MAX(MP_STATE_MEM(gc_sweep_last_used_block), block);
+    }
+    #endif
+}
+
+// CIRCUITPY-CHANGE
+#if MICROPY_GC_ALLOC_PROFILE
+void gc_alloc_profile_enable(bool enable) {
+    if (enable) {
+        memset(MP_STATE_MEM(gc_alloc_profile), 0, sizeof(MP_STATE_MEM(gc_alloc_profile)));
+        memset(&MP_STATE_MEM(gc_alloc_profile_dropped), 0, sizeof(MP_STATE_MEM(gc_alloc_profile_dropped)));
+        MP_STATE_MEM(gc_alloc_profile_len) = 0;
+        MP_STATE_MEM(gc_alloc_profile_countdown) = MICROPY_GC_ALLOC_PROFILE_PERIOD;
+    }
+    MP_STATE_MEM(gc_alloc_profile_enabled) = enable;
+}
+
+// Charge an allocation of n_blocks to the source line that the innermost
+// bytecode function is executing.  Allocations made outside bytecode, for
+// example while the REPL compiles a line, aren't recorded.
+static void gc_alloc_profile_record(size_t n_blocks) {
+    if (--MP_STATE_MEM(gc_alloc_profile_countdown) > 0) {
+        return;
+    }
+    MP_STATE_MEM(gc_alloc_profile_countdown) = MICROPY_GC_ALLOC_PROFILE_PERIOD;
+    const mp_code_state_t *code_state = MP_STATE_THREAD(current_code_state);
+    if (code_state == NULL) {
+        return;
+    }
+
+    // decode the prelude as the VM does when it adds a traceback entry
+    const mp_obj_fun_bc_t *fun_bc = code_state->fun_bc;
+    const byte *ip = fun_bc->bytecode;
+    MP_BC_PRELUDE_SIG_DECODE(ip);
+    MP_BC_PRELUDE_SIZE_DECODE(ip);
+    const byte *line_info_top = ip + n_info;
+    const byte *bytecode_start = ip + n_info + n_cell;
+    // ip is still in the prelude while the arguments are set up
+    size_t bc = code_state->ip > bytecode_start ? (size_t)(code_state->ip - bytecode_start) : 0;
+    for (size_t i = 0; i < 1 + n_pos_args + n_kwonly_args; ++i) {
+        ip = mp_decode_uint_skip(ip);
+    }
+    #if MICROPY_EMIT_BYTECODE_USES_QSTR_TABLE
+    qstr source_file = fun_bc->context->constants.qstr_table[0];
+    #else
+    qstr source_file = fun_bc->context->constants.source_file;
+    #endif
+    size_t source_line = mp_bytecode_get_source_line(ip, line_info_top, bc);
+
+    mp_alloc_profile_entry_t *entry = MP_STATE_MEM(gc_alloc_profile);
+    mp_alloc_profile_entry_t *end = entry + MP_STATE_MEM(gc_alloc_profile_len);
+    while (entry < end && (entry->source_line != source_line || entry->source_file != source_file)) {
+        entry++;
+    }
+    if (entry == end) {
+        if (MP_STATE_MEM(gc_alloc_profile_len) < MICROPY_GC_ALLOC_PROFILE_SIZE) {
+            MP_STATE_MEM(gc_alloc_profile_len)++;
+            entry->source_file = source_file;
+            entry->source_line = source_line;
+        } else {
+            entry = &MP_STATE_MEM(gc_alloc_profile_dropped);
+        }
+    }
+    entry->count += MICROPY_GC_ALLOC_PROFILE_PERIOD;
+    entry->bytes += n_blocks * BYTES_PER_BLOCK * MICROPY_GC_ALLOC_PROFILE_PERIOD;
+}
+#endif
+
 // CIRCUITPY-CHANGE: C code may be used when the VM heap isn't active. This
 // allows that code to test if it is. It can use the outer pool if needed.
 bool gc_alloc_possible(void) {
@@ -794,6 +1528,12 @@ void *gc_alloc(size_t n_bytes, unsigned int alloc_flags) {
         return NULL;
     }
 
+    // CIRCUITPY-CHANGE: make progress on a pending sweep
+    #if MICROPY_GC_INCREMENTAL
+    size_t sweep_blocks = MICROPY_GC_INCREMENTAL_SWEEP_BLOCKS;
+    gc_sweep_step(sweep_blocks);
+    #endif
+
     GC_ENTER();
 
     mp_state_mem_area_t *area;
@@ -805,9 +1545,18 @@ void *gc_alloc(size_t n_bytes, unsigned int alloc_flags) {
     #if MICROPY_GC_SPLIT_HEAP_AUTO
     bool added = false;
     #endif
+    // CIRCUITPY-CHANGE
+    #if MICROPY_GC_NURSERY
+    bool nursery_collected = collected;
+    #endif
 
     #if MICROPY_GC_ALLOC_THRESHOLD
-    if (!collected && MP_STATE_MEM(gc_alloc_amount) >= MP_STATE_MEM(gc_alloc_threshold)) {
+    if (!collected && MP_STATE_MEM(gc_alloc_amount) >= MP_STATE_MEM(gc_alloc_threshold)
+        // CIRCUITPY-CHANGE: the last collection's garbage is still being freed
+        #if MICROPY_GC_INCREMENTAL
+        && MP_STATE_MEM(gc_sweep_area) == NULL
+        #endif
+        ) {
         GC_EXIT();
         gc_collect();
         collected = 1;
@@ -828,6 +1577,45 @@ void *gc_alloc(size_t n_bytes, unsigned int alloc_flags) {
             reset_into_safe_mode(SAFE_MODE_GC_ALLOC_OUTSIDE_VM);
         }
 
+        // CIRCUITPY-CHANGE: small objects go in the nursery, and a nursery
+        // collection empties it when it fills up.
+        #if MICROPY_GC_NURSERY
+        if (n_blocks <= MICROPY_GC_NURSERY_MAX_BLOCKS && MP_STATE_MEM(gc_nursery_end) != 0) {
+            bool taken = gc_nursery_take(n_blocks, &start_block);
+            if (!taken && nursery_collected) {
+                // still no room, so the nursery is too fragmented to use
+                gc_nursery_place();
+                taken = gc_nursery_take(n_blocks, &start_block);
+            }
+            if (taken) {
+                area = MP_STATE_MEM(gc_nursery_area);
+                end_block = start_block + n_blocks - 1;
+                goto claim;
+            }
+            bool collect_nursery = !nursery_collected;
+            #if MICROPY_GC_INCREMENTAL
+            // while the last full collection is still being swept, allocate
+            // outside the nursery instead
+            collect_nursery = collect_nursery && MP_STATE_MEM(gc_sweep_area) == NULL;
+            #endif
+            if (collect_nursery) {
+                GC_EXIT();
+                gc_collect_nursery();
+                nursery_collected = true;
+                GC_ENTER();
+                continue;
+            }
+        }
+        #endif
+
+        // CIRCUITPY-CHANGE: small allocations come from the free lists if they can
+        #if MICROPY_GC_FREE_LISTS
+        if (n_blocks <= GC_FREE_LIST_CLASSES && gc_free_list_take(n_blocks, &area, &start_block)) {
+            end_block = start_block + n_blocks - 1;
+            goto claim;
+        }
+        #endif
+
         // look for a run of n_blocks available blocks
         for (; area != NULL; area = NEXT_AREA(area), i = 0) {
             n_free = 0;
@@ -853,6 +1641,16 @@ void *gc_alloc(size_t n_bytes, unsigned int alloc_flags) {
         }
 
         GC_EXIT();
+        // CIRCUITPY-CHANGE: sweep more of the heap, in growing slices, before
+        // resorting to another collection.
+        #if MICROPY_GC_INCREMENTAL
+        if (MP_STATE_MEM(gc_sweep_area) != NULL) {
+            sweep_blocks *= 2;
+            gc_sweep_step(sweep_blocks);
+            GC_ENTER();
+            continue;
+        }
+        #endif
         // nothing found!
         if (collected) {
             #if MICROPY_GC_SPLIT_HEAP_AUTO
@@ -871,6 +1669,10 @@ void *gc_alloc(size_t n_bytes, unsigned int alloc_flags) {
         DEBUG_printf("gc_alloc(" UINT_FMT "): no free mem, triggering GC\n", n_bytes);
         gc_collect();
         collected = 1;
+        // CIRCUITPY-CHANGE: nothing has been freed until some of the heap is swept
+        #if MICROPY_GC_INCREMENTAL
+        gc_sweep_step(sweep_blocks);
+        #endif
         GC_ENTER();
     }
 
@@ -892,16 +1694,29 @@ found:
         area->gc_last_free_atb_index = (i + 1) / BLOCKS_PER_ATB;
     }
 
+    // CIRCUITPY-CHANGE
+    #if MICROPY_GC_FREE_LISTS || MICROPY_GC_NURSERY
+claim:
+    #endif
+
     // CIRCUITPY-CHANGE
     #ifdef LOG_HEAP_ACTIVITY
     gc_log_change(start_block, end_block - start_block + 1);
     #endif
 
-    area->gc_last_used_block = MAX(area->gc_last_used_block, end_block);
+    gc_note_used_block(area, end_block);
 
     // mark first block as used head
     ATB_FREE_TO_HEAD(area, start_block);
 
+    // CIRCUITPY-CHANGE: objects allocated ahead of a pending sweep must be
+    // marked so that it doesn't free them.
+    #if MICROPY_GC_INCREMENTAL
+    if (gc_sweep_is_pending_at(area, start_block)) {
+        ATB_HEAD_TO_MARK(area, start_block);
+    }
+    #endif
+
     // mark rest of blocks as used tail
     // TODO for a run of many blocks can make this more efficient
     for (size_t bl = start_block + 1; bl <= end_block; bl++) {
@@ -953,6 +1768,13 @@ found:
     memorymonitor_track_allocation(end_block - start_block + 1);
     #endif
 
+    // CIRCUITPY-CHANGE
+    #if MICROPY_GC_ALLOC_PROFILE
+    if (MP_STATE_MEM(gc_alloc_profile_enabled)) {
+        gc_alloc_profile_record(n_blocks);
+    }
+    #endif
+
     return ret_ptr;
 }
 
@@ -1002,7 +1824,7 @@ void gc_free(void *ptr) {
     #endif
 
     size_t block = BLOCK_FROM_PTR(area, ptr);
-    assert(ATB_GET_KIND(area, block) == AT_HEAD);
+    assert(ATB_IS_ALLOCATED_HEAD(area, block));
 
     #if MICROPY_ENABLE_FINALISER
     FTB_CLEAR(area, block);
@@ -1062,7 +1884,7 @@ size_t gc_nbytes(const void *ptr) {
 
     if (area) {
         size_t block = BLOCK_FROM_PTR(area, ptr);
-        if (ATB_GET_KIND(area, block) == AT_HEAD) {
+        if (ATB_IS_ALLOCATED_HEAD(area, block)) {
             // work out number of consecutive blocks in the chain starting with this on
             size_t n_blocks = 0;
             do {
@@ -1137,7 +1959,7 @@ void *gc_realloc(void *ptr_in, size_t n_bytes, bool allow_move) {
     area = &MP_STATE_MEM(area);
     #endif
     size_t block = BLOCK_FROM_PTR(area, ptr);
-    assert(ATB_GET_KIND(area, block) == AT_HEAD);
+    assert(ATB_IS_ALLOCATED_HEAD(area, block));
 
     // compute number of new blocks that are requested
     size_t new_blocks = (n_bytes + BYTES_PER_BLOCK - 1) / BYTES_PER_BLOCK;
@@ -1220,7 +2042,7 @@ void *gc_realloc(void *ptr_in, size_t n_bytes, bool allow_move) {
             ATB_FREE_TO_TAIL(area, bl);
         }
 
-        area->gc_last_used_block = MAX(area->gc_last_used_block, end_block);
+        gc_note_used_block(area, end_block);
 
         GC_EXIT();
 
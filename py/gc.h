@@ -71,6 +71,28 @@ bool gc_alloc_possible(void);
 // Use this function to sweep the whole heap and run all finalisers
 void gc_sweep_all(void);
 
+// CIRCUITPY-CHANGE
+#if MICROPY_GC_INCREMENTAL
+// Sweep at least n_blocks more of the heap left unswept by the last collection.
+// Returns true if part of the heap is still to be swept.
+bool gc_sweep_step(size_t n_blocks);
+// Finish any pending sweep.
+void gc_sweep_finish(void);
+#endif
+
+// CIRCUITPY-CHANGE
+#if MICROPY_GC_NURSERY
+// Collect just the nursery.
+void gc_collect_nursery(void);
+#endif
+
+// CIRCUITPY-CHANGE
+#if MICROPY_GC_ALLOC_PROFILE
+// Start recording allocations per source line, discarding any recorded
+// before, or stop recording them.
+void gc_alloc_profile_enable(bool enable);
+#endif
+
 enum {
     GC_ALLOC_FLAG_HAS_FINALISER = 1,
 };
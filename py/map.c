@@ -61,6 +61,24 @@
 #define MAP_CACHE_SET(index, pos)
 #endif
 
+// CIRCUITPY-CHANGE
+#if MICROPY_OPT_MAP_LOOKUP_UNROLL
+// Returns the first element from elem up to top whose key is index, or top.
+// Compares four keys per iteration and combines the results without
+// branching, so a long search costs one branch per four entries.
+static inline mp_map_elem_t *map_find_key_ptr(mp_map_elem_t *elem, mp_map_elem_t *top, mp_obj_t index) {
+    for (; top - elem >= 4; elem += 4) {
+        if ((elem[0].key == index) | (elem[1].key == index) | (elem[2].key == index) | (elem[3].key == index)) {
+            break;
+        }
+    }
+    while (elem < top && elem->key != index) {
+        elem++;
+    }
+    return elem;
+}
+#endif
+
 // This table of sizes is used to control the growth of hash tables.
 // The first set of sizes are chosen so the allocation fits exactly in a
 // 4-word GC block, and it's not so important for these small values to be
@@ -190,7 +208,15 @@ mp_map_elem_t *MICROPY_WRAP_MP_MAP_LOOKUP(mp_map_lookup)(mp_map_t * map, mp_obj_
 
     // if the map is an ordered array then we must do a brute force linear search
     if (map->is_ordered) {
-        for (mp_map_elem_t *elem = &map->table[0], *top = &map->table[map->used]; elem < top; elem++) {
+        mp_map_elem_t *elem = &map->table[0], *top = &map->table[map->used];
+        // CIRCUITPY-CHANGE
+        #if MICROPY_OPT_MAP_LOOKUP_UNROLL
+        if (compare_only_ptrs) {
+            // skip straight to the element found, if any
+            elem = map_find_key_ptr(elem, top, index);
+        }
+        #endif
+        for (; elem < top; elem++) {
             if (elem->key == index || (!compare_only_ptrs && mp_obj_equal(elem->key, index))) {
                 #if MICROPY_PY_COLLECTIONS_ORDEREDDICT
                 if (MP_UNLIKELY(lookup_kind == MP_MAP_LOOKUP_REMOVE_IF_FOUND)) {
@@ -219,7 +245,7 @@ mp_map_elem_t *MICROPY_WRAP_MP_MAP_LOOKUP(mp_map_lookup)(mp_map_t * map, mp_obj_
             map->table = m_renew(mp_map_elem_t, map->table, map->used, map->alloc);
             mp_seq_clear(map->table, map->used, map->alloc, sizeof(*map->table));
         }
-        mp_map_elem_t *elem = map->table + map->used++;
+        elem = map->table + map->used++;
         elem->key = index;
         elem->value = MP_OBJ_NULL;
         if (!mp_obj_is_qstr(index)) {
@@ -33,6 +33,10 @@
 // collect(): run a garbage collection
 static mp_obj_t py_gc_collect(void) {
     gc_collect();
+    // CIRCUITPY-CHANGE: an explicit collection frees everything it can
+    #if MICROPY_GC_INCREMENTAL
+    gc_sweep_finish();
+    #endif
     #if MICROPY_PY_GC_COLLECT_RETVAL
     return MP_OBJ_NEW_SMALL_INT(MP_STATE_MEM(gc_collected));
     #else
@@ -41,6 +45,28 @@ static mp_obj_t py_gc_collect(void) {
 }
 MP_DEFINE_CONST_FUN_OBJ_0(gc_collect_obj, py_gc_collect);
 
+// CIRCUITPY-CHANGE
+#if MICROPY_GC_INCREMENTAL
+// sweep_step(): sweep part of the heap left unswept by the last collection
+static mp_obj_t py_gc_sweep_step(void) {
+    return mp_obj_new_bool(gc_sweep_step(MICROPY_GC_INCREMENTAL_SWEEP_BLOCKS));
+}
+MP_DEFINE_CONST_FUN_OBJ_0(gc_sweep_step_obj, py_gc_sweep_step);
+#endif
+
+// CIRCUITPY-CHANGE
+#if MICROPY_GC_NURSERY
+// collections(): the number of nursery and full collections so far
+static mp_obj_t gc_collections(void) {
+    mp_obj_t tuple[2] = {
+        mp_obj_new_int_from_uint(MP_STATE_MEM(gc_nursery_collections)),
+        mp_obj_new_int_from_uint(MP_STATE_MEM(gc_full_collections)),
+    };
+    return mp_obj_new_tuple(2, tuple);
+}
+MP_DEFINE_CONST_FUN_OBJ_0(gc_collections_obj, gc_collections);
+#endif
+
 // disable(): disable the garbage collector
 static mp_obj_t gc_disable(void) {
     MP_STATE_MEM(gc_auto_collect_enabled) = 0;
@@ -103,6 +129,12 @@ MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(gc_threshold_obj, 0, 1, gc_threshold);
 static const mp_rom_map_elem_t mp_module_gc_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_gc) },
     { MP_ROM_QSTR(MP_QSTR_collect), MP_ROM_PTR(&gc_collect_obj) },
+    #if MICROPY_GC_INCREMENTAL
+    { MP_ROM_QSTR(MP_QSTR_sweep_step), MP_ROM_PTR(&gc_sweep_step_obj) },
+    #endif
+    #if MICROPY_GC_NURSERY
+    { MP_ROM_QSTR(MP_QSTR_collections), MP_ROM_PTR(&gc_collections_obj) },
+    #endif
     { MP_ROM_QSTR(MP_QSTR_disable), MP_ROM_PTR(&gc_disable_obj) },
     { MP_ROM_QSTR(MP_QSTR_enable), MP_ROM_PTR(&gc_enable_obj) },
     { MP_ROM_QSTR(MP_QSTR_isenabled), MP_ROM_PTR(&gc_isenabled_obj) },
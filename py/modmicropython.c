@@ -148,6 +148,56 @@ static MP_DEFINE_CONST_FUN_OBJ_0(mp_micropython_heap_locked_obj, mp_micropython_
 #endif
 #endif
 
+// CIRCUITPY-CHANGE
+#if MICROPY_GC_ALLOC_PROFILE
+static mp_obj_t mp_micropython_alloc_profile(size_t n_args, const mp_obj_t *args) {
+    if (n_args == 1) {
+        gc_alloc_profile_enable(mp_obj_is_true(args[0]));
+        return mp_const_none;
+    }
+
+    // don't record the allocations made to build the result
+    bool enabled = MP_STATE_MEM(gc_alloc_profile_enabled);
+    MP_STATE_MEM(gc_alloc_profile_enabled) = false;
+
+    // sort the lines by bytes allocated, most first, then by line number
+    mp_alloc_profile_entry_t *profile = MP_STATE_MEM(gc_alloc_profile);
+    size_t len = MP_STATE_MEM(gc_alloc_profile_len);
+    for (size_t i = 1; i < len; i++) {
+        mp_alloc_profile_entry_t entry = profile[i];
+        size_t j = i;
+        for (; j > 0; j--) {
+            mp_alloc_profile_entry_t *prev = &profile[j - 1];
+            if (prev->bytes > entry.bytes || (prev->bytes == entry.bytes && prev->source_line <= entry.source_line)) {
+                break;
+            }
+            profile[j] = *prev;
+        }
+        profile[j] = entry;
+    }
+
+    mp_obj_t list = mp_obj_new_list(0, NULL);
+    mp_alloc_profile_entry_t *dropped = &MP_STATE_MEM(gc_alloc_profile_dropped);
+    for (size_t i = 0; i <= len; i++) {
+        mp_alloc_profile_entry_t *entry = i < len ? &profile[i] : dropped;
+        if (entry->count == 0) {
+            continue;
+        }
+        mp_obj_t items[4] = {
+            entry == dropped ? mp_const_none : MP_OBJ_NEW_QSTR(entry->source_file),
+            MP_OBJ_NEW_SMALL_INT(entry->source_line),
+            mp_obj_new_int_from_uint(entry->count),
+            mp_obj_new_int_from_uint(entry->bytes),
+        };
+        mp_obj_list_append(list, mp_obj_new_tuple(4, items));
+    }
+
+    MP_STATE_MEM(gc_alloc_profile_enabled) = enabled;
+    return list;
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mp_micropython_alloc_profile_obj, 0, 1, mp_micropython_alloc_profile);
+#endif
+
 // CIRCUITPY-CHANGE: avoid warning
 #if CIRCUITPY_MICROPYTHON_ADVANCED && MICROPY_ENABLE_EMERGENCY_EXCEPTION_BUF && (MICROPY_EMERGENCY_EXCEPTION_BUF_SIZE == 0)
 static MP_DEFINE_CONST_FUN_OBJ_1(mp_alloc_emergency_exception_buf_obj, mp_alloc_emergency_exception_buf);
@@ -194,6 +244,9 @@ static const mp_rom_map_elem_t mp_module_micropython_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR_stack_use), MP_ROM_PTR(&mp_micropython_stack_use_obj) },
     #endif
     // CIRCUITPY-CHANGE: avoid warning
+    #if MICROPY_GC_ALLOC_PROFILE
+    { MP_ROM_QSTR(MP_QSTR_alloc_profile), MP_ROM_PTR(&mp_micropython_alloc_profile_obj) },
+    #endif
     #if CIRCUITPY_MICROPYTHON_ADVANCED && MICROPY_ENABLE_EMERGENCY_EXCEPTION_BUF && (MICROPY_EMERGENCY_EXCEPTION_BUF_SIZE == 0)
     { MP_ROM_QSTR(MP_QSTR_alloc_emergency_exception_buf), MP_ROM_PTR(&mp_alloc_emergency_exception_buf_obj) },
     #endif
@@ -593,6 +593,44 @@
 #define MICROPY_OPT_MAP_LOOKUP_CACHE_SIZE (128)
 #endif
 
+// CIRCUITPY-CHANGE
+// Search ordered maps (which include all ROM module globals and locals dicts)
+// for a qstr key four entries at a time, with one branch per four compares.
+#ifndef MICROPY_OPT_MAP_LOOKUP_UNROLL
+#define MICROPY_OPT_MAP_LOOKUP_UNROLL (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
+#endif
+
+// CIRCUITPY-CHANGE
+// Give the LOAD_ATTR, LOAD_METHOD and STORE_ATTR opcodes inline caches that
+// remember, for the last two types each was run on, where in which map the
+// attribute was found, so that a hit skips the map lookup.  Each opcode has
+// its own cache, kept on the heap with the function it's in.  Costs a word
+// per function object and per Python class, and on the heap a byte per
+// bytecode offset and four words per opcode in functions that run them.
+// Replaces MICROPY_OPT_LOAD_ATTR_FAST_PATH when enabled.
+#ifndef MICROPY_OPT_ATTR_INLINE_CACHE
+#define MICROPY_OPT_ATTR_INLINE_CACHE (0)
+#endif
+
+// CIRCUITPY-CHANGE
+// Whether the VM rewrites binary ops in bytecode on the heap, once they have
+// run on small ints or floats, into opcodes specialised for those types.  A
+// specialised opcode falls back to the generic op (and rewrites itself back)
+// when its operands are of other types.  Bytecode frozen into flash is never
+// rewritten.  Code that reads bytecode while it runs, such as sys.settrace,
+// will see the specialised opcodes.
+#ifndef MICROPY_OPT_BINARY_OP_QUICKEN
+#define MICROPY_OPT_BINARY_OP_QUICKEN (0)
+#endif
+
+// CIRCUITPY-CHANGE
+// Maintain an open-addressed hash index over the dynamically interned qstrs so
+// that qstr_find_strn does not have to scan every runtime pool linearly. Costs
+// two bytes of heap per index slot (the index is kept at most 2/3 full).
+#ifndef MICROPY_OPT_QSTR_INDEX
+#define MICROPY_OPT_QSTR_INDEX (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
+#endif
+
 // Whether to use fast versions of bitwise operations (and, or, xor) when the
 // arguments are both positive.  Increases Thumb2 code size by about 250 bytes.
 #ifndef MICROPY_OPT_MPZ_BITWISE
@@ -679,6 +717,62 @@
 #define MICROPY_GC_SPLIT_HEAP_AUTO (0)
 #endif
 
+// CIRCUITPY-CHANGE
+// Whether gc_collect_end defers the sweep phase so that it can be done in
+// bounded slices by gc_sweep_step (from gc_alloc, and from the background
+// task loop on ports that have one).  Objects allocated in the part of the
+// heap that is still to be swept are allocated marked, so they survive.
+// Marking is still done in one pass, so the pause of a collection is never
+// shorter than the mark. Marking incrementally would need a store barrier on
+// every heap pointer written from C, which the runtime doesn't have.
+#ifndef MICROPY_GC_INCREMENTAL
+#define MICROPY_GC_INCREMENTAL (0)
+#endif
+
+// Number of blocks swept by each incremental sweep step.
+#ifndef MICROPY_GC_INCREMENTAL_SWEEP_BLOCKS
+#define MICROPY_GC_INCREMENTAL_SWEEP_BLOCKS (256)
+#endif
+
+// Whether the sweep builds lists of free runs of 1, 2, 3 and 4 or more blocks
+// that gc_alloc takes small allocations from before scanning the ATB.
+#ifndef MICROPY_GC_FREE_LISTS
+#define MICROPY_GC_FREE_LISTS (0)
+#endif
+
+// Whether small objects are allocated in a nursery, a window of the heap that
+// is collected on its own when it fills up.  There is no remembered set, so
+// those collections still scan the rest of the heap for pointers into it.
+#ifndef MICROPY_GC_NURSERY
+#define MICROPY_GC_NURSERY (0)
+#endif
+
+// Size of the nursery, as a fraction (1/n) of the heap.
+#ifndef MICROPY_GC_NURSERY_DIVISOR
+#define MICROPY_GC_NURSERY_DIVISOR (8)
+#endif
+
+// Largest allocation, in blocks, that is made in the nursery.
+#ifndef MICROPY_GC_NURSERY_MAX_BLOCKS
+#define MICROPY_GC_NURSERY_MAX_BLOCKS (4)
+#endif
+
+// Whether gc_alloc records the source line of the bytecode that made each
+// allocation, for micropython.alloc_profile().
+#ifndef MICROPY_GC_ALLOC_PROFILE
+#define MICROPY_GC_ALLOC_PROFILE (0)
+#endif
+
+// Number of source lines that the allocation profile can hold.
+#ifndef MICROPY_GC_ALLOC_PROFILE_SIZE
+#define MICROPY_GC_ALLOC_PROFILE_SIZE (32)
+#endif
+
+// Only one in this many allocations is recorded, to limit the overhead.
+#ifndef MICROPY_GC_ALLOC_PROFILE_PERIOD
+#define MICROPY_GC_ALLOC_PROFILE_PERIOD (1)
+#endif
+
 // Hook to run code during time consuming garbage collector operations
 // *i* is the loop index variable (e.g. can be used to run every x loops)
 #ifndef MICROPY_GC_HOOK_LOOP
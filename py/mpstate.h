@@ -107,6 +107,17 @@ typedef struct _mp_state_mem_area_t {
     size_t gc_last_used_block; // The block ID of the highest block allocated in the area
 } mp_state_mem_area_t;
 
+// CIRCUITPY-CHANGE
+#if MICROPY_GC_ALLOC_PROFILE
+// Allocations made by the bytecode of one source line.
+typedef struct _mp_alloc_profile_entry_t {
+    qstr source_file;
+    size_t source_line;
+    size_t count;
+    size_t bytes;
+} mp_alloc_profile_entry_t;
+#endif
+
 // This structure hold information about the memory allocation system.
 typedef struct _mp_state_mem_t {
     #if MICROPY_MEM_STATS
@@ -142,6 +153,53 @@ typedef struct _mp_state_mem_t {
     size_t gc_collected;
     #endif
 
+    // CIRCUITPY-CHANGE
+    #if MICROPY_GC_INCREMENTAL
+    // Position of a deferred sweep: the area and block that the next call to
+    // gc_sweep_step starts at.  gc_sweep_area is NULL when no sweep is pending.
+    mp_state_mem_area_t *gc_sweep_area;
+    size_t gc_sweep_block;
+    // highest block in use seen so far in gc_sweep_area
+    size_t gc_sweep_last_used_block;
+    #if MICROPY_GC_SPLIT_HEAP_AUTO
+    mp_state_mem_area_t *gc_sweep_prev_area;
+    #endif
+    #endif
+
+    // CIRCUITPY-CHANGE
+    #if MICROPY_GC_FREE_LISTS
+    // Free runs of 1, 2, 3 and 4 or more blocks, linked through the runs
+    // themselves.  These are only hints: entries are checked before use.
+    void *gc_free_list[4];
+    void *gc_free_list_tail[4];
+    #endif
+
+    // CIRCUITPY-CHANGE
+    #if MICROPY_GC_NURSERY
+    // The nursery is blocks [gc_nursery_start, gc_nursery_end) of
+    // gc_nursery_area, with gc_nursery_end zero when there isn't one.  Small
+    // allocations are made in it from gc_nursery_next onwards.
+    mp_state_mem_area_t *gc_nursery_area;
+    size_t gc_nursery_start;
+    size_t gc_nursery_end;
+    size_t gc_nursery_next;
+    // set while the collection in progress only collects the nursery
+    bool gc_nursery_only;
+    size_t gc_nursery_collections;
+    size_t gc_full_collections;
+    #endif
+
+    // CIRCUITPY-CHANGE
+    #if MICROPY_GC_ALLOC_PROFILE
+    // Allocations recorded per source line.  Lines that don't fit in the
+    // table are counted in gc_alloc_profile_dropped.
+    mp_alloc_profile_entry_t gc_alloc_profile[MICROPY_GC_ALLOC_PROFILE_SIZE];
+    mp_alloc_profile_entry_t gc_alloc_profile_dropped;
+    size_t gc_alloc_profile_len;
+    size_t gc_alloc_profile_countdown;
+    bool gc_alloc_profile_enabled;
+    #endif
+
     #if MICROPY_PY_THREAD && !MICROPY_PY_THREAD_GIL
     // This is a global mutex used to make the GC thread-safe.
     mp_thread_mutex_t gc_mutex;
@@ -160,6 +218,12 @@ typedef struct _mp_state_vm_t {
 
     qstr_pool_t *last_pool;
 
+    // CIRCUITPY-CHANGE
+    #if MICROPY_OPT_QSTR_INDEX
+    // hash index of the qstrs in the dynamically allocated pools
+    qstr_short_t *qstr_index;
+    #endif
+
     #if MICROPY_TRACKED_ALLOC
     struct _m_tracked_node_t *m_tracked_head;
     #endif
@@ -219,6 +283,13 @@ typedef struct _mp_state_vm_t {
     size_t qstr_last_alloc;
     size_t qstr_last_used;
 
+    // CIRCUITPY-CHANGE
+    #if MICROPY_OPT_QSTR_INDEX
+    // number of slots in, and number of qstrs stored in, qstr_index
+    size_t qstr_index_alloc;
+    size_t qstr_index_used;
+    #endif
+
     #if MICROPY_PY_THREAD && !MICROPY_PY_THREAD_GIL
     // This is a global mutex used to make qstr interning thread-safe.
     mp_thread_mutex_t qstr_mutex;
@@ -266,6 +337,12 @@ typedef struct _mp_state_vm_t {
     // See mp_map_lookup.
     uint8_t map_lookup_cache[MICROPY_OPT_MAP_LOOKUP_CACHE_SIZE];
     #endif
+
+    // CIRCUITPY-CHANGE
+    #if MICROPY_OPT_ATTR_INLINE_CACHE
+    // The last version given to a Python class, see py/attrcache.c.
+    uintptr_t attr_cache_version;
+    #endif
 } mp_state_vm_t;
 
 // This structure holds state that is specific to a given thread. Everything
@@ -315,6 +392,9 @@ typedef struct _mp_state_thread_t {
     #if MICROPY_PY_SYS_SETTRACE
     mp_obj_t prof_trace_callback;
     bool prof_callback_is_executing;
+    #endif
+    // CIRCUITPY-CHANGE: also used by the allocation profiler
+    #if MICROPY_PY_SYS_SETTRACE || MICROPY_GC_ALLOC_PROFILE
     struct _mp_code_state_t *current_code_state;
     #endif
 
@@ -28,6 +28,8 @@
 
 #include "py/objtype.h"
 #include "py/runtime.h"
+// CIRCUITPY-CHANGE
+#include "py/attrcache.h"
 
 typedef struct _mp_obj_object_t {
     mp_obj_base_t base;
@@ -73,7 +75,16 @@ static mp_obj_t object___setattr__(mp_obj_t self_in, mp_obj_t attr, mp_obj_t val
     }
 
     mp_obj_instance_t *self = MP_OBJ_TO_PTR(self_in);
+    // CIRCUITPY-CHANGE
+    #if MICROPY_OPT_ATTR_INLINE_CACHE
+    size_t used = self->members.used;
     mp_map_lookup(&self->members, attr, MP_MAP_LOOKUP_ADD_IF_NOT_FOUND)->value = value;
+    if (self->members.used != used) {
+        mp_attr_cache_member_added(self->base.type, attr);
+    }
+    #else
+    mp_map_lookup(&self->members, attr, MP_MAP_LOOKUP_ADD_IF_NOT_FOUND)->value = value;
+    #endif
     return mp_const_none;
 }
 static MP_DEFINE_CONST_FUN_OBJ_3(object___setattr___obj, object___setattr__);
@@ -32,6 +32,8 @@
 
 #include "py/objtype.h"
 #include "py/runtime.h"
+// CIRCUITPY-CHANGE
+#include "py/attrcache.h"
 
 #if MICROPY_DEBUG_VERBOSE // print debugging info
 #define DEBUG_PRINT (1)
@@ -825,7 +827,16 @@ skip_special_accessors:
         return elem != NULL;
     } else {
         // store attribute
+        // CIRCUITPY-CHANGE
+        #if MICROPY_OPT_ATTR_INLINE_CACHE
+        size_t used = self->members.used;
         mp_map_lookup(&self->members, MP_OBJ_NEW_QSTR(attr), MP_MAP_LOOKUP_ADD_IF_NOT_FOUND)->value = value;
+        if (self->members.used != used) {
+            mp_attr_cache_member_added(self->base.type, MP_OBJ_NEW_QSTR(attr));
+        }
+        #else
+        mp_map_lookup(&self->members, MP_OBJ_NEW_QSTR(attr), MP_MAP_LOOKUP_ADD_IF_NOT_FOUND)->value = value;
+        #endif
         return true;
     }
 }
@@ -1109,6 +1120,12 @@ static void type_attr(mp_obj_t self_in, qstr attr, mp_obj_t *dest) {
                 // can't apply delete/store to a fixed map
                 return;
             }
+            // CIRCUITPY-CHANGE
+            #if MICROPY_OPT_ATTR_INLINE_CACHE
+            if (mp_obj_is_instance_type(self)) {
+                mp_attr_cache_new_version(self);
+            }
+            #endif
             if (dest[1] == MP_OBJ_NULL) {
                 // delete attribute
                 mp_map_elem_t *elem = mp_map_lookup(locals_map, MP_OBJ_NEW_QSTR(attr), MP_MAP_LOOKUP_REMOVE_IF_FOUND);
@@ -1204,32 +1221,39 @@ mp_obj_t mp_obj_new_type(qstr name, mp_obj_t bases_tuple, mp_obj_t locals_dict)
     // (currently 10, plus 1 for base, plus 1 for base-protocol).
     // Note: mp_obj_type_t is (2 + 3 + #slots) words, so going from 11 to 12 slots
     // moves from 4 to 5 gc blocks.
-    mp_obj_type_t *o = m_new_obj_var0(mp_obj_type_t, slots, void *, 10 + (bases_len ? 1 : 0) + (base_protocol ? 1 : 0));
+    // CIRCUITPY-CHANGE: slots before MP_OBJ_CLASS_FIRST_SLOT aren't type slots
+    const size_t n = MP_OBJ_CLASS_FIRST_SLOT;
+    mp_obj_type_t *o = m_new_obj_var0(mp_obj_type_t, slots, void *, n + 10 + (bases_len ? 1 : 0) + (base_protocol ? 1 : 0));
     o->base.type = &mp_type_type;
     o->flags = base_flags;
     o->name = name;
-    MP_OBJ_TYPE_SET_SLOT(o, make_new, mp_obj_instance_make_new, 0);
-    MP_OBJ_TYPE_SET_SLOT(o, print, instance_print, 1);
-    MP_OBJ_TYPE_SET_SLOT(o, call, mp_obj_instance_call, 2);
-    MP_OBJ_TYPE_SET_SLOT(o, unary_op, instance_unary_op, 3);
-    MP_OBJ_TYPE_SET_SLOT(o, binary_op, instance_binary_op, 4);
-    MP_OBJ_TYPE_SET_SLOT(o, attr, mp_obj_instance_attr, 5);
-    MP_OBJ_TYPE_SET_SLOT(o, subscr, instance_subscr, 6);
-    MP_OBJ_TYPE_SET_SLOT(o, iter, mp_obj_instance_getiter, 7);
-    MP_OBJ_TYPE_SET_SLOT(o, buffer, instance_get_buffer, 8);
+    MP_OBJ_TYPE_SET_SLOT(o, make_new, mp_obj_instance_make_new, n + 0);
+    MP_OBJ_TYPE_SET_SLOT(o, print, instance_print, n + 1);
+    MP_OBJ_TYPE_SET_SLOT(o, call, mp_obj_instance_call, n + 2);
+    MP_OBJ_TYPE_SET_SLOT(o, unary_op, instance_unary_op, n + 3);
+    MP_OBJ_TYPE_SET_SLOT(o, binary_op, instance_binary_op, n + 4);
+    MP_OBJ_TYPE_SET_SLOT(o, attr, mp_obj_instance_attr, n + 5);
+    MP_OBJ_TYPE_SET_SLOT(o, subscr, instance_subscr, n + 6);
+    MP_OBJ_TYPE_SET_SLOT(o, iter, mp_obj_instance_getiter, n + 7);
+    MP_OBJ_TYPE_SET_SLOT(o, buffer, instance_get_buffer, n + 8);
 
     mp_obj_dict_t *locals_ptr = MP_OBJ_TO_PTR(locals_dict);
-    MP_OBJ_TYPE_SET_SLOT(o, locals_dict, locals_ptr, 9);
+    MP_OBJ_TYPE_SET_SLOT(o, locals_dict, locals_ptr, n + 9);
+
+    // CIRCUITPY-CHANGE
+    #if MICROPY_OPT_ATTR_INLINE_CACHE
+    mp_attr_cache_new_version(o);
+    #endif
 
     if (bases_len > 0) {
         if (bases_len >= 2) {
             #if MICROPY_MULTIPLE_INHERITANCE
-            MP_OBJ_TYPE_SET_SLOT(o, parent, MP_OBJ_TO_PTR(bases_tuple), 10);
+            MP_OBJ_TYPE_SET_SLOT(o, parent, MP_OBJ_TO_PTR(bases_tuple), n + 10);
             #else
             mp_raise_NotImplementedError(MP_ERROR_TEXT("multiple inheritance not supported"));
             #endif
         } else {
-            MP_OBJ_TYPE_SET_SLOT(o, parent, MP_OBJ_TO_PTR(bases_items[0]), 10);
+            MP_OBJ_TYPE_SET_SLOT(o, parent, MP_OBJ_TO_PTR(bases_items[0]), n + 10);
         }
 
         // Inherit protocol from a base class. This allows to define an
@@ -1237,7 +1261,7 @@ mp_obj_t mp_obj_new_type(qstr name, mp_obj_t bases_tuple, mp_obj_t locals_dict)
         // Python method calls, and any subclass inheriting from it will
         // support this feature.
         if (base_protocol) {
-            MP_OBJ_TYPE_SET_SLOT(o, protocol, base_protocol, 11);
+            MP_OBJ_TYPE_SET_SLOT(o, protocol, base_protocol, n + 11);
         }
     }
 
@@ -49,6 +49,18 @@ mp_obj_t mp_obj_instance_call(mp_obj_t self_in, size_t n_args, size_t n_kw, cons
 #define mp_obj_is_instance_type(type) ((type)->flags & MP_TYPE_FLAG_INSTANCE_TYPE)
 #define mp_obj_is_native_type(type) (!((type)->flags & MP_TYPE_FLAG_INSTANCE_TYPE))
 
+// CIRCUITPY-CHANGE
+#if MICROPY_OPT_ATTR_INLINE_CACHE
+// The first slot of a Python class holds its version for the attribute caches,
+// see py/attrcache.c.
+#define MP_OBJ_CLASS_FIRST_SLOT (1)
+static inline uintptr_t mp_obj_class_version(const mp_obj_type_t *type) {
+    return (uintptr_t)type->slots[0];
+}
+#else
+#define MP_OBJ_CLASS_FIRST_SLOT (0)
+#endif
+
 // this needs to be exposed for mp_getiter
 mp_obj_t mp_obj_instance_getiter(mp_obj_t self_in, mp_obj_iter_buf_t *iter_buf);
 
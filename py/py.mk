@@ -208,6 +208,7 @@ PY_CORE_O_BASENAME = $(addprefix py/,\
 	moderrno.o \
 	modthread.o \
 	vm.o \
+	attrcache.o \
 	bc.o \
 	showbc.o \
 	repl.o \
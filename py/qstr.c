@@ -60,13 +60,18 @@
 // allocated pool is twice this size.  The value here must be <= MP_QSTRnumber_of.
 #define MICROPY_ALLOC_QSTR_ENTRIES_INIT (10)
 
-// this must match the equivalent function in makeqstrdata.py
-size_t qstr_compute_hash(const byte *data, size_t len) {
+// CIRCUITPY-CHANGE: split into the unmasked hash, used by the qstr index, and
+// the masked hash that is stored in the pools.
+static size_t qstr_compute_full_hash(const byte *data, size_t len) {
     // djb2 algorithm; see http://www.cse.yorku.ca/~oz/hash.html
     size_t hash = 5381;
     for (const byte *top = data + len; data < top; data++) {
         hash = ((hash << 5) + hash) ^ (*data); // hash * 33 ^ data
     }
+    return hash;
+}
+
+static size_t qstr_mask_hash(size_t hash) {
     hash &= Q_HASH_MASK;
     // Make sure that valid hash is never zero, zero means "hash not computed"
     if (hash == 0) {
@@ -75,6 +80,11 @@ size_t qstr_compute_hash(const byte *data, size_t len) {
     return hash;
 }
 
+// this must match the equivalent function in makeqstrdata.py
+size_t qstr_compute_hash(const byte *data, size_t len) {
+    return qstr_mask_hash(qstr_compute_full_hash(data, len));
+}
+
 // The first pool is the static qstr table. The contents must remain stable as
 // it is part of the .mpy ABI. See the top of py/persistentcode.c and
 // static_qstr_list in makeqstrdata.py. This pool is unsorted (although in a
@@ -206,6 +216,11 @@ extern const qstr_pool_t MICROPY_QSTR_EXTRA_POOL;
 void qstr_reset(void) {
     MP_STATE_VM(last_pool) = (qstr_pool_t *)&CONST_POOL; // we won't modify the const_pool since it has no allocated room left
     MP_STATE_VM(qstr_last_chunk) = NULL;
+    #if MICROPY_OPT_QSTR_INDEX
+    MP_STATE_VM(qstr_index) = NULL;
+    MP_STATE_VM(qstr_index_alloc) = 0;
+    MP_STATE_VM(qstr_index_used) = 0;
+    #endif
 }
 
 void qstr_init(void) {
@@ -228,6 +243,111 @@ static const qstr_pool_t *find_qstr(qstr *q) {
     return pool;
 }
 
+// CIRCUITPY-CHANGE: hash index over the dynamically allocated pools
+#if MICROPY_OPT_QSTR_INDEX
+
+// The index is an open-addressed table (linear probing) of the ids of every
+// qstr stored in the pools above CONST_POOL, keyed on the unmasked hash so that
+// it still spreads well when MICROPY_QSTR_BYTES_IN_HASH is small.  Empty slots
+// hold MP_QSTRnull.  If qstr_index is NULL (it could not be allocated, or ids
+// no longer fit in a qstr_short_t) the dynamic pools are scanned linearly.
+
+#define QSTR_INDEX_MIN_ALLOC (32)
+
+// Returns false if the index is full.
+static bool qstr_index_insert(qstr_short_t *index, size_t alloc, size_t hash, qstr q) {
+    size_t mask = alloc - 1;
+    size_t slot = hash & mask;
+    for (size_t probes = 0; probes < alloc; probes++) {
+        if (index[slot] == MP_QSTRnull) {
+            index[slot] = q;
+            return true;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return false;
+}
+
+static void qstr_index_drop(void) {
+    m_del(qstr_short_t, MP_STATE_VM(qstr_index), MP_STATE_VM(qstr_index_alloc));
+    MP_STATE_VM(qstr_index) = NULL;
+    MP_STATE_VM(qstr_index_alloc) = 0;
+    MP_STATE_VM(qstr_index_used) = 0;
+}
+
+// Record a qstr that was just appended to last_pool.
+// qstr_mutex must be taken while in this function
+static void qstr_index_add(qstr q, const char *str, size_t len) {
+    if (q > (qstr_short_t)-1) {
+        // Ids no longer fit in the index; fall back to scanning the pools.
+        qstr_index_drop();
+        return;
+    }
+
+    size_t used = MP_STATE_VM(qstr_index_used) + 1;
+    if (MP_STATE_VM(qstr_index) != NULL && used * 3 <= MP_STATE_VM(qstr_index_alloc) * 2
+        && qstr_index_insert(MP_STATE_VM(qstr_index), MP_STATE_VM(qstr_index_alloc),
+            qstr_compute_full_hash((const byte *)str, len), q)) {
+        MP_STATE_VM(qstr_index_used) = used;
+        return;
+    }
+
+    // Grow (or create) the index and rebuild it from the pools, which already
+    // contain the new qstr.  The index may have been dropped while the pools
+    // kept growing, so size it from the pools rather than from qstr_index_used.
+    const qstr_pool_t *last = MP_STATE_VM(last_pool);
+    used = last->total_prev_len + last->len - (CONST_POOL.total_prev_len + CONST_POOL.len);
+    size_t new_alloc = MAX(QSTR_INDEX_MIN_ALLOC, MP_STATE_VM(qstr_index_alloc));
+    while (used * 3 > new_alloc * 2) {
+        new_alloc *= 2;
+    }
+    qstr_short_t *index = m_new_maybe(qstr_short_t, new_alloc);
+    qstr_index_drop();
+    if (index == NULL) {
+        return;
+    }
+    memset(index, 0, sizeof(qstr_short_t) * new_alloc);
+    size_t n = 0;
+    for (const qstr_pool_t *pool = MP_STATE_VM(last_pool); pool != &CONST_POOL; pool = pool->prev) {
+        for (size_t at = 0; at < pool->len; at++) {
+            if (!qstr_index_insert(index, new_alloc,
+                qstr_compute_full_hash((const byte *)pool->qstrs[at], pool->lengths[at]),
+                pool->total_prev_len + at)) {
+                m_del(qstr_short_t, index, new_alloc);
+                return;
+            }
+            n++;
+        }
+    }
+    MP_STATE_VM(qstr_index) = index;
+    MP_STATE_VM(qstr_index_alloc) = new_alloc;
+    MP_STATE_VM(qstr_index_used) = n;
+}
+
+static qstr qstr_index_find(size_t hash, const char *str, size_t str_len) {
+    const qstr_short_t *index = MP_STATE_VM(qstr_index);
+    size_t mask = MP_STATE_VM(qstr_index_alloc) - 1;
+    #if MICROPY_QSTR_BYTES_IN_HASH
+    size_t pool_hash = qstr_mask_hash(hash);
+    #endif
+    // The index is never more than 2/3 full so an empty slot ends the probe.
+    for (size_t slot = hash & mask; index[slot] != MP_QSTRnull; slot = (slot + 1) & mask) {
+        qstr at = index[slot];
+        const qstr_pool_t *pool = find_qstr(&at);
+        if (
+            #if MICROPY_QSTR_BYTES_IN_HASH
+            pool->hashes[at] == pool_hash &&
+            #endif
+            pool->lengths[at] == str_len
+            && memcmp(pool->qstrs[at], str, str_len) == 0) {
+            return index[slot];
+        }
+    }
+    return MP_QSTRnull;
+}
+
+#endif
+
 // qstr_mutex must be taken while in this function
 static qstr qstr_add(mp_uint_t len, const char *q_ptr) {
     #if MICROPY_QSTR_BYTES_IN_HASH
@@ -285,7 +405,11 @@ static qstr qstr_add(mp_uint_t len, const char *q_ptr) {
     MP_STATE_VM(last_pool)->len++;
 
     // return id for the newly-added qstr
-    return MP_STATE_VM(last_pool)->total_prev_len + at;
+    qstr q = MP_STATE_VM(last_pool)->total_prev_len + at;
+    #if MICROPY_OPT_QSTR_INDEX
+    qstr_index_add(q, q_ptr, len);
+    #endif
+    return q;
 }
 
 qstr qstr_find_strn(const char *str, size_t str_len) {
@@ -294,13 +418,32 @@ qstr qstr_find_strn(const char *str, size_t str_len) {
         return MP_QSTR_;
     }
 
+    const qstr_pool_t *first_pool = MP_STATE_VM(last_pool);
+
+    // CIRCUITPY-CHANGE: look up dynamically interned qstrs in the hash index
+    #if MICROPY_OPT_QSTR_INDEX
+    size_t full_hash = qstr_compute_full_hash((const byte *)str, str_len);
+    if (MP_STATE_VM(qstr_index) != NULL) {
+        qstr q = qstr_index_find(full_hash, str, str_len);
+        if (q != MP_QSTRnull) {
+            return q;
+        }
+        // the index covers every dynamic pool, so only the ROM pools remain
+        first_pool = &CONST_POOL;
+    }
+    #endif
+
     #if MICROPY_QSTR_BYTES_IN_HASH
     // work out hash of str
+    #if MICROPY_OPT_QSTR_INDEX
+    size_t str_hash = qstr_mask_hash(full_hash);
+    #else
     size_t str_hash = qstr_compute_hash((const byte *)str, str_len);
     #endif
+    #endif
 
     // search pools for the data
-    for (const qstr_pool_t *pool = MP_STATE_VM(last_pool); pool != NULL; pool = pool->prev) {
+    for (const qstr_pool_t *pool = first_pool; pool != NULL; pool = pool->prev) {
         size_t low = 0;
         size_t high = pool->len - 1;
 
@@ -447,6 +590,10 @@ void qstr_pool_info(size_t *n_pool, size_t *n_qstr, size_t *n_str_data_bytes, si
                 + sizeof(qstr_len_t)) * pool->alloc;
         #endif
     }
+    // CIRCUITPY-CHANGE: include the hash index
+    #if MICROPY_OPT_QSTR_INDEX
+    *n_total_bytes += sizeof(qstr_short_t) * MP_STATE_VM(qstr_index_alloc);
+    #endif
     *n_total_bytes += *n_str_data_bytes;
     QSTR_EXIT();
 }
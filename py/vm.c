@@ -35,6 +35,10 @@
 #include "py/runtime.h"
 #include "py/bc0.h"
 #include "py/profile.h"
+// CIRCUITPY-CHANGE
+#include "py/attrcache.h"
+#include "py/gc.h"
+#include "py/smallint.h"
 
 // *FORMAT-OFF*
 
@@ -187,6 +191,25 @@
     } \
 } while(0)
 
+// CIRCUITPY-CHANGE
+#elif MICROPY_GC_ALLOC_PROFILE
+
+// The allocation profiler only needs to know which frame is executing.
+#define FRAME_SETUP() do { \
+    MP_STATE_THREAD(current_code_state) = code_state; \
+} while(0)
+
+#define FRAME_ENTER() do { \
+    code_state->prev_state = MP_STATE_THREAD(current_code_state); \
+} while(0)
+
+#define FRAME_LEAVE() do { \
+    MP_STATE_THREAD(current_code_state) = code_state->prev_state; \
+} while(0)
+
+#define FRAME_UPDATE()
+#define TRACE_TICK(current_ip, current_sp, is_exception)
+
 #else // MICROPY_PY_SYS_SETTRACE
 #define FRAME_SETUP()
 #define FRAME_ENTER()
@@ -195,6 +218,233 @@
 #define TRACE_TICK(current_ip, current_sp, is_exception)
 #endif // MICROPY_PY_SYS_SETTRACE
 
+// CIRCUITPY-CHANGE
+#if MICROPY_OPT_BINARY_OP_QUICKEN
+
+// Quickening: a BINARY_OP_MULTI opcode, in bytecode on the heap, that runs on
+// two small ints or on a float and a float or small int is rewritten into one
+// of the BINARY_OP_QUICK opcodes below if there is one for its op.  This does
+// the op itself while its operands pass its guard.  When they don't, it does
+// the generic op and rewrites itself back to BINARY_OP_MULTI, to be quickened
+// again later for whatever types the opcode then sees.
+
+// The quick opcodes, in order from MP_BC_BINARY_OP_QUICK.
+enum {
+    VM_QUICK_INT_LESS,
+    VM_QUICK_INT_MORE,
+    VM_QUICK_INT_EQUAL,
+    VM_QUICK_INT_LESS_EQUAL,
+    VM_QUICK_INT_MORE_EQUAL,
+    VM_QUICK_INT_NOT_EQUAL,
+    VM_QUICK_INT_INPLACE_ADD,
+    VM_QUICK_INT_INPLACE_SUBTRACT,
+    VM_QUICK_INT_ADD,
+    VM_QUICK_INT_SUBTRACT,
+    VM_QUICK_INT_MULTIPLY,
+    VM_QUICK_INT_RSHIFT,
+    VM_QUICK_FLOAT_LESS,
+    VM_QUICK_FLOAT_MORE,
+    VM_QUICK_FLOAT_INPLACE_ADD,
+    VM_QUICK_FLOAT_INPLACE_SUBTRACT,
+    VM_QUICK_FLOAT_INPLACE_MULTIPLY,
+    VM_QUICK_FLOAT_INPLACE_TRUE_DIVIDE,
+    VM_QUICK_FLOAT_ADD,
+    VM_QUICK_FLOAT_SUBTRACT,
+    VM_QUICK_FLOAT_MULTIPLY,
+    VM_QUICK_FLOAT_TRUE_DIVIDE,
+    VM_QUICK_NUM,
+};
+
+#define VM_QUICK_FIRST_FLOAT (VM_QUICK_FLOAT_LESS)
+
+// The generic op that each quick opcode does.
+static const byte vm_quick_op[VM_QUICK_NUM] = {
+    MP_BINARY_OP_LESS,
+    MP_BINARY_OP_MORE,
+    MP_BINARY_OP_EQUAL,
+    MP_BINARY_OP_LESS_EQUAL,
+    MP_BINARY_OP_MORE_EQUAL,
+    MP_BINARY_OP_NOT_EQUAL,
+    MP_BINARY_OP_INPLACE_ADD,
+    MP_BINARY_OP_INPLACE_SUBTRACT,
+    MP_BINARY_OP_ADD,
+    MP_BINARY_OP_SUBTRACT,
+    MP_BINARY_OP_MULTIPLY,
+    MP_BINARY_OP_RSHIFT,
+    MP_BINARY_OP_LESS,
+    MP_BINARY_OP_MORE,
+    MP_BINARY_OP_INPLACE_ADD,
+    MP_BINARY_OP_INPLACE_SUBTRACT,
+    MP_BINARY_OP_INPLACE_MULTIPLY,
+    MP_BINARY_OP_INPLACE_TRUE_DIVIDE,
+    MP_BINARY_OP_ADD,
+    MP_BINARY_OP_SUBTRACT,
+    MP_BINARY_OP_MULTIPLY,
+    MP_BINARY_OP_TRUE_DIVIDE,
+};
+
+// The ops that have quick opcodes, as bitmasks, so BINARY_OP_MULTI can tell
+// cheaply whether it's worth trying to quicken itself.
+#define VM_QUICK_BIT(op) ((uint64_t)1 << MP_BINARY_OP_##op)
+#define VM_QUICK_INT_OPS (VM_QUICK_BIT(LESS) | VM_QUICK_BIT(MORE) | VM_QUICK_BIT(EQUAL) \
+    | VM_QUICK_BIT(LESS_EQUAL) | VM_QUICK_BIT(MORE_EQUAL) | VM_QUICK_BIT(NOT_EQUAL) \
+    | VM_QUICK_BIT(INPLACE_ADD) | VM_QUICK_BIT(INPLACE_SUBTRACT) | VM_QUICK_BIT(ADD) \
+    | VM_QUICK_BIT(SUBTRACT) | VM_QUICK_BIT(MULTIPLY) | VM_QUICK_BIT(RSHIFT))
+#define VM_QUICK_FLOAT_OPS (VM_QUICK_BIT(LESS) | VM_QUICK_BIT(MORE) | VM_QUICK_BIT(INPLACE_ADD) \
+    | VM_QUICK_BIT(INPLACE_SUBTRACT) | VM_QUICK_BIT(INPLACE_MULTIPLY) | VM_QUICK_BIT(INPLACE_TRUE_DIVIDE) \
+    | VM_QUICK_BIT(ADD) | VM_QUICK_BIT(SUBTRACT) | VM_QUICK_BIT(MULTIPLY) | VM_QUICK_BIT(TRUE_DIVIDE))
+
+#if MICROPY_PY_BUILTINS_FLOAT
+// Whether lhs and rhs pass the guard of the float quick opcodes, and if so
+// their values as floats.
+static inline bool vm_quick_floats(mp_obj_t lhs, mp_obj_t rhs, mp_float_t *lhs_val, mp_float_t *rhs_val) {
+    if (mp_obj_is_float(lhs)) {
+        *lhs_val = mp_obj_float_get(lhs);
+        if (mp_obj_is_float(rhs)) {
+            *rhs_val = mp_obj_float_get(rhs);
+            return true;
+        } else if (mp_obj_is_small_int(rhs)) {
+            *rhs_val = (mp_float_t)MP_OBJ_SMALL_INT_VALUE(rhs);
+            return true;
+        }
+    } else if (mp_obj_is_small_int(lhs) && mp_obj_is_float(rhs)) {
+        *lhs_val = (mp_float_t)MP_OBJ_SMALL_INT_VALUE(lhs);
+        *rhs_val = mp_obj_float_get(rhs);
+        return true;
+    }
+    return false;
+}
+#endif
+
+// Rewrite the BINARY_OP_MULTI opcode at ip, whose operands are lhs and rhs,
+// into a quick opcode if there is one for its op and their types.
+static MP_NOINLINE void vm_binary_op_quicken(const byte *ip, mp_binary_op_t op, mp_obj_t lhs, mp_obj_t rhs) {
+    MP_STATIC_ASSERT(VM_QUICK_NUM == MP_BC_BINARY_OP_QUICK_NUM);
+    size_t first, last;
+    if (mp_obj_is_small_int(lhs) && mp_obj_is_small_int(rhs)) {
+        first = 0;
+        last = VM_QUICK_FIRST_FLOAT;
+    } else {
+        #if MICROPY_PY_BUILTINS_FLOAT
+        mp_float_t lhs_val, rhs_val;
+        if (!vm_quick_floats(lhs, rhs, &lhs_val, &rhs_val)) {
+            return;
+        }
+        first = VM_QUICK_FIRST_FLOAT;
+        last = VM_QUICK_NUM;
+        #else
+        return;
+        #endif
+    }
+    // bytecode outside the heap may be in flash
+    if (!gc_ptr_on_heap((void *)ip)) {
+        return;
+    }
+    for (size_t i = first; i < last; i++) {
+        if (vm_quick_op[i] == op) {
+            *(byte *)ip = (byte)(MP_BC_BINARY_OP_QUICK + i);
+            return;
+        }
+    }
+}
+
+static inline void vm_binary_op_maybe_quicken(const byte *ip, mp_binary_op_t op, mp_obj_t lhs, mp_obj_t rhs) {
+    if ((((VM_QUICK_INT_OPS | VM_QUICK_FLOAT_OPS) >> op) & 1)
+        && (mp_obj_is_small_int(lhs) || mp_obj_is_float(lhs))
+        && (mp_obj_is_small_int(rhs) || mp_obj_is_float(rhs))) {
+        vm_binary_op_quicken(ip, op, lhs, rhs);
+    }
+}
+
+// Do the op of the quick opcode at ip the generic way, rewriting the opcode
+// back to BINARY_OP_MULTI unless the operands are still of its type.
+static MP_NOINLINE mp_obj_t vm_binary_op_unquicken(const byte *ip, mp_binary_op_t op, mp_obj_t lhs, mp_obj_t rhs, bool keep) {
+    if (!keep) {
+        *(byte *)ip = MP_BC_BINARY_OP_MULTI + op;
+    }
+    return mp_binary_op(op, lhs, rhs);
+}
+
+// Execute the quick opcode at ip.
+static inline mp_obj_t vm_binary_op_quick(const byte *ip, mp_obj_t lhs, mp_obj_t rhs) {
+    size_t n = (byte)(*ip - MP_BC_BINARY_OP_QUICK);
+    if (n < VM_QUICK_FIRST_FLOAT) {
+        if (mp_obj_is_small_int(lhs) && mp_obj_is_small_int(rhs)) {
+            mp_int_t lhs_val = MP_OBJ_SMALL_INT_VALUE(lhs);
+            mp_int_t rhs_val = MP_OBJ_SMALL_INT_VALUE(rhs);
+            switch (n) {
+                case VM_QUICK_INT_LESS:
+                    return mp_obj_new_bool(lhs_val < rhs_val);
+                case VM_QUICK_INT_MORE:
+                    return mp_obj_new_bool(lhs_val > rhs_val);
+                case VM_QUICK_INT_EQUAL:
+                    return mp_obj_new_bool(lhs_val == rhs_val);
+                case VM_QUICK_INT_LESS_EQUAL:
+                    return mp_obj_new_bool(lhs_val <= rhs_val);
+                case VM_QUICK_INT_MORE_EQUAL:
+                    return mp_obj_new_bool(lhs_val >= rhs_val);
+                case VM_QUICK_INT_NOT_EQUAL:
+                    return mp_obj_new_bool(lhs_val != rhs_val);
+                case VM_QUICK_INT_INPLACE_ADD:
+                case VM_QUICK_INT_ADD:
+                    // can't overflow mp_int_t, see mp_binary_op
+                    lhs_val += rhs_val;
+                    break;
+                case VM_QUICK_INT_INPLACE_SUBTRACT:
+                case VM_QUICK_INT_SUBTRACT:
+                    lhs_val -= rhs_val;
+                    break;
+                case VM_QUICK_INT_MULTIPLY:
+                    if (mp_small_int_mul_overflow(lhs_val, rhs_val)) {
+                        return vm_binary_op_unquicken(ip, vm_quick_op[n], lhs, rhs, true);
+                    }
+                    lhs_val *= rhs_val;
+                    break;
+                default:
+                    if (rhs_val < 0 || rhs_val >= (mp_int_t)(sizeof(lhs_val) * MP_BITS_PER_BYTE)) {
+                        return vm_binary_op_unquicken(ip, vm_quick_op[n], lhs, rhs, true);
+                    }
+                    lhs_val >>= rhs_val;
+                    break;
+            }
+            if (MP_SMALL_INT_FITS(lhs_val)) {
+                return MP_OBJ_NEW_SMALL_INT(lhs_val);
+            }
+            return mp_obj_new_int_from_ll(lhs_val);
+        }
+    } else {
+        #if MICROPY_PY_BUILTINS_FLOAT
+        mp_float_t lhs_val, rhs_val;
+        if (vm_quick_floats(lhs, rhs, &lhs_val, &rhs_val)) {
+            switch (n) {
+                case VM_QUICK_FLOAT_LESS:
+                    return mp_obj_new_bool(lhs_val < rhs_val);
+                case VM_QUICK_FLOAT_MORE:
+                    return mp_obj_new_bool(lhs_val > rhs_val);
+                case VM_QUICK_FLOAT_INPLACE_ADD:
+                case VM_QUICK_FLOAT_ADD:
+                    return mp_obj_new_float(lhs_val + rhs_val);
+                case VM_QUICK_FLOAT_INPLACE_SUBTRACT:
+                case VM_QUICK_FLOAT_SUBTRACT:
+                    return mp_obj_new_float(lhs_val - rhs_val);
+                case VM_QUICK_FLOAT_INPLACE_MULTIPLY:
+                case VM_QUICK_FLOAT_MULTIPLY:
+                    return mp_obj_new_float(lhs_val * rhs_val);
+                default:
+                    if (rhs_val == 0) {
+                        // raises ZeroDivisionError
+                        return vm_binary_op_unquicken(ip, vm_quick_op[n], lhs, rhs, true);
+                    }
+                    return mp_obj_new_float(lhs_val / rhs_val);
+            }
+        }
+        #endif
+    }
+    return vm_binary_op_unquicken(ip, vm_quick_op[n], lhs, rhs, false);
+}
+
+#endif // MICROPY_OPT_BINARY_OP_QUICKEN
+
 // CIRCUITPY-CHANGE
 static mp_obj_t get_active_exception(mp_exc_stack_t *exc_sp, mp_exc_stack_t *exc_stack) {
     for (mp_exc_stack_t *e = exc_sp; e >= exc_stack; --e) {
@@ -420,6 +670,10 @@ dispatch_loop:
                     DECODE_QSTR;
                     mp_obj_t top = TOP();
                     mp_obj_t obj;
+                    // CIRCUITPY-CHANGE
+                    #if MICROPY_OPT_ATTR_INLINE_CACHE
+                    obj = mp_attr_cache_load_attr(code_state->fun_bc, ip, top, qst);
+                    #else
                     #if MICROPY_OPT_LOAD_ATTR_FAST_PATH
                     // For the specific case of an instance type, it implements .attr
                     // and forwards to its members map. Attribute lookups on instance
@@ -437,6 +691,7 @@ dispatch_loop:
                     {
                         obj = mp_load_attr(top, qst);
                     }
+                    #endif
                     SET_TOP(obj);
                     DISPATCH();
                 }
@@ -444,7 +699,12 @@ dispatch_loop:
                 ENTRY(MP_BC_LOAD_METHOD): {
                     MARK_EXC_IP_SELECTIVE();
                     DECODE_QSTR;
+                    // CIRCUITPY-CHANGE
+                    #if MICROPY_OPT_ATTR_INLINE_CACHE
+                    mp_attr_cache_load_method(code_state->fun_bc, ip, *sp, qst, sp);
+                    #else
                     mp_load_method(*sp, qst, sp);
+                    #endif
                     sp += 1;
                     DISPATCH();
                 }
@@ -499,7 +759,12 @@ dispatch_loop:
                     FRAME_UPDATE();
                     MARK_EXC_IP_SELECTIVE();
                     DECODE_QSTR;
+                    // CIRCUITPY-CHANGE
+                    #if MICROPY_OPT_ATTR_INLINE_CACHE
+                    mp_attr_cache_store_attr(code_state->fun_bc, ip, sp[0], qst, sp[-1]);
+                    #else
                     mp_store_attr(sp[0], qst, sp[-1]);
+                    #endif
                     sp -= 2;
                     DISPATCH();
                 }
@@ -1306,14 +1571,41 @@ yield:
                     MARK_EXC_IP_SELECTIVE();
                     mp_obj_t rhs = POP();
                     mp_obj_t lhs = TOP();
+                    // CIRCUITPY-CHANGE
+                    #if MICROPY_OPT_BINARY_OP_QUICKEN
+                    mp_binary_op_t op = ip[-1] - MP_BC_BINARY_OP_MULTI;
+                    vm_binary_op_maybe_quicken(ip - 1, op, lhs, rhs);
+                    SET_TOP(mp_binary_op(op, lhs, rhs));
+                    #else
                     SET_TOP(mp_binary_op(ip[-1] - MP_BC_BINARY_OP_MULTI, lhs, rhs));
+                    #endif
+                    DISPATCH();
+                }
+
+                // CIRCUITPY-CHANGE
+                #if MICROPY_OPT_BINARY_OP_QUICKEN
+                ENTRY(MP_BC_BINARY_OP_QUICK): {
+                    MARK_EXC_IP_SELECTIVE();
+                    mp_obj_t rhs = POP();
+                    mp_obj_t lhs = TOP();
+                    SET_TOP(vm_binary_op_quick(ip - 1, lhs, rhs));
                     DISPATCH();
                 }
+                #endif
 
                 ENTRY_DEFAULT:
                     MARK_EXC_IP_SELECTIVE();
                 #else
                 ENTRY_DEFAULT:
+                    // CIRCUITPY-CHANGE: quick opcodes wrap round to 0x00, so check for them first
+                    #if MICROPY_OPT_BINARY_OP_QUICKEN
+                    if ((byte)(ip[-1] - MP_BC_BINARY_OP_QUICK) < MP_BC_BINARY_OP_QUICK_NUM) {
+                        mp_obj_t rhs = POP();
+                        mp_obj_t lhs = TOP();
+                        SET_TOP(vm_binary_op_quick(ip - 1, lhs, rhs));
+                        DISPATCH();
+                    } else
+                    #endif
                     if (ip[-1] < MP_BC_LOAD_CONST_SMALL_INT_MULTI + MP_BC_LOAD_CONST_SMALL_INT_MULTI_NUM) {
                         PUSH(MP_OBJ_NEW_SMALL_INT((mp_int_t)ip[-1] - MP_BC_LOAD_CONST_SMALL_INT_MULTI - MP_BC_LOAD_CONST_SMALL_INT_MULTI_EXCESS));
                         DISPATCH();
@@ -1329,7 +1621,14 @@ yield:
                     } else if (ip[-1] < MP_BC_BINARY_OP_MULTI + MP_BC_BINARY_OP_MULTI_NUM) {
                         mp_obj_t rhs = POP();
                         mp_obj_t lhs = TOP();
+                        // CIRCUITPY-CHANGE
+                        #if MICROPY_OPT_BINARY_OP_QUICKEN
+                        mp_binary_op_t op = ip[-1] - MP_BC_BINARY_OP_MULTI;
+                        vm_binary_op_maybe_quicken(ip - 1, op, lhs, rhs);
+                        SET_TOP(mp_binary_op(op, lhs, rhs));
+                        #else
                         SET_TOP(mp_binary_op(ip[-1] - MP_BC_BINARY_OP_MULTI, lhs, rhs));
+                        #endif
                         DISPATCH();
                     } else
                 #endif // MICROPY_OPT_COMPUTED_GOTO
@@ -132,6 +132,11 @@ static entry_table_type const PLACE_IN_DTCM_DATA(entry_table[256]) = {
     [MP_BC_STORE_FAST_MULTI ... MP_BC_STORE_FAST_MULTI + MP_BC_LOAD_FAST_MULTI_NUM - 1] = COMPUTE_ENTRY(&& entry_MP_BC_STORE_FAST_MULTI),
     [MP_BC_UNARY_OP_MULTI ... MP_BC_UNARY_OP_MULTI + MP_BC_UNARY_OP_MULTI_NUM - 1] = COMPUTE_ENTRY(&& entry_MP_BC_UNARY_OP_MULTI),
     [MP_BC_BINARY_OP_MULTI ... MP_BC_BINARY_OP_MULTI + MP_BC_BINARY_OP_MULTI_NUM - 1] = COMPUTE_ENTRY(&& entry_MP_BC_BINARY_OP_MULTI),
+    // CIRCUITPY-CHANGE
+    #if MICROPY_OPT_BINARY_OP_QUICKEN
+    [MP_BC_BINARY_OP_QUICK ... 0xff] = COMPUTE_ENTRY(&& entry_MP_BC_BINARY_OP_QUICK),
+    [0x00 ... (byte)(MP_BC_BINARY_OP_QUICK + MP_BC_BINARY_OP_QUICK_NUM - 1)] = COMPUTE_ENTRY(&& entry_MP_BC_BINARY_OP_QUICK),
+    #endif
 };
 
 // CIRCUITPY-CHANGE: #ifdef instead of #if
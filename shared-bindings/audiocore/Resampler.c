@@ -0,0 +1,146 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include <stdint.h>
+
+#include "shared/runtime/context_manager_helpers.h"
+#include "py/objproperty.h"
+#include "py/runtime.h"
+#include "shared-bindings/util.h"
+#include "shared-bindings/audiocore/Resampler.h"
+
+//| class Resampler:
+//|     """Plays an audio sample at a different sample rate"""
+//|
+//|     def __init__(
+//|         self,
+//|         sample: circuitpython_typing.AudioSample,
+//|         *,
+//|         sample_rate: int,
+//|         linear: bool = False,
+//|         buffer_size: int = 512,
+//|     ) -> None:
+//|         """Create a Resampler that converts ``sample`` to ``sample_rate`` as it plays. This lets a
+//|         sample be played by a `audiomixer.Mixer` or effect that runs at another rate.
+//|
+//|         The output is always signed 16 bit with the same number of channels as ``sample``.
+//|         Looping is handled by whatever plays the Resampler.
+//|
+//|         :param circuitpython_typing.AudioSample sample: The sample to convert
+//|         :param int sample_rate: The sample rate to output
+//|         :param bool linear: Interpolate linearly between samples. This takes much less time than the
+//|             default windowed-sinc filter but adds some distortion, and aliasing when lowering the rate.
+//|         :param int buffer_size: The total size in bytes of each of the two playback buffers to use
+//|
+//|         Playing a 22050 Hz wave file through a 44100 Hz mixer::
+//|
+//|           import audiocore
+//|           import audiomixer
+//|           import audiobusio
+//|           import board
+//|
+//|           audio = audiobusio.I2SOut(bit_clock=board.GP20, word_select=board.GP21, data=board.GP22)
+//|           mixer = audiomixer.Mixer(voice_count=1, sample_rate=44100, channel_count=1)
+//|           audio.play(mixer)
+//|           wave = audiocore.WaveFile("drum.wav")
+//|           mixer.voice[0].play(audiocore.Resampler(wave, sample_rate=44100))"""
+//|         ...
+static mp_obj_t audioio_resampler_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
+    enum { ARG_sample, ARG_sample_rate, ARG_linear, ARG_buffer_size };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_sample, MP_ARG_OBJ | MP_ARG_REQUIRED, {.u_obj = MP_OBJ_NULL } },
+        { MP_QSTR_sample_rate, MP_ARG_INT | MP_ARG_KW_ONLY | MP_ARG_REQUIRED, {.u_int = 0} },
+        { MP_QSTR_linear, MP_ARG_BOOL | MP_ARG_KW_ONLY, {.u_bool = false} },
+        { MP_QSTR_buffer_size, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 512} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all_kw_array(n_args, n_kw, all_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_obj_t sample = args[ARG_sample].u_obj;
+    mp_proto_get_or_throw(MP_QSTR_protocol_audiosample, sample);
+    mp_int_t sample_rate = mp_arg_validate_int_min(args[ARG_sample_rate].u_int, 1, MP_QSTR_sample_rate);
+    mp_int_t buffer_size = mp_arg_validate_int_min(args[ARG_buffer_size].u_int, 4, MP_QSTR_buffer_size);
+
+    audioio_resampler_obj_t *self = mp_obj_malloc(audioio_resampler_obj_t, &audioio_resampler_type);
+    common_hal_audioio_resampler_construct(self, sample, sample_rate, args[ARG_linear].u_bool, buffer_size);
+
+    return MP_OBJ_FROM_PTR(self);
+}
+
+//|     def deinit(self) -> None:
+//|         """Deinitialises the Resampler and releases its buffers."""
+//|         ...
+static mp_obj_t audioio_resampler_deinit(mp_obj_t self_in) {
+    audioio_resampler_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    common_hal_audioio_resampler_deinit(self);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(audioio_resampler_deinit_obj, audioio_resampler_deinit);
+
+static void check_for_deinit(audioio_resampler_obj_t *self) {
+    if (common_hal_audioio_resampler_deinited(self)) {
+        raise_deinited_error();
+    }
+}
+
+//|     def __enter__(self) -> Resampler:
+//|         """No-op used by Context Managers."""
+//|         ...
+//  Provided by context manager helper.
+
+//|     def __exit__(self) -> None:
+//|         """Automatically deinitializes when exiting a context. See
+//|         :ref:`lifetime-and-contextmanagers` for more info."""
+//|         ...
+static mp_obj_t audioio_resampler_obj___exit__(size_t n_args, const mp_obj_t *args) {
+    (void)n_args;
+    common_hal_audioio_resampler_deinit(args[0]);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(audioio_resampler___exit___obj, 4, 4, audioio_resampler_obj___exit__);
+
+//|     sample_rate: int
+//|     """The sample rate that the sample is converted to. (read-only)"""
+//|
+static mp_obj_t audioio_resampler_obj_get_sample_rate(mp_obj_t self_in) {
+    audioio_resampler_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return MP_OBJ_NEW_SMALL_INT(common_hal_audioio_resampler_get_sample_rate(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audioio_resampler_get_sample_rate_obj, audioio_resampler_obj_get_sample_rate);
+
+MP_PROPERTY_GETTER(audioio_resampler_sample_rate_obj,
+    (mp_obj_t)&audioio_resampler_get_sample_rate_obj);
+
+static const mp_rom_map_elem_t audioio_resampler_locals_dict_table[] = {
+    // Methods
+    { MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&audioio_resampler_deinit_obj) },
+    { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&default___enter___obj) },
+    { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&audioio_resampler___exit___obj) },
+
+    // Properties
+    { MP_ROM_QSTR(MP_QSTR_sample_rate), MP_ROM_PTR(&audioio_resampler_sample_rate_obj) },
+};
+static MP_DEFINE_CONST_DICT(audioio_resampler_locals_dict, audioio_resampler_locals_dict_table);
+
+static const audiosample_p_t audioio_resampler_proto = {
+    MP_PROTO_IMPLEMENT(MP_QSTR_protocol_audiosample)
+    .sample_rate = (audiosample_sample_rate_fun)common_hal_audioio_resampler_get_sample_rate,
+    .bits_per_sample = (audiosample_bits_per_sample_fun)common_hal_audioio_resampler_get_bits_per_sample,
+    .channel_count = (audiosample_channel_count_fun)common_hal_audioio_resampler_get_channel_count,
+    .reset_buffer = (audiosample_reset_buffer_fun)audioio_resampler_reset_buffer,
+    .get_buffer = (audiosample_get_buffer_fun)audioio_resampler_get_buffer,
+    .get_buffer_structure = (audiosample_get_buffer_structure_fun)audioio_resampler_get_buffer_structure,
+};
+
+MP_DEFINE_CONST_OBJ_TYPE(
+    audioio_resampler_type,
+    MP_QSTR_Resampler,
+    MP_TYPE_FLAG_HAS_SPECIAL_ACCESSORS,
+    make_new, audioio_resampler_make_new,
+    locals_dict, &audioio_resampler_locals_dict,
+    protocol, &audioio_resampler_proto
+    );
@@ -20,7 +20,13 @@
 //|     be 8 bit unsigned or 16 bit signed. If a buffer is provided, it will be used instead of allocating
 //|     an internal buffer, which can prevent memory fragmentation."""
 //|
-//|     def __init__(self, file: Union[str, typing.BinaryIO], buffer: WriteableBuffer) -> None:
+//|     def __init__(
+//|         self,
+//|         file: Union[str, typing.BinaryIO],
+//|         buffer: Optional[WriteableBuffer] = None,
+//|         *,
+//|         read_ahead: int = 0,
+//|     ) -> None:
 //|         """Load a .wav file for playback with `audioio.AudioOut` or `audiobusio.I2SOut`.
 //|
 //|         :param Union[str, typing.BinaryIO] file: The name of a wave file (preferred) or an already opened wave file
@@ -28,6 +34,10 @@
 //|           that will be split in half and used for double-buffering of the data.
 //|           The buffer must be 8 to 1024 bytes long.
 //|           If not provided, two 256 byte buffers are initially allocated internally.
+//|         :param int read_ahead: Number of bytes of the file to read ahead in the background,
+//|           rounded down to a multiple of 512. Playback then only waits on the file when this
+//|           runs dry, which is counted in `underruns`. A few kilobytes helps with slow storage
+//|           such as SD cards. 0 reads the file only as the data is needed.
 //|
 //|         Playing a wave file from flash::
 //|
@@ -50,9 +60,16 @@
 //|           print("stopped")
 //|         """
 //|         ...
-static mp_obj_t audioio_wavefile_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
-    mp_arg_check_num(n_args, n_kw, 1, 2, false);
-    mp_obj_t arg = args[0];
+static mp_obj_t audioio_wavefile_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
+    enum { ARG_file, ARG_buffer, ARG_read_ahead };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_file, MP_ARG_OBJ | MP_ARG_REQUIRED, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_buffer, MP_ARG_OBJ, {.u_obj = mp_const_none} },
+        { MP_QSTR_read_ahead, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 0} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all_kw_array(n_args, n_kw, all_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+    mp_obj_t arg = args[ARG_file].u_obj;
 
     if (mp_obj_is_str(arg)) {
         arg = mp_call_function_2(MP_OBJ_FROM_PTR(&mp_builtin_open_obj), arg, MP_ROM_QSTR(MP_QSTR_rb));
@@ -64,14 +81,15 @@ static mp_obj_t audioio_wavefile_make_new(const mp_obj_type_t *type, size_t n_ar
     }
     uint8_t *buffer = NULL;
     size_t buffer_size = 0;
-    if (n_args >= 2) {
+    if (args[ARG_buffer].u_obj != mp_const_none) {
         mp_buffer_info_t bufinfo;
-        mp_get_buffer_raise(args[1], &bufinfo, MP_BUFFER_WRITE);
+        mp_get_buffer_raise(args[ARG_buffer].u_obj, &bufinfo, MP_BUFFER_WRITE);
         buffer = bufinfo.buf;
         buffer_size = mp_arg_validate_length_range(bufinfo.len, 8, 1024, MP_QSTR_buffer);
     }
+    mp_int_t read_ahead = mp_arg_validate_int_min(args[ARG_read_ahead].u_int, 0, MP_QSTR_read_ahead);
     common_hal_audioio_wavefile_construct(self, MP_OBJ_TO_PTR(arg),
-        buffer, buffer_size);
+        buffer, buffer_size, read_ahead);
 
     return MP_OBJ_FROM_PTR(self);
 }
@@ -144,7 +162,6 @@ MP_PROPERTY_GETTER(audioio_wavefile_bits_per_sample_obj,
     (mp_obj_t)&audioio_wavefile_get_bits_per_sample_obj);
 //|     channel_count: int
 //|     """Number of audio channels. (read only)"""
-//|
 static mp_obj_t audioio_wavefile_obj_get_channel_count(mp_obj_t self_in) {
     audioio_wavefile_obj_t *self = MP_OBJ_TO_PTR(self_in);
     check_for_deinit(self);
@@ -155,6 +172,31 @@ MP_DEFINE_CONST_FUN_OBJ_1(audioio_wavefile_get_channel_count_obj, audioio_wavefi
 MP_PROPERTY_GETTER(audioio_wavefile_channel_count_obj,
     (mp_obj_t)&audioio_wavefile_get_channel_count_obj);
 
+//|     underruns: int
+//|     """Number of times playback had to wait on the file because the read ahead ran dry. (read only)"""
+static mp_obj_t audioio_wavefile_obj_get_underruns(mp_obj_t self_in) {
+    audioio_wavefile_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return mp_obj_new_int_from_uint(common_hal_audioio_wavefile_get_underruns(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audioio_wavefile_get_underruns_obj, audioio_wavefile_obj_get_underruns);
+
+MP_PROPERTY_GETTER(audioio_wavefile_underruns_obj,
+    (mp_obj_t)&audioio_wavefile_get_underruns_obj);
+
+//|     max_read_ms: int
+//|     """The longest any single read from the file has taken, in milliseconds. (read only)"""
+//|
+static mp_obj_t audioio_wavefile_obj_get_max_read_ms(mp_obj_t self_in) {
+    audioio_wavefile_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return mp_obj_new_int_from_uint(common_hal_audioio_wavefile_get_max_read_ms(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audioio_wavefile_get_max_read_ms_obj, audioio_wavefile_obj_get_max_read_ms);
+
+MP_PROPERTY_GETTER(audioio_wavefile_max_read_ms_obj,
+    (mp_obj_t)&audioio_wavefile_get_max_read_ms_obj);
+
 
 static const mp_rom_map_elem_t audioio_wavefile_locals_dict_table[] = {
     // Methods
@@ -166,6 +208,8 @@ static const mp_rom_map_elem_t audioio_wavefile_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_sample_rate), MP_ROM_PTR(&audioio_wavefile_sample_rate_obj) },
     { MP_ROM_QSTR(MP_QSTR_bits_per_sample), MP_ROM_PTR(&audioio_wavefile_bits_per_sample_obj) },
     { MP_ROM_QSTR(MP_QSTR_channel_count), MP_ROM_PTR(&audioio_wavefile_channel_count_obj) },
+    { MP_ROM_QSTR(MP_QSTR_underruns), MP_ROM_PTR(&audioio_wavefile_underruns_obj) },
+    { MP_ROM_QSTR(MP_QSTR_max_read_ms), MP_ROM_PTR(&audioio_wavefile_max_read_ms_obj) },
 };
 static MP_DEFINE_CONST_DICT(audioio_wavefile_locals_dict, audioio_wavefile_locals_dict_table);
 
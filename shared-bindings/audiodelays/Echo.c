@@ -328,6 +328,7 @@ static const audiosample_p_t audiodelays_echo_proto = {
     .reset_buffer = (audiosample_reset_buffer_fun)audiodelays_echo_reset_buffer,
     .get_buffer = (audiosample_get_buffer_fun)audiodelays_echo_get_buffer,
     .get_buffer_structure = (audiosample_get_buffer_structure_fun)audiodelays_echo_get_buffer_structure,
+    .render = (audiosample_render_fun)audiodelays_echo_render,
 };
 
 MP_DEFINE_CONST_OBJ_TYPE(
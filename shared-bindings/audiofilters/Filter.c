@@ -254,6 +254,7 @@ static const audiosample_p_t audiofilters_filter_proto = {
     .reset_buffer = (audiosample_reset_buffer_fun)audiofilters_filter_reset_buffer,
     .get_buffer = (audiosample_get_buffer_fun)audiofilters_filter_get_buffer,
     .get_buffer_structure = (audiosample_get_buffer_structure_fun)audiofilters_filter_get_buffer_structure,
+    .render = (audiosample_render_fun)audiofilters_filter_render,
 };
 
 MP_DEFINE_CONST_OBJ_TYPE(
@@ -250,6 +250,7 @@ static const audiosample_p_t audiomixer_mixer_proto = {
     .reset_buffer = (audiosample_reset_buffer_fun)audiomixer_mixer_reset_buffer,
     .get_buffer = (audiosample_get_buffer_fun)audiomixer_mixer_get_buffer,
     .get_buffer_structure = (audiosample_get_buffer_structure_fun)audiomixer_mixer_get_buffer_structure,
+    .render = (audiosample_render_fun)audiomixer_mixer_render,
 };
 
 MP_DEFINE_CONST_OBJ_TYPE(
@@ -65,7 +65,10 @@
 //|         auto_refresh: bool = True,
 //|         native_frames_per_second: int = 60,
 //|         backlight_on_high: bool = True,
-//|         SH1107_addressing: bool = False
+//|         SH1107_addressing: bool = False,
+//|         refresh_buffer_size: int = 512,
+//|         double_buffer: bool = False,
+//|         scroll_ram_height: int = 0,
 //|     ) -> None:
 //|         r"""Create a Display object on the given display bus (`FourWire`, `paralleldisplaybus.ParallelBus` or `I2CDisplayBus`).
 //|
@@ -123,6 +126,9 @@
 //|         :param bool SH1107_addressing: Special quirk for SH1107, use upper/lower column set and page set
 //|         :param int set_vertical_scroll: This parameter is accepted but ignored for backwards compatibility. It will be removed in a future release.
 //|         :param int backlight_pwm_frequency: The frequency to use to drive the PWM for backlight brightness control. Default is 50000.
+//|         :param int refresh_buffer_size: Number of bytes of pixels to render before sending them to the display. Larger buffers mean fewer, longer transfers. Must be between 64 and 2048. It is increased if needed to hold a row of pixels.
+//|         :param bool double_buffer: Render into a second buffer of ``refresh_buffer_size`` while the first is sent. This speeds up refresh when the bus can send in the background, such as over SPI on RP2040 or a ParallelBus on ESP32-S3.
+//|         :param int scroll_ram_height: Number of rows of memory in a display controller that supports the MIPI set_scroll_area (0x33) and set_scroll_start (0x37) commands, such as 320 for the ST7789 and ILI9341. When set, a root group that only moved vertically, or a TileGrid that only scrolled with ``TileGrid`` top_left changes as `terminalio.Terminal` does, is scrolled by the display and only the newly visible rows are sent. Only used when ``color_depth`` is at least 8 and the scroll is along the display's rows, which is true for rotations of 0 and 180 on most displays. 0 disables it.
 //|         """
 //|         ...
 static mp_obj_t busdisplay_busdisplay_make_new(const mp_obj_type_t *type, size_t n_args,
@@ -134,7 +140,8 @@ static mp_obj_t busdisplay_busdisplay_make_new(const mp_obj_type_t *type, size_t
            ARG_set_vertical_scroll, ARG_backlight_pin, ARG_brightness_command,
            ARG_brightness, ARG_single_byte_bounds, ARG_data_as_commands,
            ARG_auto_refresh, ARG_native_frames_per_second, ARG_backlight_on_high,
-           ARG_SH1107_addressing, ARG_backlight_pwm_frequency };
+           ARG_SH1107_addressing, ARG_backlight_pwm_frequency, ARG_refresh_buffer_size,
+           ARG_double_buffer, ARG_scroll_ram_height };
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_display_bus, MP_ARG_REQUIRED | MP_ARG_OBJ },
         { MP_QSTR_init_sequence, MP_ARG_REQUIRED | MP_ARG_OBJ },
@@ -162,7 +169,10 @@ static mp_obj_t busdisplay_busdisplay_make_new(const mp_obj_type_t *type, size_t
         { MP_QSTR_native_frames_per_second, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 60} },
         { MP_QSTR_backlight_on_high, MP_ARG_BOOL | MP_ARG_KW_ONLY, {.u_bool = true} },
         { MP_QSTR_SH1107_addressing, MP_ARG_BOOL | MP_ARG_KW_ONLY, {.u_bool = false} },
-        { MP_QSTR_backlight_pwm_frequency, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 50000} }
+        { MP_QSTR_backlight_pwm_frequency, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 50000} },
+        { MP_QSTR_refresh_buffer_size, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 512} },
+        { MP_QSTR_double_buffer, MP_ARG_BOOL | MP_ARG_KW_ONLY, {.u_bool = false} },
+        { MP_QSTR_scroll_ram_height, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 0} },
     };
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
     mp_arg_parse_all_kw_array(n_args, n_kw, all_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
@@ -188,6 +198,11 @@ static mp_obj_t busdisplay_busdisplay_make_new(const mp_obj_type_t *type, size_t
         mp_raise_ValueError_varg(MP_ERROR_TEXT("%q must be 1 when %q is True"), MP_QSTR_color_depth, MP_QSTR_SH1107_addressing);
     }
 
+    const mp_int_t refresh_buffer_size =
+        mp_arg_validate_int_range(args[ARG_refresh_buffer_size].u_int, 64, 2048, MP_QSTR_refresh_buffer_size);
+    const mp_int_t scroll_ram_height =
+        mp_arg_validate_int_range(args[ARG_scroll_ram_height].u_int, 0, 0xffff, MP_QSTR_scroll_ram_height);
+
     primary_display_t *disp = allocate_display_or_raise();
     busdisplay_busdisplay_obj_t *self = &disp->display;
 
@@ -214,6 +229,8 @@ static mp_obj_t busdisplay_busdisplay_make_new(const mp_obj_type_t *type, size_t
         sh1107_addressing,
         args[ARG_backlight_pwm_frequency].u_int
         );
+    common_hal_busdisplay_busdisplay_set_refresh_buffer(self, refresh_buffer_size, args[ARG_double_buffer].u_bool);
+    common_hal_busdisplay_busdisplay_set_scroll_ram_height(self, scroll_ram_height);
 
     return self;
 }
@@ -308,6 +325,49 @@ MP_PROPERTY_GETSET(busdisplay_busdisplay_auto_refresh_obj,
     (mp_obj_t)&busdisplay_busdisplay_get_auto_refresh_obj,
     (mp_obj_t)&busdisplay_busdisplay_set_auto_refresh_obj);
 
+//|     max_refresh_areas: int
+//|     """The most rectangles that a refresh sends to the display. Changed areas close to each other
+//|     are combined when sending the pixels between them is cheaper than starting another rectangle,
+//|     and further until there are at most this many."""
+static mp_obj_t busdisplay_busdisplay_obj_get_max_refresh_areas(mp_obj_t self_in) {
+    busdisplay_busdisplay_obj_t *self = native_display(self_in);
+    return MP_OBJ_NEW_SMALL_INT(common_hal_busdisplay_busdisplay_get_max_refresh_areas(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(busdisplay_busdisplay_get_max_refresh_areas_obj, busdisplay_busdisplay_obj_get_max_refresh_areas);
+
+static mp_obj_t busdisplay_busdisplay_obj_set_max_refresh_areas(mp_obj_t self_in, mp_obj_t max_refresh_areas) {
+    busdisplay_busdisplay_obj_t *self = native_display(self_in);
+    mp_int_t value = mp_arg_validate_int_range(mp_obj_get_int(max_refresh_areas), 1, DISPLAYIO_MAX_REFRESH_AREAS, MP_QSTR_max_refresh_areas);
+    common_hal_busdisplay_busdisplay_set_max_refresh_areas(self, value);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(busdisplay_busdisplay_set_max_refresh_areas_obj, busdisplay_busdisplay_obj_set_max_refresh_areas);
+
+MP_PROPERTY_GETSET(busdisplay_busdisplay_max_refresh_areas_obj,
+    (mp_obj_t)&busdisplay_busdisplay_get_max_refresh_areas_obj,
+    (mp_obj_t)&busdisplay_busdisplay_set_max_refresh_areas_obj);
+
+//|     refresh_stats: Tuple[int, int, int]
+//|     """The number of rectangles sent, the number of pixels sent and the time taken in microseconds
+//|     by the last refresh that changed the display."""
+static mp_obj_t busdisplay_busdisplay_obj_get_refresh_stats(mp_obj_t self_in) {
+    busdisplay_busdisplay_obj_t *self = native_display(self_in);
+    uint8_t areas;
+    uint32_t pixels;
+    uint32_t us;
+    common_hal_busdisplay_busdisplay_get_refresh_stats(self, &areas, &pixels, &us);
+    mp_obj_t stats[] = {
+        MP_OBJ_NEW_SMALL_INT(areas),
+        mp_obj_new_int_from_uint(pixels),
+        mp_obj_new_int_from_uint(us),
+    };
+    return mp_obj_new_tuple(MP_ARRAY_SIZE(stats), stats);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(busdisplay_busdisplay_get_refresh_stats_obj, busdisplay_busdisplay_obj_get_refresh_stats);
+
+MP_PROPERTY_GETTER(busdisplay_busdisplay_refresh_stats_obj,
+    (mp_obj_t)&busdisplay_busdisplay_get_refresh_stats_obj);
+
 //|     brightness: float
 //|     """The brightness of the display as a float. 0.0 is off and 1.0 is full brightness."""
 static mp_obj_t busdisplay_busdisplay_obj_get_brightness(mp_obj_t self_in) {
@@ -485,6 +545,8 @@ static const mp_rom_map_elem_t busdisplay_busdisplay_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_auto_refresh), MP_ROM_PTR(&busdisplay_busdisplay_auto_refresh_obj) },
 
     { MP_ROM_QSTR(MP_QSTR_brightness), MP_ROM_PTR(&busdisplay_busdisplay_brightness_obj) },
+    { MP_ROM_QSTR(MP_QSTR_max_refresh_areas), MP_ROM_PTR(&busdisplay_busdisplay_max_refresh_areas_obj) },
+    { MP_ROM_QSTR(MP_QSTR_refresh_stats), MP_ROM_PTR(&busdisplay_busdisplay_refresh_stats_obj) },
 
     { MP_ROM_QSTR(MP_QSTR_width), MP_ROM_PTR(&busdisplay_busdisplay_width_obj) },
     { MP_ROM_QSTR(MP_QSTR_height), MP_ROM_PTR(&busdisplay_busdisplay_height_obj) },
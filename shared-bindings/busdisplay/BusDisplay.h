@@ -26,6 +26,18 @@ void common_hal_busdisplay_busdisplay_construct(busdisplay_busdisplay_obj_t *sel
     bool single_byte_bounds, bool data_as_commands, bool auto_refresh, uint16_t native_frames_per_second,
     bool backlight_on_high, bool SH1107_addressing, uint16_t backlight_pwm_frequency);
 
+// Sets the number of bytes rendered per transfer and whether a second buffer is
+// rendered into while the first is sent. The defaults are 512 and false.
+void common_hal_busdisplay_busdisplay_set_refresh_buffer(busdisplay_busdisplay_obj_t *self, uint16_t size_bytes, bool double_buffer);
+
+// Enables scrolling with the MIPI set_scroll_area and set_scroll_start commands when
+// ram_height, the number of rows of display memory, is non-zero.
+void common_hal_busdisplay_busdisplay_set_scroll_ram_height(busdisplay_busdisplay_obj_t *self, uint16_t ram_height);
+
+uint8_t common_hal_busdisplay_busdisplay_get_max_refresh_areas(busdisplay_busdisplay_obj_t *self);
+void common_hal_busdisplay_busdisplay_set_max_refresh_areas(busdisplay_busdisplay_obj_t *self, uint8_t max_refresh_areas);
+void common_hal_busdisplay_busdisplay_get_refresh_stats(busdisplay_busdisplay_obj_t *self, uint8_t *areas, uint32_t *pixels, uint32_t *us);
+
 bool common_hal_busdisplay_busdisplay_refresh(busdisplay_busdisplay_obj_t *self, uint32_t target_ms_per_frame, uint32_t maximum_ms_per_real_frame);
 
 bool common_hal_busdisplay_busdisplay_get_auto_refresh(busdisplay_busdisplay_obj_t *self);
@@ -20,6 +20,13 @@
 #include "py/objproperty.h"
 #include "py/runtime.h"
 
+// Ports that can write in the background, such as with DMA, override these.
+MP_WEAK bool common_hal_busio_spi_start_write(busio_spi_obj_t *self, const uint8_t *data, size_t len) {
+    return common_hal_busio_spi_write(self, data, len);
+}
+
+MP_WEAK void common_hal_busio_spi_wait_for_write(busio_spi_obj_t *self) {
+}
 
 //| class SPI:
 //|     """A 3-4 wire serial protocol
@@ -37,6 +37,14 @@ extern bool common_hal_busio_spi_read(busio_spi_obj_t *self, uint8_t *data, size
 // Reads and write len bytes simultaneously.
 extern bool common_hal_busio_spi_transfer(busio_spi_obj_t *self, const uint8_t *data_out, uint8_t *data_in, size_t len);
 
+// Starts writing out the given data, and may return before it has all been
+// written. The data must not change until common_hal_busio_spi_wait_for_write()
+// returns. The default implementation writes it all before returning.
+extern bool common_hal_busio_spi_start_write(busio_spi_obj_t *self, const uint8_t *data, size_t len);
+
+// Waits until the data from common_hal_busio_spi_start_write() has been written.
+extern void common_hal_busio_spi_wait_for_write(busio_spi_obj_t *self);
+
 // Return actual SPI bus frequency.
 uint32_t common_hal_busio_spi_get_frequency(busio_spi_obj_t *self);
 
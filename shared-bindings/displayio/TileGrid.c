@@ -145,6 +145,30 @@ MP_PROPERTY_GETSET(displayio_tilegrid_hidden_obj,
     (mp_obj_t)&displayio_tilegrid_get_hidden_obj,
     (mp_obj_t)&displayio_tilegrid_set_hidden_obj);
 
+//|     render_cache: bool
+//|     """When True, the TileGrid keeps a copy of its pixels already converted for the display so
+//|     that unchanged pixels aren't looked up in the bitmap and pixel_shader every refresh. This
+//|     makes moving a TileGrid whose bitmap rarely changes much faster at the cost of memory for a
+//|     copy of every pixel. Only displays with 8, 16 or 32 bits per pixel use it, and not when the
+//|     pixel_shader dithers. False by default."""
+static mp_obj_t displayio_tilegrid_obj_get_render_cache(mp_obj_t self_in) {
+    displayio_tilegrid_t *self = native_tilegrid(self_in);
+    return mp_obj_new_bool(common_hal_displayio_tilegrid_get_render_cache(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(displayio_tilegrid_get_render_cache_obj, displayio_tilegrid_obj_get_render_cache);
+
+static mp_obj_t displayio_tilegrid_obj_set_render_cache(mp_obj_t self_in, mp_obj_t render_cache_obj) {
+    displayio_tilegrid_t *self = native_tilegrid(self_in);
+
+    common_hal_displayio_tilegrid_set_render_cache(self, mp_obj_is_true(render_cache_obj));
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(displayio_tilegrid_set_render_cache_obj, displayio_tilegrid_obj_set_render_cache);
+
+MP_PROPERTY_GETSET(displayio_tilegrid_render_cache_obj,
+    (mp_obj_t)&displayio_tilegrid_get_render_cache_obj,
+    (mp_obj_t)&displayio_tilegrid_set_render_cache_obj);
+
 //|     x: int
 //|     """X position of the left edge in the parent."""
 static mp_obj_t displayio_tilegrid_obj_get_x(mp_obj_t self_in) {
@@ -446,6 +470,7 @@ static mp_obj_t tilegrid_subscr(mp_obj_t self_in, mp_obj_t index_obj, mp_obj_t v
 static const mp_rom_map_elem_t displayio_tilegrid_locals_dict_table[] = {
     // Properties
     { MP_ROM_QSTR(MP_QSTR_hidden), MP_ROM_PTR(&displayio_tilegrid_hidden_obj) },
+    { MP_ROM_QSTR(MP_QSTR_render_cache), MP_ROM_PTR(&displayio_tilegrid_render_cache_obj) },
     { MP_ROM_QSTR(MP_QSTR_x), MP_ROM_PTR(&displayio_tilegrid_x_obj) },
     { MP_ROM_QSTR(MP_QSTR_y), MP_ROM_PTR(&displayio_tilegrid_y_obj) },
     { MP_ROM_QSTR(MP_QSTR_width), MP_ROM_PTR(&displayio_tilegrid_width_obj) },
@@ -35,6 +35,9 @@ void common_hal_displayio_tilegrid_set_flip_y(displayio_tilegrid_t *self, bool f
 bool common_hal_displayio_tilegrid_get_transpose_xy(displayio_tilegrid_t *self);
 void common_hal_displayio_tilegrid_set_transpose_xy(displayio_tilegrid_t *self, bool transpose_xy);
 
+bool common_hal_displayio_tilegrid_get_render_cache(displayio_tilegrid_t *self);
+void common_hal_displayio_tilegrid_set_render_cache(displayio_tilegrid_t *self, bool render_cache);
+
 bool common_hal_displayio_tilegrid_contains(displayio_tilegrid_t *self, uint16_t x, uint16_t y);
 
 uint16_t common_hal_displayio_tilegrid_get_width(displayio_tilegrid_t *self);
@@ -30,6 +30,9 @@ bool common_hal_fourwire_fourwire_begin_transaction(mp_obj_t self);
 void common_hal_fourwire_fourwire_send(mp_obj_t self, display_byte_type_t byte_type,
     display_chip_select_behavior_t chip_select, const uint8_t *data, uint32_t data_length);
 
+void common_hal_fourwire_fourwire_start_send(mp_obj_t self, display_byte_type_t byte_type,
+    display_chip_select_behavior_t chip_select, const uint8_t *data, uint32_t data_length);
+
 void common_hal_fourwire_fourwire_end_transaction(mp_obj_t self);
 
 // The FourWire object always lives off the MP heap. So, code must collect any pointers
@@ -0,0 +1,125 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include "py/runtime.h"
+#include "shared-bindings/msgpack/Unpacker.h"
+
+#define MP_OBJ_IS_METH(o) (mp_obj_is_obj(o) && (((mp_obj_base_t *)MP_OBJ_TO_PTR(o))->type->name == MP_QSTR_bound_method))
+
+//| class Unpacker:
+//|     """Unpack a sequence of objects that arrives a piece at a time
+//|
+//|     Data is buffered until it holds a whole object, so objects can be split
+//|     across reads or calls to `feed` in any way.
+//|
+//|     Example::
+//|
+//|        import msgpack
+//|
+//|        unpacker = msgpack.Unpacker()
+//|        while True:
+//|            unpacker.feed(uart.read(64) or b"")
+//|            for obj in unpacker:
+//|                print(obj)
+//|     """
+//|
+//|     def __init__(
+//|         self,
+//|         stream: Optional[circuitpython_typing.ByteStream] = None,
+//|         *,
+//|         read_size: int = 256,
+//|         ext_hook: Union[Callable[[int, bytes], object], None] = None,
+//|         use_list: bool = True,
+//|         bin_memoryview: bool = False
+//|     ) -> None:
+//|         """Create an Unpacker.
+//|
+//|         :param ~circuitpython_typing.ByteStream stream: stream to read from. If None,
+//|                data is given with `feed` instead.
+//|         :param int read_size: the most bytes to read from the stream at once.
+//|         :param Optional[~circuitpython_typing.Callable[[int, bytes], object]] ext_hook: function called for objects in
+//|                msgpack ext format.
+//|         :param bool use_list: return array as list or tuple (use_list=False).
+//|         :param bool bin_memoryview: return bin objects as read-only memoryviews of the
+//|                unpacker's buffer rather than copying them to bytes. The views stay valid
+//|                as more data arrives."""
+//|         ...
+//|
+static mp_obj_t msgpack_unpacker_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
+    enum { ARG_stream, ARG_read_size, ARG_ext_hook, ARG_use_list, ARG_bin_memoryview };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_stream, MP_ARG_OBJ, { .u_obj = mp_const_none } },
+        { MP_QSTR_read_size, MP_ARG_KW_ONLY | MP_ARG_INT, { .u_int = 256 } },
+        { MP_QSTR_ext_hook, MP_ARG_KW_ONLY | MP_ARG_OBJ, { .u_obj = mp_const_none } },
+        { MP_QSTR_use_list, MP_ARG_KW_ONLY | MP_ARG_BOOL, { .u_bool = true } },
+        { MP_QSTR_bin_memoryview, MP_ARG_KW_ONLY | MP_ARG_BOOL, { .u_bool = false } },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all_kw_array(n_args, n_kw, all_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_obj_t hook = args[ARG_ext_hook].u_obj;
+    if (hook != mp_const_none && !mp_obj_is_fun(hook) && !MP_OBJ_IS_METH(hook)) {
+        mp_raise_ValueError(MP_ERROR_TEXT("ext_hook is not a function"));
+    }
+    mp_int_t read_size = mp_arg_validate_int_min(args[ARG_read_size].u_int, 1, MP_QSTR_read_size);
+    mp_obj_t stream = args[ARG_stream].u_obj;
+
+    msgpack_unpacker_obj_t *self = mp_obj_malloc(msgpack_unpacker_obj_t, &msgpack_unpacker_type);
+    common_hal_msgpack_unpacker_construct(self, stream == mp_const_none ? MP_OBJ_NULL : stream,
+        read_size, hook, args[ARG_use_list].u_bool, args[ARG_bin_memoryview].u_bool);
+    return MP_OBJ_FROM_PTR(self);
+}
+
+//|     def feed(self, data: ReadableBuffer) -> None:
+//|         """Add data to be unpacked. Only for an Unpacker without a stream."""
+//|         ...
+//|
+static mp_obj_t msgpack_unpacker_feed(mp_obj_t self_in, mp_obj_t data) {
+    msgpack_unpacker_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    if (self->stream != MP_OBJ_NULL) {
+        mp_raise_RuntimeError(MP_ERROR_TEXT("Unpacker has a stream"));
+    }
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(data, &bufinfo, MP_BUFFER_READ);
+    common_hal_msgpack_unpacker_feed(self, bufinfo.buf, bufinfo.len);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_2(msgpack_unpacker_feed_obj, msgpack_unpacker_feed);
+
+//|     def __iter__(self) -> Unpacker:
+//|         """Returns self
+//|
+//|         This method exists so that `Unpacker` can be used as an
+//|         iterable"""
+//|         ...
+//|
+//|     def __next__(self) -> object:
+//|         """Unpack and return the next object.
+//|
+//|         If no whole object is buffered, reads from the stream, if any, until
+//|         there is one. Raises StopIteration if there still isn't, for
+//|         instance because the stream is non-blocking and has no more data
+//|         yet. Iteration can be started again once more data has arrived."""
+//|         ...
+//|
+static mp_obj_t msgpack_unpacker_iternext(mp_obj_t self_in) {
+    msgpack_unpacker_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return common_hal_msgpack_unpacker_next(self);
+}
+
+static const mp_rom_map_elem_t msgpack_unpacker_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_feed), MP_ROM_PTR(&msgpack_unpacker_feed_obj) },
+};
+static MP_DEFINE_CONST_DICT(msgpack_unpacker_locals_dict, msgpack_unpacker_locals_dict_table);
+
+MP_DEFINE_CONST_OBJ_TYPE(
+    msgpack_unpacker_type,
+    MP_QSTR_Unpacker,
+    MP_TYPE_FLAG_ITER_IS_ITERNEXT,
+    make_new, msgpack_unpacker_make_new,
+    locals_dict, &msgpack_unpacker_locals_dict,
+    iter, msgpack_unpacker_iternext
+    );
@@ -0,0 +1,16 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "shared-module/msgpack/Unpacker.h"
+
+extern const mp_obj_type_t msgpack_unpacker_type;
+
+void common_hal_msgpack_unpacker_construct(msgpack_unpacker_obj_t *self, mp_obj_t stream, size_t read_size, mp_obj_t ext_hook, bool use_list, bool bin_memoryview);
+void common_hal_msgpack_unpacker_feed(msgpack_unpacker_obj_t *self, const uint8_t *data, size_t len);
+// Returns MP_OBJ_STOP_ITERATION if no whole object is available yet.
+mp_obj_t common_hal_msgpack_unpacker_next(msgpack_unpacker_obj_t *self);
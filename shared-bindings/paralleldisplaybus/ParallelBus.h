@@ -32,6 +32,11 @@ bool common_hal_paralleldisplaybus_parallelbus_begin_transaction(mp_obj_t self);
 void common_hal_paralleldisplaybus_parallelbus_send(mp_obj_t self, display_byte_type_t byte_type,
     display_chip_select_behavior_t chip_select, const uint8_t *data, uint32_t data_length);
 
+// Like send, but may return before the data has been sent. The default
+// implementation calls send.
+void common_hal_paralleldisplaybus_parallelbus_start_send(mp_obj_t self, display_byte_type_t byte_type,
+    display_chip_select_behavior_t chip_select, const uint8_t *data, uint32_t data_length);
+
 void common_hal_paralleldisplaybus_parallelbus_end_transaction(mp_obj_t self);
 
 // The ParallelBus object always lives off the MP heap. So, code must collect any pointers
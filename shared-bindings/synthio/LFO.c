@@ -301,6 +301,7 @@ static MP_DEFINE_CONST_DICT(synthio_lfo_locals_dict, synthio_lfo_locals_dict_tab
 static const synthio_block_proto_t lfo_proto = {
     MP_PROTO_IMPLEMENT(MP_QSTR_synthio_block)
     .tick = common_hal_synthio_lfo_tick,
+    .get_input = common_hal_synthio_lfo_get_input,
 };
 
 MP_DEFINE_CONST_OBJ_TYPE(
@@ -269,6 +269,7 @@ static MP_DEFINE_CONST_DICT(synthio_math_locals_dict, synthio_math_locals_dict_t
 static const synthio_block_proto_t math_proto = {
     MP_PROTO_IMPLEMENT(MP_QSTR_synthio_block)
     .tick = common_hal_synthio_math_tick,
+    .get_input = common_hal_synthio_math_get_input,
 };
 
 MP_DEFINE_CONST_OBJ_TYPE(
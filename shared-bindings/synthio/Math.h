@@ -38,3 +38,4 @@ void common_hal_synthio_math_set_operation(synthio_math_obj_t *self, synthio_mat
 mp_float_t common_hal_synthio_math_get_value(synthio_math_obj_t *self);
 
 mp_float_t common_hal_synthio_math_tick(mp_obj_t self_in);
+struct synthio_block_slot *common_hal_synthio_math_get_input(mp_obj_t self_in, size_t i);
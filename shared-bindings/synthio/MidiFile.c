@@ -0,0 +1,190 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include <stdint.h>
+
+#include "shared/runtime/context_manager_helpers.h"
+#include "py/objproperty.h"
+#include "py/runtime.h"
+#include "shared-bindings/util.h"
+#include "shared-bindings/synthio/MidiFile.h"
+#include "shared-bindings/synthio/__init__.h"
+
+//| class MidiFile:
+//|     """MIDI file player that streams its events from a file"""
+//|
+//|     def __init__(
+//|         self,
+//|         file: Union[str, typing.BinaryIO],
+//|         *,
+//|         sample_rate: int = 11025,
+//|         waveform: Optional[ReadableBuffer] = None,
+//|         envelope: Optional[Envelope] = None,
+//|     ) -> None:
+//|         """Play a Standard MIDI File of type 0 (a single track) or type 1 (several tracks played
+//|         together). Only a small buffer of each track is held in memory so long songs can be played.
+//|
+//|         As in `MidiTrack`, only "Note On" and "Note Off" events are played; channel numbers and key
+//|         velocities are ignored. "Set Tempo" events change the tempo, and each note starts on the
+//|         sample it is due.
+//|
+//|         :param file: The name of the MIDI file, or an already opened MIDI file
+//|         :param int sample_rate: The desired playback sample rate; higher sample rate requires more memory
+//|         :param ReadableBuffer waveform: A single-cycle waveform. Default is a 50% duty cycle square wave. If specified, must be a ReadableBuffer of type 'h' (signed 16 bit)
+//|         :param Envelope envelope: An object that defines the loudness of a note over time. The default envelope provides no ramping, voices turn instantly on and off.
+//|
+//|         Playing a multi-track MIDI file from flash::
+//|
+//|           import audioio
+//|           import board
+//|           import synthio
+//|
+//|           midi = synthio.MidiFile("song.mid")
+//|           a = audioio.AudioOut(board.A0)
+//|
+//|           print("playing")
+//|           a.play(midi)
+//|           while a.playing:
+//|             pass
+//|           print("stopped")"""
+//|         ...
+static mp_obj_t synthio_midifile_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
+    enum { ARG_file, ARG_sample_rate, ARG_waveform, ARG_envelope };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_file, MP_ARG_OBJ | MP_ARG_REQUIRED, {} },
+        { MP_QSTR_sample_rate, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 11025} },
+        { MP_QSTR_waveform, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = mp_const_none } },
+        { MP_QSTR_envelope, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = mp_const_none } },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all_kw_array(n_args, n_kw, all_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+    mp_obj_t arg = args[ARG_file].u_obj;
+
+    if (mp_obj_is_str(arg)) {
+        arg = mp_call_function_2(MP_OBJ_FROM_PTR(&mp_builtin_open_obj), arg, MP_ROM_QSTR(MP_QSTR_rb));
+    }
+    if (!mp_obj_is_type(arg, &mp_type_vfs_fat_fileio)) {
+        mp_raise_TypeError(MP_ERROR_TEXT("file must be a file opened in byte mode"));
+    }
+
+    synthio_midifile_obj_t *self = mp_obj_malloc(synthio_midifile_obj_t, &synthio_midifile_type);
+
+    common_hal_synthio_midifile_construct(self, MP_OBJ_TO_PTR(arg),
+        args[ARG_sample_rate].u_int,
+        args[ARG_waveform].u_obj,
+        args[ARG_envelope].u_obj
+        );
+
+    return MP_OBJ_FROM_PTR(self);
+}
+
+//|     def deinit(self) -> None:
+//|         """Deinitialises the MidiFile and releases any hardware resources for reuse."""
+//|         ...
+static mp_obj_t synthio_midifile_deinit(mp_obj_t self_in) {
+    synthio_midifile_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    common_hal_synthio_midifile_deinit(self);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(synthio_midifile_deinit_obj, synthio_midifile_deinit);
+
+static void check_for_deinit(synthio_midifile_obj_t *self) {
+    if (common_hal_synthio_midifile_deinited(self)) {
+        raise_deinited_error();
+    }
+}
+
+//|     def __enter__(self) -> MidiFile:
+//|         """No-op used by Context Managers."""
+//|         ...
+//  Provided by context manager helper.
+
+//|     def __exit__(self) -> None:
+//|         """Automatically deinitializes the hardware when exiting a context. See
+//|         :ref:`lifetime-and-contextmanagers` for more info."""
+//|         ...
+static mp_obj_t synthio_midifile_obj___exit__(size_t n_args, const mp_obj_t *args) {
+    (void)n_args;
+    common_hal_synthio_midifile_deinit(args[0]);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(synthio_midifile___exit___obj, 4, 4, synthio_midifile_obj___exit__);
+
+//|     sample_rate: int
+//|     """32 bit value that tells how quickly samples are played in Hertz (cycles per second)."""
+//|
+static mp_obj_t synthio_midifile_obj_get_sample_rate(mp_obj_t self_in) {
+    synthio_midifile_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return MP_OBJ_NEW_SMALL_INT(common_hal_synthio_midifile_get_sample_rate(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(synthio_midifile_get_sample_rate_obj, synthio_midifile_obj_get_sample_rate);
+
+MP_PROPERTY_GETTER(synthio_midifile_sample_rate_obj,
+    (mp_obj_t)&synthio_midifile_get_sample_rate_obj);
+
+//|     track_count: int
+//|     """Number of tracks in the file"""
+//|
+static mp_obj_t synthio_midifile_obj_get_track_count(mp_obj_t self_in) {
+    synthio_midifile_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return MP_OBJ_NEW_SMALL_INT(common_hal_synthio_midifile_get_track_count(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(synthio_midifile_get_track_count_obj, synthio_midifile_obj_get_track_count);
+
+MP_PROPERTY_GETTER(synthio_midifile_track_count_obj,
+    (mp_obj_t)&synthio_midifile_get_track_count_obj);
+
+//|     error_location: Optional[int]
+//|     """Offset, in bytes within the file, of the first decoding error. The track with the error
+//|     stops playing there."""
+//|
+static mp_obj_t synthio_midifile_obj_get_error_location(mp_obj_t self_in) {
+    synthio_midifile_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    mp_int_t location = common_hal_synthio_midifile_get_error_location(self);
+    if (location >= 0) {
+        return MP_OBJ_NEW_SMALL_INT(location);
+    }
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(synthio_midifile_get_error_location_obj, synthio_midifile_obj_get_error_location);
+
+MP_PROPERTY_GETTER(synthio_midifile_error_location_obj,
+    (mp_obj_t)&synthio_midifile_get_error_location_obj);
+
+static const mp_rom_map_elem_t synthio_midifile_locals_dict_table[] = {
+    // Methods
+    { MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&synthio_midifile_deinit_obj) },
+    { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&default___enter___obj) },
+    { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&synthio_midifile___exit___obj) },
+
+    // Properties
+    { MP_ROM_QSTR(MP_QSTR_sample_rate), MP_ROM_PTR(&synthio_midifile_sample_rate_obj) },
+    { MP_ROM_QSTR(MP_QSTR_track_count), MP_ROM_PTR(&synthio_midifile_track_count_obj) },
+    { MP_ROM_QSTR(MP_QSTR_error_location), MP_ROM_PTR(&synthio_midifile_error_location_obj) },
+};
+static MP_DEFINE_CONST_DICT(synthio_midifile_locals_dict, synthio_midifile_locals_dict_table);
+
+static const audiosample_p_t synthio_midifile_proto = {
+    MP_PROTO_IMPLEMENT(MP_QSTR_protocol_audiosample)
+    .sample_rate = (audiosample_sample_rate_fun)common_hal_synthio_midifile_get_sample_rate,
+    .bits_per_sample = (audiosample_bits_per_sample_fun)common_hal_synthio_midifile_get_bits_per_sample,
+    .channel_count = (audiosample_channel_count_fun)common_hal_synthio_midifile_get_channel_count,
+    .reset_buffer = (audiosample_reset_buffer_fun)synthio_midifile_reset_buffer,
+    .get_buffer = (audiosample_get_buffer_fun)synthio_midifile_get_buffer,
+    .get_buffer_structure = (audiosample_get_buffer_structure_fun)synthio_midifile_get_buffer_structure,
+};
+
+MP_DEFINE_CONST_OBJ_TYPE(
+    synthio_midifile_type,
+    MP_QSTR_MidiFile,
+    MP_TYPE_FLAG_HAS_SPECIAL_ACCESSORS,
+    make_new, synthio_midifile_make_new,
+    locals_dict, &synthio_midifile_locals_dict,
+    protocol, &synthio_midifile_proto
+    );
@@ -0,0 +1,22 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "shared-module/synthio/MidiFile.h"
+#include "py/obj.h"
+
+extern const mp_obj_type_t synthio_midifile_type;
+
+void common_hal_synthio_midifile_construct(synthio_midifile_obj_t *self, pyb_file_obj_t *file, uint32_t sample_rate, mp_obj_t waveform_obj, mp_obj_t envelope_obj);
+
+void common_hal_synthio_midifile_deinit(synthio_midifile_obj_t *self);
+bool common_hal_synthio_midifile_deinited(synthio_midifile_obj_t *self);
+uint32_t common_hal_synthio_midifile_get_sample_rate(synthio_midifile_obj_t *self);
+uint8_t common_hal_synthio_midifile_get_bits_per_sample(synthio_midifile_obj_t *self);
+uint8_t common_hal_synthio_midifile_get_channel_count(synthio_midifile_obj_t *self);
+uint8_t common_hal_synthio_midifile_get_track_count(synthio_midifile_obj_t *self);
+mp_int_t common_hal_synthio_midifile_get_error_location(synthio_midifile_obj_t *self);
@@ -19,6 +19,7 @@
 #include "shared-bindings/synthio/Biquad.h"
 #include "shared-bindings/synthio/LFO.h"
 #include "shared-bindings/synthio/Math.h"
+#include "shared-bindings/synthio/MidiFile.h"
 #include "shared-bindings/synthio/MidiTrack.h"
 #include "shared-bindings/synthio/Note.h"
 #include "shared-bindings/synthio/Synthesizer.h"
@@ -168,9 +169,10 @@ const mp_obj_namedtuple_type_t synthio_envelope_type_obj = {
 //|     sample_rate: int = 11025,
 //|     waveform: Optional[ReadableBuffer] = None,
 //|     envelope: Optional[Envelope] = None,
-//| ) -> MidiTrack:
+//| ) -> Union[MidiTrack, MidiFile]:
 //|     """Create an AudioSample from an already opened MIDI file.
-//|     Currently, only single-track MIDI (type 0) is supported.
+//|     A single-track MIDI (type 0) is read into a `MidiTrack`. A multi-track MIDI (type 1) is
+//|     streamed from the file by a `MidiFile`.
 //|
 //|     :param typing.BinaryIO file: Already opened MIDI file
 //|     :param int sample_rate: The desired playback sample rate; higher sample rate requires more memory
@@ -215,10 +217,18 @@ static mp_obj_t synthio_from_file(size_t n_args, const mp_obj_t *pos_args, mp_ma
     if (f_read(&file->fp, chunk_header, sizeof(chunk_header), &bytes_read) != FR_OK) {
         mp_raise_OSError(MP_EIO);
     }
+    if (bytes_read == sizeof(chunk_header) &&
+        memcmp(chunk_header, "MThd\0\0\0\6\0\1", 10) == 0) {
+        synthio_midifile_obj_t *result = mp_obj_malloc(synthio_midifile_obj_t, &synthio_midifile_type);
+        common_hal_synthio_midifile_construct(result, file,
+            args[ARG_sample_rate].u_int, args[ARG_waveform].u_obj,
+            args[ARG_envelope].u_obj
+            );
+        return MP_OBJ_FROM_PTR(result);
+    }
     if (bytes_read != sizeof(chunk_header) ||
         memcmp(chunk_header, "MThd\0\0\0\6\0\0\0\1", 12)) {
         mp_arg_error_invalid(MP_QSTR_file);
-        // TODO: for a multi-track MIDI (type 1), return an AudioMixer
     }
 
     uint16_t tempo;
@@ -309,6 +319,7 @@ static const mp_rom_map_elem_t synthio_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR_Biquad), MP_ROM_PTR(&synthio_biquad_type_obj) },
     { MP_ROM_QSTR(MP_QSTR_Math), MP_ROM_PTR(&synthio_math_type) },
     { MP_ROM_QSTR(MP_QSTR_MathOperation), MP_ROM_PTR(&synthio_math_operation_type) },
+    { MP_ROM_QSTR(MP_QSTR_MidiFile), MP_ROM_PTR(&synthio_midifile_type) },
     { MP_ROM_QSTR(MP_QSTR_MidiTrack), MP_ROM_PTR(&synthio_miditrack_type) },
     { MP_ROM_QSTR(MP_QSTR_Note), MP_ROM_PTR(&synthio_note_type) },
     { MP_ROM_QSTR(MP_QSTR_EnvelopeState), MP_ROM_PTR(&synthio_note_state_type) },
@@ -0,0 +1,276 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include "shared-bindings/audiocore/Resampler.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "py/runtime.h"
+
+#if defined(__arm__) && __arm__
+#include "cmsis_compiler.h"
+#endif
+
+// Fills the kernel for a cutoff of fc times the source's Nyquist frequency. Phase p is the kernel
+// for an output frame p / AUDIOIO_RESAMPLER_PHASES of a frame past the kernel's center tap. There
+// is one more phase than that so rounding up to a whole frame needs no special case.
+static void _make_kernel(int16_t *kernel, mp_float_t fc) {
+    const int half = AUDIOIO_RESAMPLER_TAPS / 2;
+    const mp_float_t pi = MICROPY_FLOAT_CONST(3.14159265358979323846);
+    for (int p = 0; p <= AUDIOIO_RESAMPLER_PHASES; p++) {
+        mp_float_t h[AUDIOIO_RESAMPLER_TAPS];
+        mp_float_t sum = 0;
+        mp_float_t frac = (mp_float_t)p / AUDIOIO_RESAMPLER_PHASES;
+        for (int k = 0; k < AUDIOIO_RESAMPLER_TAPS; k++) {
+            mp_float_t x = (mp_float_t)(k - (half - 1)) - frac;
+            mp_float_t sinc = fc;
+            if (x != 0) {
+                sinc = MICROPY_FLOAT_C_FUN(sin)(pi * fc * x) / (pi * x);
+            }
+            // Blackman window over the kernel's span
+            mp_float_t n = (x + half) / AUDIOIO_RESAMPLER_TAPS;
+            mp_float_t window = MICROPY_FLOAT_CONST(0.42)
+                - MICROPY_FLOAT_CONST(0.5) * MICROPY_FLOAT_C_FUN(cos)(2 * pi * n)
+                + MICROPY_FLOAT_CONST(0.08) * MICROPY_FLOAT_C_FUN(cos)(4 * pi * n);
+            h[k] = sinc * window;
+            sum += h[k];
+        }
+        // Normalize each phase to unity gain so a constant input stays constant.
+        for (int k = 0; k < AUDIOIO_RESAMPLER_TAPS; k++) {
+            mp_float_t c = MICROPY_FLOAT_C_FUN(round)(h[k] / sum * 32768);
+            kernel[p * AUDIOIO_RESAMPLER_TAPS + k] = (int16_t)MIN(32767, MAX(-32768, c));
+        }
+    }
+}
+
+void common_hal_audioio_resampler_construct(audioio_resampler_obj_t *self, mp_obj_t sample,
+    uint32_t sample_rate, bool linear, uint32_t buffer_size) {
+    self->source = sample;
+    self->sample_rate = sample_rate;
+    self->channel_count = audiosample_channel_count(sample);
+    uint32_t source_rate = audiosample_sample_rate(sample);
+    self->taps = linear ? 2 : AUDIOIO_RESAMPLER_TAPS;
+
+    // Whole frames only
+    uint32_t frame_size = self->channel_count * sizeof(int16_t);
+    self->buffer_len = buffer_size / frame_size * frame_size;
+
+    self->buffer[0] = m_malloc(self->buffer_len);
+    if (self->buffer[0] == NULL) {
+        common_hal_audioio_resampler_deinit(self);
+        m_malloc_fail(self->buffer_len);
+    }
+    memset(self->buffer[0], 0, self->buffer_len);
+
+    self->buffer[1] = m_malloc(self->buffer_len);
+    if (self->buffer[1] == NULL) {
+        common_hal_audioio_resampler_deinit(self);
+        m_malloc_fail(self->buffer_len);
+    }
+    memset(self->buffer[1], 0, self->buffer_len);
+
+    self->last_buf_idx = 1;
+
+    self->history_len = self->taps + AUDIOIO_RESAMPLER_INPUT_FRAMES;
+    size_t history_size = self->history_len * self->channel_count * sizeof(int16_t);
+    self->history = m_malloc(history_size);
+    if (self->history == NULL) {
+        common_hal_audioio_resampler_deinit(self);
+        m_malloc_fail(history_size);
+    }
+
+    self->kernel = NULL;
+    if (!linear) {
+        size_t kernel_size = (AUDIOIO_RESAMPLER_PHASES + 1) * AUDIOIO_RESAMPLER_TAPS * sizeof(int16_t);
+        self->kernel = m_malloc(kernel_size);
+        if (self->kernel == NULL) {
+            common_hal_audioio_resampler_deinit(self);
+            m_malloc_fail(kernel_size);
+        }
+        // Just below the lower of the two Nyquist frequencies so downsampling doesn't alias.
+        mp_float_t fc = MICROPY_FLOAT_CONST(0.9);
+        if (sample_rate < source_rate) {
+            fc = fc * sample_rate / source_rate;
+        }
+        _make_kernel(self->kernel, fc);
+    }
+
+    audioio_resampler_reset_buffer(self, false, 0);
+}
+
+bool common_hal_audioio_resampler_deinited(audioio_resampler_obj_t *self) {
+    return self->buffer[0] == NULL;
+}
+
+void common_hal_audioio_resampler_deinit(audioio_resampler_obj_t *self) {
+    self->buffer[0] = NULL;
+    self->buffer[1] = NULL;
+    self->history = NULL;
+    self->kernel = NULL;
+    self->source = MP_OBJ_NULL;
+    audiosample_input_stop(&self->input);
+}
+
+uint32_t common_hal_audioio_resampler_get_sample_rate(audioio_resampler_obj_t *self) {
+    return self->sample_rate;
+}
+
+uint8_t common_hal_audioio_resampler_get_bits_per_sample(audioio_resampler_obj_t *self) {
+    return 16;
+}
+
+uint8_t common_hal_audioio_resampler_get_channel_count(audioio_resampler_obj_t *self) {
+    return self->channel_count;
+}
+
+void audioio_resampler_reset_buffer(audioio_resampler_obj_t *self,
+    bool single_channel_output,
+    uint8_t channel) {
+    // The source's rate is read again so a RawSample whose rate changed plays at its new pitch.
+    uint32_t source_rate = audiosample_sample_rate(self->source);
+    self->step = (((uint64_t)source_rate << 16) + self->sample_rate / 2) / self->sample_rate;
+    audiosample_input_play(&self->input, self->source, false);
+    self->ended = false;
+    self->flushed = false;
+
+    // Start with the kernel's center tap on the first source frame.
+    self->history_filled = self->taps / 2 - 1;
+    for (uint8_t c = 0; c < self->channel_count; c++) {
+        memset(self->history + c * self->history_len, 0, self->history_filled * sizeof(int16_t));
+    }
+    self->position = 0;
+}
+
+// Drops the source frames the next output no longer needs and adds more from the source. Returns
+// false if nothing could be added, either because the source has no data ready or it is finished.
+static bool _fill(audioio_resampler_obj_t *self) {
+    uint8_t channels = self->channel_count;
+    uint32_t drop = MIN(self->position >> 16, self->history_filled);
+    if (drop > 0) {
+        uint32_t keep = self->history_filled - drop;
+        for (uint8_t c = 0; c < channels; c++) {
+            int16_t *history = self->history + c * self->history_len;
+            memmove(history, history + drop, keep * sizeof(int16_t));
+        }
+        self->history_filled = keep;
+        self->position -= drop << 16;
+    }
+
+    if (!self->ended) {
+        int16_t block[AUDIOSAMPLE_BLOCK_SAMPLES];
+        uint32_t frames = MIN(self->history_len - self->history_filled, AUDIOSAMPLE_BLOCK_SAMPLES / channels);
+        uint32_t count = audiosample_input_read(&self->input, block, frames * channels) / channels;
+        for (uint8_t c = 0; c < channels; c++) {
+            int16_t *history = self->history + c * self->history_len + self->history_filled;
+            for (uint32_t i = 0; i < count; i++) {
+                history[i] = block[i * channels + c];
+            }
+        }
+        self->history_filled += count;
+        self->ended = !audiosample_input_playing(&self->input);
+        if (count > 0) {
+            return true;
+        }
+        if (!self->ended) {
+            return false;
+        }
+    }
+
+    if (!self->flushed) {
+        // There is always room for these because less than a kernel's worth of frames was kept.
+        uint32_t pad = self->taps / 2;
+        for (uint8_t c = 0; c < channels; c++) {
+            memset(self->history + c * self->history_len + self->history_filled, 0, pad * sizeof(int16_t));
+        }
+        self->history_filled += pad;
+        self->flushed = true;
+        return true;
+    }
+    return false;
+}
+
+static inline int16_t _convolve(const int16_t *samples, const int16_t *kernel) {
+    int32_t sum = 0;
+    #if (defined(__ARM_ARCH_7EM__) && (__ARM_ARCH_7EM__ == 1))
+    // Two taps per multiply-accumulate. The samples may be unaligned which a plain load allows.
+    for (uint32_t i = 0; i < AUDIOIO_RESAMPLER_TAPS; i += 2) {
+        uint32_t s, k;
+        memcpy(&s, samples + i, sizeof(s));
+        memcpy(&k, kernel + i, sizeof(k));
+        sum = (int32_t)__SMLAD(s, k, (uint32_t)sum);
+    }
+    #else
+    for (uint32_t i = 0; i < AUDIOIO_RESAMPLER_TAPS; i++) {
+        sum += samples[i] * kernel[i];
+    }
+    #endif
+    sum >>= 15;
+    return MIN(INT16_MAX, MAX(INT16_MIN, sum));
+}
+
+audioio_get_buffer_result_t audioio_resampler_get_buffer(audioio_resampler_obj_t *self,
+    bool single_channel_output,
+    uint8_t channel,
+    uint8_t **buffer,
+    uint32_t *buffer_length) {
+    uint8_t channels = self->channel_count;
+    uint32_t frames = self->buffer_len / (channels * sizeof(int16_t));
+
+    self->last_buf_idx = !self->last_buf_idx;
+    int16_t *out = self->buffer[self->last_buf_idx];
+
+    uint32_t produced = 0;
+    while (true) {
+        uint32_t first = self->position >> 16;
+        if (first + self->taps > self->history_filled) {
+            if (!_fill(self)) {
+                break;
+            }
+            continue;
+        }
+        if (produced == frames) {
+            break;
+        }
+        uint32_t frac = self->position & 0xffff;
+        for (uint8_t c = 0; c < channels; c++) {
+            const int16_t *history = self->history + c * self->history_len + first;
+            if (self->kernel == NULL) {
+                out[c] = history[0] + (((history[1] - history[0]) * (int32_t)(frac >> 1)) >> 15);
+            } else {
+                // Round to the nearest phase
+                uint32_t phase = (frac + (1 << (15 - AUDIOIO_RESAMPLER_PHASE_BITS))) >> (16 - AUDIOIO_RESAMPLER_PHASE_BITS);
+                out[c] = _convolve(history, self->kernel + phase * AUDIOIO_RESAMPLER_TAPS);
+            }
+        }
+        out += channels;
+        produced++;
+        self->position += self->step;
+    }
+
+    *buffer = (uint8_t *)self->buffer[self->last_buf_idx];
+    *buffer_length = produced * channels * sizeof(int16_t);
+
+    // Done once the last frame that reaches the source's final frame has been output.
+    if (self->flushed && (self->position >> 16) + self->taps > self->history_filled) {
+        return GET_BUFFER_DONE;
+    }
+    return GET_BUFFER_MORE_DATA;
+}
+
+void audioio_resampler_get_buffer_structure(audioio_resampler_obj_t *self, bool single_channel_output,
+    bool *single_buffer, bool *samples_signed,
+    uint32_t *max_buffer_length, uint8_t *spacing) {
+    *single_buffer = false;
+    *samples_signed = true;
+    *max_buffer_length = self->buffer_len;
+    if (single_channel_output) {
+        *spacing = self->channel_count;
+    } else {
+        *spacing = 1;
+    }
+}
@@ -0,0 +1,56 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "py/obj.h"
+
+#include "shared-module/audiocore/__init__.h"
+
+// Taps of the windowed-sinc kernel. An even count so each channel's dot product is done two
+// 16-bit taps at a time.
+#define AUDIOIO_RESAMPLER_TAPS (16)
+// The kernel is tabulated at this many fractional source positions and the nearest is used.
+#define AUDIOIO_RESAMPLER_PHASE_BITS (6)
+#define AUDIOIO_RESAMPLER_PHASES (1 << AUDIOIO_RESAMPLER_PHASE_BITS)
+// Source frames kept beyond the kernel width, and so read from the source at a time.
+#define AUDIOIO_RESAMPLER_INPUT_FRAMES (64)
+
+typedef struct {
+    mp_obj_base_t base;
+    mp_obj_t source;
+    audiosample_input_t input;
+
+    uint32_t sample_rate;
+    uint8_t channel_count;
+    uint8_t taps; // 2 when interpolating linearly
+    bool ended; // The source has no more data
+    bool flushed; // and the zeros that let the kernel reach its last frame have been added.
+
+    int16_t *buffer[2];
+    uint8_t last_buf_idx;
+    uint32_t buffer_len; // bytes
+
+    int16_t *kernel; // [phase][tap] in Q15, NULL when interpolating linearly
+    int16_t *history; // [channel][history_len] source frames as signed 16-bit
+    uint32_t history_len; // frames
+    uint32_t history_filled; // frames
+    uint32_t position; // of the next output frame in history, 16.16 frames
+    uint32_t step; // source frames per output frame, 16.16
+} audioio_resampler_obj_t;
+
+// These are not available from Python because it may be called in an interrupt.
+void audioio_resampler_reset_buffer(audioio_resampler_obj_t *self,
+    bool single_channel_output,
+    uint8_t channel);
+audioio_get_buffer_result_t audioio_resampler_get_buffer(audioio_resampler_obj_t *self,
+    bool single_channel_output,
+    uint8_t channel,
+    uint8_t **buffer,
+    uint32_t *buffer_length);  // length in bytes
+void audioio_resampler_get_buffer_structure(audioio_resampler_obj_t *self, bool single_channel_output,
+    bool *single_buffer, bool *samples_signed,
+    uint32_t *max_buffer_length, uint8_t *spacing);
@@ -10,9 +10,23 @@
 #include <string.h>
 
 #include "py/mperrno.h"
+#include "py/mphal.h"
 #include "py/runtime.h"
 
 #include "shared-module/audiocore/WaveFile.h"
+#include "supervisor/background_callback.h"
+
+#if defined(MICROPY_UNIX_COVERAGE)
+#define background_callback_prevent() ((void)0)
+#define background_callback_allow() ((void)0)
+#define background_callback_add(buf, fn, arg) ((fn)((arg)))
+#endif
+
+// Read-ahead is done in whole sectors so FatFs can read them straight into the ring.
+#define SECTOR_SIZE (512)
+// At most this much is read by each background callback so other background work, including
+// the audio output, isn't held up for long.
+#define MAX_BACKGROUND_READ (2048)
 
 struct wave_format_chunk {
     uint16_t audio_format;
@@ -27,7 +41,8 @@ struct wave_format_chunk {
 void common_hal_audioio_wavefile_construct(audioio_wavefile_obj_t *self,
     pyb_file_obj_t *file,
     uint8_t *buffer,
-    size_t buffer_size) {
+    size_t buffer_size,
+    size_t read_ahead) {
     // Load the wave
     self->file = file;
     uint8_t chunk_header[16];
@@ -109,11 +124,29 @@ void common_hal_audioio_wavefile_construct(audioio_wavefile_obj_t *self,
             m_malloc_fail(self->len);
         }
     }
+
+    self->underruns = 0;
+    self->max_read_ms = 0;
+    self->ring = NULL;
+    self->ring_read_off = 0;
+    self->ring_write_off = 0;
+    self->ring_file_remaining = 0;
+    self->ring_primed = false;
+    self->ring_size = read_ahead / SECTOR_SIZE * SECTOR_SIZE;
+    if (self->ring_size > 0) {
+        self->ring = m_malloc(self->ring_size);
+        if (self->ring == NULL) {
+            common_hal_audioio_wavefile_deinit(self);
+            m_malloc_fail(self->ring_size);
+        }
+    }
 }
 
 void common_hal_audioio_wavefile_deinit(audioio_wavefile_obj_t *self) {
     self->buffer = NULL;
     self->second_buffer = NULL;
+    self->ring = NULL;
+    self->ring_size = 0;
 }
 
 bool common_hal_audioio_wavefile_deinited(audioio_wavefile_obj_t *self) {
@@ -137,6 +170,98 @@ uint8_t common_hal_audioio_wavefile_get_channel_count(audioio_wavefile_obj_t *se
     return self->channel_count;
 }
 
+uint32_t common_hal_audioio_wavefile_get_underruns(audioio_wavefile_obj_t *self) {
+    return self->underruns;
+}
+
+uint32_t common_hal_audioio_wavefile_get_max_read_ms(audioio_wavefile_obj_t *self) {
+    return self->max_read_ms;
+}
+
+// Reads len bytes from the file, keeping track of the slowest read.
+static bool file_read(audioio_wavefile_obj_t *self, uint8_t *buffer, uint32_t len) {
+    mp_uint_t start = mp_hal_ticks_ms();
+    UINT length_read;
+    FRESULT result = f_read(&self->file->fp, buffer, len, &length_read);
+    uint32_t elapsed = mp_hal_ticks_ms() - start;
+    if (elapsed > self->max_read_ms) {
+        self->max_read_ms = elapsed;
+    }
+    return result == FR_OK && length_read == len;
+}
+
+// Reads from the file into the ring's free space, up to max_bytes. Unless whole_sectors is false,
+// reads that are limited by the free space wait until they can end on a sector boundary. Returns
+// false on a read error.
+static bool ring_fill(audioio_wavefile_obj_t *self, uint32_t max_bytes, bool whole_sectors) {
+    while (self->ring_file_remaining > 0 && max_bytes > 0) {
+        uint32_t space = self->ring_size - (self->ring_write_off - self->ring_read_off);
+        uint32_t index = self->ring_write_off % self->ring_size;
+        uint32_t n = MIN(MIN(space, self->ring_size - index), max_bytes);
+        if (n >= self->ring_file_remaining) {
+            n = self->ring_file_remaining;
+        } else if (whole_sectors) {
+            // End on a sector boundary. The ring's end is one so this only trims reads that
+            // are limited by space.
+            n -= (index + n) % SECTOR_SIZE;
+        }
+        if (n == 0) {
+            break;
+        }
+        if (!file_read(self, self->ring + index, n)) {
+            return false;
+        }
+        self->ring_write_off += n;
+        self->ring_file_remaining -= n;
+        max_bytes -= n;
+    }
+    return true;
+}
+
+static void ring_fill_cb(void *self_in) {
+    audioio_wavefile_obj_t *self = self_in;
+    if (common_hal_audioio_wavefile_deinited(self) || self->ring == NULL) {
+        return;
+    }
+    // A read error is found again, and reported, when the data is needed.
+    if (!ring_fill(self, MAX_BACKGROUND_READ, true)) {
+        return;
+    }
+    #if !defined(MICROPY_UNIX_COVERAGE)
+    uint32_t space = self->ring_size - (self->ring_write_off - self->ring_read_off);
+    if (self->ring_file_remaining > 0 && space >= SECTOR_SIZE) {
+        background_callback_add(&self->ring_fill_cb, ring_fill_cb, self);
+    }
+    #endif
+}
+
+// Loads the next len bytes of data, from the ring if there is one.
+static bool wavefile_read(audioio_wavefile_obj_t *self, uint8_t *buffer, uint32_t len) {
+    if (self->ring == NULL) {
+        return file_read(self, buffer, len);
+    }
+    uint32_t available = self->ring_write_off - self->ring_read_off;
+    if (available < len) {
+        // The background reads didn't keep up so read only what is missing now and leave the rest
+        // of the ring to them. Partial sectors are read if need be.
+        if (self->ring_primed) {
+            self->underruns++;
+        }
+        if (!ring_fill(self, len - available, false) || self->ring_write_off - self->ring_read_off < len) {
+            return false;
+        }
+    }
+    uint32_t index = self->ring_read_off % self->ring_size;
+    uint32_t first = MIN(len, self->ring_size - index);
+    memcpy(buffer, self->ring + index, first);
+    memcpy(buffer + first, self->ring, len - first);
+    self->ring_read_off += len;
+    self->ring_primed = true;
+
+    background_callback_add(&self->ring_fill_cb, ring_fill_cb, self);
+    return true;
+}
+
 void audioio_wavefile_reset_buffer(audioio_wavefile_obj_t *self,
     bool single_channel_output,
     uint8_t channel) {
@@ -145,11 +270,24 @@ void audioio_wavefile_reset_buffer(audioio_wavefile_obj_t *self,
     }
     // We don't reset the buffer index in case we're looping and we have an odd number of buffer
     // loads
+    // A pending read ahead mustn't run between the seek and the ring being emptied.
+    background_callback_prevent();
     self->bytes_remaining = self->file_length;
     f_lseek(&self->file->fp, self->data_start);
     self->read_count = 0;
     self->left_read_count = 0;
     self->right_read_count = 0;
+
+    if (self->ring != NULL) {
+        self->ring_read_off = self->ring_write_off = self->data_start % SECTOR_SIZE;
+        self->ring_file_remaining = self->file_length;
+        self->ring_primed = false;
+    }
+    background_callback_allow();
+
+    if (self->ring != NULL) {
+        background_callback_add(&self->ring_fill_cb, ring_fill_cb, self);
+    }
 }
 
 audioio_get_buffer_result_t audioio_wavefile_get_buffer(audioio_wavefile_obj_t *self,
@@ -179,13 +317,13 @@ audioio_get_buffer_result_t audioio_wavefile_get_buffer(audioio_wavefile_obj_t *
         if (num_bytes_to_load > self->bytes_remaining) {
             num_bytes_to_load = self->bytes_remaining;
         }
-        UINT length_read;
+        uint32_t length_read = num_bytes_to_load;
         if (self->buffer_index % 2 == 1) {
             *buffer = self->second_buffer;
         } else {
             *buffer = self->buffer;
         }
-        if (f_read(&self->file->fp, *buffer, num_bytes_to_load, &length_read) != FR_OK || length_read != num_bytes_to_load) {
+        if (!wavefile_read(self, *buffer, num_bytes_to_load)) {
             return GET_BUFFER_ERROR;
         }
         self->bytes_remaining -= length_read;
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "supervisor/background_callback.h"
 #include "extmod/vfs_fat.h"
 #include "py/obj.h"
 
@@ -32,6 +33,20 @@ typedef struct {
     uint32_t read_count;
     uint32_t left_read_count;
     uint32_t right_read_count;
+
+    // Optional read-ahead of the file, filled in the background. The offsets only increase and
+    // are taken modulo ring_size, a whole number of sectors. They start at the data's offset
+    // within its first sector so every read after the first covers whole sectors.
+    background_callback_t ring_fill_cb;
+    uint8_t *ring;
+    uint32_t ring_size; // 0 when reads go straight to the file
+    uint32_t ring_read_off;
+    uint32_t ring_write_off;
+    uint32_t ring_file_remaining; // Bytes of data not yet read into the ring
+    bool ring_primed; // A buffer was loaded since the last reset, so running dry is an underrun
+
+    uint32_t underruns;
+    uint32_t max_read_ms;
 } audioio_wavefile_obj_t;
 
 // These are not available from Python because it may be called in an interrupt.
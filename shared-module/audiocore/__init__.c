@@ -6,7 +6,10 @@
 
 #include "shared-module/audioio/__init__.h"
 
+#include <string.h>
+
 #include "py/obj.h"
+#include "py/runtime.h"
 #include "shared-bindings/audiocore/RawSample.h"
 #include "shared-bindings/audiocore/WaveFile.h"
 #include "shared-module/audiocore/RawSample.h"
@@ -51,6 +54,135 @@ void audiosample_get_buffer_structure(mp_obj_t sample_obj, bool single_channel_o
         samples_signed, max_buffer_length, spacing);
 }
 
+void audiosample_must_match(mp_obj_t sample, uint32_t sample_rate, uint8_t channel_count,
+    uint8_t bits_per_sample, bool samples_signed) {
+    if (audiosample_sample_rate(sample) != sample_rate) {
+        mp_raise_ValueError_varg(MP_ERROR_TEXT("The sample's %q does not match"), MP_QSTR_sample_rate);
+    }
+    if (audiosample_channel_count(sample) != channel_count) {
+        mp_raise_ValueError_varg(MP_ERROR_TEXT("The sample's %q does not match"), MP_QSTR_channel_count);
+    }
+    if (audiosample_bits_per_sample(sample) != bits_per_sample) {
+        mp_raise_ValueError_varg(MP_ERROR_TEXT("The sample's %q does not match"), MP_QSTR_bits_per_sample);
+    }
+    bool single_buffer;
+    bool sample_signed;
+    uint32_t max_buffer_length;
+    uint8_t spacing;
+    audiosample_get_buffer_structure(sample, false, &single_buffer, &sample_signed, &max_buffer_length, &spacing);
+    if (sample_signed != samples_signed) {
+        mp_raise_ValueError_varg(MP_ERROR_TEXT("The sample's %q does not match"), MP_QSTR_signedness);
+    }
+}
+
+void audiosample_input_play(audiosample_input_t *input, mp_obj_t sample, bool loop) {
+    uint8_t bits_per_sample = audiosample_bits_per_sample(sample);
+    if (bits_per_sample != 8 && bits_per_sample != 16) {
+        mp_raise_ValueError(MP_ERROR_TEXT("bits_per_sample must be 8 or 16"));
+    }
+    bool single_buffer;
+    bool samples_signed;
+    uint32_t max_buffer_length;
+    uint8_t spacing;
+    audiosample_get_buffer_structure(sample, false, &single_buffer, &samples_signed, &max_buffer_length, &spacing);
+
+    // Stop first so a background read doesn't see a mix of the old and new sample.
+    input->sample = NULL;
+    audiosample_reset_buffer(sample, false, 0);
+    const audiosample_p_t *proto = mp_proto_get_or_throw(MP_QSTR_protocol_audiosample, sample);
+    input->render = proto->render;
+    input->bits_per_sample = bits_per_sample;
+    input->samples_signed = samples_signed;
+    input->loop = loop;
+    input->more_data = true;
+    input->remaining_buffer = NULL;
+    input->remaining_length = 0;
+    input->sample = sample;
+}
+
+void audiosample_input_stop(audiosample_input_t *input) {
+    input->sample = NULL;
+}
+
+// Loads the next buffer from the sample. Returns false when there isn't one right now.
+static bool _input_load(audiosample_input_t *input) {
+    if (!input->more_data) {
+        if (!input->loop) {
+            input->sample = NULL;
+            return false;
+        }
+        audiosample_reset_buffer(input->sample, false, 0);
+    }
+    uint32_t length;
+    audioio_get_buffer_result_t result = audiosample_get_buffer(input->sample, false, 0, &input->remaining_buffer, &length);
+    if (result == GET_BUFFER_ERROR) {
+        input->sample = NULL;
+        return false;
+    }
+    input->remaining_length = length / (input->bits_per_sample / 8);
+    input->more_data = result == GET_BUFFER_MORE_DATA;
+    // An empty buffer that isn't the end means the sample has nothing ready yet.
+    return input->remaining_length > 0 || !input->more_data;
+}
+
+uint32_t audiosample_input_read(audiosample_input_t *input, int16_t *buffer, uint32_t length) {
+    if (input->render != NULL && input->sample != NULL) {
+        input->render(MP_OBJ_TO_PTR(input->sample), buffer, length);
+        return length;
+    }
+    uint32_t count = 0;
+    while (count < length && input->sample != NULL) {
+        if (input->remaining_length == 0) {
+            if (!_input_load(input)) {
+                break;
+            }
+            continue;
+        }
+        uint32_t n = MIN(input->remaining_length, length - count);
+        int16_t *out = buffer + count;
+        if (input->bits_per_sample == 16) {
+            const uint16_t *in = (const uint16_t *)input->remaining_buffer;
+            if (input->samples_signed) {
+                memcpy(out, in, n * sizeof(int16_t));
+            } else {
+                for (uint32_t i = 0; i < n; i++) {
+                    out[i] = in[i] ^ 0x8000;
+                }
+            }
+        } else {
+            const uint8_t *in = input->remaining_buffer;
+            uint8_t flip = input->samples_signed ? 0 : 0x80;
+            for (uint32_t i = 0; i < n; i++) {
+                out[i] = (int8_t)(in[i] ^ flip) << 8;
+            }
+        }
+        input->remaining_buffer += n * (input->bits_per_sample / 8);
+        input->remaining_length -= n;
+        count += n;
+    }
+    memset(buffer + count, 0, (length - count) * sizeof(int16_t));
+    return count;
+}
+
+void audiosample_output_block(uint8_t *output, uint32_t offset, const int16_t *rendered, uint32_t length,
+    uint8_t bits_per_sample, bool samples_signed) {
+    if (bits_per_sample == 16) {
+        // Already rendered in place.
+        if (!samples_signed) {
+            uint16_t *out = (uint16_t *)output + offset;
+            for (uint32_t i = 0; i < length; i++) {
+                out[i] ^= 0x8000;
+            }
+        }
+        return;
+    }
+    uint8_t *out = output + offset;
+    uint8_t flip = samples_signed ? 0 : 0x80;
+    for (uint32_t i = 0; i < length; i++) {
+        out[i] = ((uint16_t)rendered[i] >> 8) ^ flip;
+    }
+}
+
 void audiosample_convert_u8m_s16s(int16_t *buffer_out, const uint8_t *buffer_in, size_t nframes) {
     for (; nframes--;) {
         int16_t sample = (*buffer_in++ - 0x80) << 8;
@@ -30,6 +30,7 @@ typedef void (*audiosample_get_buffer_structure_fun)(mp_obj_t,
     bool single_channel_output, bool *single_buffer,
     bool *samples_signed, uint32_t *max_buffer_length,
     uint8_t *spacing);
+typedef void (*audiosample_render_fun)(mp_obj_t, int16_t *block, uint32_t length);
 
 typedef struct _audiosample_p_t {
     MP_PROTOCOL_HEAD // MP_QSTR_protocol_audiosample
@@ -39,6 +40,9 @@ typedef struct _audiosample_p_t {
     audiosample_reset_buffer_fun reset_buffer;
     audiosample_get_buffer_fun get_buffer;
     audiosample_get_buffer_structure_fun get_buffer_structure;
+    // Optional. Renders the next length signed 16-bit samples into block, which the caller
+    // processes further in place.
+    audiosample_render_fun render;
 } audiosample_p_t;
 
 uint32_t audiosample_sample_rate(mp_obj_t sample_obj);
@@ -53,6 +57,53 @@ void audiosample_get_buffer_structure(mp_obj_t sample_obj, bool single_channel_o
     bool *single_buffer, bool *samples_signed,
     uint32_t *max_buffer_length, uint8_t *spacing);
 
+// Effects pull from their source through an audiosample_input_t and render signed 16-bit
+// samples, the one format they process, a block at a time. 16-bit output is rendered in place in
+// the output buffer. 8-bit output is rendered into a block on the stack and converted into the
+// output buffer so the buffer is no bigger than the output.
+//
+// When the source is itself an effect, it renders straight into the block through its render
+// function instead of its get_buffer. A chain of effects is then pulled a block at a time, with
+// every stage working in place on the one block, and only converted to the output format by the
+// last.
+
+// Effects render blocks of this many samples.
+#define AUDIOSAMPLE_BLOCK_SAMPLES (128)
+
+typedef struct {
+    mp_obj_t sample; // NULL when not playing.
+    audiosample_render_fun render; // The sample's render function, if it has one.
+    uint8_t *remaining_buffer;
+    uint32_t remaining_length; // in samples
+    uint8_t bits_per_sample;
+    bool samples_signed;
+    bool loop;
+    bool more_data;
+} audiosample_input_t;
+
+// Raises ValueError unless sample has the given format.
+void audiosample_must_match(mp_obj_t sample, uint32_t sample_rate, uint8_t channel_count,
+    uint8_t bits_per_sample, bool samples_signed);
+
+// Starts reading sample, which may be 8 or 16-bit and signed or unsigned.
+void audiosample_input_play(audiosample_input_t *input, mp_obj_t sample, bool loop);
+void audiosample_input_stop(audiosample_input_t *input);
+static inline bool audiosample_input_playing(const audiosample_input_t *input) {
+    return input->sample != NULL;
+}
+// Fills buffer with length signed 16-bit samples from the input, loading more from the sample
+// as needed. Returns how many were read. The rest of buffer is zeroed when there were fewer.
+uint32_t audiosample_input_read(audiosample_input_t *input, int16_t *buffer, uint32_t length);
+
+// Where to render the block of samples at offset in output. block must hold
+// AUDIOSAMPLE_BLOCK_SAMPLES.
+static inline int16_t *audiosample_render_block(uint8_t *output, uint32_t offset, uint8_t bits_per_sample, int16_t *block) {
+    return bits_per_sample == 16 ? (int16_t *)output + offset : block;
+}
+// Converts length samples rendered by audiosample_render_block to the output format.
+void audiosample_output_block(uint8_t *output, uint32_t offset, const int16_t *rendered, uint32_t length,
+    uint8_t bits_per_sample, bool samples_signed);
+
 void audiosample_convert_u8m_s16s(int16_t *buffer_out, const uint8_t *buffer_in, size_t nframes);
 void audiosample_convert_u8s_s16s(int16_t *buffer_out, const uint8_t *buffer_in, size_t nframes);
 void audiosample_convert_s8m_s16s(int16_t *buffer_out, const int8_t *buffer_in, size_t nframes);
@@ -29,11 +29,6 @@ typedef struct {
     uint8_t last_buf_idx;
     uint32_t buffer_len; // max buffer in bytes
 
-    uint8_t *sample_remaining_buffer;
-    uint32_t sample_buffer_length;
-
-    bool loop;
-    bool more_data;
     bool freq_shift; // does the echo shift frequencies if delay changes
 
     int8_t *echo_buffer;
@@ -47,7 +42,7 @@ typedef struct {
     uint32_t echo_buffer_left_pos; // words << 8
     uint32_t echo_buffer_right_pos; // words << 8
 
-    mp_obj_t sample;
+    audiosample_input_t input;
 } audiodelays_echo_obj_t;
 
 void recalculate_delay(audiodelays_echo_obj_t *self, mp_float_t f_delay_ms);
@@ -62,6 +57,8 @@ audioio_get_buffer_result_t audiodelays_echo_get_buffer(audiodelays_echo_obj_t *
     uint8_t **buffer,
     uint32_t *buffer_length);  // length in bytes
 
+void audiodelays_echo_render(audiodelays_echo_obj_t *self, int16_t *block, uint32_t length);
+
 void audiodelays_echo_get_buffer_structure(audiodelays_echo_obj_t *self, bool single_channel_output,
     bool *single_buffer, bool *samples_signed,
     uint32_t *max_buffer_length, uint8_t *spacing);
@@ -51,12 +51,8 @@ void common_hal_audiofilters_filter_construct(audiofilters_filter_obj_t *self,
     }
     memset(self->filter_buffer, 0, SYNTHIO_MAX_DUR * sizeof(int32_t));
 
-    // Initialize other values most effects will need.
-    self->sample = NULL; // The current playing sample
-    self->sample_remaining_buffer = NULL; // Pointer to the start of the sample buffer we have not played
-    self->sample_buffer_length = 0; // How many samples do we have left to play (these may be 16 bit!)
-    self->loop = false; // When the sample is done do we loop to the start again or stop (e.g. in a wav file)
-    self->more_data = false; // Is there still more data to read from the sample or did we finish
+    // Nothing is playing yet
+    audiosample_input_stop(&self->input);
 
     // The below section sets up the effect's starting values.
 
@@ -68,7 +64,7 @@ void common_hal_audiofilters_filter_construct(audiofilters_filter_obj_t *self,
 
     // If we did not receive a BlockInput we need to create a default float value
     if (mix == MP_OBJ_NULL) {
-        mix = mp_obj_new_float(1.0);
+        mix = mp_obj_new_float(MICROPY_FLOAT_CONST(1.0));
     }
     synthio_block_assign_slot(mix, &self->mix, MP_QSTR_mix);
 }
@@ -130,50 +126,18 @@ void audiofilters_filter_reset_buffer(audiofilters_filter_obj_t *self,
 }
 
 bool common_hal_audiofilters_filter_get_playing(audiofilters_filter_obj_t *self) {
-    return self->sample != NULL;
+    return audiosample_input_playing(&self->input);
 }
 
 void common_hal_audiofilters_filter_play(audiofilters_filter_obj_t *self, mp_obj_t sample, bool loop) {
     // When a sample is to be played we must ensure the samples values matches what we expect
-    // Then we reset the sample and get the first buffer to play
-    // The get_buffer function will actually process that data
-
-    if (audiosample_sample_rate(sample) != self->sample_rate) {
-        mp_raise_ValueError_varg(MP_ERROR_TEXT("The sample's %q does not match"), MP_QSTR_sample_rate);
-    }
-    if (audiosample_channel_count(sample) != self->channel_count) {
-        mp_raise_ValueError_varg(MP_ERROR_TEXT("The sample's %q does not match"), MP_QSTR_channel_count);
-    }
-    if (audiosample_bits_per_sample(sample) != self->bits_per_sample) {
-        mp_raise_ValueError_varg(MP_ERROR_TEXT("The sample's %q does not match"), MP_QSTR_bits_per_sample);
-    }
-    bool single_buffer;
-    bool samples_signed;
-    uint32_t max_buffer_length;
-    uint8_t spacing;
-    audiosample_get_buffer_structure(sample, false, &single_buffer, &samples_signed, &max_buffer_length, &spacing);
-    if (samples_signed != self->samples_signed) {
-        mp_raise_ValueError_varg(MP_ERROR_TEXT("The sample's %q does not match"), MP_QSTR_signedness);
-    }
-
-    self->sample = sample;
-    self->loop = loop;
-
-    audiosample_reset_buffer(self->sample, false, 0);
-    audioio_get_buffer_result_t result = audiosample_get_buffer(self->sample, false, 0, (uint8_t **)&self->sample_remaining_buffer, &self->sample_buffer_length);
-
-    // Track remaining sample length in terms of bytes per sample
-    self->sample_buffer_length /= (self->bits_per_sample / 8);
-    // Store if we have more data in the sample to retrieve
-    self->more_data = result == GET_BUFFER_MORE_DATA;
-
-    return;
+    audiosample_must_match(sample, self->sample_rate, self->channel_count, self->bits_per_sample, self->samples_signed);
+    audiosample_input_play(&self->input, sample, loop);
 }
 
 void common_hal_audiofilters_filter_stop(audiofilters_filter_obj_t *self) {
     // When the sample is set to stop playing do any cleanup here
-    self->sample = NULL;
-    return;
+    audiosample_input_stop(&self->input);
 }
 
 #define RANGE_LOW_16 (-28000)
@@ -202,109 +166,52 @@ int16_t mix_down_sample(int32_t sample) {
     return sample;
 }
 
-audioio_get_buffer_result_t audiofilters_filter_get_buffer(audiofilters_filter_obj_t *self, bool single_channel_output, uint8_t channel,
-    uint8_t **buffer, uint32_t *buffer_length) {
+void audiofilters_filter_render(audiofilters_filter_obj_t *self, int16_t *block, uint32_t length) {
+    // get the effect values we need from the BlockInput. These may change at run time so you need to do bounds checking if required
+    mp_float_t mix = MIN(MICROPY_FLOAT_CONST(1.0), MAX(synthio_block_slot_get(&self->mix), MICROPY_FLOAT_CONST(0.0)));
+
+    audiosample_input_read(&self->input, block, length);
 
-    if (!single_channel_output) {
-        channel = 0;
+    // if mix is zero pure sample only or no biquad filter object is provided
+    if (mix <= MICROPY_FLOAT_CONST(0.01) || self->filter_obj == mp_const_none) {
+        return;
     }
+    for (uint32_t offset = 0; offset < length; offset += AUDIOSAMPLE_BLOCK_SAMPLES) {
+        int16_t *word_buffer = block + offset;
+        uint32_t n_samples = MIN(AUDIOSAMPLE_BLOCK_SAMPLES, length - offset);
 
-    // get the effect values we need from the BlockInput. These may change at run time so you need to do bounds checking if required
-    mp_float_t mix = MIN(1.0, MAX(synthio_block_slot_get(&self->mix), 0.0));
+        // Fill filter buffer with samples. A block is never more than SYNTHIO_MAX_DUR.
+        for (uint32_t j = 0; j < n_samples; j++) {
+            self->filter_buffer[j] = word_buffer[j];
+        }
+
+        // Process biquad filter
+        synthio_biquad_filter_samples(&self->filter_state, self->filter_buffer, n_samples);
+
+        // Mix processed signal with original sample back into the buffer
+        for (uint32_t j = 0; j < n_samples; j++) {
+            word_buffer[j] = mix_down_sample((int32_t)((word_buffer[j] * (MICROPY_FLOAT_CONST(1.0) - mix)) + (self->filter_buffer[j] * mix)));
+        }
+    }
+}
+
+audioio_get_buffer_result_t audiofilters_filter_get_buffer(audiofilters_filter_obj_t *self, bool single_channel_output, uint8_t channel,
+    uint8_t **buffer, uint32_t *buffer_length) {
 
     // Switch our buffers to the other buffer
     self->last_buf_idx = !self->last_buf_idx;
 
-    // If we are using 16 bit samples we need a 16 bit pointer, 8 bit needs an 8 bit pointer
-    int16_t *word_buffer = (int16_t *)self->buffer[self->last_buf_idx];
-    int8_t *hword_buffer = self->buffer[self->last_buf_idx];
+    // The sample is read as 16-bit and filtered a block at a time. Each block is converted to our
+    // output format as it is finished.
+    uint8_t *output = (uint8_t *)self->buffer[self->last_buf_idx];
     uint32_t length = self->buffer_len / (self->bits_per_sample / 8);
 
-    // Loop over the entire length of our buffer to fill it, this may require several calls to get data from the sample
-    while (length != 0) {
-        // Check if there is no more sample to play, we will either load more data, reset the sample if loop is on or clear the sample
-        if (self->sample_buffer_length == 0) {
-            if (!self->more_data) { // The sample has indicated it has no more data to play
-                if (self->loop && self->sample) { // If we are supposed to loop reset the sample to the start
-                    audiosample_reset_buffer(self->sample, false, 0);
-                } else { // If we were not supposed to loop the sample, stop playing it
-                    self->sample = NULL;
-                }
-            }
-            if (self->sample) {
-                // Load another sample buffer to play
-                audioio_get_buffer_result_t result = audiosample_get_buffer(self->sample, false, 0, (uint8_t **)&self->sample_remaining_buffer, &self->sample_buffer_length);
-                // Track length in terms of words.
-                self->sample_buffer_length /= (self->bits_per_sample / 8);
-                self->more_data = result == GET_BUFFER_MORE_DATA;
-            }
-        }
-
-        // If we have a sample, filter it
-        if (self->sample != NULL) {
-            // Determine how many bytes we can process to our buffer, the less of the sample we have left and our buffer remaining
-            uint32_t n = MIN(self->sample_buffer_length, length);
-
-            int16_t *sample_src = (int16_t *)self->sample_remaining_buffer; // for 16-bit samples
-            int8_t *sample_hsrc = (int8_t *)self->sample_remaining_buffer; // for 8-bit samples
-
-            if (mix <= 0.01 || self->filter_obj == mp_const_none) { // if mix is zero pure sample only or no biquad filter object is provided
-                for (uint32_t i = 0; i < n; i++) {
-                    if (MP_LIKELY(self->bits_per_sample == 16)) {
-                        word_buffer[i] = sample_src[i];
-                    } else {
-                        hword_buffer[i] = sample_hsrc[i];
-                    }
-                }
-            } else {
-                uint32_t i = 0;
-                while (i < n) {
-                    uint32_t n_samples = MIN(SYNTHIO_MAX_DUR, n - i);
-
-                    // Fill filter buffer with samples
-                    for (uint32_t j = 0; j < n_samples; j++) {
-                        if (MP_LIKELY(self->bits_per_sample == 16)) {
-                            self->filter_buffer[j] = sample_src[i + j];
-                        } else {
-                            if (self->samples_signed) {
-                                self->filter_buffer[j] = sample_hsrc[i + j];
-                            } else {
-                                // Be careful here changing from an 8 bit unsigned to signed into a 32-bit signed
-                                self->filter_buffer[j] = (int8_t)(((uint8_t)sample_hsrc[i + j]) ^ 0x80);
-                            }
-                        }
-                    }
-
-                    // Process biquad filter
-                    synthio_biquad_filter_samples(&self->filter_state, self->filter_buffer, n_samples);
-
-                    // Mix processed signal with original sample and transfer to output buffer
-                    for (uint32_t j = 0; j < n_samples; j++) {
-                        if (MP_LIKELY(self->bits_per_sample == 16)) {
-                            word_buffer[i + j] = mix_down_sample((sample_src[i + j] * (1.0 - mix)) + (self->filter_buffer[j] * mix));
-                            if (!self->samples_signed) {
-                                word_buffer[i + j] ^= 0x8000;
-                            }
-                        } else {
-                            if (self->samples_signed) {
-                                hword_buffer[i + j] = (int8_t)((sample_hsrc[i + j] * (1.0 - mix)) + (self->filter_buffer[j] * mix));
-                            } else {
-                                hword_buffer[i + j] = (uint8_t)(((int8_t)(((uint8_t)sample_hsrc[i + j]) ^ 0x80) * (1.0 - mix)) + (self->filter_buffer[j] * mix)) ^ 0x80;
-                            }
-                        }
-                    }
-
-                    i += n_samples;
-                }
-            }
-
-            // Update the remaining length and the buffer positions based on how much we wrote into our buffer
-            length -= n;
-            word_buffer += n;
-            hword_buffer += n;
-            self->sample_remaining_buffer += (n * (self->bits_per_sample / 8));
-            self->sample_buffer_length -= n;
-        }
+    int16_t block[AUDIOSAMPLE_BLOCK_SAMPLES];
+    for (uint32_t offset = 0; offset < length; offset += AUDIOSAMPLE_BLOCK_SAMPLES) {
+        uint32_t n_samples = MIN(AUDIOSAMPLE_BLOCK_SAMPLES, length - offset);
+        int16_t *word_buffer = audiosample_render_block(output, offset, self->bits_per_sample, block);
+        audiofilters_filter_render(self, word_buffer, n_samples);
+        audiosample_output_block(output, offset, word_buffer, n_samples, self->bits_per_sample, self->samples_signed);
     }
 
     // Finally pass our buffer and length to the calling audio function
@@ -29,15 +29,9 @@ typedef struct {
     uint8_t last_buf_idx;
     uint32_t buffer_len; // max buffer in bytes
 
-    uint8_t *sample_remaining_buffer;
-    uint32_t sample_buffer_length;
-
     int32_t *filter_buffer;
 
-    bool loop;
-    bool more_data;
-
-    mp_obj_t sample;
+    audiosample_input_t input;
 } audiofilters_filter_obj_t;
 
 void audiofilters_filter_reset_buffer(audiofilters_filter_obj_t *self,
@@ -50,6 +44,8 @@ audioio_get_buffer_result_t audiofilters_filter_get_buffer(audiofilters_filter_o
     uint8_t **buffer,
     uint32_t *buffer_length);  // length in bytes
 
+void audiofilters_filter_render(audiofilters_filter_obj_t *self, int16_t *block, uint32_t length);
+
 void audiofilters_filter_get_buffer_structure(audiofilters_filter_obj_t *self, bool single_channel_output,
     bool *single_buffer, bool *samples_signed,
     uint32_t *max_buffer_length, uint8_t *spacing);
@@ -8,6 +8,7 @@
 #include "shared-bindings/audiomixer/MixerVoice.h"
 
 #include <stdint.h>
+#include <string.h>
 
 #include "py/runtime.h"
 #include "shared-module/audiocore/__init__.h"
@@ -134,129 +135,46 @@ static inline uint32_t mult16signed(uint32_t val, int32_t mul) {
     #endif
 }
 
-static inline uint32_t tounsigned8(uint32_t val) {
-    #if (defined(__ARM_ARCH_7EM__) && (__ARM_ARCH_7EM__ == 1))
-    return __UADD8(val, 0x80808080);
-    #else
-    return val ^ 0x80808080;
-    #endif
-}
-
-static inline uint32_t tounsigned16(uint32_t val) {
-    #if (defined(__ARM_ARCH_7EM__) && (__ARM_ARCH_7EM__ == 1))
-    return __UADD16(val, 0x80008000);
-    #else
-    return val ^ 0x80008000;
-    #endif
-}
-
-static inline uint32_t tosigned16(uint32_t val) {
-    #if (defined(__ARM_ARCH_7EM__) && (__ARM_ARCH_7EM__ == 1))
-    return __UADD16(val, 0x80008000);
-    #else
-    return val ^ 0x80008000;
-    #endif
-}
-
-static inline uint32_t unpack8(uint16_t val) {
-    return ((val & 0xff00) << 16) | ((val & 0x00ff) << 8);
-}
-
-static inline uint32_t pack8(uint32_t val) {
-    return ((val & 0xff000000) >> 16) | ((val & 0xff00) >> 8);
-}
-
-static void mix_down_one_voice(audiomixer_mixer_obj_t *self,
-    audiomixer_mixervoice_obj_t *voice, bool voices_active,
-    uint32_t *word_buffer, uint32_t length) {
-    while (length != 0) {
-        if (voice->buffer_length == 0) {
-            if (!voice->more_data) {
-                if (voice->loop) {
-                    audiosample_reset_buffer(voice->sample, false, 0);
-                } else {
-                    voice->sample = NULL;
-                    break;
-                }
-            }
-            if (voice->sample) {
-                // Load another buffer
-                audioio_get_buffer_result_t result = audiosample_get_buffer(voice->sample, false, 0, (uint8_t **)&voice->remaining_buffer, &voice->buffer_length);
-                // Track length in terms of words.
-                voice->buffer_length /= sizeof(uint32_t);
-                voice->more_data = result == GET_BUFFER_MORE_DATA;
-            }
-        }
-
-        uint32_t n = MIN(voice->buffer_length, length);
-        uint32_t *src = voice->remaining_buffer;
-        uint16_t level = voice->level;
-
-        // First active voice gets copied over verbatim.
-        if (!voices_active) {
-            if (MP_LIKELY(self->bits_per_sample == 16)) {
-                if (MP_LIKELY(self->samples_signed)) {
-                    for (uint32_t i = 0; i < n; i++) {
-                        uint32_t v = src[i];
-                        word_buffer[i] = mult16signed(v, level);
-                    }
-                } else {
-                    for (uint32_t i = 0; i < n; i++) {
-                        uint32_t v = src[i];
-                        v = tosigned16(v);
-                        word_buffer[i] = mult16signed(v, level);
-                    }
-                }
-            } else {
-                uint16_t *hword_buffer = (uint16_t *)word_buffer;
-                uint16_t *hsrc = (uint16_t *)src;
-                for (uint32_t i = 0; i < n * 2; i++) {
-                    uint32_t word = unpack8(hsrc[i]);
-                    if (MP_LIKELY(!self->samples_signed)) {
-                        word = tosigned16(word);
-                    }
-                    word = mult16signed(word, level);
-                    hword_buffer[i] = pack8(word);
-                }
+void audiomixer_mixer_render(audiomixer_mixer_obj_t *self, int16_t *block, uint32_t length) {
+    uint32_t voice_block[AUDIOSAMPLE_BLOCK_SAMPLES / 2];
+    for (uint32_t offset = 0; offset < length; offset += AUDIOSAMPLE_BLOCK_SAMPLES) {
+        uint32_t n = MIN(AUDIOSAMPLE_BLOCK_SAMPLES, length - offset);
+        uint32_t *word_buffer = (uint32_t *)(block + offset);
+        bool voices_active = false;
+        for (int32_t v = 0; v < self->voice_count; v++) {
+            audiomixer_mixervoice_obj_t *voice = MP_OBJ_TO_PTR(self->voice[v]);
+            if (!audiosample_input_playing(&voice->input)) {
+                continue;
             }
-        } else {
-            if (MP_LIKELY(self->bits_per_sample == 16)) {
-                if (MP_LIKELY(self->samples_signed)) {
-                    for (uint32_t i = 0; i < n; i++) {
-                        uint32_t word = src[i];
-                        word_buffer[i] = add16signed(mult16signed(word, level), word_buffer[i]);
-                    }
-                } else {
-                    for (uint32_t i = 0; i < n; i++) {
-                        uint32_t word = src[i];
-                        word = tosigned16(word);
-                        word_buffer[i] = add16signed(mult16signed(word, level), word_buffer[i]);
-                    }
+            uint16_t level = voice->level;
+            if (!voices_active) {
+                // The first active voice is read straight into the output.
+                audiosample_input_read(&voice->input, (int16_t *)word_buffer, n);
+                for (uint32_t i = 0; i < n / 2; i++) {
+                    word_buffer[i] = mult16signed(word_buffer[i], level);
                 }
             } else {
-                uint16_t *hword_buffer = (uint16_t *)word_buffer;
-                uint16_t *hsrc = (uint16_t *)src;
-                for (uint32_t i = 0; i < n * 2; i++) {
-                    uint32_t word = unpack8(hsrc[i]);
-                    if (MP_LIKELY(!self->samples_signed)) {
-                        word = tosigned16(word);
-                    }
-                    word = mult16signed(word, level);
-                    word = add16signed(word, unpack8(hword_buffer[i]));
-                    hword_buffer[i] = pack8(word);
+                audiosample_input_read(&voice->input, (int16_t *)voice_block, n);
+                for (uint32_t i = 0; i < n / 2; i++) {
+                    word_buffer[i] = add16signed(mult16signed(voice_block[i], level), word_buffer[i]);
                 }
             }
+            voices_active = true;
+        }
+        if (!voices_active) {
+            memset(word_buffer, 0, n * sizeof(int16_t));
         }
-        length -= n;
-        word_buffer += n;
-        voice->remaining_buffer += n;
-        voice->buffer_length -= n;
     }
+}
 
-    if (length && !voices_active) {
-        for (uint32_t i = 0; i < length; i++) {
-            word_buffer[i] = 0;
-        }
+// Mixes every playing voice into length samples of output a block at a time.
+static void mix_down(audiomixer_mixer_obj_t *self, uint8_t *output, uint32_t length) {
+    int16_t block[AUDIOSAMPLE_BLOCK_SAMPLES];
+    for (uint32_t offset = 0; offset < length; offset += AUDIOSAMPLE_BLOCK_SAMPLES) {
+        uint32_t n = MIN(AUDIOSAMPLE_BLOCK_SAMPLES, length - offset);
+        int16_t *word_buffer = audiosample_render_block(output, offset, self->bits_per_sample, block);
+        audiomixer_mixer_render(self, word_buffer, n);
+        audiosample_output_block(output, offset, word_buffer, n, self->bits_per_sample, self->samples_signed);
     }
 }
 
@@ -286,34 +204,8 @@ audioio_get_buffer_result_t audiomixer_mixer_get_buffer(audiomixer_mixer_obj_t *
             word_buffer = self->second_buffer;
         }
         self->use_first_buffer = !self->use_first_buffer;
-        bool voices_active = false;
-        uint32_t length = self->len / sizeof(uint32_t);
-
-        for (int32_t v = 0; v < self->voice_count; v++) {
-            audiomixer_mixervoice_obj_t *voice = MP_OBJ_TO_PTR(self->voice[v]);
-            if (voice->sample) {
-                mix_down_one_voice(self, voice, voices_active, word_buffer, length);
-                voices_active = true;
-            }
-        }
-
-        if (!voices_active) {
-            for (uint32_t i = 0; i < length; i++) {
-                word_buffer[i] = 0;
-            }
-        }
-
-        if (!self->samples_signed) {
-            if (self->bits_per_sample == 16) {
-                for (uint32_t i = 0; i < length; i++) {
-                    word_buffer[i] = tounsigned16(word_buffer[i]);
-                }
-            } else {
-                for (uint32_t i = 0; i < length; i++) {
-                    word_buffer[i] = tounsigned8(word_buffer[i]);
-                }
-            }
-        }
+        uint32_t length = self->len / (self->bits_per_sample / 8);
+        mix_down(self, (uint8_t *)word_buffer, length);
 
         self->read_count += 1;
     } else if (!self->use_first_buffer) {
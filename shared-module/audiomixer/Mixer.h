@@ -41,6 +41,7 @@ audioio_get_buffer_result_t audiomixer_mixer_get_buffer(audiomixer_mixer_obj_t *
     uint8_t channel,
     uint8_t **buffer,
     uint32_t *buffer_length);                                                      // length in bytes
+void audiomixer_mixer_render(audiomixer_mixer_obj_t *self, int16_t *block, uint32_t length);
 void audiomixer_mixer_get_buffer_structure(audiomixer_mixer_obj_t *self, bool single_channel_output,
     bool *single_buffer, bool *samples_signed,
     uint32_t *max_buffer_length, uint8_t *spacing);
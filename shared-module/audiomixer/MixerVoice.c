@@ -11,10 +11,9 @@
 
 #include "py/runtime.h"
 #include "shared-module/audiomixer/__init__.h"
-#include "shared-module/audiocore/RawSample.h"
 
 void common_hal_audiomixer_mixervoice_construct(audiomixer_mixervoice_obj_t *self) {
-    self->sample = NULL;
+    audiosample_input_stop(&self->input);
     self->level = 1 << 15;
 }
 
@@ -31,38 +30,15 @@ void common_hal_audiomixer_mixervoice_set_level(audiomixer_mixervoice_obj_t *sel
 }
 
 void common_hal_audiomixer_mixervoice_play(audiomixer_mixervoice_obj_t *self, mp_obj_t sample, bool loop) {
-    if (audiosample_sample_rate(sample) != self->parent->sample_rate) {
-        mp_raise_ValueError_varg(MP_ERROR_TEXT("The sample's %q does not match"), MP_QSTR_sample_rate);
-    }
-    if (audiosample_channel_count(sample) != self->parent->channel_count) {
-        mp_raise_ValueError_varg(MP_ERROR_TEXT("The sample's %q does not match"), MP_QSTR_channel_count);
-    }
-    if (audiosample_bits_per_sample(sample) != self->parent->bits_per_sample) {
-        mp_raise_ValueError_varg(MP_ERROR_TEXT("The sample's %q does not match"), MP_QSTR_bits_per_sample);
-    }
-    bool single_buffer;
-    bool samples_signed;
-    uint32_t max_buffer_length;
-    uint8_t spacing;
-    audiosample_get_buffer_structure(sample, false, &single_buffer, &samples_signed,
-        &max_buffer_length, &spacing);
-    if (samples_signed != self->parent->samples_signed) {
-        mp_raise_ValueError_varg(MP_ERROR_TEXT("The sample's %q does not match"), MP_QSTR_signedness);
-    }
-    self->sample = sample;
-    self->loop = loop;
-
-    audiosample_reset_buffer(sample, false, 0);
-    audioio_get_buffer_result_t result = audiosample_get_buffer(sample, false, 0, (uint8_t **)&self->remaining_buffer, &self->buffer_length);
-    // Track length in terms of words.
-    self->buffer_length /= sizeof(uint32_t);
-    self->more_data = result == GET_BUFFER_MORE_DATA;
+    audiosample_must_match(sample, self->parent->sample_rate, self->parent->channel_count,
+        self->parent->bits_per_sample, self->parent->samples_signed);
+    audiosample_input_play(&self->input, sample, loop);
 }
 
 bool common_hal_audiomixer_mixervoice_get_playing(audiomixer_mixervoice_obj_t *self) {
-    return self->sample != NULL;
+    return audiosample_input_playing(&self->input);
 }
 
 void common_hal_audiomixer_mixervoice_stop(audiomixer_mixervoice_obj_t *self) {
-    self->sample = NULL;
+    audiosample_input_stop(&self->input);
 }
@@ -20,6 +20,8 @@
 #include "shared-bindings/time/__init__.h"
 #include "shared-module/displayio/__init__.h"
 #include "shared-module/displayio/display_core.h"
+#include "shared-module/displayio/mipi_constants.h"
+#include "supervisor/port_heap.h"
 #include "supervisor/shared/display.h"
 #include "supervisor/shared/tick.h"
 
@@ -32,6 +34,44 @@
 
 #define DELAY 0x80
 
+// Roughly what the bus could send in the time it takes to start sending a new area.
+#define REFRESH_AREA_OVERHEAD_BYTES (256)
+
+// Size of the buffer on the stack that is refreshed from when the refresh buffers couldn't be
+// allocated. The mask needs one more word at most.
+#define FALLBACK_BUFFER_WORDS (64)
+
+// The fewest rows _refresh_area sends at once. Page addressing and pixels packed by column send 8
+// rows at a time.
+static uint16_t _min_rows(busdisplay_busdisplay_obj_t *self) {
+    if (self->bus.SH1107_addressing ||
+        (self->core.colorspace.depth < 8 && !self->core.colorspace.pixels_in_byte_share_row)) {
+        return 8;
+    }
+    return 1;
+}
+
+// Replaces the refresh buffers. The old ones are kept if the new ones can't be allocated.
+static bool _allocate_refresh_buffer(busdisplay_busdisplay_obj_t *self, uint16_t size_bytes, bool double_buffer) {
+    uint16_t buffer_size = size_bytes / sizeof(uint32_t);
+    uint8_t pixels_per_word = (sizeof(uint32_t) * 8) / self->core.colorspace.depth;
+    // A buffer must hold the fewest rows sent at once in either rotation.
+    uint32_t min_pixels = MAX(self->core.width, self->core.height) * _min_rows(self);
+    buffer_size = MAX(buffer_size, (min_pixels + pixels_per_word - 1) / pixels_per_word);
+    uint32_t mask_size = buffer_size * pixels_per_word / 32 + 1;
+    uint8_t buffer_count = double_buffer ? 2 : 1;
+    uint32_t *buffer = port_malloc((buffer_count * buffer_size + mask_size) * sizeof(uint32_t), true);
+    if (buffer == NULL) {
+        return false;
+    }
+    port_free(self->refresh_buffer);
+    self->refresh_buffer = buffer;
+    self->refresh_mask = buffer + buffer_count * buffer_size;
+    self->refresh_buffer_size = buffer_size;
+    self->double_buffer = double_buffer;
+    return true;
+}
+
 void common_hal_busdisplay_busdisplay_construct(busdisplay_busdisplay_obj_t *self,
     mp_obj_t bus, uint16_t width, uint16_t height, int16_t colstart, int16_t rowstart,
     uint16_t rotation, uint16_t color_depth, bool grayscale, bool pixels_in_byte_share_row,
@@ -64,6 +104,23 @@ void common_hal_busdisplay_busdisplay_construct(busdisplay_busdisplay_obj_t *sel
     self->native_frames_per_second = native_frames_per_second;
     self->native_ms_per_frame = 1000 / native_frames_per_second;
 
+    // The default may fail to allocate when constructed by the board. It is tried again when
+    // refreshing.
+    self->refresh_buffer = NULL;
+    self->refresh_buffer_size = 512 / sizeof(uint32_t);
+    self->double_buffer = false;
+    _allocate_refresh_buffer(self, 512, false);
+    self->max_refresh_areas = DISPLAYIO_MAX_REFRESH_AREAS;
+    self->last_refresh_areas = 0;
+    self->last_refresh_pixels = 0;
+    self->last_refresh_us = 0;
+    self->scroll_ram_height = 0;
+    self->scroll_top = 0;
+    self->scroll_bottom = 0;
+    self->scroll_offset = 0;
+    self->scroll_group_x = 0;
+    self->scroll_group_y = 0;
+
     uint32_t i = 0;
     while (i < init_sequence_len) {
         uint8_t *cmd = init_sequence + i;
@@ -128,6 +185,30 @@ void common_hal_busdisplay_busdisplay_construct(busdisplay_busdisplay_obj_t *sel
     common_hal_busdisplay_busdisplay_set_auto_refresh(self, auto_refresh);
 }
 
+void common_hal_busdisplay_busdisplay_set_refresh_buffer(busdisplay_busdisplay_obj_t *self, uint16_t size_bytes, bool double_buffer) {
+    if (!_allocate_refresh_buffer(self, size_bytes, double_buffer)) {
+        m_malloc_fail(size_bytes * (double_buffer ? 2 : 1));
+    }
+}
+
+void common_hal_busdisplay_busdisplay_set_scroll_ram_height(busdisplay_busdisplay_obj_t *self, uint16_t ram_height) {
+    self->scroll_ram_height = ram_height;
+}
+
+uint8_t common_hal_busdisplay_busdisplay_get_max_refresh_areas(busdisplay_busdisplay_obj_t *self) {
+    return self->max_refresh_areas;
+}
+
+void common_hal_busdisplay_busdisplay_set_max_refresh_areas(busdisplay_busdisplay_obj_t *self, uint8_t max_refresh_areas) {
+    self->max_refresh_areas = max_refresh_areas;
+}
+
+void common_hal_busdisplay_busdisplay_get_refresh_stats(busdisplay_busdisplay_obj_t *self, uint8_t *areas, uint32_t *pixels, uint32_t *us) {
+    *areas = self->last_refresh_areas;
+    *pixels = self->last_refresh_pixels;
+    *us = self->last_refresh_us;
+}
+
 uint16_t common_hal_busdisplay_busdisplay_get_width(busdisplay_busdisplay_obj_t *self) {
     return displayio_display_core_get_width(&self->core);
 }
@@ -206,23 +287,44 @@ static const displayio_area_t *_get_refresh_areas(busdisplay_busdisplay_obj_t *s
     return NULL;
 }
 
-static void _send_pixels(busdisplay_busdisplay_obj_t *self, uint8_t *pixels, uint32_t length) {
+static void _send_pixels(busdisplay_busdisplay_obj_t *self, uint8_t *pixels, uint32_t length, display_bus_send send) {
     if (!self->bus.data_as_commands) {
         self->bus.send(self->bus.bus, DISPLAY_COMMAND, CHIP_SELECT_TOGGLE_EVERY_BYTE, &self->write_ram_command, 1);
     }
-    self->bus.send(self->bus.bus, DISPLAY_DATA, CHIP_SELECT_UNTOUCHED, pixels, length);
+    send(self->bus.bus, DISPLAY_DATA, CHIP_SELECT_UNTOUCHED, pixels, length);
 }
 
-static bool _refresh_area(busdisplay_busdisplay_obj_t *self, const displayio_area_t *area) {
-    uint16_t buffer_size = 128; // In uint32_ts
-
+// Refreshes area from buffers, which are buffer_size uint32_ts each and two of them if
+// double_buffer is set, followed by mask. ram_dy is how many rows down display memory the area is
+// stored because of hardware scrolling.
+static bool _refresh_area_from(busdisplay_busdisplay_obj_t *self, const displayio_area_t *area, int16_t ram_dy,
+    uint32_t *buffers, uint16_t buffer_size, uint32_t *mask, bool double_buffer) {
     displayio_area_t clipped;
     // Clip the area to the display by overlapping the areas. If there is no overlap then we're done.
     if (!displayio_display_core_clip_area(&self->core, area, &clipped)) {
         return true;
     }
-    uint16_t rows_per_buffer = displayio_area_height(&clipped);
     uint8_t pixels_per_word = (sizeof(uint32_t) * 8) / self->core.colorspace.depth;
+
+    // Allocated buffers always hold the rows sent at once, but the fallback buffer may not. It
+    // then sends strips narrow enough to fit.
+    uint32_t strip_width = buffer_size * pixels_per_word / _min_rows(self);
+    if (displayio_area_width(&clipped) > strip_width) {
+        if (self->core.colorspace.depth < 8 && self->core.colorspace.pixels_in_byte_share_row) {
+            strip_width -= strip_width % (8 / self->core.colorspace.depth);
+        }
+        displayio_area_t strip = clipped;
+        for (strip.x1 = clipped.x1; strip.x1 < clipped.x2; strip.x1 += strip_width) {
+            strip.x2 = MIN(strip.x1 + (int16_t)strip_width, clipped.x2);
+            if (!_refresh_area_from(self, &strip, ram_dy, buffers, buffer_size, mask, double_buffer)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    uint16_t buffer_stride = buffer_size;
+    uint16_t rows_per_buffer = displayio_area_height(&clipped);
     uint16_t pixels_per_buffer = displayio_area_size(&clipped);
 
     uint16_t subrectangles = 1;
@@ -231,6 +333,7 @@ static bool _refresh_area(busdisplay_busdisplay_obj_t *self, const displayio_are
     if (self->bus.SH1107_addressing) {
         subrectangles = rows_per_buffer / 8;  // page addressing mode writes 8 rows at a time
         rows_per_buffer = 8;
+        pixels_per_buffer = rows_per_buffer * displayio_area_width(&clipped);
     } else if (displayio_area_size(&clipped) > buffer_size * pixels_per_word) {
         rows_per_buffer = buffer_size * pixels_per_word / displayio_area_width(&clipped);
         if (rows_per_buffer == 0) {
@@ -254,14 +357,22 @@ static bool _refresh_area(busdisplay_busdisplay_obj_t *self, const displayio_are
         }
     }
 
-    // Allocated and shared as a uint32_t array so the compiler knows the
-    // alignment everywhere.
-    uint32_t buffer[buffer_size];
+    // With double buffering, the next subrectangle is rendered into one buffer while the
+    // bus sends the other. The transaction for a buffer stays open until the next one is
+    // rendered because ending it waits for the send to finish. Nothing else runs while it
+    // is open.
+    uint8_t buffer_count = 1;
+    if (double_buffer && subrectangles > 1) {
+        buffer_count = 2;
+    }
+
+    // The buffers and mask are uint32_t arrays so the compiler knows the alignment everywhere.
     uint32_t mask_length = (pixels_per_buffer / 32) + 1;
-    uint32_t mask[mask_length];
     uint16_t remaining_rows = displayio_area_height(&clipped);
+    bool in_transaction = false;
 
     for (uint16_t j = 0; j < subrectangles; j++) {
+        uint32_t *buffer = buffers + (j % buffer_count) * buffer_stride;
         displayio_area_t subrectangle = {
             .x1 = clipped.x1,
             .y1 = clipped.y1 + rows_per_buffer * j,
@@ -273,8 +384,6 @@ static bool _refresh_area(busdisplay_busdisplay_obj_t *self, const displayio_are
         }
         remaining_rows -= rows_per_buffer;
 
-        displayio_display_bus_set_region_to_update(&self->bus, &self->core, &subrectangle);
-
         uint16_t subrectangle_size_bytes;
         if (self->core.colorspace.depth >= 8) {
             subrectangle_size_bytes = displayio_area_size(&subrectangle) * (self->core.colorspace.depth / 8);
@@ -287,20 +396,211 @@ static bool _refresh_area(busdisplay_busdisplay_obj_t *self, const displayio_are
 
         displayio_display_core_fill_area(&self->core, &subrectangle, mask, buffer);
 
+        if (in_transaction) {
+            displayio_display_bus_end_transaction(&self->bus);
+            in_transaction = false;
+        }
+
+        // TODO(tannewt): Make refresh displays faster so we don't starve other
+        // background tasks.
+        // Run here, between transactions, so that background work never finds the
+        // bus locked and chip select asserted.
+        #if CIRCUITPY_TINYUSB
+        usb_background();
+        #endif
+
+        displayio_area_t ram_area;
+        displayio_area_copy(&subrectangle, &ram_area);
+        displayio_area_shift(&ram_area, 0, ram_dy);
+        displayio_display_bus_set_region_to_update(&self->bus, &self->core, &ram_area);
+
         // Can't acquire display bus; skip the rest of the data.
         if (!displayio_display_bus_is_free(&self->bus)) {
             return false;
         }
 
         displayio_display_bus_begin_transaction(&self->bus);
-        _send_pixels(self, (uint8_t *)buffer, subrectangle_size_bytes);
+        if (buffer_count > 1) {
+            _send_pixels(self, (uint8_t *)buffer, subrectangle_size_bytes, self->bus.start_send);
+            in_transaction = true;
+        } else {
+            _send_pixels(self, (uint8_t *)buffer, subrectangle_size_bytes, self->bus.send);
+            displayio_display_bus_end_transaction(&self->bus);
+        }
+    }
+    if (in_transaction) {
         displayio_display_bus_end_transaction(&self->bus);
+    }
+    return true;
+}
 
-        // TODO(tannewt): Make refresh displays faster so we don't starve other
-        // background tasks.
-        #if CIRCUITPY_TINYUSB
-        usb_background();
-        #endif
+// Refreshes from a small buffer on the stack, in its own function so that refreshing from the
+// allocated buffers doesn't take the stack too.
+static MP_NOINLINE bool _refresh_area_from_fallback(busdisplay_busdisplay_obj_t *self, const displayio_area_t *area, int16_t ram_dy) {
+    uint32_t buffer[FALLBACK_BUFFER_WORDS];
+    uint32_t mask[FALLBACK_BUFFER_WORDS + 1];
+    return _refresh_area_from(self, area, ram_dy, buffer, FALLBACK_BUFFER_WORDS, mask, false);
+}
+
+static bool _refresh_area(busdisplay_busdisplay_obj_t *self, const displayio_area_t *area, int16_t ram_dy) {
+    if (self->refresh_buffer == NULL &&
+        !_allocate_refresh_buffer(self, self->refresh_buffer_size * sizeof(uint32_t), self->double_buffer)) {
+        return _refresh_area_from_fallback(self, area, ram_dy);
+    }
+    return _refresh_area_from(self, area, ram_dy, self->refresh_buffer, self->refresh_buffer_size,
+        self->refresh_mask, self->double_buffer);
+}
+
+// Sends area, split where hardware scrolling wraps it around in display memory.
+static bool _refresh_scrolled_area(busdisplay_busdisplay_obj_t *self, const displayio_area_t *area) {
+    displayio_area_t clipped;
+    if (!displayio_display_core_clip_area(&self->core, area, &clipped)) {
+        return true;
+    }
+    if (self->scroll_offset == 0) {
+        return _refresh_area(self, &clipped, 0);
+    }
+    int16_t top = self->scroll_top;
+    int16_t bottom = self->scroll_bottom;
+    int16_t offset = self->scroll_offset;
+    // Rows from wrap down are stored at the top of the scrolled rows.
+    int16_t wrap = bottom - offset;
+    const struct {
+        int16_t y1;
+        int16_t y2;
+        int16_t ram_dy;
+    } pieces[] = {
+        { clipped.y1, MIN(clipped.y2, top), 0 },
+        { MAX(clipped.y1, top), MIN(clipped.y2, wrap), offset },
+        { MAX(clipped.y1, wrap), MIN(clipped.y2, bottom), offset - (bottom - top) },
+        { MAX(clipped.y1, bottom), clipped.y2, 0 },
+    };
+    for (size_t i = 0; i < MP_ARRAY_SIZE(pieces); i++) {
+        if (pieces[i].y1 >= pieces[i].y2) {
+            continue;
+        }
+        displayio_area_t piece = {
+            .x1 = clipped.x1,
+            .y1 = pieces[i].y1,
+            .x2 = clipped.x2,
+            .y2 = pieces[i].y2,
+        };
+        if (!_refresh_area(self, &piece, pieces[i].ram_dy)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool _send_scroll_command(busdisplay_busdisplay_obj_t *self, uint8_t command, const uint16_t *values, uint8_t count) {
+    if (!displayio_display_bus_begin_transaction(&self->bus)) {
+        return false;
+    }
+    uint8_t data[count * 2];
+    for (uint8_t i = 0; i < count; i++) {
+        data[2 * i] = values[i] >> 8;
+        data[2 * i + 1] = values[i] & 0xff;
+    }
+    self->bus.send(self->bus.bus, DISPLAY_COMMAND, CHIP_SELECT_TOGGLE_EVERY_BYTE, &command, 1);
+    self->bus.send(self->bus.bus, DISPLAY_DATA, CHIP_SELECT_UNTOUCHED, data, count * 2);
+    displayio_display_bus_end_transaction(&self->bus);
+    return true;
+}
+
+static bool _set_scroll_start(busdisplay_busdisplay_obj_t *self, uint16_t offset) {
+    uint16_t start = self->bus.rowstart + self->scroll_top + offset;
+    if (!_send_scroll_command(self, MIPI_COMMAND_SET_SCROLL_START, &start, 1)) {
+        return false;
+    }
+    self->scroll_offset = offset;
+    return true;
+}
+
+// Undoes any hardware scrolling and forgets the scrolled rows, so the scroll area is sent again
+// before the next scroll. Returns false if the bus is busy.
+static bool _reset_scroll(busdisplay_busdisplay_obj_t *self) {
+    if (self->scroll_offset != 0 && !_set_scroll_start(self, 0)) {
+        return false;
+    }
+    self->scroll_top = 0;
+    self->scroll_bottom = 0;
+    return true;
+}
+
+// Makes rows top to bottom the scrolled rows. Returns false if they can't be scrolled now.
+static bool _set_scroll_area(busdisplay_busdisplay_obj_t *self, int16_t top, int16_t bottom) {
+    if (top == self->scroll_top && bottom == self->scroll_bottom) {
+        return true;
+    }
+    if (self->scroll_offset != 0) {
+        // Display memory for the old rows is still rotated. Undo it and redraw everything so the
+        // new rows can be set up on the next refresh.
+        if (_set_scroll_start(self, 0)) {
+            self->core.full_refresh = true;
+        }
+        return false;
+    }
+    int32_t top_fixed = self->bus.rowstart + top;
+    int32_t bottom_fixed = self->scroll_ram_height - top_fixed - (bottom - top);
+    if (bottom_fixed < 0) {
+        return false;
+    }
+    uint16_t values[3] = { top_fixed, bottom - top, bottom_fixed };
+    if (!_send_scroll_command(self, MIPI_COMMAND_SET_SCROLL_AREA, values, 3)) {
+        return false;
+    }
+    self->scroll_top = top;
+    self->scroll_bottom = bottom;
+    return true;
+}
+
+// Scrolls the pixels already on the display when the root group or a single TileGrid, such as
+// a Terminal, only moved vertically. exposed is set to the rows that then need to be sent.
+static bool _hardware_scroll(busdisplay_busdisplay_obj_t *self, displayio_area_t *exposed) {
+    if (self->scroll_ram_height == 0 || self->core.full_refresh || self->core.current_group == NULL ||
+        self->core.colorspace.depth < 8 || self->bus.data_as_commands || self->bus.SH1107_addressing) {
+        return false;
+    }
+    displayio_group_t *root_group = self->core.current_group;
+    const displayio_buffer_transform_t *transform = &root_group->absolute_transform;
+    displayio_area_t area;
+    int16_t dy = transform->y - self->scroll_group_y;
+    displayio_tilegrid_t *tilegrid = NULL;
+    if (!transform->transpose_xy && transform->x == self->scroll_group_x && dy != 0 &&
+        displayio_group_only_moved_by(root_group, dy)) {
+        displayio_area_copy(&self->core.area, &area);
+    } else {
+        tilegrid = displayio_group_get_scrolled_tilegrid(root_group, &area, &dy);
+        if (tilegrid == NULL) {
+            return false;
+        }
+    }
+    displayio_area_t clipped;
+    if (!displayio_display_core_clip_area(&self->core, &area, &clipped)) {
+        return false;
+    }
+    int16_t height = displayio_area_height(&clipped);
+    if (dy >= height || -dy >= height || !_set_scroll_area(self, clipped.y1, clipped.y2)) {
+        return false;
+    }
+    int32_t offset = ((int32_t)self->scroll_offset - dy) % height;
+    if (offset < 0) {
+        offset += height;
+    }
+    if (!_set_scroll_start(self, offset)) {
+        return false;
+    }
+
+    displayio_area_copy(&clipped, exposed);
+    if (dy < 0) {
+        exposed->y1 = clipped.y2 + dy;
+    } else {
+        exposed->y2 = clipped.y1 + dy;
+    }
+    if (tilegrid != NULL) {
+        displayio_tilegrid_finish_scroll(tilegrid);
+    } else {
+        displayio_group_finish_scroll(root_group);
     }
     return true;
 }
@@ -310,13 +610,42 @@ static void _refresh_display(busdisplay_busdisplay_obj_t *self) {
         // A refresh on this bus is already in progress.  Try next display.
         return;
     }
+    uint64_t start_ns = common_hal_time_monotonic_ns();
     displayio_display_core_start_refresh(&self->core);
-    const displayio_area_t *current_area = _get_refresh_areas(self);
-    while (current_area != NULL) {
-        _refresh_area(self, current_area);
-        current_area = current_area->next;
+    if (self->core.full_refresh && self->scroll_offset != 0) {
+        // Everything is sent again so there's no need to keep display memory rotated. This also
+        // finishes a reset that set_rotation couldn't make while the bus was busy.
+        _reset_scroll(self);
+    }
+    // Starting an area costs a few commands and transactions on the bus, so send some unchanged
+    // pixels rather than many small, nearby areas.
+    uint32_t overhead_pixels = REFRESH_AREA_OVERHEAD_BYTES * 8 / self->core.colorspace.depth;
+    displayio_area_t exposed;
+    const displayio_area_t *refresh_areas;
+    if (_hardware_scroll(self, &exposed)) {
+        exposed.next = _get_refresh_areas(self);
+        refresh_areas = &exposed;
+    } else {
+        refresh_areas = _get_refresh_areas(self);
+    }
+    displayio_area_t areas[DISPLAYIO_MAX_REFRESH_AREAS + 1];
+    size_t area_count = displayio_display_core_coalesce_areas(&self->core, refresh_areas,
+        areas, self->max_refresh_areas, overhead_pixels);
+    uint32_t pixels = 0;
+    for (size_t i = 0; i < area_count; i++) {
+        _refresh_scrolled_area(self, &areas[i]);
+        pixels += displayio_area_size(&areas[i]);
+    }
+    if (self->core.current_group != NULL) {
+        self->scroll_group_x = self->core.current_group->absolute_transform.x;
+        self->scroll_group_y = self->core.current_group->absolute_transform.y;
     }
     displayio_display_core_finish_refresh(&self->core);
+    if (area_count > 0) {
+        self->last_refresh_areas = area_count;
+        self->last_refresh_pixels = pixels;
+        self->last_refresh_us = (common_hal_time_monotonic_ns() - start_ns) / 1000;
+    }
 }
 
 void common_hal_busdisplay_busdisplay_set_rotation(busdisplay_busdisplay_obj_t *self, int rotation) {
@@ -328,6 +657,10 @@ void common_hal_busdisplay_busdisplay_set_rotation(busdisplay_busdisplay_obj_t *
         self->core.height = tmp;
     }
     displayio_display_core_set_rotation(&self->core, rotation);
+    // Display memory rows run another way after rotating, so hardware scrolling starts over
+    // and everything is sent again.
+    _reset_scroll(self);
+    self->core.full_refresh = true;
     if (self == &displays[0].display) {
         supervisor_stop_terminal();
         supervisor_start_terminal(self->core.width, self->core.height);
@@ -401,6 +734,8 @@ void busdisplay_busdisplay_background(busdisplay_busdisplay_obj_t *self) {
 void release_busdisplay(busdisplay_busdisplay_obj_t *self) {
     common_hal_busdisplay_busdisplay_set_auto_refresh(self, false);
     release_display_core(&self->core);
+    port_free(self->refresh_buffer);
+    self->refresh_buffer = NULL;
     #if (CIRCUITPY_PWMIO)
     if (self->backlight_pwm.base.type == &pwmio_pwmout_type) {
         common_hal_pwmio_pwmout_deinit(&self->backlight_pwm);
@@ -27,14 +27,34 @@ typedef struct {
         #endif
     };
     uint64_t last_refresh_call;
+    // Stats for the last refresh that sent anything.
+    uint32_t last_refresh_pixels;
+    uint32_t last_refresh_us;
+    uint8_t last_refresh_areas;
+    uint8_t max_refresh_areas;
     mp_float_t current_brightness;
     uint16_t brightness_command;
     uint16_t native_frames_per_second;
     uint16_t native_ms_per_frame;
+    // Buffers to render pixels into, followed by the mask. They are allocated outside the VM heap
+    // so they last as long as the display.
+    uint32_t *refresh_buffer;
+    uint32_t *refresh_mask;
+    uint16_t refresh_buffer_size; // In uint32_ts
+    // Hardware scrolling state. Rows scroll_top to scroll_bottom are shown starting scroll_offset
+    // rows into the same rows of display memory. Zero scroll_ram_height disables scrolling.
+    uint16_t scroll_ram_height;
+    int16_t scroll_top;
+    int16_t scroll_bottom;
+    uint16_t scroll_offset;
+    // Where the root group was at the last refresh so moves of the whole group can be scrolled.
+    int16_t scroll_group_x;
+    int16_t scroll_group_y;
     uint8_t write_ram_command;
     bool auto_refresh;
     bool first_manual_refresh;
     bool backlight_on_high;
+    bool double_buffer;
 } busdisplay_busdisplay_obj_t;
 
 void busdisplay_busdisplay_background(busdisplay_busdisplay_obj_t *self);
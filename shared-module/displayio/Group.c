@@ -6,6 +6,8 @@
 
 #include "shared-bindings/displayio/Group.h"
 
+#include <string.h>
+
 #include "py/runtime.h"
 #include "py/objlist.h"
 #include "shared-bindings/displayio/TileGrid.h"
@@ -366,43 +368,125 @@ void displayio_group_construct(displayio_group_t *self, mp_obj_list_t *members,
     self->readonly = false;
 }
 
-bool displayio_group_fill_area(displayio_group_t *self, const _displayio_colorspace_t *colorspace, const displayio_area_t *area, uint32_t *mask, uint32_t *buffer) {
+static bool _group_fill_area(displayio_group_t *self, const _displayio_colorspace_t *colorspace, const displayio_area_t *area, uint32_t *mask, uint32_t *buffer, bool from_bottom);
+
+// from_bottom is passed on to Groups, see _group_fill_area.
+static bool _fill_layer(mp_obj_t item, const _displayio_colorspace_t *colorspace, const displayio_area_t *area, uint32_t *mask, uint32_t *buffer, bool from_bottom) {
+    mp_obj_t layer;
+    #if CIRCUITPY_VECTORIO
+    const vectorio_draw_protocol_t *draw_protocol = mp_proto_get(MP_QSTR_protocol_draw, item);
+    if (draw_protocol != NULL) {
+        layer = draw_protocol->draw_get_protocol_self(item);
+        return draw_protocol->draw_protocol_impl->draw_fill_area(layer, colorspace, area, mask, buffer);
+    }
+    #endif
+    layer = mp_obj_cast_to_native_base(item, &displayio_tilegrid_type);
+    if (layer != MP_OBJ_NULL) {
+        return displayio_tilegrid_fill_area(layer, colorspace, area, mask, buffer);
+    }
+    layer = mp_obj_cast_to_native_base(item, &displayio_group_type);
+    if (layer != MP_OBJ_NULL) {
+        return _group_fill_area(layer, colorspace, area, mask, buffer, from_bottom);
+    }
+    return false;
+}
+
+bool displayio_group_covers_area(displayio_group_t *self, const displayio_area_t *area) {
+    if (self->hidden) {
+        return false;
+    }
+    for (int32_t i = self->members->len - 1; i >= 0; i--) {
+        mp_obj_t layer = mp_obj_cast_to_native_base(
+            self->members->items[i], &displayio_tilegrid_type);
+        if (layer != MP_OBJ_NULL) {
+            if (displayio_tilegrid_covers_area(layer, area)) {
+                return true;
+            }
+            continue;
+        }
+        layer = mp_obj_cast_to_native_base(
+            self->members->items[i], &displayio_group_type);
+        if (layer != MP_OBJ_NULL && displayio_group_covers_area(layer, area)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Draws the layers from the topmost one that covers the area up, each over the last. Nothing
+// below it is drawn and TileGrids skip the mask entirely. Returns false if the covering layer
+// turned out to have transparent pixels, in which case the buffer must be redrawn.
+static bool _fill_area_from_bottom(displayio_group_t *self, const _displayio_colorspace_t *colorspace, const displayio_area_t *area, uint32_t *mask, uint32_t *buffer) {
+    int32_t bottom = self->members->len - 1;
+    while (bottom >= 0) {
+        mp_obj_t item = self->members->items[bottom];
+        mp_obj_t layer = mp_obj_cast_to_native_base(item, &displayio_tilegrid_type);
+        if (layer != MP_OBJ_NULL && displayio_tilegrid_covers_area(layer, area)) {
+            break;
+        }
+        layer = mp_obj_cast_to_native_base(item, &displayio_group_type);
+        if (layer != MP_OBJ_NULL && displayio_group_covers_area(layer, area)) {
+            break;
+        }
+        bottom--;
+    }
+    if (bottom < 0) {
+        return false;
+    }
+    size_t mask_bytes = (displayio_area_size(area) + 31) / 32 * sizeof(uint32_t);
+    for (size_t i = bottom; i < self->members->len; i++) {
+        mp_obj_t item = self->members->items[i];
+        mp_obj_t tilegrid = mp_obj_cast_to_native_base(item, &displayio_tilegrid_type);
+        bool covered;
+        if (tilegrid != MP_OBJ_NULL) {
+            covered = displayio_tilegrid_fill_area(tilegrid, colorspace, area, NULL, buffer);
+        } else {
+            // Other layers only use the mask to avoid what's above them, which isn't drawn yet.
+            // A Group above the bottom one must draw over what is already in the buffer.
+            memset(mask, 0, mask_bytes);
+            covered = _fill_layer(item, colorspace, area, mask, buffer, i == (size_t)bottom);
+        }
+        if (i == (size_t)bottom && !covered) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// With from_bottom, nothing has been drawn into the area yet and the Group draws from its topmost
+// covering layer up. It returns false if that isn't possible and then the caller must redraw the
+// area. Otherwise the Group draws top down, skipping pixels already set in the mask.
+static bool _group_fill_area(displayio_group_t *self, const _displayio_colorspace_t *colorspace, const displayio_area_t *area, uint32_t *mask, uint32_t *buffer, bool from_bottom) {
+    if (self->hidden) {
+        return false;
+    }
+    if (from_bottom) {
+        return _fill_area_from_bottom(self, colorspace, area, mask, buffer);
+    }
     // Track if any of the layers finishes filling in the given area. We can ignore any remaining
     // layers at that point.
-    if (self->hidden == false) {
-        for (int32_t i = self->members->len - 1; i >= 0; i--) {
-            mp_obj_t layer;
-            #if CIRCUITPY_VECTORIO
-            const vectorio_draw_protocol_t *draw_protocol = mp_proto_get(MP_QSTR_protocol_draw, self->members->items[i]);
-            if (draw_protocol != NULL) {
-                layer = draw_protocol->draw_get_protocol_self(self->members->items[i]);
-                if (draw_protocol->draw_protocol_impl->draw_fill_area(layer, colorspace, area, mask, buffer)) {
-                    return true;
-                }
-                continue;
-            }
-            #endif
-            layer = mp_obj_cast_to_native_base(
-                self->members->items[i], &displayio_tilegrid_type);
-            if (layer != MP_OBJ_NULL) {
-                if (displayio_tilegrid_fill_area(layer, colorspace, area, mask, buffer)) {
-                    return true;
-                }
-                continue;
-            }
-            layer = mp_obj_cast_to_native_base(
-                self->members->items[i], &displayio_group_type);
-            if (layer != MP_OBJ_NULL) {
-                if (displayio_group_fill_area(layer, colorspace, area, mask, buffer)) {
-                    return true;
-                }
-                continue;
-            }
+    for (int32_t i = self->members->len - 1; i >= 0; i--) {
+        if (_fill_layer(self->members->items[i], colorspace, area, mask, buffer, false)) {
+            return true;
         }
     }
     return false;
 }
 
+bool displayio_group_fill_area(displayio_group_t *self, const _displayio_colorspace_t *colorspace, const displayio_area_t *area, uint32_t *mask, uint32_t *buffer) {
+    // The display clears the mask and buffer before asking the root group to fill them. If one of
+    // the layers is opaque over the whole area, draw from it up instead. Overwriting pixels only
+    // works with at least a byte per pixel.
+    if (colorspace->depth >= 8) {
+        if (_group_fill_area(self, colorspace, area, mask, buffer, true)) {
+            return true;
+        }
+        memset(mask, 0, (displayio_area_size(area) + 31) / 32 * sizeof(uint32_t));
+        memset(buffer, 0, displayio_area_size(area) * (colorspace->depth / 8));
+    }
+    return _group_fill_area(self, colorspace, area, mask, buffer, false);
+}
+
 void displayio_group_finish_refresh(displayio_group_t *self) {
     self->item_removed = false;
     for (int32_t i = self->members->len - 1; i >= 0; i--) {
@@ -464,3 +548,115 @@ displayio_area_t *displayio_group_get_refresh_areas(displayio_group_t *self, dis
 
     return tail;
 }
+
+// Vector shapes don't track where they were drawn closely enough to scroll them.
+static bool _is_vector_shape(mp_obj_t item) {
+    #if CIRCUITPY_VECTORIO
+    return mp_proto_get(MP_QSTR_protocol_draw, item) != NULL;
+    #else
+    return false;
+    #endif
+}
+
+bool displayio_group_only_moved_by(displayio_group_t *self, int16_t dy) {
+    if (self->item_removed) {
+        return false;
+    }
+    for (size_t i = 0; i < self->members->len; i++) {
+        mp_obj_t item = self->members->items[i];
+        if (_is_vector_shape(item)) {
+            return false;
+        }
+        mp_obj_t layer = mp_obj_cast_to_native_base(item, &displayio_tilegrid_type);
+        if (layer != MP_OBJ_NULL) {
+            if (!displayio_tilegrid_only_moved_by(layer, dy)) {
+                return false;
+            }
+            continue;
+        }
+        layer = mp_obj_cast_to_native_base(item, &displayio_group_type);
+        if (layer != MP_OBJ_NULL && !displayio_group_only_moved_by(layer, dy)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void displayio_group_finish_scroll(displayio_group_t *self) {
+    for (size_t i = 0; i < self->members->len; i++) {
+        mp_obj_t layer = mp_obj_cast_to_native_base(self->members->items[i], &displayio_tilegrid_type);
+        if (layer != MP_OBJ_NULL) {
+            displayio_tilegrid_finish_scroll(layer);
+            continue;
+        }
+        layer = mp_obj_cast_to_native_base(self->members->items[i], &displayio_group_type);
+        if (layer != MP_OBJ_NULL) {
+            displayio_group_finish_scroll(layer);
+        }
+    }
+}
+
+static bool _overlaps_rows(const displayio_area_t *area, int16_t y1, int16_t y2) {
+    return area->y1 < y2 && y1 < area->y2;
+}
+
+// True when anything other than skip was or will be drawn in rows y1 to y2.
+static bool _draws_in_rows(displayio_group_t *self, displayio_tilegrid_t *skip, int16_t y1, int16_t y2) {
+    if (self->item_removed && _overlaps_rows(&self->dirty_area, y1, y2)) {
+        return true;
+    }
+    for (size_t i = 0; i < self->members->len; i++) {
+        mp_obj_t item = self->members->items[i];
+        if (_is_vector_shape(item)) {
+            return true;
+        }
+        mp_obj_t layer = mp_obj_cast_to_native_base(item, &displayio_tilegrid_type);
+        if (layer != MP_OBJ_NULL) {
+            displayio_tilegrid_t *tilegrid = layer;
+            if (tilegrid == skip) {
+                continue;
+            }
+            displayio_area_t previous;
+            if (displayio_tilegrid_get_previous_area(tilegrid, &previous) && _overlaps_rows(&previous, y1, y2)) {
+                return true;
+            }
+            if (!tilegrid->hidden && !tilegrid->hidden_by_parent && _overlaps_rows(&tilegrid->current_area, y1, y2)) {
+                return true;
+            }
+            continue;
+        }
+        layer = mp_obj_cast_to_native_base(item, &displayio_group_type);
+        if (layer != MP_OBJ_NULL && _draws_in_rows(layer, skip, y1, y2)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static displayio_tilegrid_t *_find_scrolled_tilegrid(displayio_group_t *self, displayio_area_t *area, int16_t *dy) {
+    for (size_t i = 0; i < self->members->len; i++) {
+        mp_obj_t layer = mp_obj_cast_to_native_base(self->members->items[i], &displayio_tilegrid_type);
+        if (layer != MP_OBJ_NULL) {
+            if (displayio_tilegrid_get_scroll(layer, area, dy)) {
+                return layer;
+            }
+            continue;
+        }
+        layer = mp_obj_cast_to_native_base(self->members->items[i], &displayio_group_type);
+        if (layer != MP_OBJ_NULL) {
+            displayio_tilegrid_t *tilegrid = _find_scrolled_tilegrid(layer, area, dy);
+            if (tilegrid != NULL) {
+                return tilegrid;
+            }
+        }
+    }
+    return NULL;
+}
+
+displayio_tilegrid_t *displayio_group_get_scrolled_tilegrid(displayio_group_t *self, displayio_area_t *area, int16_t *dy) {
+    displayio_tilegrid_t *tilegrid = _find_scrolled_tilegrid(self, area, dy);
+    if (tilegrid == NULL || _draws_in_rows(self, tilegrid, area->y1, area->y2)) {
+        return NULL;
+    }
+    return tilegrid;
+}
@@ -13,6 +13,7 @@
 #include "py/objlist.h"
 #include "shared-module/displayio/area.h"
 #include "shared-module/displayio/Palette.h"
+#include "shared-module/displayio/TileGrid.h"
 
 typedef struct {
     mp_obj_base_t base;
@@ -34,6 +35,17 @@ void displayio_group_construct(displayio_group_t *self, mp_obj_list_t *members,
 void displayio_group_set_hidden_by_parent(displayio_group_t *self, bool hidden);
 bool displayio_group_get_previous_area(displayio_group_t *group, displayio_area_t *area);
 bool displayio_group_fill_area(displayio_group_t *group, const _displayio_colorspace_t *colorspace, const displayio_area_t *area, uint32_t *mask, uint32_t *buffer);
+// True when a visible TileGrid in the group draws every pixel of area with an opaque pixel shader.
+bool displayio_group_covers_area(displayio_group_t *group, const displayio_area_t *area);
 void displayio_group_update_transform(displayio_group_t *group, const displayio_buffer_transform_t *parent_transform);
 void displayio_group_finish_refresh(displayio_group_t *self);
 displayio_area_t *displayio_group_get_refresh_areas(displayio_group_t *self, displayio_area_t *tail);
+
+// Hardware scrolling moves every pixel in a band of rows so it is only used when nothing else
+// changed. only_moved_by is true when every layer in the group only moved dy pixels.
+bool displayio_group_only_moved_by(displayio_group_t *self, int16_t dy);
+// Returns the TileGrid that only scrolled since the last refresh, when nothing else draws in the
+// rows it covers, or NULL. area and dy are set as displayio_tilegrid_get_scroll does.
+displayio_tilegrid_t *displayio_group_get_scrolled_tilegrid(displayio_group_t *self, displayio_area_t *area, int16_t *dy);
+// Marks everything in the group as scrolled. See displayio_tilegrid_finish_scroll.
+void displayio_group_finish_scroll(displayio_group_t *self);
@@ -83,6 +83,15 @@ void displayio_palette_get_color(displayio_palette_t *self, const _displayio_col
     }
 }
 
+bool displayio_palette_is_opaque(displayio_palette_t *self) {
+    for (uint32_t i = 0; i < self->color_count; i++) {
+        if (self->colors[i].transparent) {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool displayio_palette_needs_refresh(displayio_palette_t *self) {
     return self->needs_refresh;
 }
@@ -61,4 +61,6 @@ typedef struct displayio_palette {
 void displayio_palette_get_color(displayio_palette_t *palette, const _displayio_colorspace_t *colorspace, const displayio_input_pixel_t *input_pixel, displayio_output_pixel_t *output_color);
 ;
 bool displayio_palette_needs_refresh(displayio_palette_t *self);
+// True when none of the palette's colors are transparent.
+bool displayio_palette_is_opaque(displayio_palette_t *self);
 void displayio_palette_finish_refresh(displayio_palette_t *self);
@@ -6,6 +6,9 @@
 
 #include "shared-bindings/displayio/TileGrid.h"
 
+#include <string.h>
+
+#include "py/gc.h"
 #include "py/runtime.h"
 #include "shared-bindings/displayio/Bitmap.h"
 #include "shared-bindings/displayio/ColorConverter.h"
@@ -54,6 +57,9 @@ void common_hal_displayio_tilegrid_construct(displayio_tilegrid_t *self, mp_obj_
     self->flip_y = false;
     self->transpose_xy = false;
     self->absolute_transform = NULL;
+    self->render_cache = NULL;
+    self->use_render_cache = false;
+    self->scrolled_rows = 0;
 }
 
 
@@ -89,6 +95,17 @@ bool displayio_tilegrid_get_previous_area(displayio_tilegrid_t *self, displayio_
     return true;
 }
 
+static void _invalidate_render_cache(displayio_tilegrid_t *self, const displayio_area_t *area) {
+    if (area == NULL) {
+        self->render_cache_dirty.x1 = 0;
+        self->render_cache_dirty.y1 = 0;
+        self->render_cache_dirty.x2 = self->pixel_width;
+        self->render_cache_dirty.y2 = self->pixel_height;
+    } else {
+        displayio_area_union(&self->render_cache_dirty, area, &self->render_cache_dirty);
+    }
+}
+
 static void _update_current_x(displayio_tilegrid_t *self) {
     uint16_t width;
     if (self->transpose_xy) {
@@ -157,6 +174,10 @@ static void _update_current_y(displayio_tilegrid_t *self) {
 
 void displayio_tilegrid_update_transform(displayio_tilegrid_t *self,
     const displayio_buffer_transform_t *absolute_transform) {
+    // Changes while we weren't shown may not have been seen.
+    if (!self->in_group && absolute_transform != NULL) {
+        _invalidate_render_cache(self, NULL);
+    }
     self->in_group = absolute_transform != NULL;
     self->absolute_transform = absolute_transform;
     if (absolute_transform != NULL) {
@@ -348,6 +369,32 @@ void common_hal_displayio_tilegrid_set_transpose_xy(displayio_tilegrid_t *self,
     self->moved = true;
 }
 
+static size_t _render_cache_pixel_words(displayio_tilegrid_t *self, uint8_t depth) {
+    return (self->pixel_width * self->pixel_height * (depth / 8) + 3) / 4;
+}
+
+static size_t _render_cache_words(displayio_tilegrid_t *self, uint8_t depth) {
+    return _render_cache_pixel_words(self, depth) + (self->pixel_width * self->pixel_height + 31) / 32;
+}
+
+static void _free_render_cache(displayio_tilegrid_t *self) {
+    if (self->render_cache != NULL) {
+        m_del(uint32_t, self->render_cache, _render_cache_words(self, self->render_cache_depth));
+        self->render_cache = NULL;
+    }
+}
+
+bool common_hal_displayio_tilegrid_get_render_cache(displayio_tilegrid_t *self) {
+    return self->use_render_cache;
+}
+
+void common_hal_displayio_tilegrid_set_render_cache(displayio_tilegrid_t *self, bool render_cache) {
+    self->use_render_cache = render_cache;
+    if (!render_cache) {
+        _free_render_cache(self);
+    }
+}
+
 bool common_hal_displayio_tilegrid_contains(displayio_tilegrid_t *self, uint16_t x, uint16_t y) {
     uint16_t right_edge = self->x + (self->width_in_tiles * self->tile_width);
     uint16_t bottom_edge = self->y + (self->height_in_tiles * self->tile_height);
@@ -356,9 +403,195 @@ bool common_hal_displayio_tilegrid_contains(displayio_tilegrid_t *self, uint16_t
 }
 
 void common_hal_displayio_tilegrid_set_top_left(displayio_tilegrid_t *self, uint16_t x, uint16_t y) {
+    int32_t rows = 0;
+    if (x == self->top_left_x && !self->flip_y && !self->transpose_xy) {
+        // The content wraps around, so take the shorter way: up when y increases, down when it
+        // decreases.
+        int32_t height = self->height_in_tiles;
+        rows = (y % height + height - self->top_left_y % height) % height;
+        if (rows > height / 2) {
+            rows -= height;
+        }
+    }
+    // Moving only top_left_y scrolls the content. Track it as such so displays that can scroll
+    // don't redraw everything.
+    int32_t scrolled_rows = self->scrolled_rows + rows;
+    if (rows != 0 && !self->full_change && scrolled_rows < self->height_in_tiles &&
+        -scrolled_rows < self->height_in_tiles) {
+        if (self->partial_change) {
+            // Dirty rows that scroll off an edge come back in the rows the scroll exposes.
+            int16_t shift = rows * self->tile_height;
+            self->dirty_area.y1 = MIN(MAX(self->dirty_area.y1 - shift, 0), self->pixel_height);
+            self->dirty_area.y2 = MIN(MAX(self->dirty_area.y2 - shift, 0), self->pixel_height);
+        }
+        self->scrolled_rows += rows;
+        _invalidate_render_cache(self, NULL);
+    } else if (x != self->top_left_x || y != self->top_left_y) {
+        self->full_change = true;
+    }
     self->top_left_x = x;
     self->top_left_y = y;
-    self->full_change = true;
+}
+
+// Gets the pixel at x, y relative to the TileGrid and converts it to the colorspace.
+static void _get_pixel(displayio_tilegrid_t *self, const _displayio_colorspace_t *colorspace,
+    const uint8_t *tiles, int16_t local_x, int16_t local_y,
+    displayio_input_pixel_t *input_pixel, displayio_output_pixel_t *output_pixel) {
+    uint16_t tile_location = ((local_y / self->tile_height + self->top_left_y) % self->height_in_tiles) * self->width_in_tiles + (local_x / self->tile_width + self->top_left_x) % self->width_in_tiles;
+    input_pixel->tile = tiles[tile_location];
+    input_pixel->tile_x = (input_pixel->tile % self->bitmap_width_in_tiles) * self->tile_width + local_x % self->tile_width;
+    input_pixel->tile_y = (input_pixel->tile / self->bitmap_width_in_tiles) * self->tile_height + local_y % self->tile_height;
+
+    output_pixel->pixel = 0;
+    input_pixel->pixel = 0;
+
+    // We always want to read bitmap pixels by row first and then transpose into the destination
+    // buffer because most bitmaps are row associated.
+    if (mp_obj_is_type(self->bitmap, &displayio_bitmap_type)) {
+        input_pixel->pixel = common_hal_displayio_bitmap_get_pixel(self->bitmap, input_pixel->tile_x, input_pixel->tile_y);
+    } else if (mp_obj_is_type(self->bitmap, &displayio_ondiskbitmap_type)) {
+        input_pixel->pixel = common_hal_displayio_ondiskbitmap_get_pixel(self->bitmap, input_pixel->tile_x, input_pixel->tile_y);
+    }
+
+    output_pixel->opaque = true;
+    if (self->pixel_shader == mp_const_none) {
+        output_pixel->pixel = input_pixel->pixel;
+    } else if (mp_obj_is_type(self->pixel_shader, &displayio_palette_type)) {
+        displayio_palette_get_color(self->pixel_shader, colorspace, input_pixel, output_pixel);
+    } else if (mp_obj_is_type(self->pixel_shader, &displayio_colorconverter_type)) {
+        displayio_colorconverter_convert(self->pixel_shader, colorspace, input_pixel, output_pixel);
+    }
+}
+
+// Returns the render cache with every pixel up to date, or NULL when it can't be used.
+static uint32_t *_get_render_cache(displayio_tilegrid_t *self, const _displayio_colorspace_t *colorspace, const uint8_t *tiles) {
+    if (!self->use_render_cache ||
+        (colorspace->depth != 8 && colorspace->depth != 16 && colorspace->depth != 32)) {
+        return NULL;
+    }
+    // Dithered colors depend on where they are on the display.
+    if ((mp_obj_is_type(self->pixel_shader, &displayio_palette_type) &&
+         ((displayio_palette_t *)MP_OBJ_TO_PTR(self->pixel_shader))->dither) ||
+        (mp_obj_is_type(self->pixel_shader, &displayio_colorconverter_type) &&
+         ((displayio_colorconverter_t *)MP_OBJ_TO_PTR(self->pixel_shader))->dither)) {
+        return NULL;
+    }
+    if (self->render_cache != NULL && self->render_cache_depth != colorspace->depth) {
+        _free_render_cache(self);
+    }
+    size_t pixel_count = self->pixel_width * self->pixel_height;
+    if (self->render_cache == NULL) {
+        // Refreshes may run when the heap can't be used.
+        if (!gc_alloc_possible() || gc_is_locked()) {
+            return NULL;
+        }
+        self->render_cache = m_new_maybe(uint32_t, _render_cache_words(self, colorspace->depth));
+        if (self->render_cache == NULL) {
+            // Don't try again on every refresh.
+            self->use_render_cache = false;
+            return NULL;
+        }
+        self->render_cache_depth = colorspace->depth;
+        self->render_cache_colorspace = colorspace;
+        _invalidate_render_cache(self, NULL);
+    } else if (self->render_cache_colorspace != colorspace) {
+        self->render_cache_colorspace = colorspace;
+        _invalidate_render_cache(self, NULL);
+    }
+
+    displayio_area_t *dirty = &self->render_cache_dirty;
+    if (!displayio_area_empty(dirty)) {
+        uint32_t *cache_opaque = self->render_cache + _render_cache_pixel_words(self, colorspace->depth);
+        displayio_input_pixel_t input_pixel;
+        displayio_output_pixel_t output_pixel;
+        for (int16_t y = dirty->y1; y < dirty->y2; y++) {
+            for (int16_t x = dirty->x1; x < dirty->x2; x++) {
+                input_pixel.x = x;
+                input_pixel.y = y;
+                _get_pixel(self, colorspace, tiles, x, y, &input_pixel, &output_pixel);
+                uint32_t index = y * self->pixel_width + x;
+                if (output_pixel.opaque) {
+                    cache_opaque[index / 32] |= 1u << (index % 32);
+                } else {
+                    cache_opaque[index / 32] &= ~(1u << (index % 32));
+                }
+                if (colorspace->depth == 16) {
+                    ((uint16_t *)self->render_cache)[index] = output_pixel.pixel;
+                } else if (colorspace->depth == 32) {
+                    self->render_cache[index] = output_pixel.pixel;
+                } else {
+                    ((uint8_t *)self->render_cache)[index] = output_pixel.pixel;
+                }
+            }
+        }
+        dirty->x1 = 0;
+        dirty->x2 = 0;
+        self->render_cache_opaque = true;
+        for (size_t i = 0; i < pixel_count / 32; i++) {
+            if (cache_opaque[i] != 0xffffffff) {
+                self->render_cache_opaque = false;
+                break;
+            }
+        }
+        // A last partial word.
+        uint32_t last_bits = (1u << (pixel_count % 32)) - 1;
+        if (last_bits != 0 && (cache_opaque[pixel_count / 32] & last_bits) != last_bits) {
+            self->render_cache_opaque = false;
+        }
+    }
+    return self->render_cache;
+}
+
+static inline bool _cache_pixel_opaque(const uint32_t *cache_opaque, uint32_t index) {
+    return (cache_opaque[index / 32] & (1u << (index % 32))) != 0;
+}
+
+static inline uint32_t _cache_pixel(const uint32_t *cache, uint8_t depth, uint32_t index) {
+    if (depth == 16) {
+        return ((const uint16_t *)cache)[index];
+    } else if (depth == 32) {
+        return cache[index];
+    }
+    return ((const uint8_t *)cache)[index];
+}
+
+// Copies count cached pixels from index on into the buffer from offset on, in reverse order.
+static void _copy_reversed(uint32_t *buffer, uint8_t depth, int32_t offset, const uint32_t *cache, uint32_t index, size_t count) {
+    if (depth == 16) {
+        uint16_t *row = (uint16_t *)buffer + offset + count - 1;
+        const uint16_t *pixels = (const uint16_t *)cache + index;
+        for (size_t i = 0; i < count; i++) {
+            *row-- = pixels[i];
+        }
+    } else if (depth == 32) {
+        uint32_t *row = buffer + offset + count - 1;
+        for (size_t i = 0; i < count; i++) {
+            *row-- = cache[index + i];
+        }
+    } else {
+        uint8_t *row = (uint8_t *)buffer + offset + count - 1;
+        const uint8_t *pixels = (const uint8_t *)cache + index;
+        for (size_t i = 0; i < count; i++) {
+            *row-- = pixels[i];
+        }
+    }
+}
+
+// Writes count copies of pixel from offset on, for depths of a byte or more.
+static inline void _fill_pixels(uint32_t *buffer, uint8_t depth, int32_t offset, size_t count, uint32_t pixel) {
+    if (depth == 16) {
+        uint16_t *row = (uint16_t *)buffer + offset;
+        for (size_t i = 0; i < count; i++) {
+            row[i] = pixel;
+        }
+    } else if (depth == 32) {
+        uint32_t *row = buffer + offset;
+        for (size_t i = 0; i < count; i++) {
+            row[i] = pixel;
+        }
+    } else {
+        memset((uint8_t *)buffer + offset, pixel, count);
+    }
 }
 
 bool displayio_tilegrid_fill_area(displayio_tilegrid_t *self,
@@ -409,11 +642,6 @@ bool displayio_tilegrid_fill_area(displayio_tilegrid_t *self,
     // layers at that point.
     bool full_coverage = displayio_area_equal(area, &overlap);
 
-    // TODO(tannewt): Skip coverage tracking if all pixels outside the overlap have already been
-    // set and our palette is all opaque.
-
-    // TODO(tannewt): Check to see if the pixel_shader has any transparency. If it doesn't then we
-    // can either return full coverage or bulk update the mask.
     displayio_area_t transformed;
     displayio_area_transform_within(flip_x != (self->absolute_transform->dx < 0), flip_y != (self->absolute_transform->dy < 0), self->transpose_xy != self->absolute_transform->transpose_xy,
         &overlap,
@@ -450,9 +678,97 @@ bool displayio_tilegrid_fill_area(displayio_tilegrid_t *self,
 
     uint8_t pixels_per_byte = 8 / colorspace->depth;
 
+    uint32_t *cache = _get_render_cache(self, colorspace, tiles);
+    uint32_t *cache_opaque = NULL;
+    if (cache != NULL) {
+        cache_opaque = cache + _render_cache_pixel_words(self, colorspace->depth);
+    }
+
     displayio_input_pixel_t input_pixel;
     displayio_output_pixel_t output_pixel;
 
+    // Without a mask this layer simply draws over the ones below it, so each row is written as
+    // runs of opaque pixels: copied straight from the render cache when it isn't scaled and
+    // otherwise filled a source pixel at a time. A scaled up row that is all opaque is copied
+    // down to the rows that repeat it.
+    if (mask == NULL && colorspace->depth >= 8 && (x_stride == 1 || x_stride == -1)) {
+        uint8_t bytes_per_pixel = colorspace->depth / 8;
+        uint16_t scale = self->absolute_transform->scale;
+        size_t row_bytes = (end_x - start_x) * bytes_per_pixel;
+        int32_t last_left = 0;
+        int16_t last_local_y = -1;
+        bool last_opaque = false;
+        for (input_pixel.y = start_y; input_pixel.y < end_y; ++input_pixel.y) {
+            // The buffer offset of start_x and of the leftmost pixel of the row, in pixels.
+            int32_t row_start = start + (input_pixel.y - start_y + y_shift) * y_stride + x_shift * x_stride;
+            int32_t row_left = x_stride == 1 ? row_start : row_start - (end_x - start_x - 1);
+            int16_t local_y = input_pixel.y / scale;
+            if (local_y == last_local_y && last_opaque) {
+                memcpy((uint8_t *)buffer + row_left * bytes_per_pixel,
+                    (uint8_t *)buffer + last_left * bytes_per_pixel, row_bytes);
+                continue;
+            }
+            bool row_opaque = true;
+            if (cache != NULL && scale == 1) {
+                uint32_t row_index = local_y * self->pixel_width;
+                int16_t x = start_x;
+                while (x < end_x) {
+                    while (x < end_x && !_cache_pixel_opaque(cache_opaque, row_index + x)) {
+                        row_opaque = false;
+                        x++;
+                    }
+                    int16_t run_start = x;
+                    if (self->render_cache_opaque) {
+                        x = end_x;
+                    }
+                    while (x < end_x && _cache_pixel_opaque(cache_opaque, row_index + x)) {
+                        x++;
+                    }
+                    if (x_stride == 1) {
+                        memcpy((uint8_t *)buffer + (row_start + run_start - start_x) * bytes_per_pixel,
+                            (uint8_t *)cache + (row_index + run_start) * bytes_per_pixel,
+                            (x - run_start) * bytes_per_pixel);
+                    } else {
+                        _copy_reversed(buffer, colorspace->depth, row_start - (x - 1 - start_x),
+                            cache, row_index + run_start, x - run_start);
+                    }
+                }
+            } else {
+                input_pixel.x = start_x;
+                while (input_pixel.x < end_x) {
+                    int16_t local_x = input_pixel.x / scale;
+                    int16_t run_end = MIN(end_x, (local_x + 1) * scale);
+                    if (cache != NULL) {
+                        uint32_t index = local_y * self->pixel_width + local_x;
+                        output_pixel.opaque = _cache_pixel_opaque(cache_opaque, index);
+                        output_pixel.pixel = _cache_pixel(cache, colorspace->depth, index);
+                    } else {
+                        _get_pixel(self, colorspace, tiles, local_x, local_y, &input_pixel, &output_pixel);
+                    }
+                    if (output_pixel.opaque) {
+                        size_t count = run_end - input_pixel.x;
+                        int32_t offset = row_start + (input_pixel.x - start_x) * x_stride;
+                        if (x_stride < 0) {
+                            offset -= count - 1;
+                        }
+                        _fill_pixels(buffer, colorspace->depth, offset, count, output_pixel.pixel);
+                    } else {
+                        row_opaque = false;
+                    }
+                    input_pixel.x = run_end;
+                }
+            }
+            if (!row_opaque) {
+                // A pixel is transparent so we haven't fully covered the area ourselves.
+                full_coverage = false;
+            }
+            last_left = row_left;
+            last_local_y = local_y;
+            last_opaque = row_opaque;
+        }
+        return full_coverage;
+    }
+
     for (input_pixel.y = start_y; input_pixel.y < end_y; ++input_pixel.y) {
         int16_t row_start = start + (input_pixel.y - start_y + y_shift) * y_stride; // in pixels
         int16_t local_y = input_pixel.y / self->absolute_transform->scale;
@@ -466,39 +782,24 @@ bool displayio_tilegrid_fill_area(displayio_tilegrid_t *self,
             // }
 
             // Check the mask first to see if the pixel has already been set.
-            if ((mask[offset / 32] & (1 << (offset % 32))) != 0) {
+            if (mask != NULL && (mask[offset / 32] & (1 << (offset % 32))) != 0) {
                 continue;
             }
             int16_t local_x = input_pixel.x / self->absolute_transform->scale;
-            uint16_t tile_location = ((local_y / self->tile_height + self->top_left_y) % self->height_in_tiles) * self->width_in_tiles + (local_x / self->tile_width + self->top_left_x) % self->width_in_tiles;
-            input_pixel.tile = tiles[tile_location];
-            input_pixel.tile_x = (input_pixel.tile % self->bitmap_width_in_tiles) * self->tile_width + local_x % self->tile_width;
-            input_pixel.tile_y = (input_pixel.tile / self->bitmap_width_in_tiles) * self->tile_height + local_y % self->tile_height;
-
-            output_pixel.pixel = 0;
-            input_pixel.pixel = 0;
-
-            // We always want to read bitmap pixels by row first and then transpose into the destination
-            // buffer because most bitmaps are row associated.
-            if (mp_obj_is_type(self->bitmap, &displayio_bitmap_type)) {
-                input_pixel.pixel = common_hal_displayio_bitmap_get_pixel(self->bitmap, input_pixel.tile_x, input_pixel.tile_y);
-            } else if (mp_obj_is_type(self->bitmap, &displayio_ondiskbitmap_type)) {
-                input_pixel.pixel = common_hal_displayio_ondiskbitmap_get_pixel(self->bitmap, input_pixel.tile_x, input_pixel.tile_y);
-            }
-
-            output_pixel.opaque = true;
-            if (self->pixel_shader == mp_const_none) {
-                output_pixel.pixel = input_pixel.pixel;
-            } else if (mp_obj_is_type(self->pixel_shader, &displayio_palette_type)) {
-                displayio_palette_get_color(self->pixel_shader, colorspace, &input_pixel, &output_pixel);
-            } else if (mp_obj_is_type(self->pixel_shader, &displayio_colorconverter_type)) {
-                displayio_colorconverter_convert(self->pixel_shader, colorspace, &input_pixel, &output_pixel);
+            if (cache != NULL) {
+                uint32_t index = local_y * self->pixel_width + local_x;
+                output_pixel.opaque = _cache_pixel_opaque(cache_opaque, index);
+                output_pixel.pixel = _cache_pixel(cache, colorspace->depth, index);
+            } else {
+                _get_pixel(self, colorspace, tiles, local_x, local_y, &input_pixel, &output_pixel);
             }
             if (!output_pixel.opaque) {
                 // A pixel is transparent so we haven't fully covered the area ourselves.
                 full_coverage = false;
             } else {
-                mask[offset / 32] |= 1 << (offset % 32);
+                if (mask != NULL) {
+                    mask[offset / 32] |= 1 << (offset % 32);
+                }
                 if (colorspace->depth == 16) {
                     *(((uint16_t *)buffer) + offset) = output_pixel.pixel;
                 } else if (colorspace->depth == 32) {
@@ -531,6 +832,93 @@ bool displayio_tilegrid_fill_area(displayio_tilegrid_t *self,
     return full_coverage;
 }
 
+bool displayio_tilegrid_covers_area(displayio_tilegrid_t *self, const displayio_area_t *area) {
+    if (self->hidden || self->hidden_by_parent || (self->tiles == NULL && !self->inline_tiles)) {
+        return false;
+    }
+    displayio_area_t overlap;
+    if (!displayio_area_compute_overlap(area, &self->current_area, &overlap) ||
+        !displayio_area_equal(area, &overlap)) {
+        return false;
+    }
+    if (mp_obj_is_type(self->pixel_shader, &displayio_palette_type)) {
+        return displayio_palette_is_opaque(self->pixel_shader);
+    } else if (mp_obj_is_type(self->pixel_shader, &displayio_colorconverter_type)) {
+        return displayio_colorconverter_is_opaque(self->pixel_shader);
+    }
+    return self->pixel_shader == mp_const_none;
+}
+
+// True when anything other than tiles, top_left or position changed since the last refresh.
+static bool _content_changed(displayio_tilegrid_t *self) {
+    if (self->full_change) {
+        return true;
+    }
+    if (mp_obj_is_type(self->bitmap, &displayio_bitmap_type) &&
+        !displayio_area_empty(&((displayio_bitmap_t *)MP_OBJ_TO_PTR(self->bitmap))->dirty_area)) {
+        return true;
+    }
+    return (mp_obj_is_type(self->pixel_shader, &displayio_palette_type) &&
+            displayio_palette_needs_refresh(self->pixel_shader)) ||
+           (mp_obj_is_type(self->pixel_shader, &displayio_colorconverter_type) &&
+               displayio_colorconverter_needs_refresh(self->pixel_shader));
+}
+
+bool displayio_tilegrid_get_scroll(displayio_tilegrid_t *self, displayio_area_t *area, int16_t *dy) {
+    bool first_draw = self->previous_area.x1 == self->previous_area.x2;
+    if (self->scrolled_rows == 0 || first_draw || self->moved || self->hidden || self->hidden_by_parent ||
+        self->absolute_transform->transpose_xy || _content_changed(self)) {
+        return false;
+    }
+    displayio_area_copy(&self->current_area, area);
+    *dy = -self->scrolled_rows * self->tile_height * self->absolute_transform->dy;
+    return true;
+}
+
+bool displayio_tilegrid_only_moved_by(displayio_tilegrid_t *self, int16_t dy) {
+    bool first_draw = self->previous_area.x1 == self->previous_area.x2;
+    if (self->hidden || self->hidden_by_parent) {
+        // Nothing to move when it wasn't shown before either.
+        return first_draw;
+    }
+    if (first_draw || self->partial_change || self->scrolled_rows != 0 || _content_changed(self)) {
+        return false;
+    }
+    displayio_area_t moved;
+    displayio_area_copy(&self->previous_area, &moved);
+    displayio_area_shift(&moved, 0, dy);
+    return displayio_area_equal(&moved, &self->current_area);
+}
+
+void displayio_tilegrid_finish_scroll(displayio_tilegrid_t *self) {
+    if (self->scrolled_rows != 0) {
+        // The rows at the edge the content moved away from now show tiles that wrapped around
+        // from the other edge.
+        displayio_area_t exposed = {
+            .x1 = 0,
+            .y1 = 0,
+            .x2 = self->pixel_width,
+            .y2 = self->pixel_height,
+        };
+        if (self->scrolled_rows > 0) {
+            exposed.y1 = self->pixel_height - self->scrolled_rows * self->tile_height;
+        } else {
+            exposed.y2 = -self->scrolled_rows * self->tile_height;
+        }
+        if (self->partial_change) {
+            displayio_area_union(&self->dirty_area, &exposed, &self->dirty_area);
+        } else {
+            displayio_area_copy(&exposed, &self->dirty_area);
+        }
+        self->partial_change = true;
+        self->scrolled_rows = 0;
+    }
+    if (self->moved) {
+        displayio_area_copy(&self->current_area, &self->previous_area);
+        self->moved = false;
+    }
+}
+
 void displayio_tilegrid_finish_refresh(displayio_tilegrid_t *self) {
     bool first_draw = self->previous_area.x1 == self->previous_area.x2;
     bool hidden = self->hidden || self->hidden_by_parent;
@@ -543,6 +931,7 @@ void displayio_tilegrid_finish_refresh(displayio_tilegrid_t *self) {
     self->moved = false;
     self->full_change = false;
     self->partial_change = false;
+    self->scrolled_rows = 0;
     if (mp_obj_is_type(self->pixel_shader, &displayio_palette_type)) {
         displayio_palette_finish_refresh(self->pixel_shader);
     } else if (mp_obj_is_type(self->pixel_shader, &displayio_colorconverter_type)) {
@@ -558,7 +947,35 @@ void displayio_tilegrid_finish_refresh(displayio_tilegrid_t *self) {
     // That way they won't change during a refresh and tear.
 }
 
+// Marks the render cache pixels that the changes since the last refresh affect.
+static void _check_render_cache(displayio_tilegrid_t *self) {
+    if (self->full_change ||
+        (mp_obj_is_type(self->pixel_shader, &displayio_palette_type) &&
+         displayio_palette_needs_refresh(self->pixel_shader))) {
+        _invalidate_render_cache(self, NULL);
+        return;
+    }
+    if (mp_obj_is_type(self->bitmap, &displayio_bitmap_type)) {
+        const displayio_area_t *bitmap_dirty = &((displayio_bitmap_t *)MP_OBJ_TO_PTR(self->bitmap))->dirty_area;
+        if (!displayio_area_empty(bitmap_dirty)) {
+            // Only a single tile maps bitmap pixels directly to ours.
+            if (self->width_in_tiles == 1 && self->height_in_tiles == 1 && self->tiles_in_bitmap == 1) {
+                _invalidate_render_cache(self, bitmap_dirty);
+            } else {
+                _invalidate_render_cache(self, NULL);
+                return;
+            }
+        }
+    }
+    if (self->partial_change) {
+        _invalidate_render_cache(self, &self->dirty_area);
+    }
+}
+
 displayio_area_t *displayio_tilegrid_get_refresh_areas(displayio_tilegrid_t *self, displayio_area_t *tail) {
+    if (self->render_cache != NULL) {
+        _check_render_cache(self);
+    }
     bool first_draw = self->previous_area.x1 == self->previous_area.x2;
     bool hidden = self->hidden || self->hidden_by_parent;
     // Check hidden first because it trumps all other changes.
@@ -596,7 +1013,7 @@ displayio_area_t *displayio_tilegrid_get_refresh_areas(displayio_tilegrid_t *sel
         }
     }
 
-    self->full_change = self->full_change ||
+    self->full_change = self->full_change || self->scrolled_rows != 0 ||
         (mp_obj_is_type(self->pixel_shader, &displayio_palette_type) &&
             displayio_palette_needs_refresh(self->pixel_shader)) ||
         (mp_obj_is_type(self->pixel_shader, &displayio_colorconverter_type) &&
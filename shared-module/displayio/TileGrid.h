@@ -30,11 +30,18 @@ typedef struct {
     uint16_t tile_height;
     uint16_t top_left_x;
     uint16_t top_left_y;
+    int16_t scrolled_rows; // Tile rows the content moved up (or down, if negative) by top_left changes since the last refresh.
     uint8_t *tiles;
     const displayio_buffer_transform_t *absolute_transform;
     displayio_area_t dirty_area; // Stored as a relative area until the refresh area is fetched.
     displayio_area_t previous_area; // Stored as an absolute area.
     displayio_area_t current_area; // Stored as an absolute area so it applies across frames.
+    // Every pixel converted to render_cache_colorspace followed by a bit per pixel that is set
+    // when it's opaque. Allocated on first use when use_render_cache is set.
+    uint32_t *render_cache;
+    const _displayio_colorspace_t *render_cache_colorspace;
+    displayio_area_t render_cache_dirty; // Pixels to convert again. Relative to the TileGrid.
+    uint8_t render_cache_depth;
     bool partial_change : 1;
     bool full_change : 1;
     bool moved : 1;
@@ -46,7 +53,9 @@ typedef struct {
     bool hidden : 1;
     bool hidden_by_parent : 1;
     bool rendered_hidden : 1;
-    uint8_t padding : 6;
+    bool use_render_cache : 1;
+    bool render_cache_opaque : 1; // All pixels in the render cache are opaque.
+    uint8_t padding : 4;
 } displayio_tilegrid_t;
 
 void displayio_tilegrid_set_hidden_by_parent(displayio_tilegrid_t *self, bool hidden);
@@ -57,8 +66,12 @@ void displayio_tilegrid_set_hidden_by_parent(displayio_tilegrid_t *self, bool hi
 displayio_area_t *displayio_tilegrid_get_refresh_areas(displayio_tilegrid_t *self, displayio_area_t *tail);
 
 // Area is always in absolute screen coordinates. Update transform is used to inform TileGrids how
-// they relate to it.
+// they relate to it. When mask is NULL, every opaque pixel is written without checking or setting
+// the mask. Groups do this when they draw their layers from the bottom up.
 bool displayio_tilegrid_fill_area(displayio_tilegrid_t *self, const _displayio_colorspace_t *colorspace, const displayio_area_t *area, uint32_t *mask, uint32_t *buffer);
+// True when the tilegrid draws every pixel of area with an opaque pixel shader. Palettes are
+// only opaque for indices they contain so fill_area's result must still be checked.
+bool displayio_tilegrid_covers_area(displayio_tilegrid_t *self, const displayio_area_t *area);
 void displayio_tilegrid_update_transform(displayio_tilegrid_t *group, const displayio_buffer_transform_t *parent_transform);
 
 // Fills in area with the maximum bounds of all related pixels in the last rendered frame. Returns
@@ -67,3 +80,15 @@ bool displayio_tilegrid_get_previous_area(displayio_tilegrid_t *self, displayio_
 void displayio_tilegrid_finish_refresh(displayio_tilegrid_t *self);
 
 bool displayio_tilegrid_get_rendered_hidden(displayio_tilegrid_t *self);
+
+// Displays that can scroll what is already on screen use these to avoid redrawing it.
+// get_scroll is true when the only change since the last refresh is that the content moved
+// vertically because top_left changed. area is set to the TileGrid's absolute area and dy to
+// how far the content moved along it.
+bool displayio_tilegrid_get_scroll(displayio_tilegrid_t *self, displayio_area_t *area, int16_t *dy);
+// True when the only change since the last refresh is that the TileGrid moved dy pixels in
+// absolute coordinates.
+bool displayio_tilegrid_only_moved_by(displayio_tilegrid_t *self, int16_t dy);
+// Called once the display has moved the pixels on screen so only what the move exposed in the
+// TileGrid is refreshed.
+void displayio_tilegrid_finish_scroll(displayio_tilegrid_t *self);
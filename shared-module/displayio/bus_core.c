@@ -55,6 +55,7 @@ void displayio_display_bus_construct(displayio_display_bus_t *self,
         self->bus_free = common_hal_paralleldisplaybus_parallelbus_bus_free;
         self->begin_transaction = common_hal_paralleldisplaybus_parallelbus_begin_transaction;
         self->send = common_hal_paralleldisplaybus_parallelbus_send;
+        self->start_send = common_hal_paralleldisplaybus_parallelbus_start_send;
         self->end_transaction = common_hal_paralleldisplaybus_parallelbus_end_transaction;
         self->collect_ptrs = common_hal_paralleldisplaybus_parallelbus_collect_ptrs;
     } else
@@ -65,6 +66,7 @@ void displayio_display_bus_construct(displayio_display_bus_t *self,
         self->bus_free = common_hal_fourwire_fourwire_bus_free;
         self->begin_transaction = common_hal_fourwire_fourwire_begin_transaction;
         self->send = common_hal_fourwire_fourwire_send;
+        self->start_send = common_hal_fourwire_fourwire_start_send;
         self->end_transaction = common_hal_fourwire_fourwire_end_transaction;
         self->collect_ptrs = common_hal_fourwire_fourwire_collect_ptrs;
     } else
@@ -75,6 +77,7 @@ void displayio_display_bus_construct(displayio_display_bus_t *self,
         self->bus_free = common_hal_i2cdisplaybus_i2cdisplaybus_bus_free;
         self->begin_transaction = common_hal_i2cdisplaybus_i2cdisplaybus_begin_transaction;
         self->send = common_hal_i2cdisplaybus_i2cdisplaybus_send;
+        self->start_send = common_hal_i2cdisplaybus_i2cdisplaybus_send;
         self->end_transaction = common_hal_i2cdisplaybus_i2cdisplaybus_end_transaction;
         self->collect_ptrs = common_hal_i2cdisplaybus_i2cdisplaybus_collect_ptrs;
     } else
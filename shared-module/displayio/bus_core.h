@@ -20,6 +20,9 @@ typedef struct {
     display_bus_bus_free bus_free;
     display_bus_begin_transaction begin_transaction;
     display_bus_send send;
+    // Like send, but may return before the data has been sent. The data must
+    // not change until end_transaction, which waits for it.
+    display_bus_send start_send;
     display_bus_end_transaction end_transaction;
     display_bus_collect_ptrs collect_ptrs;
     uint16_t ram_width;
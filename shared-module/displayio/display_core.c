@@ -203,3 +203,45 @@ bool displayio_display_core_clip_area(displayio_display_core_t *self, const disp
     }
     return true;
 }
+
+size_t displayio_display_core_coalesce_areas(displayio_display_core_t *self, const displayio_area_t *areas,
+    displayio_area_t *coalesced, size_t max_areas, uint32_t overhead_pixels) {
+    size_t count = 0;
+    for (const displayio_area_t *area = areas; area != NULL; area = area->next) {
+        if (!displayio_display_core_clip_area(self, area, &coalesced[count])) {
+            continue;
+        }
+        count++;
+        // Merge the cheapest pair until no merge pays for itself and we're within the limit.
+        while (count > 1) {
+            size_t best_i = 0;
+            size_t best_j = 0;
+            int32_t best_cost = INT32_MAX;
+            for (size_t i = 0; i < count - 1; i++) {
+                for (size_t j = i + 1; j < count; j++) {
+                    displayio_area_t merged;
+                    displayio_area_union(&coalesced[i], &coalesced[j], &merged);
+                    // Pixels sent beyond the two separate areas. Negative when they overlap.
+                    int32_t cost = (int32_t)displayio_area_size(&merged) -
+                        (int32_t)displayio_area_size(&coalesced[i]) -
+                        (int32_t)displayio_area_size(&coalesced[j]);
+                    if (cost < best_cost) {
+                        best_cost = cost;
+                        best_i = i;
+                        best_j = j;
+                    }
+                }
+            }
+            if (best_cost > (int32_t)overhead_pixels && count <= max_areas) {
+                break;
+            }
+            displayio_area_union(&coalesced[best_i], &coalesced[best_j], &coalesced[best_i]);
+            count--;
+            displayio_area_copy(&coalesced[count], &coalesced[best_j]);
+        }
+    }
+    for (size_t i = 0; i < count; i++) {
+        coalesced[i].next = i + 1 < count ? &coalesced[i + 1] : NULL;
+    }
+    return count;
+}
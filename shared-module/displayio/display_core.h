@@ -13,6 +13,11 @@
 
 #define NO_COMMAND 0x100
 
+// The most areas displayio_display_core_coalesce_areas() will produce.
+#ifndef DISPLAYIO_MAX_REFRESH_AREAS
+#define DISPLAYIO_MAX_REFRESH_AREAS (8)
+#endif
+
 typedef struct {
     displayio_group_t *current_group;
     uint64_t last_refresh;
@@ -51,3 +56,10 @@ void displayio_display_core_collect_ptrs(displayio_display_core_t *self);
 bool displayio_display_core_fill_area(displayio_display_core_t *self, displayio_area_t *area, uint32_t *mask, uint32_t *buffer);
 
 bool displayio_display_core_clip_area(displayio_display_core_t *self, const displayio_area_t *area, displayio_area_t *clipped);
+
+// Clips the linked list of areas to the display and merges them into at most max_areas linked
+// areas in coalesced, which must have room for max_areas + 1. Two areas are merged when the
+// pixels the merged area adds cost less than overhead_pixels, the cost of starting an area, or
+// when there are too many. Returns the number of areas, which start at coalesced[0].
+size_t displayio_display_core_coalesce_areas(displayio_display_core_t *self, const displayio_area_t *areas,
+    displayio_area_t *coalesced, size_t max_areas, uint32_t overhead_pixels);
@@ -11,4 +11,6 @@ enum mipi_command {
     MIPI_COMMAND_SET_COLUMN_ADDRESS = 0x2a,
     MIPI_COMMAND_SET_PAGE_ADDRESS = 0x2b,
     MIPI_COMMAND_WRITE_MEMORY_START = 0x2c,
+    MIPI_COMMAND_SET_SCROLL_AREA = 0x33,
+    MIPI_COMMAND_SET_SCROLL_START = 0x37,
 };
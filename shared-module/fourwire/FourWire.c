@@ -101,6 +101,7 @@ bool common_hal_fourwire_fourwire_begin_transaction(mp_obj_t obj) {
 void common_hal_fourwire_fourwire_send(mp_obj_t obj, display_byte_type_t data_type,
     display_chip_select_behavior_t chip_select, const uint8_t *data, uint32_t data_length) {
     fourwire_fourwire_obj_t *self = MP_OBJ_TO_PTR(obj);
+    common_hal_busio_spi_wait_for_write(self->bus);
     if (self->command.base.type == &mp_type_NoneType) {
         // When the data/command pin is not specified, we simulate a 9-bit SPI mode, by
         // adding a data/command bit to every byte, and then splitting the resulting data back
@@ -159,8 +160,22 @@ void common_hal_fourwire_fourwire_send(mp_obj_t obj, display_byte_type_t data_ty
     }
 }
 
+void common_hal_fourwire_fourwire_start_send(mp_obj_t obj, display_byte_type_t data_type,
+    display_chip_select_behavior_t chip_select, const uint8_t *data, uint32_t data_length) {
+    fourwire_fourwire_obj_t *self = MP_OBJ_TO_PTR(obj);
+    // Only a plain write of the data can go on in the background.
+    if (self->command.base.type == &mp_type_NoneType || chip_select == CHIP_SELECT_TOGGLE_EVERY_BYTE) {
+        common_hal_fourwire_fourwire_send(obj, data_type, chip_select, data, data_length);
+        return;
+    }
+    common_hal_busio_spi_wait_for_write(self->bus);
+    common_hal_digitalio_digitalinout_set_value(&self->command, data_type == DISPLAY_DATA);
+    common_hal_busio_spi_start_write(self->bus, data, data_length);
+}
+
 void common_hal_fourwire_fourwire_end_transaction(mp_obj_t obj) {
     fourwire_fourwire_obj_t *self = MP_OBJ_TO_PTR(obj);
+    common_hal_busio_spi_wait_for_write(self->bus);
     if (self->chip_select.base.type != &mp_type_NoneType) {
         common_hal_digitalio_digitalinout_set_value(&self->chip_select, true);
     }
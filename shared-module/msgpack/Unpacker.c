@@ -0,0 +1,129 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include <string.h>
+
+#include "py/runtime.h"
+#include "py/stream.h"
+
+#include "shared-bindings/msgpack/Unpacker.h"
+#include "shared-module/msgpack/__init__.h"
+
+void common_hal_msgpack_unpacker_construct(msgpack_unpacker_obj_t *self, mp_obj_t stream, size_t read_size, mp_obj_t ext_hook, bool use_list, bool bin_memoryview) {
+    if (stream != MP_OBJ_NULL) {
+        mp_get_stream_raise(stream, MP_STREAM_OP_READ);
+    }
+    self->stream = stream;
+    self->ext_hook = ext_hook;
+    self->read_size = read_size;
+    self->use_list = use_list;
+    self->bin_memoryview = bin_memoryview;
+    self->alloc = read_size;
+    self->buf = m_new(uint8_t, self->alloc);
+    self->start = 0;
+    self->end = 0;
+    self->need = 1;
+    self->shared = false;
+    self->unpacking = false;
+}
+
+// Make room for at least len more bytes after the buffered data.
+static void make_room(msgpack_unpacker_obj_t *self, size_t len) {
+    if (len <= self->alloc - self->end) {
+        return;
+    }
+    size_t used = self->end - self->start;
+    if (!self->shared && !self->unpacking && len <= self->alloc - used) {
+        memmove(self->buf, self->buf + self->start, used);
+    } else {
+        // Returned memoryviews and an unpack in progress still refer to the
+        // old buffer, so leave it as it is for the GC to free when they're done.
+        size_t alloc = self->alloc;
+        while (alloc < used + len) {
+            alloc *= 2;
+        }
+        uint8_t *buf = m_new(uint8_t, alloc);
+        memcpy(buf, self->buf + self->start, used);
+        self->buf = buf;
+        self->alloc = alloc;
+        self->shared = false;
+    }
+    self->start = 0;
+    self->end = used;
+}
+
+void common_hal_msgpack_unpacker_feed(msgpack_unpacker_obj_t *self, const uint8_t *data, size_t len) {
+    make_room(self, len);
+    memcpy(self->buf + self->end, data, len);
+    self->end += len;
+}
+
+// Read whatever the stream has, up to read_size bytes.  Returns false if it
+// had nothing.
+static bool read_stream(msgpack_unpacker_obj_t *self) {
+    // Fill what's left of the buffer before making more room: a buffer that
+    // returned memoryviews refer to can't be compacted, only replaced.
+    if (self->end == self->alloc) {
+        make_room(self, self->read_size);
+    }
+    size_t len = MIN(self->read_size, self->alloc - self->end);
+    int errcode;
+    mp_uint_t ret = mp_stream_rw(self->stream, self->buf + self->end, len, &errcode, MP_STREAM_RW_READ | MP_STREAM_RW_ONCE);
+    if (errcode != 0) {
+        if (mp_is_nonblocking_error(errcode)) {
+            return false;
+        }
+        mp_raise_OSError(errcode);
+    }
+    self->end += ret;
+    return ret > 0;
+}
+
+mp_obj_t common_hal_msgpack_unpacker_next(msgpack_unpacker_obj_t *self) {
+    size_t size;
+    for (;;) {
+        size_t avail = self->end - self->start;
+        if (avail >= self->need) {
+            if (msgpack_object_complete(self->buf + self->start, avail, &size)) {
+                break;
+            }
+            // a partial object: wait until there's more than this
+            self->need = avail + 1;
+        }
+        if (self->stream == MP_OBJ_NULL || !read_stream(self)) {
+            return MP_OBJ_STOP_ITERATION;
+        }
+    }
+
+    // Unpacking may run ext_hook, which may feed more data, so the buffer
+    // is kept where it is until it's done.  Keep a pointer to its start so
+    // that the GC does too, even if it's replaced meanwhile.
+    uint8_t *buf = self->buf;
+    size_t start = self->start;
+    self->unpacking = true;
+    mp_obj_t obj;
+    nlr_buf_t nlr;
+    if (nlr_push(&nlr) == 0) {
+        obj = msgpack_unpack_buffer(buf, start, size, self->ext_hook, self->use_list, self->bin_memoryview);
+        nlr_pop();
+    } else {
+        self->unpacking = false;
+        nlr_jump(nlr.ret_val);
+    }
+    self->unpacking = false;
+
+    // feed() starts a new buffer from start, and otherwise start is unchanged
+    self->start += size;
+    self->need = 1;
+    if (self->bin_memoryview && buf == self->buf) {
+        self->shared = true;
+    }
+    if (self->start == self->end && !self->shared) {
+        self->start = 0;
+        self->end = 0;
+    }
+    return obj;
+}
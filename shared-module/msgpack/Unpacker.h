@@ -0,0 +1,30 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "py/obj.h"
+
+typedef struct {
+    mp_obj_base_t base;
+    // MP_OBJ_NULL if data is given with feed()
+    mp_obj_t stream;
+    mp_obj_t ext_hook;
+    // buffered data is buf[start:end]
+    uint8_t *buf;
+    size_t alloc;
+    size_t start;
+    size_t end;
+    // don't look for another object until this much is buffered
+    size_t need;
+    size_t read_size;
+    bool use_list;
+    bool bin_memoryview;
+    // memoryviews of buf have been returned, so it must not be overwritten
+    bool shared;
+    // an object is being unpacked from buf, so it must not be moved
+    bool unpacking;
+} msgpack_unpacker_obj_t;
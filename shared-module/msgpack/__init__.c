@@ -5,6 +5,7 @@
 // SPDX-License-Identifier: MIT
 
 #include <stdio.h>
+#include <string.h>
 #include <inttypes.h>
 
 #include "py/obj.h"
@@ -28,21 +29,35 @@ typedef struct _msgpack_stream_t {
     mp_uint_t (*read)(mp_obj_t obj, void *buf, mp_uint_t size, int *errcode);
     mp_uint_t (*write)(mp_obj_t obj, const void *buf, mp_uint_t size, int *errcode);
     int errcode;
+    // When stream_obj is MP_OBJ_NULL, reads come from memory instead.
+    const uint8_t *pos;
+    const uint8_t *end;
+    // If not NULL, the heap block that holds that memory, and bin objects
+    // are returned as memoryviews into it.
+    uint8_t *view_base;
 } msgpack_stream_t;
 
 static msgpack_stream_t get_stream(mp_obj_t stream_obj, int flags) {
     const mp_stream_p_t *stream_p = mp_get_stream_raise(stream_obj, flags);
-    msgpack_stream_t s = {stream_obj, stream_p->read, stream_p->write, 0};
+    msgpack_stream_t s = {stream_obj, stream_p->read, stream_p->write, 0, NULL, NULL, NULL};
     return s;
 }
 
 ////////////////////////////////////////////////////////////////
 // readers
 
-static void read(msgpack_stream_t *s, void *buf, mp_uint_t size) {
+static void read_bytes(msgpack_stream_t *s, void *buf, mp_uint_t size) {
     if (size == 0) {
         return;
     }
+    if (s->stream_obj == MP_OBJ_NULL) {
+        if (size > (mp_uint_t)(s->end - s->pos)) {
+            mp_raise_msg(&mp_type_EOFError, NULL);
+        }
+        memcpy(buf, s->pos, size);
+        s->pos += size;
+        return;
+    }
     mp_uint_t ret = s->read(s->stream_obj, buf, size, &s->errcode);
     if (s->errcode != 0) {
         mp_raise_OSError(s->errcode);
@@ -57,13 +72,13 @@ static void read(msgpack_stream_t *s, void *buf, mp_uint_t size) {
 
 static uint8_t read1(msgpack_stream_t *s) {
     uint8_t res = 0;
-    read(s, &res, 1);
+    read_bytes(s, &res, 1);
     return res;
 }
 
 static uint16_t read2(msgpack_stream_t *s) {
     uint16_t res = 0;
-    read(s, &res, 2);
+    read_bytes(s, &res, 2);
     int n = 1;
     if (*(char *)&n == 1) {
         res = __builtin_bswap16(res);
@@ -73,7 +88,7 @@ static uint16_t read2(msgpack_stream_t *s) {
 
 static uint32_t read4(msgpack_stream_t *s) {
     uint32_t res = 0;
-    read(s, &res, 4);
+    read_bytes(s, &res, 4);
     int n = 1;
     if (*(char *)&n == 1) {
         res = __builtin_bswap32(res);
@@ -83,7 +98,7 @@ static uint32_t read4(msgpack_stream_t *s) {
 
 static uint64_t read8(msgpack_stream_t *s) {
     uint64_t res = 0;
-    read(s, &res, 8);
+    read_bytes(s, &res, 8);
     int n = 1;
     if (*(char *)&n == 1) {
         res = __builtin_bswap64(res);
@@ -110,7 +125,7 @@ static size_t read_size(msgpack_stream_t *s, uint8_t len_index) {
 ////////////////////////////////////////////////////////////////
 // writers
 
-static void write(msgpack_stream_t *s, const void *buf, mp_uint_t size) {
+static void write_bytes(msgpack_stream_t *s, const void *buf, mp_uint_t size) {
     mp_uint_t ret = s->write(s->stream_obj, buf, size, &s->errcode);
     if (s->errcode != 0) {
         mp_raise_OSError(s->errcode);
@@ -121,7 +136,7 @@ static void write(msgpack_stream_t *s, const void *buf, mp_uint_t size) {
 }
 
 static void write1(msgpack_stream_t *s, uint8_t obj) {
-    write(s, &obj, 1);
+    write_bytes(s, &obj, 1);
 }
 
 static void write2(msgpack_stream_t *s, uint16_t obj) {
@@ -129,7 +144,7 @@ static void write2(msgpack_stream_t *s, uint16_t obj) {
     if (*(char *)&n == 1) {
         obj = __builtin_bswap16(obj);
     }
-    write(s, &obj, 2);
+    write_bytes(s, &obj, 2);
 }
 
 static void write4(msgpack_stream_t *s, uint32_t obj) {
@@ -137,7 +152,7 @@ static void write4(msgpack_stream_t *s, uint32_t obj) {
     if (*(char *)&n == 1) {
         obj = __builtin_bswap32(obj);
     }
-    write(s, &obj, 4);
+    write_bytes(s, &obj, 4);
 }
 
 // compute and write msgpack size code (array structures)
@@ -192,7 +207,7 @@ static void pack_int(msgpack_stream_t *s, int32_t x) {
 static void pack_bin(msgpack_stream_t *s, const uint8_t *data, size_t len) {
     write_size(s, 0xc4, len);
     if (len > 0) {
-        write(s, data, len);
+        write_bytes(s, data, len);
     }
 }
 
@@ -212,7 +227,7 @@ static void pack_ext(msgpack_stream_t *s, int8_t code, const uint8_t *data, size
     }
     write1(s, code);    // type byte
     if (len > 0) {
-        write(s, data, len);
+        write_bytes(s, data, len);
     }
 }
 
@@ -223,7 +238,7 @@ static void pack_str(msgpack_stream_t *s, const char *str, size_t len) {
         write_size(s, 0xd9, len);
     }
     if (len > 0) {
-        write(s, str, len);
+        write_bytes(s, str, len);
     }
 }
 
@@ -342,16 +357,37 @@ static mp_obj_t unpack_array_elements(msgpack_stream_t *s, size_t size, mp_obj_t
     }
 }
 
+static mp_obj_t unpack_map_elements(msgpack_stream_t *s, size_t size, mp_obj_t ext_hook, bool use_list) {
+    mp_obj_dict_t *d = MP_OBJ_TO_PTR(mp_obj_new_dict(size));
+    for (size_t i = 0; i < size; i++) {
+        // the key comes first, so it must be unpacked before the value
+        mp_obj_t key = unpack(s, ext_hook, use_list);
+        mp_obj_dict_store(d, key, unpack(s, ext_hook, use_list));
+    }
+    return MP_OBJ_FROM_PTR(d);
+}
+
 static mp_obj_t unpack_bytes(msgpack_stream_t *s, size_t size) {
+    // a truncated payload in a buffer shouldn't allocate anything
+    if (s->stream_obj == MP_OBJ_NULL && size > (size_t)(s->end - s->pos)) {
+        mp_raise_msg(&mp_type_EOFError, NULL);
+    }
+    if (s->stream_obj == MP_OBJ_NULL && s->view_base != NULL) {
+        // view the payload where it is, rather than copying it
+        mp_obj_array_t *view = MP_OBJ_TO_PTR(mp_obj_new_memoryview('B', size, s->view_base));
+        view->free = s->pos - s->view_base; // memoryview offset
+        s->pos += size;
+        return MP_OBJ_FROM_PTR(view);
+    }
     vstr_t vstr;
     vstr_init_len(&vstr, size);
     byte *p = (byte *)vstr.buf;
     // read in chunks: (some drivers - e.g. UART) limit the
     // maximum number of bytes that can be read at once
-    // read(s, p, size);
+    // read_bytes(s, p, size);
     while (size > 0) {
         int n = size > 256 ? 256 : size;
-        read(s, p, n);
+        read_bytes(s, p, n);
         size -= n;
         p += n;
     }
@@ -360,7 +396,10 @@ static mp_obj_t unpack_bytes(msgpack_stream_t *s, size_t size) {
 
 static mp_obj_t unpack_ext(msgpack_stream_t *s, size_t size, mp_obj_t ext_hook) {
     int8_t code = read1(s);
+    uint8_t *view_base = s->view_base;
+    s->view_base = NULL;
     mp_obj_t data = unpack_bytes(s, size);
+    s->view_base = view_base;
     if (ext_hook != mp_const_none) {
         return mp_call_function_2(ext_hook, MP_OBJ_NEW_SMALL_INT(code), data);
     } else {
@@ -382,7 +421,7 @@ static mp_obj_t unpack(msgpack_stream_t *s, mp_obj_t ext_hook, bool use_list) {
         size_t len = code & 0b11111;
         // allocate on stack; len < 32
         char str[len];
-        read(s, &str, len);
+        read_bytes(s, &str, len);
         return mp_obj_new_str(str, len);
     }
     if ((code & 0b11110000) == 0b10010000) {
@@ -391,12 +430,7 @@ static mp_obj_t unpack(msgpack_stream_t *s, mp_obj_t ext_hook, bool use_list) {
     }
     if ((code & 0b11110000) == 0b10000000) {
         // map (dict)
-        size_t len = code & 0b1111;
-        mp_obj_dict_t *d = MP_OBJ_TO_PTR(mp_obj_new_dict(len));
-        for (size_t i = 0; i < len; i++) {
-            mp_obj_dict_store(d, unpack(s, ext_hook, use_list), unpack(s, ext_hook, use_list));
-        }
-        return MP_OBJ_FROM_PTR(d);
+        return unpack_map_elements(s, code & 0b1111, ext_hook, use_list);
     }
     switch (code) {
         case 0xc0:
@@ -453,18 +487,14 @@ static mp_obj_t unpack(msgpack_stream_t *s, mp_obj_t ext_hook, bool use_list) {
             vstr_t vstr;
             vstr_init_len(&vstr, size);
             byte *p = (byte *)vstr.buf;
-            read(s, p, size);
+            read_bytes(s, p, size);
             return mp_obj_new_str_from_vstr(&vstr);
         }
         case 0xde:
         case 0xdf: {
             // map 16 & 32
             size_t len = read_size(s, code - 0xde + 1);
-            mp_obj_dict_t *d = MP_OBJ_TO_PTR(mp_obj_new_dict(len));
-            for (size_t i = 0; i < len; i++) {
-                mp_obj_dict_store(d, unpack(s, ext_hook, use_list), unpack(s, ext_hook, use_list));
-            }
-            return MP_OBJ_FROM_PTR(d);
+            return unpack_map_elements(s, len, ext_hook, use_list);
         }
         case 0xdc:
         case 0xdd: {
@@ -502,3 +532,136 @@ mp_obj_t common_hal_msgpack_unpack(mp_obj_t stream_obj, mp_obj_t ext_hook, bool
     msgpack_stream_t stream = get_stream(stream_obj, MP_STREAM_OP_READ);
     return unpack(&stream, ext_hook, use_list);
 }
+
+////////////////////////////////////////////////////////////////
+// unpacking from memory
+
+// Big-endian length of n bytes at p.
+static size_t read_length(const uint8_t *p, size_t n) {
+    size_t res = 0;
+    for (size_t i = 0; i < n; i++) {
+        res = (res << 8) | p[i];
+    }
+    return res;
+}
+
+bool msgpack_object_complete(const uint8_t *buf, size_t len, size_t *size) {
+    const uint8_t *p = buf;
+    const uint8_t *end = buf + len;
+    // Objects still to be skipped.  Containers add their elements to this, so
+    // nesting needs no recursion.
+    size_t remaining = 1;
+    while (remaining > 0) {
+        // every object takes at least one byte
+        if (remaining > (size_t)(end - p)) {
+            return false;
+        }
+        uint8_t code = *p++;
+        remaining--;
+        // bytes of length after the code, and of payload after that
+        size_t length_size = 0;
+        size_t skip = 0;
+        size_t elements = 0;
+        if (((code & 0b10000000) == 0) || ((code & 0b11100000) == 0b11100000)) {
+            // fixint
+        } else if ((code & 0b11100000) == 0b10100000) {
+            skip = code & 0b11111;
+        } else if ((code & 0b11110000) == 0b10010000) {
+            elements = code & 0b1111;
+        } else if ((code & 0b11110000) == 0b10000000) {
+            elements = 2 * (code & 0b1111);
+        } else {
+            switch (code) {
+                case 0xc0:
+                case 0xc2:
+                case 0xc3:
+                    break;
+                case 0xc4:
+                case 0xc5:
+                case 0xc6:
+                    length_size = 1 << (code - 0xc4);
+                    break;
+                case 0xd9:
+                case 0xda:
+                case 0xdb:
+                    length_size = 1 << (code - 0xd9);
+                    break;
+                case 0xc7:
+                case 0xc8:
+                case 0xc9:
+                    length_size = 1 << (code - 0xc7);
+                    skip = 1; // type byte
+                    break;
+                case 0xcc:
+                case 0xd0:
+                    skip = 1;
+                    break;
+                case 0xcd:
+                case 0xd1:
+                    skip = 2;
+                    break;
+                case 0xce:
+                case 0xd2:
+                case 0xca:
+                    skip = 4;
+                    break;
+                case 0xcf:
+                case 0xd3:
+                case 0xcb:
+                    skip = 8;
+                    break;
+                case 0xd4:
+                case 0xd5:
+                case 0xd6:
+                case 0xd7:
+                case 0xd8:
+                    skip = 1 + (1 << (code - 0xd4));
+                    break;
+                case 0xdc:
+                case 0xdd:
+                case 0xde:
+                case 0xdf:
+                    length_size = code & 1 ? 4 : 2;
+                    break;
+                default:
+                    mp_raise_ValueError(MP_ERROR_TEXT("Invalid format"));
+            }
+            if (length_size > 0) {
+                if (length_size > (size_t)(end - p)) {
+                    return false;
+                }
+                size_t length = read_length(p, length_size);
+                p += length_size;
+                // each element takes at least one byte, so checking the
+                // length against what's buffered also avoids overflow
+                if (length > (size_t)(end - p)) {
+                    return false;
+                }
+                if (code >= 0xde) {
+                    elements = 2 * length;
+                } else if (code >= 0xdc) {
+                    elements = length;
+                } else {
+                    skip += length;
+                }
+            }
+        }
+        if (skip > (size_t)(end - p)) {
+            return false;
+        }
+        p += skip;
+        remaining += elements;
+    }
+    *size = p - buf;
+    return true;
+}
+
+mp_obj_t msgpack_unpack_buffer(uint8_t *base, size_t offset, size_t len, mp_obj_t ext_hook, bool use_list, bool bin_memoryview) {
+    msgpack_stream_t s = {
+        .stream_obj = MP_OBJ_NULL,
+        .pos = base + offset,
+        .end = base + offset + len,
+        .view_base = bin_memoryview ? base : NULL,
+    };
+    return unpack(&s, ext_hook, use_list);
+}
@@ -9,3 +9,9 @@
 
 void common_hal_msgpack_pack(mp_obj_t obj, mp_obj_t stream_obj, mp_obj_t default_handler);
 mp_obj_t common_hal_msgpack_unpack(mp_obj_t stream_obj, mp_obj_t ext_hook, bool use_list);
+
+// Whether buf holds a whole msgpack object, and if so how many bytes it takes.
+bool msgpack_object_complete(const uint8_t *buf, size_t len, size_t *size);
+// Unpack the object at base + offset, which must be complete.  base must be
+// the start of a heap block if bin_memoryview is true.
+mp_obj_t msgpack_unpack_buffer(uint8_t *base, size_t offset, size_t len, mp_obj_t ext_hook, bool use_list, bool bin_memoryview);
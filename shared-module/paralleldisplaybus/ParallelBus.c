@@ -15,6 +15,12 @@ MP_WEAK void common_hal_paralleldisplaybus_parallelbus_construct_nonsequential(p
     mp_raise_NotImplementedError(MP_ERROR_TEXT("This microcontroller only supports data0=, not data_pins=, because it requires contiguous pins."));
 }
 
+// Ports that can send in the background override this.
+MP_WEAK void common_hal_paralleldisplaybus_parallelbus_start_send(mp_obj_t self, display_byte_type_t byte_type,
+    display_chip_select_behavior_t chip_select, const uint8_t *data, uint32_t data_length) {
+    common_hal_paralleldisplaybus_parallelbus_send(self, byte_type, chip_select, data, data_length);
+}
+
 MP_WEAK void common_hal_paralleldisplaybus_parallelbus_collect_ptrs(mp_obj_t self) {
 
 }
@@ -56,11 +56,18 @@ mp_float_t common_hal_synthio_lfo_tick(mp_obj_t self_in) {
 
     mp_float_t scale = synthio_block_slot_get(&lfo->scale);
     mp_float_t offset = synthio_block_slot_get(&lfo->offset);
-    value = MICROPY_FLOAT_C_FUN(ldexp)(value, -15) * scale + offset;
+    // scaling by a power of two is exact, so this is ldexp(value, -15) without the call
+    value = value * (MICROPY_FLOAT_CONST(1.) / 32768) * scale + offset;
 
     return value;
 }
 
+synthio_block_slot_t *common_hal_synthio_lfo_get_input(mp_obj_t self_in, size_t i) {
+    synthio_lfo_obj_t *lfo = MP_OBJ_TO_PTR(self_in);
+    synthio_block_slot_t *inputs[] = { &lfo->rate, &lfo->phase_offset, &lfo->scale, &lfo->offset };
+    return i < MP_ARRAY_SIZE(inputs) ? inputs[i] : NULL;
+}
+
 mp_obj_t common_hal_synthio_lfo_get_waveform_obj(synthio_lfo_obj_t *self) {
     return self->waveform_obj;
 }
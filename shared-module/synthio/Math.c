@@ -23,6 +23,10 @@ synthio_math_operation_t common_hal_synthio_math_get_operation(synthio_math_obj_
 }
 
 void common_hal_synthio_math_set_operation(synthio_math_obj_t *self, synthio_math_operation_t arg) {
+    if ((self->operation == OP_ABS) != (arg == OP_ABS)) {
+        // which inputs are read has changed
+        synthio_block_generation++;
+    }
     self->operation = arg;
 }
 
@@ -32,6 +36,12 @@ mp_float_t common_hal_synthio_math_get_value(synthio_math_obj_t *self) {
     return self->base.value;
 }
 
+synthio_block_slot_t *common_hal_synthio_math_get_input(mp_obj_t self_in, size_t i) {
+    synthio_math_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    size_t n = self->operation == OP_ABS ? 1 : MP_ARRAY_SIZE(self->inputs);
+    return i < n ? &self->inputs[i] : NULL;
+}
+
 mp_float_t common_hal_synthio_math_tick(mp_obj_t self_in) {
     synthio_math_obj_t *self = MP_OBJ_TO_PTR(self_in);
     mp_float_t a = synthio_block_slot_get(&self->inputs[0]);
@@ -0,0 +1,418 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include <string.h>
+
+#include "py/mperrno.h"
+#include "py/runtime.h"
+#include "shared-bindings/synthio/MidiFile.h"
+
+#define DEFAULT_TEMPO (500000) // 120 beats per minute
+
+static uint32_t read_be(const uint8_t *buf, size_t len) {
+    uint32_t result = 0;
+    for (size_t i = 0; i < len; i++) {
+        result = (result << 8) | buf[i];
+    }
+    return result;
+}
+
+static void read_exactly(synthio_midifile_obj_t *self, uint32_t offset, uint8_t *buf, size_t len) {
+    UINT bytes_read;
+    if (f_lseek(&self->file->fp, offset) != FR_OK || f_read(&self->file->fp, buf, len, &bytes_read) != FR_OK) {
+        mp_raise_OSError(MP_EIO);
+    }
+    if (bytes_read != len) {
+        mp_arg_error_invalid(MP_QSTR_file);
+    }
+}
+
+static uint32_t track_offset(synthio_midifile_track_t *track) {
+    return track->pos - track->buf_len + track->buf_pos;
+}
+
+static void record_error(synthio_midifile_obj_t *self, synthio_midifile_track_t *track) {
+    // errors cannot be raised from the background task, so just end the track.
+    if (self->error_location < 0) {
+        self->error_location = track_offset(track);
+    }
+}
+
+// Returns the track's next byte, or -1 at its end or if the file can't be read
+static int track_read(synthio_midifile_obj_t *self, synthio_midifile_track_t *track) {
+    if (track->buf_pos == track->buf_len) {
+        uint32_t n = MIN(SYNTHIO_MIDIFILE_READ_SIZE, track->end - track->pos);
+        UINT bytes_read;
+        if (n == 0
+            || f_lseek(&self->file->fp, track->pos) != FR_OK
+            || f_read(&self->file->fp, track->buf, n, &bytes_read) != FR_OK
+            || bytes_read != n) {
+            return -1;
+        }
+        track->pos += n;
+        track->buf_pos = 0;
+        track->buf_len = n;
+    }
+    return track->buf[track->buf_pos++];
+}
+
+static bool track_skip(synthio_midifile_track_t *track, uint32_t n) {
+    uint32_t buffered = track->buf_len - track->buf_pos;
+    if (n <= buffered) {
+        track->buf_pos += n;
+        return true;
+    }
+    n -= buffered;
+    if (n > track->end - track->pos) {
+        return false;
+    }
+    track->pos += n;
+    track->buf_pos = track->buf_len = 0;
+    return true;
+}
+
+static bool track_read_varlen(synthio_midifile_obj_t *self, synthio_midifile_track_t *track, uint32_t *value) {
+    uint32_t result = 0;
+    // at most 4 bytes are allowed
+    for (int i = 0; i < 4; i++) {
+        int c = track_read(self, track);
+        if (c < 0) {
+            return false;
+        }
+        result = (result << 7) | (c & 0x7f);
+        if (!(c & 0x80)) {
+            *value = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+static int track_read_data(synthio_midifile_obj_t *self, synthio_midifile_track_t *track) {
+    int c = track_read(self, track);
+    return c > 127 ? -1 : c;
+}
+
+// The sample at which a tick falls, rounded to the nearest
+static uint64_t tick_to_sample(synthio_midifile_obj_t *self, uint32_t tick) {
+    // microseconds * division; this and the remainder times the sample rate fit in 64 bits
+    uint64_t us_scaled = (uint64_t)(tick - self->tempo_tick) * self->tempo;
+    uint64_t den = (uint64_t)self->division * 1000000;
+    uint32_t sample_rate = self->synth.sample_rate;
+    return self->tempo_sample + us_scaled / den * sample_rate + (us_scaled % den * sample_rate + den / 2) / den;
+}
+
+static bool heap_less(synthio_midifile_obj_t *self, uint8_t a, uint8_t b) {
+    uint32_t tick_a = self->tracks[a].tick, tick_b = self->tracks[b].tick;
+    return tick_a < tick_b || (tick_a == tick_b && a < b);
+}
+
+static void heap_sift_down(synthio_midifile_obj_t *self, size_t i) {
+    uint8_t *heap = self->heap;
+    while (true) {
+        size_t least = i;
+        size_t left = 2 * i + 1, right = left + 1;
+        if (left < self->heap_len && heap_less(self, heap[left], heap[least])) {
+            least = left;
+        }
+        if (right < self->heap_len && heap_less(self, heap[right], heap[least])) {
+            least = right;
+        }
+        if (least == i) {
+            return;
+        }
+        uint8_t t = heap[i];
+        heap[i] = heap[least];
+        heap[least] = t;
+        i = least;
+    }
+}
+
+static void heap_push(synthio_midifile_obj_t *self, uint8_t track) {
+    uint8_t *heap = self->heap;
+    size_t i = self->heap_len++;
+    while (i > 0 && heap_less(self, track, heap[(i - 1) / 2])) {
+        heap[i] = heap[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    heap[i] = track;
+}
+
+// Reads the time of the track's next event. Returns false at the end of the track.
+static bool track_next(synthio_midifile_obj_t *self, synthio_midifile_track_t *track) {
+    // A track should finish with an End of Track event, but it's no error if it doesn't
+    if (track_offset(track) == track->end) {
+        return false;
+    }
+    uint32_t delta;
+    if (!track_read_varlen(self, track, &delta)) {
+        record_error(self, track);
+        return false;
+    }
+    track->tick += delta;
+    return true;
+}
+
+static bool track_play_meta_event(synthio_midifile_obj_t *self, synthio_midifile_track_t *track) {
+    int type = track_read_data(self, track);
+    uint32_t len;
+    if (type < 0 || !track_read_varlen(self, track, &len)) {
+        record_error(self, track);
+        return false;
+    }
+    if (type == 0x2f) { // End of Track
+        return false;
+    }
+    if (type == 0x51 && len == 3 && !self->smpte) { // Set Tempo
+        uint8_t buf[3];
+        for (size_t i = 0; i < 3; i++) {
+            int c = track_read(self, track);
+            if (c < 0) {
+                record_error(self, track);
+                return false;
+            }
+            buf[i] = c;
+        }
+        uint32_t tempo = read_be(buf, 3);
+        if (tempo > 0) {
+            self->tempo_sample = tick_to_sample(self, track->tick);
+            self->tempo_tick = track->tick;
+            self->tempo = tempo;
+        }
+        return true;
+    }
+    if (!track_skip(track, len)) {
+        record_error(self, track);
+        return false;
+    }
+    return true;
+}
+
+// Plays the track's next event. Returns false when the track has ended.
+static bool track_play_event(synthio_midifile_obj_t *self, synthio_midifile_track_t *track) {
+    int status = track_read(self, track);
+    int data = -1;
+    if (status < 0) {
+        record_error(self, track);
+        return false;
+    }
+    if (status < 0x80) {
+        // running status: this was the first data byte
+        data = status;
+        status = track->status;
+        if (status == 0) {
+            record_error(self, track);
+            return false;
+        }
+    } else if (status < 0xf0) {
+        track->status = status;
+    } else {
+        // system exclusive and meta events cancel running status
+        track->status = 0;
+    }
+
+    int data_bytes = 2;
+    switch (status >> 4) {
+        case 8: // Note Off
+        case 9: { // Note On
+            int note = data >= 0 ? data : track_read_data(self, track);
+            int velocity = track_read_data(self, track);
+            if (note < 0 || velocity < 0) {
+                record_error(self, track);
+                return false;
+            }
+            // Note On with no velocity is the usual way to turn a note off, as it allows running status.
+            if ((status >> 4) == 9 && velocity > 0) {
+                synthio_span_change_note(&self->synth, SYNTHIO_SILENCE, MP_OBJ_NEW_SMALL_INT(note));
+            } else {
+                synthio_span_change_note(&self->synth, MP_OBJ_NEW_SMALL_INT(note), SYNTHIO_SILENCE);
+            }
+            return true;
+        }
+        case 12:
+        case 13:
+            data_bytes = 1;
+            MP_FALLTHROUGH;
+        case 10:
+        case 11:
+        case 14: // data bytes to ignore
+            for (int i = data >= 0 ? 1 : 0; i < data_bytes; i++) {
+                if (track_read_data(self, track) < 0) {
+                    record_error(self, track);
+                    return false;
+                }
+            }
+            return true;
+    }
+
+    if (status == 0xff) {
+        return track_play_meta_event(self, track);
+    }
+    uint32_t len;
+    if ((status == 0xf0 || status == 0xf7) && track_read_varlen(self, track, &len) && track_skip(track, len)) {
+        return true;
+    }
+    // Other system messages are not allowed in a file
+    record_error(self, track);
+    return false;
+}
+
+// Plays the events that are due by the end of the audio rendered so far and sets the number of
+// samples to render until the next one. This is 0 when every track has ended.
+static void play_due_events(synthio_midifile_obj_t *self) {
+    while (self->heap_len > 0) {
+        uint8_t index = self->heap[0];
+        synthio_midifile_track_t *track = &self->tracks[index];
+        uint64_t when = tick_to_sample(self, track->tick);
+        if (when > self->sample) {
+            self->synth.span.dur = MIN(when - self->sample, UINT16_MAX);
+            return;
+        }
+        if (!track_play_event(self, track) || !track_next(self, track)) {
+            self->heap[0] = self->heap[--self->heap_len];
+        }
+        heap_sift_down(self, 0);
+    }
+    self->synth.span.dur = 0;
+}
+
+static void start_parse(synthio_midifile_obj_t *self) {
+    self->error_location = -1;
+    self->tempo = self->start_tempo;
+    self->tempo_tick = 0;
+    self->tempo_sample = 0;
+    self->sample = 0;
+    for (size_t i = 0; i < CIRCUITPY_SYNTHIO_MAX_CHANNELS; i++) {
+        self->synth.span.note_obj[i] = SYNTHIO_SILENCE;
+    }
+
+    self->heap_len = 0;
+    for (uint8_t i = 0; i < self->track_count; i++) {
+        synthio_midifile_track_t *track = &self->tracks[i];
+        track->pos = track->start;
+        track->buf_pos = track->buf_len = 0;
+        track->status = 0;
+        track->tick = 0;
+        if (track_next(self, track)) {
+            heap_push(self, i);
+        }
+    }
+    play_due_events(self);
+}
+
+void common_hal_synthio_midifile_construct(synthio_midifile_obj_t *self, pyb_file_obj_t *file,
+    uint32_t sample_rate, mp_obj_t waveform_obj, mp_obj_t envelope_obj) {
+    self->file = file;
+
+    uint8_t header[14];
+    read_exactly(self, 0, header, sizeof(header));
+    uint32_t header_len = read_be(header + 4, 4);
+    uint32_t format = read_be(header + 8, 2);
+    if (memcmp(header, "MThd", 4) || header_len < 6 || format > 1) {
+        // Format 2 files are a set of separate patterns and not a song
+        mp_arg_error_invalid(MP_QSTR_file);
+    }
+    self->track_count = mp_arg_validate_int_range(read_be(header + 10, 2), 1, SYNTHIO_MIDIFILE_MAX_TRACKS, MP_QSTR_tracks);
+
+    self->smpte = header[12] & 0x80;
+    if (self->smpte) {
+        // frames per second, as a negative number, then ticks per frame. 29 is 30 drop-frame.
+        uint32_t fps = -(int8_t)header[12];
+        self->start_tempo = fps == 29 ? 33367 : 1000000 / MAX(fps, 1);
+        self->division = header[13];
+    } else {
+        self->start_tempo = DEFAULT_TEMPO;
+        self->division = read_be(header + 12, 2);
+    }
+    if (self->division == 0) {
+        mp_arg_error_invalid(MP_QSTR_file);
+    }
+
+    self->tracks = m_malloc(self->track_count * sizeof(synthio_midifile_track_t));
+    self->heap = m_malloc(self->track_count);
+
+    // Find the track chunks, skipping any of other types
+    uint32_t size = f_size(&file->fp);
+    uint32_t offset = 8 + header_len;
+    for (uint8_t i = 0; i < self->track_count;) {
+        uint8_t chunk_header[8];
+        read_exactly(self, offset, chunk_header, sizeof(chunk_header));
+        uint32_t len = read_be(chunk_header + 4, 4);
+        offset += sizeof(chunk_header);
+        if (len > size - offset) {
+            mp_arg_error_invalid(MP_QSTR_file);
+        }
+        if (memcmp(chunk_header, "MTrk", 4) == 0) {
+            self->tracks[i].start = offset;
+            self->tracks[i].end = offset + len;
+            i++;
+        }
+        offset += len;
+    }
+
+    synthio_synth_init(&self->synth, sample_rate, 1, waveform_obj, envelope_obj);
+
+    start_parse(self);
+}
+
+void common_hal_synthio_midifile_deinit(synthio_midifile_obj_t *self) {
+    synthio_synth_deinit(&self->synth);
+    self->tracks = NULL;
+    self->heap = NULL;
+}
+
+bool common_hal_synthio_midifile_deinited(synthio_midifile_obj_t *self) {
+    return synthio_synth_deinited(&self->synth);
+}
+
+mp_int_t common_hal_synthio_midifile_get_error_location(synthio_midifile_obj_t *self) {
+    return self->error_location;
+}
+
+uint8_t common_hal_synthio_midifile_get_track_count(synthio_midifile_obj_t *self) {
+    return self->track_count;
+}
+
+uint32_t common_hal_synthio_midifile_get_sample_rate(synthio_midifile_obj_t *self) {
+    return self->synth.sample_rate;
+}
+uint8_t common_hal_synthio_midifile_get_bits_per_sample(synthio_midifile_obj_t *self) {
+    return SYNTHIO_BITS_PER_SAMPLE;
+}
+uint8_t common_hal_synthio_midifile_get_channel_count(synthio_midifile_obj_t *self) {
+    return 1;
+}
+
+void synthio_midifile_reset_buffer(synthio_midifile_obj_t *self,
+    bool single_channel_output, uint8_t channel) {
+    synthio_synth_reset_buffer(&self->synth, single_channel_output, channel);
+    start_parse(self);
+}
+
+audioio_get_buffer_result_t synthio_midifile_get_buffer(synthio_midifile_obj_t *self,
+    bool single_channel_output, uint8_t channel, uint8_t **buffer, uint32_t *buffer_length) {
+    if (common_hal_synthio_midifile_deinited(self)) {
+        *buffer_length = 0;
+        return GET_BUFFER_ERROR;
+    }
+
+    // The synth renders up to the next event, so events start on the sample they're due.
+    uint16_t dur = self->synth.span.dur;
+    synthio_synth_synthesize(&self->synth, buffer, buffer_length, single_channel_output ? 0 : channel);
+    self->sample += dur - self->synth.span.dur;
+    if (self->synth.span.dur == 0) {
+        play_due_events(self);
+        if (self->synth.span.dur == 0) {
+            return GET_BUFFER_DONE;
+        }
+    }
+    return GET_BUFFER_MORE_DATA;
+}
+
+void synthio_midifile_get_buffer_structure(synthio_midifile_obj_t *self, bool single_channel_output,
+    bool *single_buffer, bool *samples_signed, uint32_t *max_buffer_length, uint8_t *spacing) {
+    return synthio_synth_get_buffer_structure(&self->synth, single_channel_output, single_buffer, samples_signed, max_buffer_length, spacing);
+}
@@ -0,0 +1,61 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "extmod/vfs_fat.h"
+#include "py/obj.h"
+
+#include "shared-module/synthio/__init__.h"
+
+// Bytes of each track that are read from the file at a time
+#define SYNTHIO_MIDIFILE_READ_SIZE (64)
+#define SYNTHIO_MIDIFILE_MAX_TRACKS (64)
+
+typedef struct {
+    uint32_t start, end; // file offsets of the track's events
+    uint32_t pos; // file offset of buf[buf_len]
+    uint32_t tick; // of the next event
+    uint8_t status; // for running status
+    uint8_t buf_pos, buf_len;
+    uint8_t buf[SYNTHIO_MIDIFILE_READ_SIZE];
+} synthio_midifile_track_t;
+
+typedef struct {
+    mp_obj_base_t base;
+    synthio_synth_t synth;
+    pyb_file_obj_t *file;
+    synthio_midifile_track_t *tracks;
+    // Indices of the tracks that haven't ended, as a min-heap ordered by the tick of each
+    // track's next event and then by index.
+    uint8_t *heap;
+    uint8_t track_count, heap_len;
+    bool smpte; // division is in ticks per frame and tempo is in microseconds per frame
+    uint16_t division; // ticks per quarter note
+    uint32_t tempo; // microseconds per quarter note
+    uint32_t start_tempo;
+    // Timing since the last tempo change, to the sample, so rounding doesn't accumulate
+    uint32_t tempo_tick;
+    uint64_t tempo_sample;
+    uint64_t sample; // of the end of the audio rendered so far
+    mp_int_t error_location;
+} synthio_midifile_obj_t;
+
+
+// These are not available from Python because it may be called in an interrupt.
+void synthio_midifile_reset_buffer(synthio_midifile_obj_t *self,
+    bool single_channel_output,
+    uint8_t channel);
+
+audioio_get_buffer_result_t synthio_midifile_get_buffer(synthio_midifile_obj_t *self,
+    bool single_channel_output,
+    uint8_t channel,
+    uint8_t **buffer,
+    uint32_t *buffer_length); // length in bytes
+
+void synthio_midifile_get_buffer_structure(synthio_midifile_obj_t *self, bool single_channel_output,
+    bool *single_buffer, bool *samples_signed,
+    uint32_t *max_buffer_length, uint8_t *spacing);
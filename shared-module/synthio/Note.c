@@ -36,7 +36,12 @@ mp_float_t common_hal_synthio_note_get_ring_frequency(synthio_note_obj_t *self)
 void common_hal_synthio_note_set_ring_frequency(synthio_note_obj_t *self, mp_float_t value_in) {
     mp_float_t val = mp_arg_validate_float_range(value_in, 0, 32767, MP_QSTR_ring_frequency);
     self->ring_frequency = val;
-    self->ring_frequency_scaled = synthio_frequency_convert_float_to_scaled(val);
+    int32_t ring_frequency_scaled = synthio_frequency_convert_float_to_scaled(val);
+    if ((self->ring_frequency_scaled == 0) != (ring_frequency_scaled == 0)) {
+        // ring_bend is only read while there is a ring frequency
+        synthio_block_generation++;
+    }
+    self->ring_frequency_scaled = ring_frequency_scaled;
 }
 
 mp_obj_t common_hal_synthio_note_get_panning(synthio_note_obj_t *self) {
@@ -18,6 +18,7 @@ void common_hal_synthio_synthesizer_construct(synthio_synthesizer_obj_t *self,
 
     synthio_synth_init(&self->synth, sample_rate, channel_count, waveform_obj, envelope_obj);
     self->blocks = mp_obj_new_list(0, NULL);
+    self->synth.block_program.blocks = self->blocks;
 }
 
 void common_hal_synthio_synthesizer_deinit(synthio_synthesizer_obj_t *self) {
@@ -61,7 +62,7 @@ audioio_get_buffer_result_t synthio_synthesizer_get_buffer(synthio_synthesizer_o
         if (!synthio_obj_is_block(item)) {
             continue;
         }
-        synthio_block_slot_t slot = { item };
+        synthio_block_slot_t slot = { .obj = item, .block = MP_OBJ_TO_PTR(item) };
         (void)synthio_block_slot_get(&slot);
     }
     return GET_BUFFER_MORE_DATA;
@@ -15,6 +15,7 @@
 
 mp_float_t synthio_global_rate_scale;
 uint8_t synthio_global_tick;
+uint32_t synthio_block_generation;
 
 static const int16_t square_wave[] = {-32768, 32767};
 
@@ -152,7 +153,126 @@ int16_t mix_down_sample(int32_t sample) {
     return sample;
 }
 
-static bool synth_note_into_buffer(synthio_synth_t *synth, int chan, int32_t *out_buffer32, int16_t dur, int16_t loudness[2]) {
+// (sample * loudness) >> 16, with the loudness in the bottom or top half of a
+// word holding that of both output channels
+__attribute__((always_inline))
+static inline int32_t scale_by_loudness_bottom(int32_t sample, uint32_t loudness) {
+    #if (defined(__ARM_ARCH_7EM__) && (__ARM_ARCH_7EM__ == 1))
+    int32_t result;
+    asm ("smulwb %0, %1, %2" : "=r" (result) : "r" (sample), "r" (loudness));
+    return result;
+    #else
+    return (sample * (int16_t)loudness) >> 16;
+    #endif
+}
+
+__attribute__((always_inline))
+static inline int32_t scale_by_loudness_top(int32_t sample, uint32_t loudness) {
+    #if (defined(__ARM_ARCH_7EM__) && (__ARM_ARCH_7EM__ == 1))
+    int32_t result;
+    asm ("smulwt %0, %1, %2" : "=r" (result) : "r" (sample), "r" (loudness));
+    return result;
+    #else
+    return (sample * (int16_t)(loudness >> 16)) >> 16;
+    #endif
+}
+
+static uint32_t pack_loudness(const int16_t loudness[2]) {
+    return (uint16_t)loudness[0] | ((uint32_t)(uint16_t)loudness[1] << 16);
+}
+
+// What an oscillator pass does with each sample it generates
+enum {
+    // store it in the buffer
+    SYNTH_PASS_STORE,
+    // scale it by the loudness and add it to a mono buffer
+    SYNTH_PASS_SUM_MONO,
+    // scale it by the loudness of each channel and add it to a stereo buffer
+    SYNTH_PASS_SUM_STEREO,
+};
+
+__attribute__((always_inline))
+static inline void synth_pass_emit(int mode, int32_t *out_buffer32, size_t i, int32_t sample, uint32_t loudness) {
+    if (mode == SYNTH_PASS_STORE) {
+        out_buffer32[i] = sample;
+    } else if (mode == SYNTH_PASS_SUM_MONO) {
+        out_buffer32[i] += scale_by_loudness_bottom(sample, loudness);
+    } else {
+        out_buffer32[2 * i] += scale_by_loudness_bottom(sample, loudness);
+        out_buffer32[2 * i + 1] += scale_by_loudness_top(sample, loudness);
+    }
+}
+
+__attribute__((always_inline))
+static inline int32_t synth_pass_sample(const int16_t *waveform, uint32_t accum, const int32_t *modulate, size_t i) {
+    int32_t sample = waveform[accum >> SYNTHIO_FREQUENCY_SHIFT];
+    if (modulate) {
+        sample = (int16_t)((sample * modulate[i]) / 32768);
+    }
+    return sample;
+}
+
+// Step a DDS oscillator through dur samples of waveform, optionally ring
+// modulating the samples in modulate, and return the new phase.  The phase
+// only wraps once every few samples, so the samples in between are done in
+// a run that doesn't check for it.
+__attribute__((always_inline))
+static inline uint32_t synth_pass(int mode, int32_t *out_buffer32, const int32_t *modulate, size_t dur, uint32_t loudness,
+    const int16_t *waveform, uint32_t accum, uint32_t dds_rate, uint32_t offset, uint32_t lim) {
+    size_t i = 0;
+    while (i < dur) {
+        size_t run = dur - i;
+        if (accum > lim) {
+            run = 0;
+        } else if (dds_rate > 0) {
+            run = MIN(run, (lim - accum) / dds_rate);
+        }
+        for (size_t end = i + run; i < end; i++) {
+            accum += dds_rate;
+            synth_pass_emit(mode, out_buffer32, i, synth_pass_sample(waveform, accum, modulate, i), loudness);
+        }
+        if (i < dur) {
+            accum += dds_rate;
+            // because dds_rate is low enough, the subtraction is guaranteed to go back into range, no expensive modulo needed
+            if (accum > lim) {
+                accum = accum - lim + offset;
+            }
+            synth_pass_emit(mode, out_buffer32, i, synth_pass_sample(waveform, accum, modulate, i), loudness);
+            i++;
+        }
+    }
+    return accum;
+}
+
+static uint32_t synth_oscillator(int mode, int32_t *out_buffer32, const int32_t *modulate, size_t dur, uint32_t loudness,
+    const int16_t *waveform, uint32_t accum, uint32_t dds_rate, uint32_t offset, uint32_t lim) {
+    // expand synth_pass for each mode, so that each has a loop of its own
+    #define SYNTH_PASS(mode, modulate) synth_pass(mode, out_buffer32, modulate, dur, loudness, waveform, accum, dds_rate, offset, lim)
+    if (modulate == NULL) {
+        switch (mode) {
+            case SYNTH_PASS_STORE:
+                return SYNTH_PASS(SYNTH_PASS_STORE, NULL);
+            case SYNTH_PASS_SUM_MONO:
+                return SYNTH_PASS(SYNTH_PASS_SUM_MONO, NULL);
+            default:
+                return SYNTH_PASS(SYNTH_PASS_SUM_STEREO, NULL);
+        }
+    } else {
+        switch (mode) {
+            case SYNTH_PASS_STORE:
+                return SYNTH_PASS(SYNTH_PASS_STORE, modulate);
+            case SYNTH_PASS_SUM_MONO:
+                return SYNTH_PASS(SYNTH_PASS_SUM_MONO, modulate);
+            default:
+                return SYNTH_PASS(SYNTH_PASS_SUM_STEREO, modulate);
+        }
+    }
+    #undef SYNTH_PASS
+}
+
+// Render a note into out_buffer32.  If sum_buffer32 is not NULL, the note is
+// instead scaled by its loudness and added to sum_buffer32 as it's rendered.
+static bool synth_note_into_buffer(synthio_synth_t *synth, int chan, int32_t *out_buffer32, int16_t dur, int16_t loudness[2], int32_t *sum_buffer32) {
     mp_obj_t note_obj = synth->span.note_obj[chan];
 
     int32_t sample_rate = synth->sample_rate;
@@ -223,47 +343,39 @@ static bool synth_note_into_buffer(synthio_synth_t *synth, int chan, int32_t *ou
         accum = accum % lim + offset;
     }
 
-    // first, fill with waveform
-    for (uint16_t i = 0; i < dur; i++) {
-        accum += dds_rate;
-        // because dds_rate is low enough, the subtraction is guaranteed to go back into range, no expensive modulo needed
-        if (accum > lim) {
-            accum = accum - lim + offset;
-        }
-        int16_t idx = accum >> SYNTHIO_FREQUENCY_SHIFT;
-        out_buffer32[i] = waveform[idx];
+    if (ring_dds_rate > lim / 2) {
+        // beyond nyquist, can't play ring (but can play the main sound)
+        ring_dds_rate = 0;
     }
-    synth->accum[chan] = accum;
 
-    if (ring_dds_rate) {
-        if (ring_dds_rate > lim / 2) {
-            // beyond nyquist, can't play ring (but did synth main sound so
-            // return true)
-            return true;
-        }
+    // the last pass sums into sum_buffer32, if there is one
+    int mode = SYNTH_PASS_STORE;
+    int32_t *dest_buffer32 = out_buffer32;
+    if (sum_buffer32 != NULL) {
+        mode = synth->channel_count == 1 ? SYNTH_PASS_SUM_MONO : SYNTH_PASS_SUM_STEREO;
+        dest_buffer32 = sum_buffer32;
+    }
+    uint32_t packed_loudness = pack_loudness(loudness);
 
-        // now modulate by ring and accumulate
-        accum = synth->ring_accum[chan];
-        offset = ring_waveform_start << SYNTHIO_FREQUENCY_SHIFT;
-        lim = ring_waveform_length << SYNTHIO_FREQUENCY_SHIFT;
+    if (!ring_dds_rate) {
+        synth->accum[chan] = synth_oscillator(mode, dest_buffer32, NULL, dur, packed_loudness, waveform, accum, dds_rate, offset, lim);
+        return true;
+    }
 
-        // can happen if note waveform gets set mid-note, but the expensive modulo is usually avoided
-        if (accum > lim) {
-            accum = accum % lim + offset;
-        }
+    // first, fill with waveform
+    synth->accum[chan] = synth_oscillator(SYNTH_PASS_STORE, out_buffer32, NULL, dur, 0, waveform, accum, dds_rate, offset, lim);
 
-        for (uint16_t i = 0; i < dur; i++) {
-            accum += ring_dds_rate;
-            // because dds_rate is low enough, the subtraction is guaranteed to go back into range, no expensive modulo needed
-            if (accum > lim) {
-                accum = accum - lim + offset;
-            }
-            int16_t idx = accum >> SYNTHIO_FREQUENCY_SHIFT;
-            int16_t wi = (ring_waveform[idx] * out_buffer32[i]) / 32768;
-            out_buffer32[i] = wi;
-        }
-        synth->ring_accum[chan] = accum;
+    // now modulate by ring and accumulate
+    accum = synth->ring_accum[chan];
+    offset = ring_waveform_start << SYNTHIO_FREQUENCY_SHIFT;
+    lim = ring_waveform_length << SYNTHIO_FREQUENCY_SHIFT;
+
+    // can happen if note waveform gets set mid-note, but the expensive modulo is usually avoided
+    if (accum > lim) {
+        accum = accum % lim + offset;
     }
+
+    synth->ring_accum[chan] = synth_oscillator(mode, dest_buffer32, out_buffer32, dur, packed_loudness, ring_waveform, accum, ring_dds_rate, offset, lim);
     return true;
 }
 
@@ -279,14 +391,15 @@ static mp_obj_t synthio_synth_get_note_filter(mp_obj_t note_obj) {
 }
 
 static void sum_with_loudness(int32_t *out_buffer32, int32_t *tmp_buffer32, int16_t loudness[2], size_t dur, int synth_chan) {
+    uint32_t packed_loudness = pack_loudness(loudness);
     if (synth_chan == 1) {
         for (size_t i = 0; i < dur; i++) {
-            *out_buffer32++ += (*tmp_buffer32++ *loudness[0]) >> 16;
+            *out_buffer32++ += scale_by_loudness_bottom(*tmp_buffer32++, packed_loudness);
         }
     } else {
         for (size_t i = 0; i < dur; i++) {
-            *out_buffer32++ += (*tmp_buffer32 * loudness[0]) >> 16;
-            *out_buffer32++ += (*tmp_buffer32++ *loudness[1]) >> 16;
+            *out_buffer32++ += scale_by_loudness_bottom(*tmp_buffer32, packed_loudness);
+            *out_buffer32++ += scale_by_loudness_top(*tmp_buffer32++, packed_loudness);
         }
     }
 }
@@ -301,6 +414,14 @@ void synthio_synth_synthesize(synthio_synth_t *synth, uint8_t **bufptr, uint32_t
 
     shared_bindings_synthio_lfo_tick(synth->sample_rate);
 
+    for (int chan = 0; chan < CIRCUITPY_SYNTHIO_MAX_CHANNELS; chan++) {
+        if (synth->span.note_obj[chan] != SYNTHIO_SILENCE && synth->envelope_state[chan].level == 0) {
+            // note is truly finished, but we only just noticed
+            synth->span.note_obj[chan] = SYNTHIO_SILENCE;
+        }
+    }
+    synthio_block_program_run(synth);
+
     synth->buffer_index = !synth->buffer_index;
     synth->other_channel = 1 - channel;
     synth->other_buffer_index = synth->buffer_index;
@@ -318,28 +439,25 @@ void synthio_synth_synthesize(synthio_synth_t *synth, uint8_t **bufptr, uint32_t
             continue;
         }
 
-        if (synth->envelope_state[chan].level == 0) {
-            // note is truly finished, but we only just noticed
-            synth->span.note_obj[chan] = SYNTHIO_SILENCE;
-            continue;
-        }
-
         int16_t loudness[2] = {synth->envelope_state[chan].level, synth->envelope_state[chan].level};
 
-        if (!synth_note_into_buffer(synth, chan, tmp_buffer32, dur, loudness)) {
+        // unless it's filtered, a note is summed in as it's rendered
+        mp_obj_t filter_obj = synthio_synth_get_note_filter(note_obj);
+        int32_t *sum_buffer32 = filter_obj == mp_const_none ? out_buffer32 : NULL;
+
+        if (!synth_note_into_buffer(synth, chan, tmp_buffer32, dur, loudness, sum_buffer32)) {
             // for some other reason, such as being above nyquist, note
             // couldn't be synthed, so don't filter or sum it in
             continue;
         }
 
-        mp_obj_t filter_obj = synthio_synth_get_note_filter(note_obj);
         if (filter_obj != mp_const_none) {
             synthio_note_obj_t *note = MP_OBJ_TO_PTR(note_obj);
             synthio_biquad_filter_samples(&note->filter_state, tmp_buffer32, dur);
-        }
 
-        // adjust loudness by envelope
-        sum_with_loudness(out_buffer32, tmp_buffer32, loudness, dur, synth->channel_count);
+            // adjust loudness by envelope
+            sum_with_loudness(out_buffer32, tmp_buffer32, loudness, dur, synth->channel_count);
+        }
     }
 
     int16_t *out_buffer16 = (int16_t *)(void *)synth->buffers[synth->buffer_index];
@@ -403,6 +521,8 @@ void synthio_synth_init(synthio_synth_t *synth, uint32_t sample_rate, int channe
     for (size_t i = 0; i < CIRCUITPY_SYNTHIO_MAX_CHANNELS; i++) {
         synth->span.note_obj[i] = SYNTHIO_SILENCE;
     }
+    synth->block_program.blocks = MP_OBJ_NULL;
+    synth->block_program.compiled = false;
 }
 
 void synthio_synth_get_buffer_structure(synthio_synth_t *synth, bool single_channel_output,
@@ -494,23 +614,27 @@ void shared_bindings_synthio_lfo_tick(uint32_t sample_rate) {
     synthio_global_tick++;
 }
 
+static mp_float_t block_tick(synthio_block_base_t *block, mp_float_t (*tick)(mp_obj_t obj)) {
+    block->last_tick = synthio_global_tick;
+    mp_float_t value = tick(MP_OBJ_FROM_PTR(block));
+    block->value = value;
+    return value;
+}
+
 mp_float_t synthio_block_slot_get(synthio_block_slot_t *slot) {
     // all numbers (and None!) previously converted to float in synthio_block_assign_slot
-    if (mp_obj_is_float(slot->obj)) {
-        return mp_obj_get_float(slot->obj);
+    synthio_block_base_t *block = slot->block;
+    if (block == NULL) {
+        return slot->value;
     }
 
-    synthio_block_base_t *block = MP_OBJ_TO_PTR(slot->obj);
     if (block->last_tick == synthio_global_tick) {
         return block->value;
     }
 
-    block->last_tick = synthio_global_tick;
     // previously verified by call to mp_proto_get in synthio_block_assign_slot
-    const synthio_block_proto_t *p = MP_OBJ_TYPE_GET_SLOT(mp_obj_get_type(slot->obj), protocol);
-    mp_float_t value = p->tick(slot->obj);
-    block->value = value;
-    return value;
+    const synthio_block_proto_t *p = MP_OBJ_TYPE_GET_SLOT(block->base.type, protocol);
+    return block_tick(block, p->tick);
 }
 
 mp_float_t synthio_block_slot_get_limited(synthio_block_slot_t *lfo_slot, mp_float_t lo, mp_float_t hi) {
@@ -526,12 +650,14 @@ mp_float_t synthio_block_slot_get_limited(synthio_block_slot_t *lfo_slot, mp_flo
 
 int32_t synthio_block_slot_get_scaled(synthio_block_slot_t *lfo_slot, mp_float_t lo, mp_float_t hi) {
     mp_float_t value = synthio_block_slot_get_limited(lfo_slot, lo, hi);
-    return (int32_t)MICROPY_FLOAT_C_FUN(round)(MICROPY_FLOAT_C_FUN(ldexp)(value, 15));
+    return (int32_t)MICROPY_FLOAT_C_FUN(round)(value * 32768);
 }
 
 bool synthio_block_assign_slot_maybe(mp_obj_t obj, synthio_block_slot_t *slot) {
     if (synthio_obj_is_block(obj)) {
         slot->obj = obj;
+        slot->block = MP_OBJ_TO_PTR(obj);
+        synthio_block_generation++;
         return true;
     }
 
@@ -540,7 +666,13 @@ bool synthio_block_assign_slot_maybe(mp_obj_t obj, synthio_block_slot_t *slot) {
         return false;
     }
 
+    if (slot->block != NULL) {
+        synthio_block_generation++;
+    }
     slot->obj = mp_obj_new_float(value);
+    slot->block = NULL;
+    // as stored in the object, which may be less precise
+    slot->value = mp_obj_get_float(slot->obj);
     return true;
 }
 
@@ -553,3 +685,115 @@ void synthio_block_assign_slot(mp_obj_t obj, synthio_block_slot_t *slot, qstr ar
 bool synthio_obj_is_block(mp_obj_t obj) {
     return mp_proto_get(MP_QSTR_synthio_block, obj);
 }
+
+struct block_program_path {
+    synthio_block_base_t *block;
+    const struct block_program_path *next;
+};
+
+// Add block to the program after the blocks that it reads from, unless it is already there.
+// path is the blocks that are waiting on this one. Returns false if block reads from one of
+// them, because the order a loop is ticked in depends on where it is first read, and so has to be
+// left to synthio_block_slot_get.
+static bool block_program_add(synthio_block_program_t *program, synthio_block_base_t *block, const struct block_program_path *path) {
+    if (block == NULL || program->len == SYNTHIO_BLOCK_PROGRAM_LEN) {
+        return true;
+    }
+    for (size_t i = 0; i < program->len; i++) {
+        if (program->ops[i].block == block) {
+            return true;
+        }
+    }
+    for (const struct block_program_path *p = path; p != NULL; p = p->next) {
+        if (p->block == block) {
+            return false;
+        }
+    }
+
+    const synthio_block_proto_t *p = MP_OBJ_TYPE_GET_SLOT(block->base.type, protocol);
+    const struct block_program_path here = { block, path };
+    synthio_block_slot_t *input;
+    for (size_t i = 0; (input = p->get_input(MP_OBJ_FROM_PTR(block), i)) != NULL; i++) {
+        if (!block_program_add(program, input->block, &here)) {
+            return false;
+        }
+    }
+    if (program->len < SYNTHIO_BLOCK_PROGRAM_LEN) {
+        program->ops[program->len++] = (synthio_block_op_t) { block, p->tick };
+    }
+    return true;
+}
+
+static void block_program_add_root(synthio_block_program_t *program, synthio_block_base_t *block) {
+    uint8_t len = program->len;
+    if (!block_program_add(program, block, NULL)) {
+        program->len = len;
+    }
+}
+
+static bool block_program_is_current(synthio_synth_t *synth) {
+    synthio_block_program_t *program = &synth->block_program;
+    if (!program->compiled || program->generation != synthio_block_generation
+        || memcmp(program->note_obj, synth->span.note_obj, sizeof(program->note_obj)) != 0) {
+        return false;
+    }
+    if (program->blocks != MP_OBJ_NULL) {
+        size_t len;
+        mp_obj_t *items;
+        mp_obj_list_get(program->blocks, &len, &items);
+        if (len != program->blocks_len
+            || memcmp(program->free_running, items, MIN(len, SYNTHIO_BLOCK_PROGRAM_FREE_RUNNING) * sizeof(mp_obj_t)) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void block_program_compile(synthio_synth_t *synth) {
+    synthio_block_program_t *program = &synth->block_program;
+    program->compiled = true;
+    program->generation = synthio_block_generation;
+    program->len = 0;
+
+    // Notes read their slots in this order in synthio_note_step
+    memcpy(program->note_obj, synth->span.note_obj, sizeof(program->note_obj));
+    for (size_t chan = 0; chan < CIRCUITPY_SYNTHIO_MAX_CHANNELS; chan++) {
+        mp_obj_t note_obj = program->note_obj[chan];
+        if (note_obj == SYNTHIO_SILENCE || mp_obj_is_small_int(note_obj)) {
+            continue;
+        }
+        synthio_note_obj_t *note = MP_OBJ_TO_PTR(note_obj);
+        block_program_add_root(program, note->panning.block);
+        block_program_add_root(program, note->amplitude.block);
+        if (note->ring_frequency_scaled != 0) {
+            block_program_add_root(program, note->ring_bend.block);
+        }
+        block_program_add_root(program, note->bend.block);
+    }
+
+    // Then the first of the free-running blocks
+    if (program->blocks != MP_OBJ_NULL) {
+        mp_obj_t *items;
+        mp_obj_list_get(program->blocks, &program->blocks_len, &items);
+        size_t n = MIN(program->blocks_len, SYNTHIO_BLOCK_PROGRAM_FREE_RUNNING);
+        memcpy(program->free_running, items, n * sizeof(mp_obj_t));
+        for (size_t i = 0; i < n; i++) {
+            if (synthio_obj_is_block(items[i])) {
+                block_program_add_root(program, MP_OBJ_TO_PTR(items[i]));
+            }
+        }
+    }
+}
+
+void synthio_block_program_run(synthio_synth_t *synth) {
+    if (!block_program_is_current(synth)) {
+        block_program_compile(synth);
+    }
+    synthio_block_program_t *program = &synth->block_program;
+    for (size_t i = 0; i < program->len; i++) {
+        synthio_block_base_t *block = program->ops[i].block;
+        if (block->last_tick != synthio_global_tick) {
+            block_tick(block, program->ops[i].tick);
+        }
+    }
+}
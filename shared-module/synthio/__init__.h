@@ -36,6 +36,30 @@ typedef struct {
     envelope_state_e state;
 } synthio_envelope_state_t;
 
+// The longest block program. Any other blocks are ticked when they are first read.
+#define SYNTHIO_BLOCK_PROGRAM_LEN (48)
+// Items of a Synthesizer's blocks list that are compiled into its program
+#define SYNTHIO_BLOCK_PROGRAM_FREE_RUNNING (8)
+
+struct synthio_block_base;
+
+typedef struct {
+    struct synthio_block_base *block;
+    mp_float_t (*tick)(mp_obj_t obj);
+} synthio_block_op_t;
+
+// The blocks of a synth in the order to tick them, along with what they were compiled from
+typedef struct {
+    mp_obj_t blocks; // Synthesizer.blocks, or MP_OBJ_NULL
+    bool compiled;
+    uint8_t len;
+    uint32_t generation;
+    size_t blocks_len;
+    mp_obj_t note_obj[CIRCUITPY_SYNTHIO_MAX_CHANNELS];
+    mp_obj_t free_running[SYNTHIO_BLOCK_PROGRAM_FREE_RUNNING];
+    synthio_block_op_t ops[SYNTHIO_BLOCK_PROGRAM_LEN];
+} synthio_block_program_t;
+
 typedef struct synthio_synth {
     uint32_t sample_rate;
     uint32_t total_envelope;
@@ -51,6 +75,7 @@ typedef struct synthio_synth {
     uint32_t accum[CIRCUITPY_SYNTHIO_MAX_CHANNELS];
     uint32_t ring_accum[CIRCUITPY_SYNTHIO_MAX_CHANNELS];
     synthio_envelope_state_t envelope_state[CIRCUITPY_SYNTHIO_MAX_CHANNELS];
+    synthio_block_program_t block_program;
 } synthio_synth_t;
 
 typedef struct {
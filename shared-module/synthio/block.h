@@ -20,13 +20,22 @@ typedef struct synthio_block_base {
 
 typedef struct synthio_block_slot {
     mp_obj_t obj;
+    // obj decoded once when it is assigned, so reading the slot needs no object dispatch
+    synthio_block_base_t *block; // NULL if obj is a number
+    mp_float_t value; // the number
 } synthio_block_slot_t;
 
 typedef struct {
     MP_PROTOCOL_HEAD;
     mp_float_t (*tick)(mp_obj_t obj);
+    // Return the i'th slot that tick reads, or NULL after the last one
+    synthio_block_slot_t *(*get_input)(mp_obj_t obj, size_t i);
 } synthio_block_proto_t;
 
+// Incremented whenever a slot changes to or from a block, and whenever anything else changes
+// which slots a block or note reads, so that compiled block programs are rebuilt.
+extern uint32_t synthio_block_generation;
+
 // Update the value inside the lfo slot if the value is an LFO, returning the new value
 mp_float_t synthio_block_slot_get(synthio_block_slot_t *block_slot);
 // the same, but the output is constrained to be between lo and hi
@@ -38,3 +47,7 @@ int32_t synthio_block_slot_get_scaled(synthio_block_slot_t *block_slot, mp_float
 void synthio_block_assign_slot(mp_obj_t obj, synthio_block_slot_t *block_slot, qstr arg_name);
 bool synthio_block_assign_slot_maybe(mp_obj_t obj, synthio_block_slot_t *block_slot);
 bool synthio_obj_is_block(mp_obj_t obj);
+
+// Tick the blocks that the synth's notes (and, for a Synthesizer, its blocks list) read, each
+// after the blocks that it reads. The order is worked out again only when the graph changes.
+void synthio_block_program_run(synthio_synth_t *synth);
@@ -22,24 +22,34 @@
 
 #define NO_SECTOR_LOADED 0xFFFFFFFF
 
-// The currently cached sector in the cache, ram or flash based.
-static uint32_t current_sector;
-
 static const external_flash_device possible_devices[] = {EXTERNAL_FLASH_DEVICES};
 #define EXTERNAL_FLASH_DEVICE_COUNT MP_ARRAY_SIZE(possible_devices)
 
 static const external_flash_device *flash_device = NULL;
 
-// Track which blocks (up to 32) in the current sector currently live in the
-// cache.
-static uint32_t dirty_mask;
-
-// Table of pointers to each cached block. Should be zero'd after allocation.
 #define BLOCKS_PER_SECTOR (SPI_FLASH_ERASE_SIZE / FILESYSTEM_BLOCK_SIZE)
 #define PAGES_PER_BLOCK (FILESYSTEM_BLOCK_SIZE / SPI_FLASH_PAGE_SIZE)
 #define FLASH_CACHE_TABLE_NUM_ENTRIES (BLOCKS_PER_SECTOR * PAGES_PER_BLOCK)
 #define FLASH_CACHE_TABLE_SIZE (FLASH_CACHE_TABLE_NUM_ENTRIES * sizeof (uint8_t *))
-static uint8_t **flash_cache_table = NULL;
+
+// Writes are held back per erase sector so that each sector is erased and reprogrammed once for
+// many writes. A sector is only written back when the filesystem is flushed or when its cache is
+// needed for another sector, in which case the least recently written sector goes.
+typedef struct {
+    // The cached sector, or NO_SECTOR_LOADED.
+    uint32_t sector;
+    // Track which blocks (up to 32) in the sector currently live in the cache.
+    uint32_t dirty_mask;
+    // Value of write_count when the sector was last written.
+    uint32_t last_write;
+    // Table of pointers to each cached page. Should be zero'd after allocation. When NULL, a
+    // loaded sector is cached in the scratch sector at the end of the flash, which is only used
+    // when ram is too tight for any table.
+    uint8_t **table;
+} flash_cache_t;
+
+static flash_cache_t flash_cache[CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS];
+static uint32_t write_count;
 
 // Wait until both the write enable and write in progress bits have cleared.
 static bool wait_for_flash_ready(void) {
@@ -82,30 +92,32 @@ static bool write_flash(uint32_t address, const uint8_t *data, uint32_t data_len
     if (flash_device == NULL) {
         return false;
     }
-    // Don't bother writing if the data is all 1s. That's equivalent to the flash
-    // state after an erase.
-    if (!flash_device->no_erase_cmd) {
-        // Only do this if the device has an erase command
-        bool all_ones = true;
-        for (uint16_t i = 0; i < data_length; i++) {
-            if (data[i] != 0xff) {
-                all_ones = false;
-                break;
-            }
-        }
-        if (all_ones) {
-            return true;
-        }
-    }
 
     for (uint32_t bytes_written = 0;
          bytes_written < data_length;
          bytes_written += SPI_FLASH_PAGE_SIZE) {
+        const uint8_t *page = data + bytes_written;
+        // Don't bother writing a page if the data is all 1s. That's equivalent to the flash
+        // state after an erase.
+        if (!flash_device->no_erase_cmd) {
+            // Only do this if the device has an erase command
+            bool all_ones = true;
+            for (uint16_t i = 0; i < SPI_FLASH_PAGE_SIZE; i++) {
+                if (page[i] != 0xff) {
+                    all_ones = false;
+                    break;
+                }
+            }
+            if (all_ones) {
+                continue;
+            }
+        }
+
         if (!wait_for_flash_ready() || !write_enable()) {
             return false;
         }
 
-        if (!spi_flash_write_data(address + bytes_written, (uint8_t *)data + bytes_written,
+        if (!spi_flash_write_data(address + bytes_written, (uint8_t *)page,
             SPI_FLASH_PAGE_SIZE)) {
             return false;
         }
@@ -135,7 +147,7 @@ static bool page_erased(uint32_t sector_address) {
     uint8_t full_buffer[FILESYSTEM_BLOCK_SIZE];
     if (read_flash(sector_address, full_buffer, FILESYSTEM_BLOCK_SIZE)) {
         for (uint16_t i = 0; i < FILESYSTEM_BLOCK_SIZE; i++) {
-            if (short_buffer[i] != 0xff) {
+            if (full_buffer[i] != 0xff) {
                 return false;
             }
         }
@@ -145,6 +157,15 @@ static bool page_erased(uint32_t sector_address) {
     return true;
 }
 
+static bool sector_erased(uint32_t sector_address) {
+    for (size_t i = 0; i < BLOCKS_PER_SECTOR; i++) {
+        if (!page_erased(sector_address + i * FILESYSTEM_BLOCK_SIZE)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 // Erases the given sector. Make sure you copied all of the data out of it you
 // need! Also note, sector_address is really 24 bits.
 static bool erase_sector(uint32_t sector_address) {
@@ -277,9 +298,11 @@ void supervisor_flash_init(void) {
 
     wait_for_flash_ready();
 
-    current_sector = NO_SECTOR_LOADED;
-    dirty_mask = 0;
-    flash_cache_table = NULL;
+    for (size_t i = 0; i < CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS; i++) {
+        flash_cache[i].sector = NO_SECTOR_LOADED;
+        flash_cache[i].dirty_mask = 0;
+        flash_cache[i].table = NULL;
+    }
 }
 
 // The size of each individual block.
@@ -299,8 +322,8 @@ uint32_t supervisor_flash_get_block_count(void) {
 
 // Flush the cache that was written to the scratch portion of flash. Only used
 // when ram is tight.
-static bool flush_scratch_flash(void) {
-    if (current_sector == NO_SECTOR_LOADED) {
+static bool flush_scratch_flash(flash_cache_t *cache) {
+    if (cache->sector == NO_SECTOR_LOADED) {
         return true;
     }
     // First, copy out any blocks that we haven't touched from the sector we've
@@ -308,9 +331,9 @@ static bool flush_scratch_flash(void) {
     bool copy_to_scratch_ok = true;
     uint32_t scratch_sector = flash_device->total_size - SPI_FLASH_ERASE_SIZE;
     for (size_t i = 0; i < BLOCKS_PER_SECTOR; i++) {
-        if ((dirty_mask & (1 << i)) == 0) {
+        if ((cache->dirty_mask & (1 << i)) == 0) {
             copy_to_scratch_ok = copy_to_scratch_ok &&
-                copy_block(current_sector + i * FILESYSTEM_BLOCK_SIZE,
+                copy_block(cache->sector + i * FILESYSTEM_BLOCK_SIZE,
                 scratch_sector + i * FILESYSTEM_BLOCK_SIZE);
         }
     }
@@ -320,44 +343,44 @@ static bool flush_scratch_flash(void) {
         return false;
     }
     // Second, erase the current sector.
-    erase_sector(current_sector);
+    erase_sector(cache->sector);
     // Finally, copy the new version into it.
     for (size_t i = 0; i < BLOCKS_PER_SECTOR; i++) {
         copy_block(scratch_sector + i * FILESYSTEM_BLOCK_SIZE,
-            current_sector + i * FILESYSTEM_BLOCK_SIZE);
+            cache->sector + i * FILESYSTEM_BLOCK_SIZE);
     }
     return true;
 }
 
-// Free all entries in the partially or completely filled flash_cache_table, and then free the table itself.
-static void release_ram_cache(void) {
-    if (flash_cache_table == NULL) {
+// Free all entries in the partially or completely filled table, and then free the table itself.
+static void release_ram_cache(flash_cache_t *cache) {
+    if (cache->table == NULL) {
         return;
     }
 
     for (size_t i = 0; i < FLASH_CACHE_TABLE_NUM_ENTRIES; i++) {
         // Table may not be completely full. Stop at first NULL entry.
-        if (flash_cache_table[i] == NULL) {
+        if (cache->table[i] == NULL) {
             break;
         }
-        port_free(flash_cache_table[i]);
+        port_free(cache->table[i]);
     }
-    port_free(flash_cache_table);
-    flash_cache_table = NULL;
+    port_free(cache->table);
+    cache->table = NULL;
 }
 
 // Attempts to allocate a new set of page buffers for caching a full sector in
 // ram. Each page is allocated separately so that the GC doesn't need to provide
 // one huge block. We can free it as we write if we want to also.
-static bool allocate_ram_cache(void) {
-    flash_cache_table = port_malloc(FLASH_CACHE_TABLE_SIZE, false);
-    if (flash_cache_table == NULL) {
+static bool allocate_ram_cache(flash_cache_t *cache) {
+    cache->table = port_malloc(FLASH_CACHE_TABLE_SIZE, false);
+    if (cache->table == NULL) {
         // Not enough space even for the cache table.
         return false;
     }
 
     // Clear all the entries so it's easy to find the last entry.
-    memset(flash_cache_table, 0, FLASH_CACHE_TABLE_SIZE);
+    memset(cache->table, 0, FLASH_CACHE_TABLE_SIZE);
 
     bool success = true;
     for (size_t i = 0; i < BLOCKS_PER_SECTOR && success; i++) {
@@ -367,28 +390,28 @@ static bool allocate_ram_cache(void) {
                 success = false;
                 break;
             }
-            flash_cache_table[i * PAGES_PER_BLOCK + j] = page_cache;
+            cache->table[i * PAGES_PER_BLOCK + j] = page_cache;
         }
     }
 
     // We couldn't allocate enough so give back what we got.
     if (!success) {
-        release_ram_cache();
+        release_ram_cache(cache);
     }
     return success;
 }
 
 // Flush the cached sector from ram onto the flash. We'll free the cache unless
 // keep_cache is true.
-static bool flush_ram_cache(bool keep_cache) {
-    if (flash_cache_table == NULL) {
+static bool flush_ram_cache(flash_cache_t *cache, bool keep_cache) {
+    if (cache->table == NULL) {
         // Nothing to flush because there is no cache.
         return true;
     }
 
-    if (current_sector == NO_SECTOR_LOADED) {
+    if (cache->sector == NO_SECTOR_LOADED) {
         if (!keep_cache) {
-            release_ram_cache();
+            release_ram_cache(cache);
         }
         return true;
     }
@@ -397,11 +420,11 @@ static bool flush_ram_cache(bool keep_cache) {
     // erase below.
     bool copy_to_ram_ok = true;
     for (size_t i = 0; i < BLOCKS_PER_SECTOR; i++) {
-        if ((dirty_mask & (1 << i)) == 0) {
+        if ((cache->dirty_mask & (1 << i)) == 0) {
             for (size_t j = 0; j < PAGES_PER_BLOCK; j++) {
                 copy_to_ram_ok = read_flash(
-                    current_sector + (i * PAGES_PER_BLOCK + j) * SPI_FLASH_PAGE_SIZE,
-                    flash_cache_table[i * PAGES_PER_BLOCK + j],
+                    cache->sector + (i * PAGES_PER_BLOCK + j) * SPI_FLASH_PAGE_SIZE,
+                    cache->table[i * PAGES_PER_BLOCK + j],
                     SPI_FLASH_PAGE_SIZE);
                 if (!copy_to_ram_ok) {
                     break;
@@ -417,35 +440,46 @@ static bool flush_ram_cache(bool keep_cache) {
         return false;
     }
     // Second, erase the current sector.
-    erase_sector(current_sector);
+    erase_sector(cache->sector);
     // Lastly, write all the data in ram that we've cached.
     for (size_t i = 0; i < BLOCKS_PER_SECTOR; i++) {
         for (size_t j = 0; j < PAGES_PER_BLOCK; j++) {
-            write_flash(current_sector + (i * PAGES_PER_BLOCK + j) * SPI_FLASH_PAGE_SIZE,
-                flash_cache_table[i * PAGES_PER_BLOCK + j],
+            write_flash(cache->sector + (i * PAGES_PER_BLOCK + j) * SPI_FLASH_PAGE_SIZE,
+                cache->table[i * PAGES_PER_BLOCK + j],
                 SPI_FLASH_PAGE_SIZE);
         }
     }
     // We're done with the cache for now so give it back.
     if (!keep_cache) {
-        release_ram_cache();
+        release_ram_cache(cache);
     }
     return true;
 }
 
-// Delegates to the correct flash flush method depending on the existing cache.
+// Delegates to the correct flash flush method depending on where the sector is cached.
+static void flush_cache(flash_cache_t *cache, bool keep_cache) {
+    // If we've cached to the flash itself flush from there.
+    if (cache->table == NULL) {
+        flush_scratch_flash(cache);
+    } else {
+        flush_ram_cache(cache, keep_cache);
+    }
+    cache->sector = NO_SECTOR_LOADED;
+    cache->dirty_mask = 0;
+}
+
 // TODO Don't blink the status indicator if we don't actually do any writing (hard to tell right now).
 static void spi_flash_flush_keep_cache(bool keep_cache) {
     #ifdef MICROPY_HW_LED_MSC
     port_pin_set_output_level(MICROPY_HW_LED_MSC, true);
     #endif
-    // If we've cached to the flash itself flush from there.
-    if (flash_cache_table == NULL) {
-        flush_scratch_flash();
-    } else {
-        flush_ram_cache(keep_cache);
+    for (size_t i = 0; i < CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS; i++) {
+        flush_cache(&flash_cache[i], keep_cache);
+        // Only one cache keeps its ram. The others are allocated again if writing carries on.
+        if (flash_cache[i].table != NULL) {
+            keep_cache = false;
+        }
     }
-    current_sector = NO_SECTOR_LOADED;
     #ifdef MICROPY_HW_LED_MSC
     port_pin_set_output_level(MICROPY_HW_LED_MSC, false);
     #endif
@@ -459,6 +493,52 @@ void supervisor_flash_release_cache(void) {
     spi_flash_flush_keep_cache(false);
 }
 
+static flash_cache_t *find_cache(uint32_t sector) {
+    for (size_t i = 0; i < CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS; i++) {
+        if (flash_cache[i].sector == sector) {
+            return &flash_cache[i];
+        }
+    }
+    return NULL;
+}
+
+// Returns a cache to hold the given sector: a free one if there's ram for it, otherwise the least
+// recently written one after flushing it.
+static flash_cache_t *claim_cache(uint32_t sector) {
+    flash_cache_t *unallocated = NULL;
+    flash_cache_t *least_recent = NULL;
+    for (size_t i = 0; i < CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS; i++) {
+        flash_cache_t *cache = &flash_cache[i];
+        if (cache->sector != NO_SECTOR_LOADED) {
+            if (least_recent == NULL || cache->last_write - least_recent->last_write > UINT32_MAX / 2) {
+                least_recent = cache;
+            }
+        } else if (cache->table != NULL) {
+            cache->sector = sector;
+            return cache;
+        } else if (unallocated == NULL) {
+            unallocated = cache;
+        }
+    }
+    if (unallocated != NULL && allocate_ram_cache(unallocated)) {
+        unallocated->sector = sector;
+        return unallocated;
+    }
+    if (least_recent != NULL && least_recent->table != NULL) {
+        flush_cache(least_recent, true);
+        least_recent->sector = sector;
+        return least_recent;
+    }
+    // There's no ram for any cache so fall back to the scratch sector. Only one sector can be
+    // cached there at a time.
+    flash_cache_t *cache = least_recent != NULL ? least_recent : unallocated;
+    flush_cache(cache, true);
+    erase_sector(flash_device->total_size - SPI_FLASH_ERASE_SIZE);
+    wait_for_flash_ready();
+    cache->sector = sector;
+    return cache;
+}
+
 static int32_t convert_block_to_flash_addr(uint32_t block) {
     if (0 <= block && block < supervisor_flash_get_block_count()) {
         // a block in partition 1
@@ -479,12 +559,13 @@ static bool external_flash_read_block(uint8_t *dest, uint32_t block) {
     uint32_t this_sector = address & (~(SPI_FLASH_ERASE_SIZE - 1));
     size_t block_index = (address / FILESYSTEM_BLOCK_SIZE) % BLOCKS_PER_SECTOR;
     uint32_t mask = 1 << (block_index);
-    // We're reading from the currently cached sector.
-    if (current_sector == this_sector && (mask & dirty_mask) > 0) {
-        if (flash_cache_table != NULL) {
+    flash_cache_t *cache = find_cache(this_sector);
+    // We're reading from a cached sector.
+    if (cache != NULL && (mask & cache->dirty_mask) > 0) {
+        if (cache->table != NULL) {
             for (int i = 0; i < PAGES_PER_BLOCK; i++) {
                 memcpy(dest + i * SPI_FLASH_PAGE_SIZE,
-                    flash_cache_table[block_index * PAGES_PER_BLOCK + i],
+                    cache->table[block_index * PAGES_PER_BLOCK + i],
                     SPI_FLASH_PAGE_SIZE);
             }
             return true;
@@ -509,29 +590,27 @@ static bool external_flash_write_block(const uint8_t *data, uint32_t block) {
     uint32_t this_sector = address & (~(SPI_FLASH_ERASE_SIZE - 1));
     size_t block_index = (address / FILESYSTEM_BLOCK_SIZE) % BLOCKS_PER_SECTOR;
     uint32_t mask = 1 << (block_index);
-    // Flush the cache if we're moving onto a sector or we're writing the
-    // same block again.
-    if (current_sector != this_sector || (mask & dirty_mask) > 0) {
+    flash_cache_t *cache = find_cache(this_sector);
+    // A block cached in ram can simply be overwritten but the scratch sector would need erasing,
+    // so flush it when writing the same block again.
+    if (cache != NULL && cache->table == NULL && (mask & cache->dirty_mask) > 0) {
+        flush_cache(cache, true);
+        cache = NULL;
+    }
+    if (cache == NULL) {
         // Check to see if we'd write to an erased page. In that case we
         // can write directly.
         if (page_erased(address)) {
             return write_flash(address, data, FILESYSTEM_BLOCK_SIZE);
         }
-        if (current_sector != NO_SECTOR_LOADED) {
-            supervisor_flash_flush();
-        }
-        if (flash_cache_table == NULL && !allocate_ram_cache()) {
-            erase_sector(flash_device->total_size - SPI_FLASH_ERASE_SIZE);
-            wait_for_flash_ready();
-        }
-        current_sector = this_sector;
-        dirty_mask = 0;
+        cache = claim_cache(this_sector);
     }
-    dirty_mask |= mask;
+    cache->dirty_mask |= mask;
+    cache->last_write = ++write_count;
     // Copy the block to the appropriate cache.
-    if (flash_cache_table != NULL) {
+    if (cache->table != NULL) {
         for (int i = 0; i < PAGES_PER_BLOCK; i++) {
-            memcpy(flash_cache_table[block_index * PAGES_PER_BLOCK + i],
+            memcpy(cache->table[block_index * PAGES_PER_BLOCK + i],
                 data + i * SPI_FLASH_PAGE_SIZE,
                 SPI_FLASH_PAGE_SIZE);
         }
@@ -542,19 +621,74 @@ static bool external_flash_write_block(const uint8_t *data, uint32_t block) {
     }
 }
 
+// Whether the latest data for the block at the address is in a cache rather than the flash.
+static bool block_cached(uint32_t address) {
+    flash_cache_t *cache = find_cache(address & (~(SPI_FLASH_ERASE_SIZE - 1)));
+    size_t block_index = (address / FILESYSTEM_BLOCK_SIZE) % BLOCKS_PER_SECTOR;
+    return cache != NULL && (cache->dirty_mask & (1 << block_index)) > 0;
+}
+
+// Writes a whole sector straight to the flash. This saves copying it through a cache and leaves the
+// caches for sectors that are written a block at a time, such as the FAT's.
+static bool external_flash_write_sector(const uint8_t *data, uint32_t block) {
+    int32_t address = convert_block_to_flash_addr(block);
+    if (address == -1) {
+        // bad block number
+        return false;
+    }
+    // Anything cached for the sector is replaced.
+    flash_cache_t *cache = find_cache(address);
+    if (cache != NULL) {
+        cache->sector = NO_SECTOR_LOADED;
+        cache->dirty_mask = 0;
+    }
+    // Wait for any previous writes to finish.
+    wait_for_flash_ready();
+    if (!sector_erased(address)) {
+        erase_sector(address);
+    }
+    return write_flash(address, data, SPI_FLASH_ERASE_SIZE);
+}
+
 mp_uint_t supervisor_flash_read_blocks(uint8_t *dest, uint32_t block_num, uint32_t num_blocks) {
-    for (size_t i = 0; i < num_blocks; i++) {
-        if (!external_flash_read_block(dest + i * FILESYSTEM_BLOCK_SIZE, block_num + i)) {
-            return 1; // error
+    for (size_t i = 0; i < num_blocks;) {
+        // Read each run of blocks that aren't cached with a single command.
+        size_t run = 0;
+        while (i + run < num_blocks) {
+            int32_t address = convert_block_to_flash_addr(block_num + i + run);
+            if (address == -1 || block_cached(address)) {
+                break;
+            }
+            run++;
+        }
+        if (run > 0) {
+            if (!read_flash((block_num + i) * FILESYSTEM_BLOCK_SIZE, dest + i * FILESYSTEM_BLOCK_SIZE,
+                run * FILESYSTEM_BLOCK_SIZE)) {
+                return 1; // error
+            }
+            i += run;
+        } else {
+            if (!external_flash_read_block(dest + i * FILESYSTEM_BLOCK_SIZE, block_num + i)) {
+                return 1; // error
+            }
+            i++;
         }
     }
     return 0; // success
 }
 
 mp_uint_t supervisor_flash_write_blocks(const uint8_t *src, uint32_t block_num, uint32_t num_blocks) {
-    for (size_t i = 0; i < num_blocks; i++) {
-        if (!external_flash_write_block(src + i * FILESYSTEM_BLOCK_SIZE, block_num + i)) {
-            return 1; // error
+    for (size_t i = 0; i < num_blocks;) {
+        if ((block_num + i) % BLOCKS_PER_SECTOR == 0 && num_blocks - i >= BLOCKS_PER_SECTOR) {
+            if (!external_flash_write_sector(src + i * FILESYSTEM_BLOCK_SIZE, block_num + i)) {
+                return 1; // error
+            }
+            i += BLOCKS_PER_SECTOR;
+        } else {
+            if (!external_flash_write_block(src + i * FILESYSTEM_BLOCK_SIZE, block_num + i)) {
+                return 1; // error
+            }
+            i++;
         }
     }
     return 0; // success
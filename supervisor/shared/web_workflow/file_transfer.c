@@ -0,0 +1,192 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include "supervisor/shared/web_workflow/file_transfer.h"
+
+#include <string.h>
+
+#include "py/mpconfig.h"
+#include "py/misc.h"
+#include "py/mperrno.h"
+#include "supervisor/port_heap.h"
+#include "supervisor/shared/tick.h"
+#include "supervisor/shared/web_workflow/web_workflow.h"
+
+#if FF_MAX_SS == FF_MIN_SS
+#define SECTOR_SIZE(file) (FF_MIN_SS)
+#else
+#define SECTOR_SIZE(file) ((file)->obj.fs->ssize)
+#endif
+
+// Parses decimal digits and moves value past them. Returns false if there are none.
+static bool _parse_number(const char **value, uint32_t *result) {
+    const char *c = *value;
+    uint64_t number = 0;
+    while (*c >= '0' && *c <= '9') {
+        number = number * 10 + (*c - '0');
+        if (number > UINT32_MAX) {
+            number = UINT32_MAX + 1ULL; // Past the end of any file.
+        }
+        c++;
+    }
+    if (c == *value) {
+        return false;
+    }
+    *value = c;
+    *result = MIN(number, UINT32_MAX);
+    return true;
+}
+
+web_workflow_range_t web_workflow_parse_range(const char *value, uint32_t size, uint32_t *start, uint32_t *length) {
+    const char *prefix = "bytes=";
+    if (strncmp(value, prefix, strlen(prefix)) != 0) {
+        return WEB_WORKFLOW_RANGE_NONE;
+    }
+    value += strlen(prefix);
+    uint32_t first;
+    uint32_t last = size - 1;
+    if (*value == '-') {
+        // The last n bytes.
+        value++;
+        uint32_t suffix;
+        if (!_parse_number(&value, &suffix) || *value != '\0') {
+            return WEB_WORKFLOW_RANGE_NONE;
+        }
+        if (suffix == 0 || size == 0) {
+            return WEB_WORKFLOW_RANGE_UNSATISFIABLE;
+        }
+        first = suffix < size ? size - suffix : 0;
+    } else {
+        if (!_parse_number(&value, &first) || *value != '-') {
+            return WEB_WORKFLOW_RANGE_NONE;
+        }
+        value++;
+        if (*value != '\0') {
+            uint32_t requested_last;
+            if (!_parse_number(&value, &requested_last) || *value != '\0' || requested_last < first) {
+                return WEB_WORKFLOW_RANGE_NONE;
+            }
+            last = MIN(last, requested_last);
+        }
+        if (first >= size) {
+            return WEB_WORKFLOW_RANGE_UNSATISFIABLE;
+        }
+    }
+    *start = first;
+    *length = last - first + 1;
+    return WEB_WORKFLOW_RANGE_OK;
+}
+
+bool web_workflow_send_file(socketpool_socket_obj_t *socket, FIL *file, uint32_t length) {
+    uint8_t small_buffer[64];
+    uint8_t *buffer = port_malloc(CIRCUITPY_WEB_WORKFLOW_TRANSFER_SIZE, false);
+    uint32_t buffer_size = CIRCUITPY_WEB_WORKFLOW_TRANSFER_SIZE;
+    if (buffer == NULL) {
+        buffer = small_buffer;
+        buffer_size = sizeof(small_buffer);
+    }
+    const uint32_t sector_size = SECTOR_SIZE(file);
+
+    bool ok = true;
+    while (length > 0) {
+        uint32_t quantity = MIN(length, buffer_size);
+        // FatFs reads whole sectors at sector aligned file offsets straight into our buffer instead
+        // of copying them through its own sector buffer. So, if we start partway through a sector,
+        // stop the first read at the end of it and keep later reads to whole sectors.
+        uint32_t sector_offset = f_tell(file) % sector_size;
+        if (sector_offset != 0 && quantity > sector_size - sector_offset) {
+            quantity = sector_size - sector_offset;
+        } else if (quantity < length && quantity >= sector_size) {
+            quantity -= quantity % sector_size;
+        }
+        UINT quantity_read;
+        if (f_read(file, buffer, quantity, &quantity_read) != FR_OK || quantity_read != quantity) {
+            ok = false;
+            break;
+        }
+        length -= quantity;
+        // Flush the last chunk so it goes out without waiting for Nagle's algorithm.
+        web_workflow_send_raw(socket, length == 0, buffer, quantity);
+        if (!common_hal_socketpool_socket_get_connected(socket)) {
+            ok = false;
+            break;
+        }
+    }
+
+    if (buffer != small_buffer) {
+        port_free(buffer);
+    }
+    return ok;
+}
+
+// Receives into data until it is full. Returns the number of bytes received, which is less than
+// length only if the connection failed.
+static size_t _receive(socketpool_socket_obj_t *socket, web_workflow_request_t *request, uint8_t *data, size_t length) {
+    size_t received = 0;
+    while (received < length) {
+        int len = web_workflow_request_read_body_into(socket, request, data + received, length - received);
+        if (len == -MP_EAGAIN) {
+            continue;
+        }
+        if (len <= 0) {
+            break;
+        }
+        received += len;
+    }
+    return received;
+}
+
+bool web_workflow_receive_file(socketpool_socket_obj_t *socket, web_workflow_request_t *request, FIL *file, size_t length, size_t *received, web_workflow_receive_time_t *timing) {
+    // Collect whole clusters, as many as fit, so that FatFs writes them straight from the buffer
+    // with one multi-sector write each instead of a sector at a time through its own buffer. The
+    // network stack keeps receiving into its TCP window while we write, so the radio stays busy
+    // during the write without a second buffer of our own.
+    uint32_t buffer_size = CIRCUITPY_WEB_WORKFLOW_TRANSFER_SIZE;
+    uint32_t cluster_size = file->obj.fs->csize * SECTOR_SIZE(file);
+    if (cluster_size <= buffer_size) {
+        buffer_size -= buffer_size % cluster_size;
+    }
+    uint8_t *buffer = port_malloc(buffer_size, false);
+
+    *received = 0;
+    timing->network_ms = 0;
+    timing->flash_ms = 0;
+    bool ok = true;
+    while (*received < length && ok) {
+        uint32_t start = supervisor_ticks_ms32();
+        uint8_t *data;
+        size_t quantity;
+        if (buffer != NULL) {
+            data = buffer;
+            size_t wanted = MIN(buffer_size, length - *received);
+            quantity = _receive(socket, request, buffer, wanted);
+            ok = quantity == wanted;
+        } else {
+            // No room for a buffer so write whatever arrives from the request's own.
+            int len;
+            do {
+                len = web_workflow_request_read_body(socket, request, &data, length - *received);
+            } while (len == -MP_EAGAIN);
+            ok = len > 0;
+            quantity = ok ? len : 0;
+        }
+        *received += quantity;
+        uint32_t received_at = supervisor_ticks_ms32();
+        timing->network_ms += received_at - start;
+        if (!ok) {
+            break;
+        }
+
+        UINT actual;
+        ok = f_write(file, data, quantity, &actual) == FR_OK && actual == quantity;
+        timing->flash_ms += supervisor_ticks_ms32() - received_at;
+    }
+
+    if (buffer != NULL) {
+        port_free(buffer);
+    }
+    return ok;
+}
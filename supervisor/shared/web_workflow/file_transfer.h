@@ -0,0 +1,39 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "lib/oofatfs/ff.h"
+#include "shared-bindings/socketpool/Socket.h"
+#include "supervisor/shared/web_workflow/request.h"
+
+// Where the time receiving a file went.
+typedef struct {
+    uint32_t network_ms; // Waiting for data to arrive.
+    uint32_t flash_ms; // Writing it to the file.
+} web_workflow_receive_time_t;
+
+typedef enum {
+    WEB_WORKFLOW_RANGE_NONE, // No usable range so send the whole file.
+    WEB_WORKFLOW_RANGE_OK,
+    WEB_WORKFLOW_RANGE_UNSATISFIABLE,
+} web_workflow_range_t;
+
+// Resolves the value of a Range header against a file of size bytes. Only a single byte range is
+// supported. Anything else is ignored, which HTTP allows, so the whole file is sent instead.
+web_workflow_range_t web_workflow_parse_range(const char *value, uint32_t size, uint32_t *start, uint32_t *length);
+
+// Sends length bytes of file from its current position. Returns false if the file couldn't be read
+// or the connection was lost.
+bool web_workflow_send_file(socketpool_socket_obj_t *socket, FIL *file, uint32_t length);
+
+// Writes length bytes of request's body to file. received is set to the number of bytes taken from
+// the socket, even if they couldn't all be written. Returns false if the connection failed or the
+// file couldn't be written.
+bool web_workflow_receive_file(socketpool_socket_obj_t *socket, web_workflow_request_t *request, FIL *file, size_t length, size_t *received, web_workflow_receive_time_t *timing);
@@ -0,0 +1,210 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include "supervisor/shared/web_workflow/request.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "py/mperrno.h"
+#include "py/misc.h"
+
+void web_workflow_request_reset(web_workflow_request_t *request) {
+    request->state = STATE_METHOD;
+    request->origin[0] = '\0';
+    request->host[0] = '\0';
+    request->range[0] = '\0';
+    request->content_length = 0;
+    request->offset = 0;
+    request->timestamp_ms = 0;
+    request->redirect = false;
+    request->in_progress = false;
+    request->new_socket = false;
+    request->authenticated = false;
+    request->expect = false;
+    request->json = false;
+    request->websocket = false;
+    request->buffer_start = 0;
+    request->buffer_end = 0;
+}
+
+static void _process_header(web_workflow_request_t *request, const char *api_password) {
+    if (strcasecmp(request->header_key, "Authorization") == 0) {
+        const char *prefix = "Basic ";
+        request->authenticated = strncmp(request->header_value, prefix, strlen(prefix)) == 0 &&
+            strcmp(api_password, request->header_value + strlen(prefix)) == 0;
+    } else if (strcasecmp(request->header_key, "Host") == 0) {
+        // Do a prefix check so that port is ignored. Length must be the same or the
+        // header ends in :.
+        const char *cp_local = "circuitpython.local";
+        request->redirect = strncmp(request->header_value, cp_local, strlen(cp_local)) == 0 &&
+            (strlen(request->header_value) == strlen(cp_local) ||
+                request->header_value[strlen(cp_local)] == ':');
+        strncpy(request->host, request->header_value, sizeof(request->host) - 1);
+        request->host[sizeof(request->host) - 1] = '\0';
+    } else if (strcasecmp(request->header_key, "Content-Length") == 0) {
+        request->content_length = strtoul(request->header_value, NULL, 10);
+    } else if (strcasecmp(request->header_key, "Expect") == 0) {
+        request->expect = strcmp(request->header_value, "100-continue") == 0;
+    } else if (strcasecmp(request->header_key, "Accept") == 0) {
+        request->json = strcasecmp(request->header_value, "application/json") == 0;
+    } else if (strcasecmp(request->header_key, "Origin") == 0) {
+        strncpy(request->origin, request->header_value, sizeof(request->origin) - 1);
+        request->origin[sizeof(request->origin) - 1] = '\0';
+    } else if (strcasecmp(request->header_key, "X-Timestamp") == 0) {
+        request->timestamp_ms = strtoull(request->header_value, NULL, 10);
+    } else if (strcasecmp(request->header_key, "Upgrade") == 0) {
+        request->websocket = strcmp(request->header_value, "websocket") == 0;
+    } else if (strcasecmp(request->header_key, "Sec-WebSocket-Version") == 0) {
+        request->websocket_version = strtoul(request->header_value, NULL, 10);
+    } else if (strcasecmp(request->header_key, "Sec-WebSocket-Key") == 0 &&
+               strlen(request->header_value) == 24) {
+        strcpy(request->websocket_key, request->header_value);
+    } else if (strcasecmp(request->header_key, "X-Destination") == 0) {
+        strcpy(request->destination, request->header_value);
+    } else if (strcasecmp(request->header_key, "Range") == 0 &&
+               strlen(request->header_value) < sizeof(request->range)) {
+        // Longer values aren't a single range we can serve, so they are ignored.
+        strcpy(request->range, request->header_value);
+    }
+}
+
+// Parses one byte. Returns false if the request is invalid.
+static bool _parse_byte(web_workflow_request_t *request, uint8_t c, const char *api_password) {
+    switch (request->state) {
+        case STATE_METHOD: {
+            if (c == ' ') {
+                request->method[request->offset] = '\0';
+                request->offset = 0;
+                request->state = STATE_PATH;
+            } else if (request->offset >= sizeof(request->method) - 1) {
+                // Skip methods that are too long.
+            } else {
+                request->method[request->offset] = c;
+                request->offset++;
+            }
+            break;
+        }
+        case STATE_PATH:  {
+            if (c == ' ') {
+                request->path[request->offset] = '\0';
+                request->offset = 0;
+                request->state = STATE_VERSION;
+            } else if (request->offset >= sizeof(request->path) - 1) {
+                // Skip paths that are too long.
+            } else {
+                request->path[request->offset] = c;
+                request->offset++;
+            }
+            break;
+        }
+        case STATE_VERSION: {
+            const char *supported_version = "HTTP/1.1\r";
+            if (supported_version[request->offset] != c) {
+                return false;
+            }
+            request->offset++;
+            if (request->offset == strlen(supported_version)) {
+                request->state = STATE_HEADER_KEY;
+                request->offset = 0;
+            }
+            break;
+        }
+        case STATE_HEADER_KEY: {
+            if (c == '\r') {
+                request->state = STATE_BODY;
+            } else if (c == '\n') {
+                // Consume the \n
+            } else if (c == ':') {
+                request->header_key[request->offset] = '\0';
+                request->offset = 0;
+                request->state = STATE_HEADER_VALUE;
+            } else if (request->offset >= sizeof(request->header_key) - 1) {
+                // Skip keys that are too long.
+            } else {
+                request->header_key[request->offset] = c;
+                request->offset++;
+            }
+            break;
+        }
+        case STATE_HEADER_VALUE: {
+            if (request->offset == 0) {
+                if (c != ' ') {
+                    return false;
+                }
+                request->offset++;
+            } else if (c == '\r') {
+                request->header_value[request->offset - 1] = '\0';
+                request->offset = 0;
+                request->state = STATE_HEADER_KEY;
+                _process_header(request, api_password);
+            } else if (request->offset > sizeof(request->header_value) - 1) {
+                // Skip values that are too long.
+            } else {
+                request->header_value[request->offset - 1] = c;
+                request->offset++;
+            }
+            break;
+        }
+        case STATE_BODY:
+            // Consume the \n of the blank line.
+            break;
+    }
+    return true;
+}
+
+web_workflow_request_status_t web_workflow_request_parse(socketpool_socket_obj_t *socket, web_workflow_request_t *request, const char *api_password) {
+    // This code assumes header lines are terminated with \r\n
+    while (true) {
+        if (request->buffer_start == request->buffer_end) {
+            int len = socketpool_socket_recv_into(socket, request->buffer, sizeof(request->buffer));
+            if (len <= 0) {
+                if (len == 0 || len == -MP_ENOTCONN) {
+                    return WEB_WORKFLOW_REQUEST_CLOSED;
+                }
+                return WEB_WORKFLOW_REQUEST_INCOMPLETE;
+            }
+            request->buffer_start = 0;
+            request->buffer_end = len;
+        }
+        if (!request->in_progress) {
+            request->in_progress = true;
+            request->new_socket = false;
+        }
+        bool body = request->state == STATE_BODY;
+        if (!_parse_byte(request, request->buffer[request->buffer_start++], api_password)) {
+            return WEB_WORKFLOW_REQUEST_INVALID;
+        }
+        if (body) {
+            return WEB_WORKFLOW_REQUEST_DONE;
+        }
+    }
+}
+
+int web_workflow_request_read_body(socketpool_socket_obj_t *socket, web_workflow_request_t *request, uint8_t **data, size_t max) {
+    if (request->buffer_start == request->buffer_end) {
+        int len = socketpool_socket_recv_into(socket, request->buffer, MIN(max, sizeof(request->buffer)));
+        if (len <= 0) {
+            return len;
+        }
+        request->buffer_start = 0;
+        request->buffer_end = len;
+    }
+    size_t len = MIN(max, (size_t)(request->buffer_end - request->buffer_start));
+    *data = request->buffer + request->buffer_start;
+    request->buffer_start += len;
+    return len;
+}
+
+int web_workflow_request_read_body_into(socketpool_socket_obj_t *socket, web_workflow_request_t *request, uint8_t *buf, size_t len) {
+    if (request->buffer_start == request->buffer_end) {
+        return socketpool_socket_recv_into(socket, buf, len);
+    }
+    len = MIN(len, (size_t)(request->buffer_end - request->buffer_start));
+    memcpy(buf, request->buffer + request->buffer_start, len);
+    request->buffer_start += len;
+    return len;
+}
@@ -0,0 +1,75 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "shared-bindings/socketpool/Socket.h"
+
+// Bytes received from the socket at a time. This is one full TCP segment over WiFi.
+#define WEB_WORKFLOW_REQUEST_BUFFER_SIZE (1460)
+
+enum request_state {
+    STATE_METHOD,
+    STATE_PATH,
+    STATE_VERSION,
+    STATE_HEADER_KEY,
+    STATE_HEADER_VALUE,
+    STATE_BODY
+};
+
+typedef struct {
+    enum request_state state;
+    char method[8];
+    char path[256];
+    char destination[256];
+    char header_key[64];
+    char header_value[256];
+    char origin[64];        // We store the origin so we can reply back with it.
+    char host[64];          // We store the host to check against origin.
+    char range[32];         // Resolved once we know the size of the file.
+    size_t content_length;
+    size_t offset;
+    uint64_t timestamp_ms;
+    bool redirect;
+    bool in_progress;
+    bool authenticated;
+    bool expect;
+    bool json;
+    bool websocket;
+    bool new_socket;
+    uint32_t websocket_version;
+    // RFC6455 for websockets says this header should be 24 base64 characters long.
+    char websocket_key[24 + 1];
+    // Received bytes from buffer_start up to buffer_end haven't been parsed or read as body yet.
+    uint16_t buffer_start;
+    uint16_t buffer_end;
+    uint8_t buffer[WEB_WORKFLOW_REQUEST_BUFFER_SIZE];
+} web_workflow_request_t;
+
+typedef enum {
+    WEB_WORKFLOW_REQUEST_INCOMPLETE, // Nothing more has been received yet.
+    WEB_WORKFLOW_REQUEST_DONE, // The headers are complete. The body hasn't been read.
+    WEB_WORKFLOW_REQUEST_INVALID,
+    WEB_WORKFLOW_REQUEST_CLOSED, // The other end disconnected.
+} web_workflow_request_status_t;
+
+void web_workflow_request_reset(web_workflow_request_t *request);
+
+// Parses as much of the request line and headers as has been received. api_password is the
+// base64 encoded ":password" that authenticates a request, or empty if there is none.
+web_workflow_request_status_t web_workflow_request_parse(socketpool_socket_obj_t *socket, web_workflow_request_t *request, const char *api_password);
+
+// Points data at up to max bytes of the body. They are the bytes received along with the headers if
+// there are any left, otherwise they are received into the request's buffer. Returns the number of
+// bytes or the negative error from the socket. The bytes are only valid until the next call.
+int web_workflow_request_read_body(socketpool_socket_obj_t *socket, web_workflow_request_t *request, uint8_t **data, size_t max);
+
+// Like web_workflow_request_read_body but into buf, so bytes received now don't need copying.
+int web_workflow_request_read_body_into(socketpool_socket_obj_t *socket, web_workflow_request_t *request, uint8_t *buf, size_t len);
@@ -22,6 +22,9 @@
 #include "supervisor/filesystem.h"
 #include "supervisor/port.h"
 #include "supervisor/shared/reload.h"
+#include "supervisor/shared/tick.h"
+#include "supervisor/shared/web_workflow/file_transfer.h"
+#include "supervisor/shared/web_workflow/request.h"
 #include "supervisor/shared/web_workflow/web_workflow.h"
 #include "supervisor/shared/web_workflow/websocket.h"
 #include "supervisor/shared/workflow.h"
@@ -50,40 +53,6 @@
 #include "shared-module/os/__init__.h"
 #endif
 
-enum request_state {
-    STATE_METHOD,
-    STATE_PATH,
-    STATE_VERSION,
-    STATE_HEADER_KEY,
-    STATE_HEADER_VALUE,
-    STATE_BODY
-};
-
-typedef struct {
-    enum request_state state;
-    char method[8];
-    char path[256];
-    char destination[256];
-    char header_key[64];
-    char header_value[256];
-    char origin[64];        // We store the origin so we can reply back with it.
-    char host[64];          // We store the host to check against origin.
-    size_t content_length;
-    size_t offset;
-    uint64_t timestamp_ms;
-    bool redirect;
-    bool done;
-    bool in_progress;
-    bool authenticated;
-    bool expect;
-    bool json;
-    bool websocket;
-    bool new_socket;
-    uint32_t websocket_version;
-    // RFC6455 for websockets says this header should be 24 base64 characters long.
-    char websocket_key[24 + 1];
-} _request;
-
 static wifi_radio_error_t _wifi_status = WIFI_RADIO_ERROR_NONE;
 
 #if CIRCUITPY_STATUS_BAR
@@ -103,7 +72,7 @@ static socketpool_socketpool_obj_t pool;
 static socketpool_socket_obj_t listening;
 static socketpool_socket_obj_t active;
 
-static _request active_request;
+static web_workflow_request_t active_request;
 
 static char _api_password[64];
 static char web_instance_name[50];
@@ -476,7 +445,7 @@ static bool _endswith(const char *str, const char *suffix) {
 const char http_scheme[] = "http://";
 #define PREFIX_HTTP_LEN (sizeof(http_scheme) - 1)
 
-static bool _origin_ok(_request *request) {
+static bool _origin_ok(web_workflow_request_t *request) {
     // Origin may be 'null'
     if (request->origin[0] == '\0') {
         return true;
@@ -509,7 +478,7 @@ static bool _origin_ok(_request *request) {
 
 static const char *OK_JSON = "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\nContent-Type: application/json\r\n";
 
-static void _cors_header(socketpool_socket_obj_t *socket, _request *request) {
+static void _cors_header(socketpool_socket_obj_t *socket, web_workflow_request_t *request) {
     _send_strs(socket,
         "Access-Control-Allow-Credentials: true\r\n",
         "Vary: Origin, Accept, Upgrade\r\n",
@@ -517,13 +486,13 @@ static void _cors_header(socketpool_socket_obj_t *socket, _request *request) {
         (request->origin[0] == '\0') ? "*" : request->origin, "\r\n", NULL);
 }
 
-static void _reply_continue(socketpool_socket_obj_t *socket, _request *request) {
+static void _reply_continue(socketpool_socket_obj_t *socket, web_workflow_request_t *request) {
     _send_str(socket, "HTTP/1.1 100 Continue\r\n");
     _cors_header(socket, request);
     _send_final_str(socket, "\r\n");
 }
 
-static void _reply_created(socketpool_socket_obj_t *socket, _request *request) {
+static void _reply_created(socketpool_socket_obj_t *socket, web_workflow_request_t *request) {
     _send_strs(socket,
         "HTTP/1.1 201 Created\r\n",
         "Content-Length: 0\r\n", NULL);
@@ -531,7 +500,7 @@ static void _reply_created(socketpool_socket_obj_t *socket, _request *request) {
     _send_final_str(socket, "\r\n");
 }
 
-static void _reply_no_content(socketpool_socket_obj_t *socket, _request *request) {
+static void _reply_no_content(socketpool_socket_obj_t *socket, web_workflow_request_t *request) {
     _send_strs(socket,
         "HTTP/1.1 204 No Content\r\n",
         "Content-Length: 0\r\n", NULL);
@@ -539,19 +508,34 @@ static void _reply_no_content(socketpool_socket_obj_t *socket, _request *request
     _send_final_str(socket, "\r\n");
 }
 
-static void _reply_access_control(socketpool_socket_obj_t *socket, _request *request) {
+// Server-Timing shows where an upload's time went in the browser's developer tools.
+static void _reply_written(socketpool_socket_obj_t *socket, web_workflow_request_t *request, bool new_file, web_workflow_receive_time_t *timing) {
+    uint32_t total_ms = MAX(timing->network_ms + timing->flash_ms, 1);
+    _send_strs(socket,
+        new_file ? "HTTP/1.1 201 Created\r\n" : "HTTP/1.1 204 No Content\r\n",
+        "Content-Length: 0\r\n", NULL);
+    mp_print_t _socket_print = {socket, _print_raw};
+    mp_printf(&_socket_print, "Server-Timing: network;dur=%u, flash;dur=%u, total;dur=%u;desc=\"%u KB/s\"\r\n",
+        timing->network_ms, timing->flash_ms, total_ms, request->content_length / total_ms);
+    _send_strs(socket,
+        "Timing-Allow-Origin: ", (request->origin[0] == '\0') ? "*" : request->origin, "\r\n", NULL);
+    _cors_header(socket, request);
+    _send_final_str(socket, "\r\n");
+}
+
+static void _reply_access_control(socketpool_socket_obj_t *socket, web_workflow_request_t *request) {
     _send_strs(socket,
         "HTTP/1.1 204 No Content\r\n",
         "Content-Length: 0\r\n",
         "Access-Control-Expose-Headers: Access-Control-Allow-Methods\r\n",
-        "Access-Control-Allow-Headers: X-Timestamp, X-Destination, Content-Type, Authorization\r\n",
+        "Access-Control-Allow-Headers: X-Timestamp, X-Destination, Content-Type, Authorization, Range\r\n",
         "Access-Control-Allow-Methods:GET, OPTIONS, PUT, DELETE, MOVE", NULL);
     _send_str(socket, "\r\n");
     _cors_header(socket, request);
     _send_final_str(socket, "\r\n");
 }
 
-static void _reply_missing(socketpool_socket_obj_t *socket, _request *request) {
+static void _reply_missing(socketpool_socket_obj_t *socket, web_workflow_request_t *request) {
     _send_strs(socket,
         "HTTP/1.1 404 Not Found\r\n",
         "Content-Length: 0\r\n", NULL);
@@ -559,7 +543,7 @@ static void _reply_missing(socketpool_socket_obj_t *socket, _request *request) {
     _send_final_str(socket, "\r\n");
 }
 
-static void _reply_method_not_allowed(socketpool_socket_obj_t *socket, _request *request) {
+static void _reply_method_not_allowed(socketpool_socket_obj_t *socket, web_workflow_request_t *request) {
     _send_strs(socket,
         "HTTP/1.1 405 Method Not Allowed\r\n",
         "Content-Length: 0\r\n", NULL);
@@ -567,7 +551,7 @@ static void _reply_method_not_allowed(socketpool_socket_obj_t *socket, _request
     _send_final_str(socket, "\r\n");
 }
 
-static void _reply_forbidden(socketpool_socket_obj_t *socket, _request *request) {
+static void _reply_forbidden(socketpool_socket_obj_t *socket, web_workflow_request_t *request) {
     _send_strs(socket,
         "HTTP/1.1 403 Forbidden\r\n",
         "Content-Length: 0\r\n", NULL);
@@ -575,7 +559,7 @@ static void _reply_forbidden(socketpool_socket_obj_t *socket, _request *request)
     _send_final_str(socket, "\r\n");
 }
 
-static void _reply_conflict(socketpool_socket_obj_t *socket, _request *request) {
+static void _reply_conflict(socketpool_socket_obj_t *socket, web_workflow_request_t *request) {
     _send_strs(socket,
         "HTTP/1.1 409 Conflict\r\n",
         "Content-Length: 19\r\n", NULL);
@@ -584,7 +568,7 @@ static void _reply_conflict(socketpool_socket_obj_t *socket, _request *request)
 }
 
 
-static void _reply_precondition_failed(socketpool_socket_obj_t *socket, _request *request) {
+static void _reply_precondition_failed(socketpool_socket_obj_t *socket, web_workflow_request_t *request) {
     _send_strs(socket,
         "HTTP/1.1 412 Precondition Failed\r\n",
         "Content-Length: 0\r\n", NULL);
@@ -592,7 +576,7 @@ static void _reply_precondition_failed(socketpool_socket_obj_t *socket, _request
     _send_final_str(socket, "\r\n");
 }
 
-static void _reply_payload_too_large(socketpool_socket_obj_t *socket, _request *request) {
+static void _reply_payload_too_large(socketpool_socket_obj_t *socket, web_workflow_request_t *request) {
     _send_strs(socket,
         "HTTP/1.1 413 Payload Too Large\r\n",
         "Content-Length: 0\r\n", NULL);
@@ -600,7 +584,7 @@ static void _reply_payload_too_large(socketpool_socket_obj_t *socket, _request *
     _send_final_str(socket, "\r\n");
 }
 
-static void _reply_expectation_failed(socketpool_socket_obj_t *socket, _request *request) {
+static void _reply_expectation_failed(socketpool_socket_obj_t *socket, web_workflow_request_t *request) {
     _send_strs(socket,
         "HTTP/1.1 417 Expectation Failed\r\n",
         "Content-Length: 0\r\n", NULL);
@@ -608,7 +592,7 @@ static void _reply_expectation_failed(socketpool_socket_obj_t *socket, _request
     _send_final_str(socket, "\r\n");
 }
 
-static void _reply_unauthorized(socketpool_socket_obj_t *socket, _request *request) {
+static void _reply_unauthorized(socketpool_socket_obj_t *socket, web_workflow_request_t *request) {
     _send_strs(socket,
         "HTTP/1.1 401 Unauthorized\r\n",
         "Content-Length: 0\r\n",
@@ -617,7 +601,7 @@ static void _reply_unauthorized(socketpool_socket_obj_t *socket, _request *reque
     _send_final_str(socket, "\r\n");
 }
 
-static void _reply_server_error(socketpool_socket_obj_t *socket, _request *request) {
+static void _reply_server_error(socketpool_socket_obj_t *socket, web_workflow_request_t *request) {
     _send_strs(socket,
         "HTTP/1.1 500 Internal Server Error\r\n",
         "Content-Length: 0\r\n", NULL);
@@ -626,7 +610,7 @@ static void _reply_server_error(socketpool_socket_obj_t *socket, _request *reque
 }
 
 #if CIRCUITPY_MDNS
-static void _reply_redirect(socketpool_socket_obj_t *socket, _request *request, const char *path) {
+static void _reply_redirect(socketpool_socket_obj_t *socket, web_workflow_request_t *request, const char *path) {
     int nodelay = 1;
     common_hal_socketpool_socket_setsockopt(socket, SOCKETPOOL_IPPROTO_TCP, SOCKETPOOL_TCP_NODELAY, &nodelay, sizeof(nodelay));
     const char *hostname = common_hal_mdns_server_get_hostname(&mdns);
@@ -652,7 +636,7 @@ static void _reply_redirect(socketpool_socket_obj_t *socket, _request *request,
 }
 #endif
 
-static void _reply_directory_json(socketpool_socket_obj_t *socket, _request *request, fs_user_mount_t *fs_mount, FF_DIR *dir, const char *request_path, const char *path) {
+static void _reply_directory_json(socketpool_socket_obj_t *socket, web_workflow_request_t *request, fs_user_mount_t *fs_mount, FF_DIR *dir, const char *request_path, const char *path) {
     FILINFO file_info;
     char *fn = file_info.fname;
     FRESULT res = f_readdir(dir, &file_info);
@@ -736,12 +720,30 @@ static void _reply_directory_json(socketpool_socket_obj_t *socket, _request *req
     _send_chunk(socket, "");
 }
 
-static void _reply_with_file(socketpool_socket_obj_t *socket, _request *request, const char *filename, FIL *active_file) {
+static void _reply_with_file(socketpool_socket_obj_t *socket, web_workflow_request_t *request, const char *filename, FIL *active_file) {
     uint32_t total_length = f_size(active_file);
+    uint32_t start = 0;
+    uint32_t length = total_length;
+    web_workflow_range_t range = web_workflow_parse_range(request->range, total_length, &start, &length);
 
-    _send_str(socket, "HTTP/1.1 200 OK\r\n");
     mp_print_t _socket_print = {socket, _print_raw};
-    mp_printf(&_socket_print, "Content-Length: %d\r\n", total_length);
+    if (range == WEB_WORKFLOW_RANGE_UNSATISFIABLE) {
+        _send_str(socket, "HTTP/1.1 416 Range Not Satisfiable\r\n");
+        mp_printf(&_socket_print, "Content-Range: bytes */%d\r\n", total_length);
+        _send_str(socket, "Content-Length: 0\r\n");
+        _cors_header(socket, request);
+        _send_final_str(socket, "\r\n");
+        return;
+    }
+    if (range == WEB_WORKFLOW_RANGE_OK) {
+        _send_str(socket, "HTTP/1.1 206 Partial Content\r\n");
+        mp_printf(&_socket_print, "Content-Range: bytes %d-%d/%d\r\n", start, start + length - 1, total_length);
+        f_lseek(active_file, start);
+    } else {
+        _send_str(socket, "HTTP/1.1 200 OK\r\n");
+    }
+    _send_str(socket, "Accept-Ranges: bytes\r\n");
+    mp_printf(&_socket_print, "Content-Length: %d\r\n", length);
     // TODO: Make this a table to save space.
     if (_endswith(filename, ".txt") || _endswith(filename, ".py") || _endswith(filename, ".toml")) {
         _send_strs(socket, "Content-Type:", "text/plain", ";charset=UTF-8\r\n", NULL);
@@ -757,45 +759,12 @@ static void _reply_with_file(socketpool_socket_obj_t *socket, _request *request,
     _cors_header(socket, request);
     _send_str(socket, "\r\n");
 
-    uint32_t total_read = 0;
-    int nodelay_ok = -1;
-    while (total_read < total_length) {
-        uint8_t data_buffer[64];
-        size_t quantity_read;
-        f_read(active_file, data_buffer, 64, &quantity_read);
-        total_read += quantity_read;
-        // When getting near the end of the file, disable Nagle's combining algorithm so that
-        // data is sent immediately.
-        if (total_length - total_read < 64) {
-            int nodelay = 1;
-            // Returns 0 when it works.
-            nodelay_ok = common_hal_socketpool_socket_setsockopt(socket, SOCKETPOOL_IPPROTO_TCP, SOCKETPOOL_TCP_NODELAY, &nodelay, sizeof(nodelay));
-        }
-        uint32_t send_offset = 0;
-        while (send_offset < quantity_read) {
-            int sent = socketpool_socket_send(socket, data_buffer + send_offset, quantity_read - send_offset);
-            if (sent < 0) {
-                if (sent == -MP_EAGAIN) {
-                    sent = 0;
-                } else {
-                    break;
-                }
-            }
-            send_offset += sent;
-        }
-    }
-    if (total_read < total_length) {
+    if (!web_workflow_send_file(socket, active_file, length)) {
         socketpool_socket_close(socket);
     }
-
-    // Re-enable Nagle's algorithm when done sending.
-    if (nodelay_ok == 0) {
-        int nodelay = 0;
-        nodelay_ok = common_hal_socketpool_socket_setsockopt(socket, SOCKETPOOL_IPPROTO_TCP, SOCKETPOOL_TCP_NODELAY, &nodelay, sizeof(nodelay));
-    }
 }
 
-static void _reply_with_devices_json(socketpool_socket_obj_t *socket, _request *request) {
+static void _reply_with_devices_json(socketpool_socket_obj_t *socket, web_workflow_request_t *request) {
     size_t total_results = 0;
     #if CIRCUITPY_MDNS
     mdns_remoteservice_obj_t found_devices[32];
@@ -833,7 +802,7 @@ static void _reply_with_devices_json(socketpool_socket_obj_t *socket, _request *
     _send_chunk(socket, "");
 }
 
-static void _reply_with_version_json(socketpool_socket_obj_t *socket, _request *request) {
+static void _reply_with_version_json(socketpool_socket_obj_t *socket, web_workflow_request_t *request) {
     _send_str(socket, OK_JSON);
     _cors_header(socket, request);
     _send_str(socket, "\r\n");
@@ -874,7 +843,7 @@ static void _reply_with_version_json(socketpool_socket_obj_t *socket, _request *
     _send_chunk(socket, "");
 }
 
-static void _reply_with_diskinfo_json(socketpool_socket_obj_t *socket, _request *request) {
+static void _reply_with_diskinfo_json(socketpool_socket_obj_t *socket, web_workflow_request_t *request) {
     _send_str(socket, OK_JSON);
     _cors_header(socket, request);
     _send_str(socket, "\r\n");
@@ -940,27 +909,27 @@ static uint64_t truncate_time(uint64_t input_time, DWORD *fattime) {
     return truncated_time;
 }
 
-static void _discard_incoming(socketpool_socket_obj_t *socket, size_t amount) {
+static void _discard_incoming(socketpool_socket_obj_t *socket, web_workflow_request_t *request, size_t amount) {
     size_t discarded = 0;
     while (discarded < amount) {
-        uint8_t bytes[64];
-        size_t read_len = MIN(sizeof(bytes), amount - discarded);
-        int len = socketpool_socket_recv_into(socket, bytes, read_len);
-        if (len < 0) {
-            if (len == -MP_EAGAIN) {
-                continue;
-            }
+        uint8_t *bytes;
+        int len = web_workflow_request_read_body(socket, request, &bytes, amount - discarded);
+        if (len == -MP_EAGAIN) {
+            continue;
+        }
+        // Zero means the other end closed the connection so nothing more will arrive.
+        if (len <= 0) {
             break;
         }
         discarded += len;
     }
 }
 
-static void _write_file_and_reply(socketpool_socket_obj_t *socket, _request *request, fs_user_mount_t *fs_mount, const TCHAR *path) {
+static void _write_file_and_reply(socketpool_socket_obj_t *socket, web_workflow_request_t *request, fs_user_mount_t *fs_mount, const TCHAR *path) {
     FIL active_file;
 
     if (!filesystem_lock(fs_mount)) {
-        _discard_incoming(socket, request->content_length);
+        _discard_incoming(socket, request, request->content_length);
         _reply_conflict(socket, request);
         return;
     }
@@ -984,14 +953,14 @@ static void _write_file_and_reply(socketpool_socket_obj_t *socket, _request *req
     if (result == FR_NO_PATH) {
         override_fattime(0);
         filesystem_unlock(fs_mount);
-        _discard_incoming(socket, request->content_length);
+        _discard_incoming(socket, request, request->content_length);
         _reply_missing(socket, request);
         return;
     }
     if (result != FR_OK) {
         override_fattime(0);
         filesystem_unlock(fs_mount);
-        _discard_incoming(socket, request->content_length);
+        _discard_incoming(socket, request, request->content_length);
         _reply_server_error(socket, request);
         return;
     }
@@ -1015,7 +984,7 @@ static void _write_file_and_reply(socketpool_socket_obj_t *socket, _request *req
         if (request->expect) {
             _reply_expectation_failed(socket, request);
         } else {
-            _discard_incoming(socket, request->content_length);
+            _discard_incoming(socket, request, request->content_length);
             _reply_payload_too_large(socket, request);
         }
         return;
@@ -1025,39 +994,21 @@ static void _write_file_and_reply(socketpool_socket_obj_t *socket, _request *req
     f_truncate(&active_file);
     f_rewind(&active_file);
 
-    size_t total_read = 0;
-    bool error = false;
-    while (total_read < request->content_length && !error) {
-        uint8_t bytes[64];
-        size_t read_len = MIN(sizeof(bytes), request->content_length - total_read);
-        int len = socketpool_socket_recv_into(socket, bytes, read_len);
-        if (len < 0) {
-            if (len == -MP_EAGAIN) {
-                continue;
-            }
-            error = true;
-            break;
-        }
-        total_read += len;
-        UINT actual;
-        f_write(&active_file, bytes, len, &actual);
-        if (actual < (UINT)len) {
-            error = true;
-            break;
-        }
-    }
+    size_t total_read;
+    web_workflow_receive_time_t timing;
+    bool error = !web_workflow_receive_file(socket, request, &active_file, request->content_length, &total_read, &timing);
 
+    uint32_t close_start = supervisor_ticks_ms32();
     f_close(&active_file);
+    timing.flash_ms += supervisor_ticks_ms32() - close_start;
     filesystem_unlock(fs_mount);
 
     override_fattime(0);
     if (error) {
-        _discard_incoming(socket, request->content_length - total_read);
+        _discard_incoming(socket, request, request->content_length - total_read);
         _reply_server_error(socket, request);
-    } else if (new_file) {
-        _reply_created(socket, request);
     } else {
-        _reply_no_content(socket, request);
+        _reply_written(socket, request, new_file, &timing);
     }
 }
 
@@ -1075,7 +1026,7 @@ STATIC_FILE(serial_html);
 STATIC_FILE(serial_js);
 STATIC_FILE(blinka_32x32_ico);
 
-static void _reply_static(socketpool_socket_obj_t *socket, _request *request, const uint8_t *response, size_t response_len, const char *content_type) {
+static void _reply_static(socketpool_socket_obj_t *socket, web_workflow_request_t *request, const uint8_t *response, size_t response_len, const char *content_type) {
     uint32_t total_length = response_len;
     char encoded_len[10];
     snprintf(encoded_len, sizeof(encoded_len), "%" PRIu32, total_length);
@@ -1091,7 +1042,7 @@ static void _reply_static(socketpool_socket_obj_t *socket, _request *request, co
 
 #define _REPLY_STATIC(socket, request, filename) _reply_static(socket, request, filename, filename##_length, filename##_content_type)
 
-static void _reply_websocket_upgrade(socketpool_socket_obj_t *socket, _request *request) {
+static void _reply_websocket_upgrade(socketpool_socket_obj_t *socket, web_workflow_request_t *request) {
     // Compute accept key
     hashlib_hash_obj_t hash;
     common_hal_hashlib_new(&hash, "sha1");
@@ -1146,7 +1097,7 @@ static void _decode_percents(char *str) {
     }
 }
 
-static bool _reply(socketpool_socket_obj_t *socket, _request *request) {
+static bool _reply(socketpool_socket_obj_t *socket, web_workflow_request_t *request) {
     if (request->redirect) {
         #if CIRCUITPY_MDNS
         if (!common_hal_mdns_server_deinited(&mdns)) {
@@ -1384,168 +1335,32 @@ static bool _reply(socketpool_socket_obj_t *socket, _request *request) {
     return false;
 }
 
-static void _reset_request(_request *request) {
-    request->state = STATE_METHOD;
-    request->origin[0] = '\0';
-    request->host[0] = '\0';
-    request->content_length = 0;
-    request->offset = 0;
-    request->timestamp_ms = 0;
-    request->redirect = false;
-    request->done = false;
-    request->in_progress = false;
-    request->new_socket = false;
-    request->authenticated = false;
-    request->expect = false;
-    request->json = false;
-    request->websocket = false;
-}
-
-static void _process_request(socketpool_socket_obj_t *socket, _request *request) {
-    bool more = true;
-    bool error = false;
-    uint8_t c;
-    // This code assumes header lines are terminated with \r\n
-    while (more && !error) {
-
-        int len = socketpool_socket_recv_into(socket, &c, 1);
-        if (len != 1) {
-            more = false;
-            if (len == 0 || len == -MP_ENOTCONN) {
-                // Disconnect - clear 'in-progress'
-                _reset_request(request);
-                common_hal_socketpool_socket_close(socket);
-            }
-            break;
-        }
-        if (!request->in_progress) {
-            autoreload_suspend(AUTORELOAD_SUSPEND_WEB);
-            request->in_progress = true;
-            request->new_socket = false;
-        }
-        switch (request->state) {
-            case STATE_METHOD: {
-                if (c == ' ') {
-                    request->method[request->offset] = '\0';
-                    request->offset = 0;
-                    request->state = STATE_PATH;
-                } else if (request->offset > sizeof(request->method) - 1) {
-                    // Skip methods that are too long.
-                } else {
-                    request->method[request->offset] = c;
-                    request->offset++;
-                }
-                break;
-            }
-            case STATE_PATH:  {
-                if (c == ' ') {
-                    request->path[request->offset] = '\0';
-                    request->offset = 0;
-                    request->state = STATE_VERSION;
-                } else if (request->offset > sizeof(request->path) - 1) {
-                    // Skip methods that are too long.
-                } else {
-                    request->path[request->offset] = c;
-                    request->offset++;
-                }
-                break;
-            }
-            case STATE_VERSION: {
-                const char *supported_version = "HTTP/1.1\r";
-                error = supported_version[request->offset] != c;
-                request->offset++;
-                if (request->offset == strlen(supported_version)) {
-                    request->state = STATE_HEADER_KEY;
-                    request->offset = 0;
-                }
-                break;
-            }
-            case STATE_HEADER_KEY: {
-                if (c == '\r') {
-                    request->state = STATE_BODY;
-                } else if (c == '\n') {
-                    // Consume the \n
-                } else if (c == ':') {
-                    request->header_key[request->offset] = '\0';
-                    request->offset = 0;
-                    request->state = STATE_HEADER_VALUE;
-                } else if (request->offset > sizeof(request->header_key) - 1) {
-                    // Skip methods that are too long.
-                } else {
-                    request->header_key[request->offset] = c;
-                    request->offset++;
-                }
-                break;
-            }
-            case STATE_HEADER_VALUE: {
-                if (request->offset == 0) {
-                    error = c != ' ';
-                    request->offset++;
-                } else if (c == '\r') {
-                    request->header_value[request->offset - 1] = '\0';
-                    request->offset = 0;
-                    request->state = STATE_HEADER_KEY;
-                    if (strcasecmp(request->header_key, "Authorization") == 0) {
-                        const char *prefix = "Basic ";
-                        request->authenticated = strncmp(request->header_value, prefix, strlen(prefix)) == 0 &&
-                            strcmp(_api_password, request->header_value + strlen(prefix)) == 0;
-                    } else if (strcasecmp(request->header_key, "Host") == 0) {
-                        // Do a prefix check so that port is ignored. Length must be the same or the
-                        // header ends in :.
-                        const char *cp_local = "circuitpython.local";
-                        request->redirect = strncmp(request->header_value, cp_local, strlen(cp_local)) == 0 &&
-                            (strlen(request->header_value) == strlen(cp_local) ||
-                                request->header_value[strlen(cp_local)] == ':');
-                        strncpy(request->host, request->header_value, sizeof(request->host) - 1);
-                        request->host[sizeof(request->host) - 1] = '\0';
-                    } else if (strcasecmp(request->header_key, "Content-Length") == 0) {
-                        request->content_length = strtoul(request->header_value, NULL, 10);
-                    } else if (strcasecmp(request->header_key, "Expect") == 0) {
-                        request->expect = strcmp(request->header_value, "100-continue") == 0;
-                    } else if (strcasecmp(request->header_key, "Accept") == 0) {
-                        request->json = strcasecmp(request->header_value, "application/json") == 0;
-                    } else if (strcasecmp(request->header_key, "Origin") == 0) {
-                        strncpy(request->origin, request->header_value, sizeof(request->origin) - 1);
-                        request->origin[sizeof(request->origin) - 1] = '\0';
-                    } else if (strcasecmp(request->header_key, "X-Timestamp") == 0) {
-                        request->timestamp_ms = strtoull(request->header_value, NULL, 10);
-                    } else if (strcasecmp(request->header_key, "Upgrade") == 0) {
-                        request->websocket = strcmp(request->header_value, "websocket") == 0;
-                    } else if (strcasecmp(request->header_key, "Sec-WebSocket-Version") == 0) {
-                        request->websocket_version = strtoul(request->header_value, NULL, 10);
-                    } else if (strcasecmp(request->header_key, "Sec-WebSocket-Key") == 0 &&
-                               strlen(request->header_value) == 24) {
-                        strcpy(request->websocket_key, request->header_value);
-                    } else if (strcasecmp(request->header_key, "X-Destination") == 0) {
-                        strcpy(request->destination, request->header_value);
-                    }
-                } else if (request->offset > sizeof(request->header_value) - 1) {
-                    // Skip methods that are too long.
-                } else {
-                    request->header_value[request->offset - 1] = c;
-                    request->offset++;
-                }
-                break;
-            }
-            case STATE_BODY:
-                request->done = true;
-                more = false;
-                break;
+static void _process_request(socketpool_socket_obj_t *socket, web_workflow_request_t *request) {
+    bool was_in_progress = request->in_progress;
+    web_workflow_request_status_t status = web_workflow_request_parse(socket, request, _api_password);
+    if (!was_in_progress && request->in_progress) {
+        autoreload_suspend(AUTORELOAD_SUSPEND_WEB);
+    }
+    if (status == WEB_WORKFLOW_REQUEST_CLOSED) {
+        // Disconnect - clear 'in-progress'
+        if (request->in_progress) {
+            autoreload_resume(AUTORELOAD_SUSPEND_WEB);
         }
+        web_workflow_request_reset(request);
+        common_hal_socketpool_socket_close(socket);
+        return;
     }
-    if (error) {
+    if (status == WEB_WORKFLOW_REQUEST_INVALID) {
         const char *error_response = "HTTP/1.1 501 Not Implemented\r\n\r\n";
 
         int nodelay = 1;
         common_hal_socketpool_socket_setsockopt(socket, SOCKETPOOL_IPPROTO_TCP, SOCKETPOOL_TCP_NODELAY, &nodelay, sizeof(nodelay));
         socketpool_socket_send(socket, (const uint8_t *)error_response, strlen(error_response));
-        request->done = true;
-    }
-    if (!request->done) {
+    } else if (status != WEB_WORKFLOW_REQUEST_DONE) {
         return;
     }
     bool reload = _reply(socket, request);
-    _reset_request(request);
+    web_workflow_request_reset(request);
     common_hal_socketpool_socket_close(socket);
     autoreload_resume(AUTORELOAD_SUSPEND_WEB);
     if (reload) {
@@ -1606,7 +1421,7 @@ void supervisor_web_workflow_background(void *data) {
             }
             if (newsoc > 0) {
                 common_hal_socketpool_socket_settimeout(&active, 0);
-                _reset_request(&active_request);
+                web_workflow_request_reset(&active_request);
                 // Mark new sockets, otherwise we may accept another before the first
                 // could start its request.
                 active_request.new_socket = true;
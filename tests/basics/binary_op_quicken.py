@@ -0,0 +1,96 @@
+# test binary ops that run on different types from one execution to the next,
+# so that a VM which specialises them for the types it sees must switch back
+
+
+def add(a, b):
+    return a + b
+
+
+def iadd(a, b):
+    a += b
+    return a
+
+
+def sub(a, b):
+    return a - b
+
+
+def mul(a, b):
+    return a * b
+
+
+def div(a, b):
+    return a / b
+
+
+def idiv(a, b):
+    a /= b
+    return a
+
+
+def rshift(a, b):
+    return a >> b
+
+
+def cmp(a, b):
+    return a < b, a > b, a <= b, a >= b, a == b, a != b
+
+
+args = [
+    (1, 2),
+    (3, 4),
+    (1.5, 2),
+    (2, 0.25),
+    (1.5, 2.5),
+    (5, 6),
+    ("a", "b"),
+    (7, 8),
+    ([1], [2]),
+    (2**40, 3),
+    (3, 2**40),
+]
+for a, b in args:
+    print(add(a, b), iadd(a, b))
+for a, b in args:
+    try:
+        print(sub(a, b), mul(a, b))
+    except TypeError:
+        print("TypeError")
+for a, b in args:
+    print(cmp(a, b) if type(a) is type(b) or type(a) is not str else None)
+
+# results that overflow a small int
+big = 1 << 29
+for i in range(4):
+    print(add(big, big), sub(-big, big), mul(big, big), iadd(big, big))
+    big <<= 16
+
+# in-place ops on a list must still extend it
+lst = [0]
+for x in (1, 2, [3], 4, [5]):
+    lst = iadd(lst, x if isinstance(x, list) else [x])
+print(lst)
+n = 0
+for x in (1, 2, 3.5, 4):
+    n = iadd(n, x)
+print(n)
+
+# division, including by zero once specialised
+for a, b in ((1.0, 2.0), (3.0, 4), (1.0, 0.0), (1, 0), (5.0, 0), (7.0, 2)):
+    try:
+        print(div(a, b), idiv(a, b))
+    except ZeroDivisionError:
+        print("ZeroDivisionError")
+
+# shifts
+for a, b in ((256, 4), (-256, 4), (1, 100), (-1, 100), (5, -1), (256, 1)):
+    try:
+        print(rshift(a, b))
+    except ValueError:
+        print("ValueError")
+
+# a loop that runs the same op many times with a change of type part way
+x = 0
+for i in range(20):
+    x = x + (i if i < 10 else i * 0.5)
+print(x)
@@ -0,0 +1,179 @@
+# test that attribute lookups stay correct when the objects behind a
+# repeatedly executed LOAD_ATTR/LOAD_METHOD/STORE_ATTR change
+
+
+class A:
+    x = 1
+
+    def f(self):
+        return "A.f"
+
+
+class B:
+    def __init__(self):
+        self.x = 2
+
+    def f(self):
+        return "B.f"
+
+
+class C(A):
+    def f(self):
+        return "C.f"
+
+
+def get_x(o):
+    return o.x
+
+
+def call_f(o):
+    return o.f()
+
+
+# polymorphic sites
+objs = [A(), B(), C(), A(), B(), C()]
+print([get_x(o) for o in objs])
+print([call_f(o) for o in objs])
+
+# member deleted and added again
+b = B()
+for i in range(3):
+    print(get_x(b))
+    del b.x
+    print(get_x(b) if hasattr(b, "x") else None)
+    b.y = i
+    b.x = i * 10
+    print(get_x(b), b.y)
+
+# instance member shadowing a method
+a = A()
+print(call_f(a))
+a.f = lambda: "shadow"
+print(call_f(a))
+del a.f
+print(call_f(a))
+
+# class attribute modified
+a = A()
+for i in range(3):
+    A.x = i
+    print(get_x(a), get_x(A))
+A.f = lambda self: "new A.f"
+print(call_f(A()), call_f(C()))
+
+# many members so that later ones land at larger indices
+o = B()
+for i in range(20):
+    setattr(o, "m%d" % i, i)
+for i in range(3):
+    o.x = i
+    print(o.x, o.m19)
+
+
+# properties and stores through them
+class P:
+    def __init__(self):
+        self._v = 0
+
+    @property
+    def v(self):
+        return self._v
+
+    @v.setter
+    def v(self, value):
+        self._v = value * 2
+
+
+def set_v(o, value):
+    o.v = value
+
+
+p = P()
+for i in range(3):
+    set_v(p, i)
+    print(p.v)
+
+
+# __setattr__ and __getattr__ defined on the class
+class S:
+    def __getattr__(self, name):
+        return "getattr " + name
+
+    def __setattr__(self, name, value):
+        print("setattr", name, value)
+
+
+s = S()
+for i in range(2):
+    s.z = i
+    print(s.z)
+
+# native types at the same site
+def call_copy(o):
+    return o.copy()
+
+
+for o in ([1], {2: 3}, [4], {5}, {7: 8}):
+    print(call_copy(o))
+
+
+# a method hidden by a member of one instance but not others
+class H:
+    def f(self):
+        return "H.f"
+
+
+hs = [H(), H(), H()]
+for h in hs:
+    print(call_f(h))
+hs[1].f = lambda: "member f"
+for i in range(2):
+    print([call_f(h) for h in hs])
+object.__setattr__(hs[2], "f", lambda: "set f")
+print([call_f(h) for h in hs])
+del hs[1].f
+print([call_f(h) for h in hs])
+
+# a method replaced by a value that isn't a function
+H.f = staticmethod(lambda: "static f")
+print(call_f(H()))
+
+# classes made and freed while a site is hot
+for i in range(4):
+
+    class T:
+        def __init__(self, i):
+            self.x = i
+
+        def f(self):
+            return self.x
+
+    print(call_f(T(i)), get_x(T(i + 10)))
+    T = None
+    try:
+        import gc
+
+        gc.collect()
+    except ImportError:
+        pass
+
+
+# many sites in one function
+class M:
+    def __init__(self):
+        self.a = 1
+        self.b = 2
+        self.c = 3
+        self.d = 4
+        self.e = 5
+        self.f = 6
+
+
+def many(o):
+    return [o.a, o.b, o.c, o.d, o.e, o.f, o.a + o.b, o.c + o.d, o.e + o.f]
+
+
+m = M()
+for i in range(3):
+    m.a = i
+    print(many(m))
@@ -0,0 +1,83 @@
+import time
+
+import board
+import busdisplay
+import busio
+import displayio
+import fourwire
+import terminalio
+
+TFT_CS = board.D9
+TFT_DC = board.D10
+BAUDRATE = 62_500_000
+LINES = 100
+
+_INIT_SEQUENCE = (
+    b"\x01\x80\x80"  # Software reset then delay 0x80 (128ms)
+    b"\xef\x03\x03\x80\x02"
+    b"\xcf\x03\x00\xc1\x30"
+    b"\xed\x04\x64\x03\x12\x81"
+    b"\xe8\x03\x85\x00\x78"
+    b"\xcb\x05\x39\x2c\x00\x34\x02"
+    b"\xf7\x01\x20"
+    b"\xea\x02\x00\x00"
+    b"\xc0\x01\x23"  # Power control VRH[5:0]
+    b"\xc1\x01\x10"  # Power control SAP[2:0];BT[3:0]
+    b"\xc5\x02\x3e\x28"  # VCM control
+    b"\xc7\x01\x86"  # VCM control2
+    b"\x36\x01\x48"  # Memory Access Control, portrait so rows scroll
+    b"\x37\x01\x00"  # Vertical scroll zero
+    b"\x3a\x01\x55"  # COLMOD: Pixel Format Set
+    b"\xb1\x02\x00\x18"  # Frame Rate Control (In Normal Mode/Full Colors)
+    b"\xb6\x03\x08\x82\x27"  # Display Function Control
+    b"\xf2\x01\x00"  # 3Gamma Function Disable
+    b"\x26\x01\x01"  # Gamma curve selected
+    b"\x11\x80\x78"  # Exit Sleep then delay 0x78 (120ms)
+    b"\x29\x80\x78"  # Display on then delay 0x78 (120ms)
+)
+
+
+def run(scroll_ram_height):
+    displayio.release_displays()
+    spi = busio.SPI(board.SCK, board.MOSI)
+    bus = fourwire.FourWire(spi, command=TFT_DC, chip_select=TFT_CS, baudrate=BAUDRATE)
+    display = busdisplay.BusDisplay(
+        bus,
+        _INIT_SEQUENCE,
+        width=240,
+        height=320,
+        auto_refresh=False,
+        scroll_ram_height=scroll_ram_height,
+    )
+    font = terminalio.FONT
+    char_width, char_height = font.get_bounding_box()
+    grid = displayio.TileGrid(
+        font.bitmap,
+        pixel_shader=displayio.Palette(2),
+        tile_width=char_width,
+        tile_height=char_height,
+        width=240 // char_width,
+        height=320 // char_height,
+    )
+    grid.pixel_shader[1] = 0xFFFFFF
+    root = displayio.Group()
+    root.append(grid)
+    display.root_group = root
+    terminal = terminalio.Terminal(grid, font)
+    display.refresh()
+    pixels = 0
+    start = time.monotonic_ns()
+    for i in range(LINES):
+        terminal.write("line {} of the scroll test\r\n".format(i))
+        display.refresh()
+        pixels += display.refresh_stats[1]
+    elapsed = (time.monotonic_ns() - start) / 1e9
+    display.root_group = None
+    return LINES / elapsed, pixels // LINES
+
+
+print("scroll_ram_height lines/s pixels/line")
+for height in (0, 320):
+    rate, pixels = run(height)
+    print("{:17d} {:7.1f} {:11d}".format(height, rate, pixels))
+displayio.release_displays()
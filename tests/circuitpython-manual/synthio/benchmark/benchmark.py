@@ -0,0 +1,44 @@
+import sys
+import time
+import array
+import math
+import audiocore
+import synthio
+
+VOICES = int(sys.argv[1]) if len(sys.argv) > 1 else 12
+SECONDS = int(sys.argv[2]) if len(sys.argv) > 2 else 10
+SAMPLE_RATE = 48000
+
+sine = array.array("h", [int(math.sin(2 * math.pi * i / 1024) * 14700) for i in range(1024)])
+envelope = synthio.Envelope(attack_time=0, decay_time=0, release_time=0, sustain_level=0.8)
+
+
+def bench(name, channel_count=1, **kwargs):
+    synth = synthio.Synthesizer(
+        sample_rate=SAMPLE_RATE, channel_count=channel_count, envelope=envelope
+    )
+    notes = []
+    for i in range(VOICES):
+        args = {"frequency": 110 * 2 ** (i / 7), "waveform": sine, "panning": (i % 3 - 1) / 2}
+        args.update(kwargs)
+        if "filter" in args:
+            args["filter"] = synth.low_pass_filter(args["filter"])
+        notes.append(synthio.Note(**args))
+    synth.press(notes)
+
+    frames = 0
+    t0 = time.time()
+    while frames < SECONDS * SAMPLE_RATE:
+        frames += len(audiocore.get_buffer(synth)[1]) // channel_count
+    t = time.time() - t0
+    print(
+        "%-12s %10d samples/s %6.1fx realtime" % (name, frames * VOICES / t, SECONDS / t)
+    )
+
+
+print("%d voices, %d seconds at %dHz" % (VOICES, SECONDS, SAMPLE_RATE))
+bench("oscillator")
+bench("stereo", channel_count=2)
+bench("ring", ring_frequency=330, ring_waveform=sine)
+bench("filter", filter=2000)
+bench("ring+filter", ring_frequency=330, ring_waveform=sine, filter=2000)
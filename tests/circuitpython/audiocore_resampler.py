@@ -0,0 +1,72 @@
+import array
+import math
+
+try:
+    import audiocore
+    import audiomixer
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+
+def pull(sample):
+    out = []
+    while True:
+        result, data = audiocore.get_buffer(sample)
+        out.extend(data)
+        if result == 0:
+            return out
+
+
+ramp = audiocore.RawSample(array.array("h", [i * 1000 for i in range(8)]), sample_rate=8000)
+
+# linear interpolation up and down
+r = audiocore.Resampler(ramp, sample_rate=16000, linear=True, buffer_size=8)
+print(r.sample_rate, audiocore.get_structure(r))
+print(pull(r))
+print(pull(audiocore.Resampler(ramp, sample_rate=4000, linear=True)))
+
+# playing it again starts over
+audiocore.reset_buffer(r)
+print(pull(r))
+
+# the windowed-sinc kernel passes a constant through once it has settled
+dc = audiocore.RawSample(array.array("h", [10000] * 64), sample_rate=8000)
+out = pull(audiocore.Resampler(dc, sample_rate=11025))
+print(len(out), out[20:40:4])
+
+# stereo channels are kept apart
+stereo = audiocore.RawSample(
+    array.array("h", [1000, -1000] * 32), channel_count=2, sample_rate=8000
+)
+out = pull(audiocore.Resampler(stereo, sample_rate=16000))
+print(len(out), out[40:48])
+
+# both modes follow a sine wave, the sinc one more closely
+sine = audiocore.RawSample(
+    array.array("h", [int(10000 * math.sin(2 * math.pi * 500 * i / 8000)) for i in range(400)]),
+    sample_rate=8000,
+)
+for linear in (True, False):
+    out = pull(audiocore.Resampler(sine, sample_rate=44100, linear=linear))
+    err = 0
+    for j in range(100, len(out) - 100):
+        err = max(err, abs(out[j] - 10000 * math.sin(2 * math.pi * 500 * j / 44100)))
+    print(linear, len(out), err < (250 if linear else 100))
+
+# a mixer running at a different rate can play it, and loop it
+mixer = audiomixer.Mixer(
+    voice_count=1, sample_rate=16000, channel_count=1, bits_per_sample=16, buffer_size=32
+)
+mixer.voice[0].play(audiocore.Resampler(ramp, sample_rate=16000, linear=True), loop=True)
+for _ in range(3):
+    print(list(audiocore.get_buffer(mixer)[1]))
+
+try:
+    audiocore.Resampler(ramp, sample_rate=0)
+except ValueError as e:
+    print(e)
+try:
+    audiocore.Resampler(1, sample_rate=8000)
+except TypeError as e:
+    print(type(e).__name__)
@@ -0,0 +1,80 @@
+# Test WaveFile's background read ahead against a slow block device.
+try:
+    import os, struct, time
+    import audiocore
+
+    os.VfsFat
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+
+class SlowRAMFS:
+    SEC_SIZE = 512
+
+    def __init__(self, blocks):
+        self.data = bytearray(blocks * self.SEC_SIZE)
+        self.delay = 0
+        self.reads = 0
+
+    # Don't do any allocations in the below functions because they may be called
+    # during a gc_sweep from a finalizer.
+    def readblocks(self, n, buf):
+        self.reads += 1
+        time.sleep_ms(self.delay)
+        for i in range(len(buf)):
+            buf[i] = self.data[n * self.SEC_SIZE + i]
+        return 0
+
+    def writeblocks(self, n, buf):
+        for i in range(len(buf)):
+            self.data[n * self.SEC_SIZE + i] = buf[i]
+        return 0
+
+    def ioctl(self, op, arg):
+        if op == 4:  # MP_BLOCKDEV_IOCTL_BLOCK_COUNT
+            return len(self.data) // self.SEC_SIZE
+        if op == 5:  # MP_BLOCKDEV_IOCTL_BLOCK_SIZE
+            return self.SEC_SIZE
+
+
+bdev = SlowRAMFS(64)
+os.VfsFat.mkfs(bdev)
+os.umount("/")
+os.mount(os.VfsFat(bdev), "/")
+
+samples = [(i * 37) % 65536 - 32768 for i in range(3000)]
+data = struct.pack("<%dh" % len(samples), *samples)
+with open("test.wav", "wb") as f:
+    f.write(b"RIFF" + struct.pack("<I", 36 + len(data)) + b"WAVE")
+    f.write(b"fmt " + struct.pack("<IHHIIHH", 16, 1, 1, 8000, 16000, 2, 16))
+    f.write(b"data" + struct.pack("<I", len(data)))
+    f.write(data)
+
+
+def pull(sample):
+    out = []
+    while True:
+        result, buf = audiocore.get_buffer(sample)
+        out.extend(buf)
+        if result != 1:
+            return result, out
+
+
+for read_ahead in (0, 100, 512, 4096):
+    w = audiocore.WaveFile("test.wav", read_ahead=read_ahead)
+    bdev.delay = 2
+    bdev.reads = 0
+    audiocore.reset_buffer(w)
+    result, out = pull(w)
+    bdev.delay = 0
+    print(read_ahead, result, out == samples, bdev.reads, w.underruns, w.max_read_ms >= 2)
+    # and again from the start
+    audiocore.reset_buffer(w)
+    print(pull(w)[1] == samples)
+    w.deinit()
+
+try:
+    audiocore.WaveFile("test.wav", read_ahead=-1)
+except ValueError:
+    print("ValueError")
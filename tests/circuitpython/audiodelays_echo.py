@@ -0,0 +1,45 @@
+import array
+
+try:
+    import audiocore
+    import audiodelays
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+
+def show(sample, count=4):
+    for _ in range(count):
+        result, data = audiocore.get_buffer(sample)
+        print(result, list(data))
+
+
+click = audiocore.RawSample(array.array("h", [16000, -16000] + [0] * 6), sample_rate=8000)
+
+# 2ms of delay is 16 samples, two buffers
+echo = audiodelays.Echo(
+    max_delay_ms=4, delay_ms=2, decay=0.5, mix=0.5, sample_rate=8000, channel_count=1, buffer_size=16
+)
+echo.play(click)
+print(echo.playing)
+show(echo)
+print(echo.playing)
+
+# with no mix the sample is passed through
+echo.mix = 0.0
+echo.play(click)
+show(echo, 2)
+
+# 8 bit signed output
+echo8 = audiodelays.Echo(
+    max_delay_ms=4,
+    delay_ms=2,
+    decay=0.5,
+    mix=1.0,
+    sample_rate=8000,
+    channel_count=1,
+    bits_per_sample=8,
+    buffer_size=8,
+)
+echo8.play(audiocore.RawSample(array.array("b", [62, -63] + [0] * 6), sample_rate=8000))
+show(echo8)
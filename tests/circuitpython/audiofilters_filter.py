@@ -0,0 +1,65 @@
+import array
+
+try:
+    import audiocore
+    import audiofilters
+    import synthio
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+
+def show(sample, count=2):
+    for _ in range(count):
+        result, data = audiocore.get_buffer(sample)
+        print(result, list(data)[:16])
+
+
+square = audiocore.RawSample(array.array("h", [8000] * 4 + [-8000] * 4), sample_rate=8000)
+synth = synthio.Synthesizer(sample_rate=8000)
+
+f = audiofilters.Filter(sample_rate=8000, channel_count=1, buffer_size=32)
+print(f.playing)
+show(f, 1)
+
+# without a filter the sample passes through unchanged
+f.play(square, loop=True)
+print(f.playing)
+show(f)
+
+f.filter = synth.low_pass_filter(500)
+show(f)
+f.mix = 0.5
+show(f)
+f.stop()
+print(f.playing)
+show(f, 1)
+
+# unsigned 8 bit output
+f8 = audiofilters.Filter(
+    filter=synth.low_pass_filter(500),
+    sample_rate=8000,
+    channel_count=1,
+    bits_per_sample=8,
+    samples_signed=False,
+    buffer_size=16,
+)
+f8.play(audiocore.RawSample(array.array("B", [159] * 4 + [97] * 4), sample_rate=8000), loop=True)
+show(f8)
+
+# an effect playing another renders it in place, so a pass through after the filter above
+# changes nothing
+low = audiofilters.Filter(
+    filter=synth.low_pass_filter(500),
+    sample_rate=8000,
+    channel_count=1,
+    bits_per_sample=8,
+    samples_signed=False,
+    buffer_size=16,
+)
+through = audiofilters.Filter(
+    sample_rate=8000, channel_count=1, bits_per_sample=8, samples_signed=False, buffer_size=16
+)
+low.play(audiocore.RawSample(array.array("B", [159] * 4 + [97] * 4), sample_rate=8000), loop=True)
+through.play(low, loop=True)
+show(through)
@@ -0,0 +1,81 @@
+import array
+
+try:
+    import audiocore
+    import audiomixer
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+
+def show(sample, count=3):
+    for _ in range(count):
+        result, data = audiocore.get_buffer(sample)
+        print(result, list(data)[:12])
+
+
+ramp = audiocore.RawSample(
+    array.array("h", [i * 1000 - 8000 for i in range(17)]), sample_rate=8000
+)
+other = audiocore.RawSample(array.array("h", [3000, -3000] * 4), sample_rate=8000)
+
+mixer = audiomixer.Mixer(
+    voice_count=2, sample_rate=8000, channel_count=1, bits_per_sample=16, buffer_size=32
+)
+show(mixer, 1)
+mixer.voice[0].play(ramp)
+show(mixer)
+mixer.voice[0].play(ramp, loop=True)
+mixer.voice[1].play(other, loop=True)
+mixer.voice[1].level = 0.5
+show(mixer)
+print(mixer.playing)
+mixer.voice[0].stop()
+mixer.voice[1].stop()
+print(mixer.playing)
+
+# unsigned 8 bit output from an unsigned 8 bit sample
+ramp8 = audiocore.RawSample(array.array("B", [i * 8 for i in range(32)]), sample_rate=8000)
+mixer8 = audiomixer.Mixer(
+    voice_count=1,
+    sample_rate=8000,
+    channel_count=1,
+    bits_per_sample=8,
+    samples_signed=False,
+    buffer_size=32,
+)
+mixer8.voice[0].play(ramp8, loop=True)
+show(mixer8, 2)
+
+# 8 bit output is mixed in blocks, so check a buffer of several
+mixer8 = audiomixer.Mixer(
+    voice_count=1,
+    sample_rate=8000,
+    channel_count=1,
+    bits_per_sample=8,
+    samples_signed=False,
+    buffer_size=600,
+)
+mixer8.voice[0].play(ramp8, loop=True)
+result, data = audiocore.get_buffer(mixer8)
+print(len(data), list(data)[124:132], list(data)[252:260])
+
+# the sample must match the mixer's format
+try:
+    mixer.voice[0].play(ramp8)
+except ValueError as e:
+    print(e)
+try:
+    mixer.voice[0].play(audiocore.RawSample(array.array("H", [0] * 8), sample_rate=8000))
+except ValueError as e:
+    print(e)
+try:
+    mixer.voice[0].play(audiocore.RawSample(array.array("h", [0] * 8), sample_rate=16000))
+except ValueError as e:
+    print(e)
+try:
+    mixer.voice[0].play(
+        audiocore.RawSample(array.array("h", [0] * 8), channel_count=2, sample_rate=8000)
+    )
+except ValueError as e:
+    print(e)
@@ -0,0 +1,126 @@
+# test msgpack.Unpacker, fed a piece at a time and reading from a stream
+
+try:
+    import msgpack
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+from io import BytesIO
+
+objs = [
+    None,
+    True,
+    1,
+    -300,
+    2**30,
+    "abc",
+    "x" * 40,
+    b"bytes",
+    [1, [2, 3], {"a": 4}],
+    {"k": (5, 6)},
+    list(range(20)),
+]
+b = BytesIO()
+for o in objs:
+    msgpack.pack(o, b)
+data = b.getvalue()
+
+
+def show(unpacker):
+    print([o for o in unpacker])
+
+
+# all at once
+u = msgpack.Unpacker()
+u.feed(data)
+show(u)
+
+# one byte at a time
+u = msgpack.Unpacker(use_list=False)
+out = []
+for i in range(len(data)):
+    u.feed(data[i : i + 1])
+    out.extend(u)
+print(out)
+print(list(u))
+
+# pieces of different sizes
+for n in (2, 3, 7, 50):
+    u = msgpack.Unpacker()
+    out = []
+    for i in range(0, len(data), n):
+        u.feed(memoryview(data)[i : i + n])
+        for o in u:
+            out.append(o)
+    print(n, len(out), out[-3:])
+
+# from a stream, with a small read size
+show(msgpack.Unpacker(BytesIO(data), read_size=5))
+show(msgpack.Unpacker(BytesIO(b"")))
+u = msgpack.Unpacker(BytesIO(data[:-1]))
+print(len(list(u)))
+
+try:
+    u.feed(b"\xc0")
+except RuntimeError:
+    print("RuntimeError")
+
+# bin as memoryview
+b = BytesIO()
+for i in range(10):
+    msgpack.pack(bytes([i]) * (i + 1), b)
+data = b.getvalue()
+u = msgpack.Unpacker(bin_memoryview=True, read_size=4)
+views = []
+for i in range(0, len(data), 3):
+    u.feed(data[i : i + 3])
+    views.extend(u)
+u.feed(b"\xc4\x03abc")
+views.extend(u)
+print([type(v).__name__ for v in views[:2]])
+print([bytes(v) for v in views])
+try:
+    views[0][0] = 1
+except TypeError:
+    print("TypeError")
+
+# a truncated bin is waited for without allocating anything for it
+import micropython
+
+u = msgpack.Unpacker(bin_memoryview=True)
+u.feed(b"\xc6\x00\x01\x00\x00" + b"x" * 10)
+micropython.heap_lock()
+for o in u:
+    pass
+micropython.heap_unlock()
+u.feed(b"x" * (0x10000 - 10))
+print([len(v) for v in u])
+
+
+# ext_hook, including one that feeds the unpacker
+def hook(code, data):
+    u.feed(b"\x01")
+    return (code, data)
+
+
+b = BytesIO()
+msgpack.pack(msgpack.ExtType(1, b"ext"), b)
+msgpack.pack(msgpack.ExtType(2, b"data" * 10), b)
+data = b.getvalue()
+u = msgpack.Unpacker(ext_hook=hook, bin_memoryview=True)
+u.feed(data)
+print(list(u))
+
+# invalid data
+u = msgpack.Unpacker()
+u.feed(b"\xc1")
+try:
+    next(u)
+except ValueError:
+    print("ValueError")
+
+try:
+    msgpack.Unpacker(read_size=0)
+except ValueError:
+    print("ValueError")
@@ -0,0 +1,76 @@
+# Blocks read by a Synthesizer's notes and blocks list are ticked in a precompiled
+# order; check that the order follows edits to what reads what.
+try:
+    import audiocore
+    import synthio
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+synth = synthio.Synthesizer(sample_rate=48000)
+
+
+def render(n=4):
+    for _ in range(n):
+        audiocore.get_buffer(synth)
+
+
+def phases(*lfos):
+    return " ".join("%.4f" % l.phase for l in lfos)
+
+
+a = synthio.LFO(rate=1)
+b = synthio.LFO(rate=2)
+c = synthio.LFO(rate=4)
+mix = synthio.Math(synthio.MathOperation.SUM, a, b, 0)
+note = synthio.Note(440, bend=mix)
+synth.press(note)
+render()
+print("a, b read by the note", phases(a, b, c))
+
+mix.b = 0
+render()
+print("b no longer read", phases(a, b, c))
+
+note.amplitude = c
+render()
+print("c read too", phases(a, b, c))
+
+mix.operation = synthio.MathOperation.ABS
+mix.b = b
+render()
+print("ABS reads only a", phases(a, b, c))
+
+synth.blocks.append(b)
+render()
+print("b free-running", phases(a, b, c))
+
+synth.blocks[0] = c
+note.amplitude = 1
+render()
+print("c free-running instead", phases(a, b, c))
+
+synth.blocks.clear()
+synth.release(note)
+render(20)
+print("note released", phases(a, b, c))
+render()
+print("nothing read", phases(a, b, c))
+
+# blocks that read each other still tick once per buffer
+m1 = synthio.Math(synthio.MathOperation.SUM, 0, 0.25, 0)
+m2 = synthio.Math(synthio.MathOperation.SUM, m1, a, 0)
+m1.a = m2
+note = synthio.Note(440, bend=m1, panning=m2)
+synth.press(note)
+render()
+print("loop", phases(a, b, c), "%.4f %.4f" % (m1.value, m2.value))
+
+# more blocks than fit in the compiled program
+lfos = [synthio.LFO(rate=1) for _ in range(60)]
+chain = lfos[0]
+for l in lfos[1:]:
+    chain = synthio.Math(synthio.MathOperation.SUM, chain, l, 0)
+note.bend = chain
+render()
+print("long chain", len(set(l.phase for l in lfos)), phases(lfos[0], lfos[-1]))
@@ -0,0 +1,161 @@
+# Test MidiFile's merging of tracks, tempo changes and note timing.
+try:
+    import os, struct
+    import synthio
+    import audiocore
+
+    os.VfsFat
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+
+class RAMFS:
+    SEC_SIZE = 512
+
+    def __init__(self, blocks):
+        self.data = bytearray(blocks * self.SEC_SIZE)
+
+    def readblocks(self, n, buf):
+        for i in range(len(buf)):
+            buf[i] = self.data[n * self.SEC_SIZE + i]
+        return 0
+
+    def writeblocks(self, n, buf):
+        for i in range(len(buf)):
+            self.data[n * self.SEC_SIZE + i] = buf[i]
+        return 0
+
+    def ioctl(self, op, arg):
+        if op == 4:  # MP_BLOCKDEV_IOCTL_BLOCK_COUNT
+            return len(self.data) // self.SEC_SIZE
+        if op == 5:  # MP_BLOCKDEV_IOCTL_BLOCK_SIZE
+            return self.SEC_SIZE
+
+
+bdev = RAMFS(64)
+os.VfsFat.mkfs(bdev)
+os.umount("/")
+os.mount(os.VfsFat(bdev), "/")
+
+
+def varlen(n):
+    result = bytes([n & 0x7F])
+    n >>= 7
+    while n:
+        result = bytes([0x80 | (n & 0x7F)]) + result
+        n >>= 7
+    return result
+
+
+def track(*events):
+    data = b"".join(varlen(delta) + event for delta, event in events)
+    return b"MTrk" + struct.pack(">I", len(data)) + data
+
+
+def write_midi(name, tracks, fmt=1, division=4, extra=b""):
+    with open(name, "wb") as f:
+        f.write(b"MThd" + struct.pack(">IHHH", 6, fmt, len(tracks), division))
+        f.write(extra)
+        for t in tracks:
+            f.write(t)
+
+
+END = b"\xff\x2f\x00"
+
+
+def sounding(sample):
+    # The ranges of samples where the output isn't silent
+    ranges = []
+    start = None
+    n = 0
+    while True:
+        result, buf = audiocore.get_buffer(sample)
+        for v in buf:
+            if v and start is None:
+                start = n
+            elif not v and start is not None:
+                ranges.append((start, n))
+                start = None
+            n += 1
+        if result != 1:
+            break
+    if start is not None:
+        ranges.append((start, n))
+    return result, ranges, n
+
+
+# At 4 ticks per quarter note and the default 120 beats per minute, a tick is 1000 samples at
+# 8 kHz. The tempo doubles at tick 8, so later ticks are 500 samples.
+write_midi(
+    "song.mid",
+    [
+        track((8, b"\xff\x51\x03" + struct.pack(">I", 250000)[1:]), (0, END)),
+        # running status, and a Note On with no velocity to stop the note
+        track(
+            (0, b"\x90\x3c\x40"),
+            (1, b"\x3c\x00"),
+            (9, b"\xf0\x03\x01\x02\xf7"),
+            (0, b"\x90\x40\x40"),
+            (1, b"\x80\x40\x00"),
+            (0, END),
+        ),
+        track(
+            (2, b"\xff\x01\x04text"),
+            (0, b"\xb0\x07\x64"),
+            (0, b"\x90\x43\x40"),
+            (1, b"\xc0\x05"),
+            (0, b"\x80\x43\x00"),
+            (9, b"\x90\x48\x40"),
+            (1, b"\x48\x00"),
+        ),
+    ],
+)
+# An unknown chunk between the tracks is skipped
+with open("song.mid", "rb") as f:
+    data = f.read()
+with open("song2.mid", "wb") as f:
+    offset = 14 + 8 + struct.unpack(">I", data[18:22])[0]
+    f.write(data[:offset] + b"XTRA\0\0\0\2hi" + data[offset:])
+
+for name in ("song.mid", "song2.mid"):
+    m = synthio.MidiFile(name, sample_rate=8000)
+    print(m.track_count, m.sample_rate, m.error_location)
+    print(sounding(m))
+    # and again from the start
+    audiocore.reset_buffer(m)
+    print(sounding(m))
+    m.deinit()
+
+with open("song.mid", "rb") as f:
+    m = synthio.from_file(f, sample_rate=8000)
+    print(type(m).__name__, sounding(m)[1])
+
+# A single track file still gives a MidiTrack
+write_midi("single.mid", [track((0, b"\x90\x3c\x40"), (4, b"\x80\x3c\x00"))], fmt=0)
+with open("single.mid", "rb") as f:
+    print(type(synthio.from_file(f, sample_rate=8000)).__name__)
+print(synthio.MidiFile("single.mid", sample_rate=8000).track_count)
+
+# SMPTE timing: 25 frames per second of 4 ticks, so a tick is 80 samples
+write_midi(
+    "smpte.mid", [track((1, b"\x90\x3c\x40"), (2, b"\x80\x3c\x00"))], division=0xE704
+)
+print(sounding(synthio.MidiFile("smpte.mid", sample_rate=8000))[1])
+
+# A track that's cut short ends at the error; the others play on
+write_midi("bad.mid", [track((0, b"\x90\x3c\x40"), (1, b"\x90\x3c")), track((2, b"\x90\x40\x40"), (1, b"\x80\x40\x00"))])
+m = synthio.MidiFile("bad.mid", sample_rate=8000)
+print(sounding(m)[1], m.error_location)
+
+for fmt, tracks in ((2, [track((0, END))]), (1, [])):
+    write_midi("bad.mid", tracks, fmt=fmt)
+    try:
+        synthio.MidiFile("bad.mid")
+    except ValueError as e:
+        print("ValueError", e)
+
+try:
+    synthio.MidiFile(bytearray(10))
+except TypeError as e:
+    print("TypeError", e)
@@ -0,0 +1,17 @@
+import bench
+
+
+def test(num):
+    # Leave the heap littered with small holes between long-lived objects.
+    keep = []
+    for i in range(8000):
+        keep.append(i + 0.5)
+        x = (i, i, i, i)
+        y = i + 0.25
+    i = 0
+    while i < num // 20:
+        x = (i, i, i, i)
+        i += 1
+
+
+bench.run(test)
@@ -0,0 +1,27 @@
+import bench
+import io
+import msgpack
+
+
+# a stream where, like a UART or socket, each read has a cost of its own
+class Stream(io.IOBase):
+    def __init__(self, data):
+        self.data = io.BytesIO(data)
+
+    def readinto(self, buf):
+        return self.data.readinto(buf)
+
+
+data = io.BytesIO()
+for i in range(50):
+    msgpack.pack([i, "sensor", b"\x55" * 32, {"t": i * 3}], data)
+data = data.getvalue()
+
+
+def test(num):
+    for i in range(num // 20000):
+        for o in msgpack.Unpacker(Stream(data)):
+            pass
+
+
+bench.run(test)
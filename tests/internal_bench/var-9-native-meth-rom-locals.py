@@ -0,0 +1,16 @@
+import bench
+
+
+def test(num):
+    # str, bytes and bytearray share one ROM locals table at different
+    # offsets, so each lookup here misses the caches and searches the
+    # table for a method near its end
+    objs = ("", b"", bytearray())
+    i = 0
+    while i < num:
+        for o in objs:
+            o.isupper
+        i += 3
+
+
+bench.run(test)
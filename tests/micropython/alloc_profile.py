@@ -0,0 +1,45 @@
+# Test micropython.alloc_profile, which records allocations per source line.
+
+import micropython
+
+try:
+    micropython.alloc_profile
+except AttributeError:
+    print("SKIP")
+    raise SystemExit
+
+
+def pairs(n):
+    out = [None] * n
+    for i in range(n):
+        out[i] = (i, i)
+    return out
+
+
+def nested(n):
+    return [pairs(n) for _ in range(3)]
+
+
+# nothing is recorded until the profile is started
+print(micropython.alloc_profile())
+
+micropython.alloc_profile(True)
+pairs(10)
+nested(4)
+micropython.alloc_profile(False)
+
+# stopping keeps what was recorded; print it without the sizes, which depend
+# on the heap's block size
+profile = micropython.alloc_profile()
+print(len(set(source_file for source_file, _, _, _ in profile)))
+for source_file, line, count, nbytes in profile:
+    print(line, count, nbytes > 0)
+
+# allocations aren't recorded once the profile is stopped
+pairs(10)
+print(micropython.alloc_profile() == profile)
+
+# starting the profile again clears it
+micropython.alloc_profile(True)
+micropython.alloc_profile(False)
+print(micropython.alloc_profile())
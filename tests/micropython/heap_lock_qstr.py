@@ -0,0 +1,25 @@
+# check that interning works after the qstr index couldn't be grown with the heap locked
+
+import micropython
+
+# Short names so that many are interned with the heap locked before the qstr data runs out,
+# growing the index at some point on the way.
+names = ["hq%d" % i for i in range(1000)]
+at = 0
+failed = 0
+while at < len(names):
+    micropython.heap_lock()
+    try:
+        while at < len(names):
+            hasattr(1, names[at])
+            at += 1
+    except MemoryError:
+        failed += 1
+    micropython.heap_unlock()
+    # Interning now grows the index again.
+    hasattr(1, "hq_after_%d" % failed)
+print(failed > 10)
+
+# All the names can still be found.
+print(all(not hasattr(1, name) for name in names))
+print(hasattr(int, "from_bytes"))
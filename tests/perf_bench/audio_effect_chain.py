@@ -0,0 +1,66 @@
+# Pull audio through a 4 stage effect chain, the way an audio output would.
+# The score is seconds of audio rendered per second of CPU.
+
+try:
+    import array
+    import audiocore
+    import audiodelays
+    import audiofilters
+    import audiomixer
+    import synthio
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+SAMPLE_RATE = 22050
+
+
+def build_chain(buffer_size):
+    # one cycle of a 441Hz triangle wave
+    period = SAMPLE_RATE // 441
+    wave = array.array("h", [0] * period)
+    for i in range(period):
+        wave[i] = (abs(2 * i - period) * 2 - period) * 16000 // period
+    source = audiocore.RawSample(wave, sample_rate=SAMPLE_RATE)
+    synth = synthio.Synthesizer(sample_rate=SAMPLE_RATE)
+
+    settings = {"buffer_size": buffer_size, "sample_rate": SAMPLE_RATE, "channel_count": 1}
+    low = audiofilters.Filter(filter=synth.low_pass_filter(2000), mix=1.0, **settings)
+    echo = audiodelays.Echo(max_delay_ms=100, delay_ms=80, decay=0.5, mix=0.5, **settings)
+    high = audiofilters.Filter(filter=synth.high_pass_filter(100), mix=1.0, **settings)
+    mixer = audiomixer.Mixer(voice_count=1, **settings)
+
+    low.play(source, loop=True)
+    echo.play(low, loop=True)
+    high.play(echo, loop=True)
+    mixer.voice[0].play(high, loop=True)
+    return mixer
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (50, 25): (1, 256),
+    (100, 100): (2, 1024),
+    (1000, 1000): (10, 2048),
+    (5000, 1000): (50, 2048),
+}
+
+
+def bm_setup(params):
+    seconds, buffer_size = params
+    mixer = build_chain(buffer_size)
+    state = [0]
+
+    def run():
+        total = 0
+        while total < seconds * SAMPLE_RATE:
+            _, data = audiocore.get_buffer(mixer)
+            total += len(data)
+        state[0] = total
+
+    def result():
+        return seconds, state[0] >= seconds * SAMPLE_RATE
+
+    return run, result
@@ -0,0 +1,58 @@
+# Resample 22050Hz voices to 44100Hz through a Mixer, interpolating with the windowed-sinc kernel.
+# The score is seconds of audio per voice rendered per second of CPU.
+
+try:
+    import array
+    import audiocore
+    import audiomixer
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+SOURCE_RATE = 22050
+SAMPLE_RATE = 44100
+
+
+def build_mixer(voices, buffer_size):
+    # one cycle of a 441Hz triangle wave
+    period = SOURCE_RATE // 441
+    wave = array.array("h", [0] * period)
+    for i in range(period):
+        wave[i] = (abs(2 * i - period) * 2 - period) * 16000 // period
+    mixer = audiomixer.Mixer(
+        voice_count=voices, sample_rate=SAMPLE_RATE, channel_count=1, buffer_size=buffer_size
+    )
+    for v in range(voices):
+        source = audiocore.RawSample(wave, sample_rate=SOURCE_RATE)
+        resampler = audiocore.Resampler(source, sample_rate=SAMPLE_RATE, linear=False)
+        mixer.voice[v].play(resampler, loop=True)
+    return mixer
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (50, 25): (1, 1, 256),
+    (100, 100): (1, 2, 1024),
+    (1000, 1000): (4, 4, 2048),
+    (5000, 1000): (4, 20, 2048),
+}
+
+
+def bm_setup(params):
+    voices, seconds, buffer_size = params
+    mixer = build_mixer(voices, buffer_size)
+    state = [0]
+
+    def run():
+        total = 0
+        while total < seconds * SAMPLE_RATE:
+            _, data = audiocore.get_buffer(mixer)
+            total += len(data)
+        state[0] = total
+
+    def result():
+        return voices * seconds, state[0] >= seconds * SAMPLE_RATE
+
+    return run, result
@@ -0,0 +1,33 @@
+# This tests qstr_find_strn() speed when many qstrs have been interned at runtime.
+# The number of lookups is the same for every parameter set, so with the qstr
+# hash index the run time should stay flat as the number of interned qstrs grows.
+
+
+class A:
+    pass
+
+
+def test(names, nloop):
+    n = len(names)
+    a = A()
+    for i in range(nloop):
+        getattr(a, names[i % n], None)
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (32, 10): (100, 4000),
+    (1000, 10): (1000, 4000),
+    (5000, 10): (4000, 4000),
+}
+
+
+def bm_setup(params):
+    nqstr, nloop = params
+    # getattr interns the attribute name, so this adds nqstr qstrs to the pools.
+    names = ["attr_%d_%d" % (nqstr, i) for i in range(nqstr)]
+    for name in names:
+        getattr(A, name, None)
+    return lambda: test(names, nloop), lambda: (nloop // 100, None)
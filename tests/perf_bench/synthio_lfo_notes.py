@@ -0,0 +1,57 @@
+# Render a chord of notes that are each modulated by a few LFOs and Math
+# blocks, some shared between the notes. The score is seconds of audio
+# rendered per second of CPU.
+
+try:
+    import audiocore
+    import synthio
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+SAMPLE_RATE = 22050
+
+
+def build_synth(voices):
+    synth = synthio.Synthesizer(sample_rate=SAMPLE_RATE)
+    vibrato = synthio.LFO(rate=5, scale=0.1)
+    tremolo = synthio.LFO(rate=3, scale=0.2, offset=0.8)
+    synth.blocks.append(synthio.LFO(rate=0.5))
+    for i in range(voices):
+        sweep = synthio.LFO(rate=0.25 + i / 8, scale=0.5)
+        bend = synthio.Math(synthio.MathOperation.SUM, vibrato, sweep, 0)
+        pan = synthio.LFO(rate=1 + i / 4, phase_offset=i / voices)
+        note = synthio.Note(
+            frequency=110 * (i + 2), bend=bend, amplitude=tremolo, panning=pan
+        )
+        synth.press(note)
+    return synth
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (50, 25): (1, 4),
+    (100, 100): (1, 8),
+    (1000, 1000): (4, 12),
+    (5000, 1000): (20, 12),
+}
+
+
+def bm_setup(params):
+    seconds, voices = params
+    synth = build_synth(voices)
+    state = [0]
+
+    def run():
+        total = 0
+        while total < seconds * SAMPLE_RATE:
+            _, data = audiocore.get_buffer(synth)
+            total += len(data)
+        state[0] = total
+
+    def result():
+        return seconds, state[0] >= seconds * SAMPLE_RATE
+
+    return run, result
@@ -0,0 +1,120 @@
+# Play a long multi-track MIDI file streamed from a filesystem. The score is
+# MIDI events per second of CPU, and the result checks that the RAM used while
+# playing doesn't grow with the length of the song.
+
+try:
+    import gc, os, struct
+    import audiocore
+    import synthio
+
+    os.VfsFat
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+# Low enough that rendering the audio doesn't swamp the cost of the events
+SAMPLE_RATE = 2000
+DIVISION = 96
+
+
+class RAMFS:
+    SEC_SIZE = 512
+
+    def __init__(self, blocks):
+        self.data = bytearray(blocks * self.SEC_SIZE)
+
+    def readblocks(self, n, buf):
+        start = n * self.SEC_SIZE
+        buf[:] = memoryview(self.data)[start : start + len(buf)]
+        return 0
+
+    def writeblocks(self, n, buf):
+        start = n * self.SEC_SIZE
+        self.data[start : start + len(buf)] = buf
+        return 0
+
+    def ioctl(self, op, arg):
+        if op == 4:  # MP_BLOCKDEV_IOCTL_BLOCK_COUNT
+            return len(self.data) // self.SEC_SIZE
+        if op == 5:  # MP_BLOCKDEV_IOCTL_BLOCK_SIZE
+            return self.SEC_SIZE
+
+
+def varlen(n):
+    result = bytes([n & 0x7F])
+    n >>= 7
+    while n:
+        result = bytes([0x80 | (n & 0x7F)]) + result
+        n >>= 7
+    return result
+
+
+def write_song(name, seconds, tracks):
+    # A tempo track that speeds up and slows down every 8 beats, then tracks of
+    # sixteenth notes that each use running status. Returns the number of events.
+    beats = seconds * 2
+    events = 0
+    with open(name, "wb") as f:
+        f.write(b"MThd" + struct.pack(">IHHH", 6, 1, tracks + 1, DIVISION))
+        data = bytearray()
+        for i in range(beats // 8):
+            tempo = 500000 if i % 2 else 450000
+            data += varlen(0 if i == 0 else 8 * DIVISION)
+            data += b"\xff\x51\x03" + struct.pack(">I", tempo)[1:]
+            events += 1
+        data += b"\x00\xff\x2f\x00"
+        f.write(b"MTrk" + struct.pack(">I", len(data)) + data)
+        for t in range(tracks):
+            data = bytearray(b"\x00\x90")
+            for i in range(beats * 4):
+                note = 48 + 12 * t + (i * 7) % 12
+                data += bytes([note, 0x40]) + varlen(DIVISION // 4) + bytes([note, 0])
+                data += b"\x00"
+                events += 2
+            data += b"\xff\x2f\x00"
+            f.write(b"MTrk" + struct.pack(">I", len(data)) + data)
+    return events
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (50, 25): (5, 2),
+    (100, 100): (15, 2),
+    (1000, 1000): (600, 3),
+    (5000, 1000): (600, 3),
+}
+
+
+def bm_setup(params):
+    seconds, tracks = params
+    bdev = RAMFS(512)
+    os.VfsFat.mkfs(bdev)
+    os.umount("/")
+    os.mount(os.VfsFat(bdev), "/")
+    events = write_song("song.mid", seconds, tracks)
+
+    gc.collect()
+    free = gc.mem_free()
+    midi = synthio.MidiFile("song.mid", sample_rate=SAMPLE_RATE)
+    gc.collect()
+    footprint = free - gc.mem_free()
+    state = [0]
+
+    def run():
+        audiocore.reset_buffer(midi)
+        total = 0
+        while True:
+            result, data = audiocore.get_buffer(midi)
+            total += len(data)
+            if result != 1:
+                break
+        state[0] = total
+
+    def result():
+        # The song is 10 minutes at most, with a small tempo change.
+        played = state[0] / SAMPLE_RATE
+        return events, played > seconds * 0.9 and footprint < 8192
+
+    return run, result
@@ -186,6 +186,7 @@ special_tests = [
         "esp32/partition_ota.py",
         "circuitpython/traceback_test.py",  # CIRCUITPY-CHANGE
         "circuitpython/traceback_test_chained.py",  # CIRCUITPY-CHANGE
+        "stress/gc_incremental_pause.py",  # CIRCUITPY-CHANGE
     )
 ]
 
@@ -761,6 +762,9 @@ def run_tests(pyb, tests, args, result_dir, num_threads=1):
             "micropython/opt_level_lineno.py"
         )  # native doesn't have proper traceback info
         skip_tests.add("micropython/schedule.py")  # native code doesn't check pending events
+        skip_tests.add(
+            "micropython/alloc_profile.py"
+        )  # native code doesn't record which line is executing
         skip_tests.add("stress/bytecode_limit.py")  # bytecode specific test
 
     def run_one_test(test_file):
@@ -0,0 +1,35 @@
+# Report the longest single pause of an allocation loop that fills the heap
+# with garbage again and again, so that it triggers many automatic collections.
+# With incremental sweeping each of those pauses is a mark and a slice of the
+# sweep.  Timings vary from run to run so they're reported, not checked.
+
+import gc
+import time
+
+try:
+    gc.sweep_step
+    time.ticks_us
+except AttributeError:
+    print("SKIP")
+    raise SystemExit
+
+# Long-lived data, so that marking has something to do.  Kept narrow enough
+# not to overflow the GC mark stack, which would add a full heap scan to every
+# collection and hide the cost of the sweep.
+keep = [[i, str(i)] for i in range(40)]
+
+gc.collect()
+longest = 0
+for i in range(200000):
+    t0 = time.ticks_us()
+    x = [i, i]
+    longest = max(longest, time.ticks_diff(time.ticks_us(), t0))
+print("longest pause:", longest, "us")
+
+# The heap must still be consistent after all of that.
+gc.collect()
+print(len(keep), keep[12])
+x = [[i] for i in range(1000)]
+while gc.sweep_step():
+    pass
+print(gc.sweep_step(), sum(y[0] for y in x))
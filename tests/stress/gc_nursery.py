@@ -0,0 +1,48 @@
+# Test that nursery collections keep objects referenced only from older objects.
+
+import gc
+
+try:
+    gc.collections
+except AttributeError:
+    print("SKIP")
+    raise SystemExit
+
+
+class Holder:
+    pass
+
+
+# Long-lived objects, which end up outside the nursery.
+try:
+    old = [[i, str(i)] for i in range(4000)]
+except MemoryError:
+    print("SKIP")
+    raise SystemExit
+keep = []
+table = {}
+holder = Holder()
+gc.collect()
+
+
+# Churn through short-lived objects, storing a few of them in the old objects
+# above so that the only references to them come from outside the nursery.
+def churn(n):
+    for i in range(n):
+        x = i + 0.5
+        if i % 1000 == 0:
+            keep.append(x)
+            table[i] = (i, x)
+            holder.last = [x]
+
+
+nursery, full = gc.collections()
+churn(100000)
+nursery2, full2 = gc.collections()
+print("nursery collections:", nursery2 > nursery, "full collections:", full2 - full)
+
+gc.collect()
+print(len(keep), sum(keep), keep[-1])
+print(len(table), table[99000])
+print(holder.last)
+
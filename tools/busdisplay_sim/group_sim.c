@@ -0,0 +1,330 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+// Renders a Group of TileGrids on the host both ways displayio can: from the topmost layer that
+// covers an area up, writing rows of opaque pixels over the layers below, and top down, skipping
+// pixels already set in the mask. Every area of every rotation and color depth must come out the
+// same both ways. The layers are scaled, flipped, transposed, partly transparent, partly off
+// screen, with and without render caches, and dithered.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "py/gc.h"
+#include "py/objlist.h"
+#include "py/runtime.h"
+#include "shared-bindings/displayio/Bitmap.h"
+#include "shared-bindings/displayio/ColorConverter.h"
+#include "shared-bindings/displayio/OnDiskBitmap.h"
+#include "shared-bindings/displayio/Palette.h"
+#include "shared-bindings/displayio/TileGrid.h"
+#include "shared-module/displayio/display_core.h"
+#include "supervisor/shared/display.h"
+#include "supervisor/shared/tick.h"
+
+// The top down render is static.
+#include "shared-module/displayio/Group.c"
+
+// Small enough for the whole screen to be one area.
+#define WIDTH (96)
+#define HEIGHT (64)
+#define AREAS (200)
+
+const mp_obj_type_t displayio_bitmap_type;
+const mp_obj_type_t displayio_colorconverter_type;
+const mp_obj_type_t displayio_group_type;
+const mp_obj_type_t displayio_ondiskbitmap_type;
+const mp_obj_type_t displayio_palette_type;
+const mp_obj_type_t displayio_tilegrid_type;
+const mp_obj_type_t mp_type_list;
+const mp_obj_type_t mp_type_NoneType;
+const mp_obj_type_t mp_type_bool;
+const mp_obj_type_t mp_type_int;
+const mp_obj_type_t mp_type_str;
+
+displayio_buffer_transform_t null_transform = { .dx = 1, .dy = 1, .scale = 1 };
+
+static uint32_t seed = 1;
+
+static uint32_t next_random(void) {
+    seed = seed * 1103515245 + 12345;
+    return seed >> 16;
+}
+
+void *m_malloc(size_t num_bytes) {
+    void *ptr = calloc(1, num_bytes);
+    if (ptr == NULL) {
+        printf("couldn't allocate %zu bytes\n", num_bytes);
+        exit(1);
+    }
+    return ptr;
+}
+
+void *m_malloc_maybe(size_t num_bytes) {
+    return calloc(1, num_bytes);
+}
+
+void *m_malloc0(size_t num_bytes) {
+    return m_malloc(num_bytes);
+}
+
+void m_free(void *ptr, size_t num_bytes) {
+    free(ptr);
+}
+
+void gc_free(void *ptr) {
+    free(ptr);
+}
+
+bool gc_alloc_possible(void) {
+    return true;
+}
+
+bool gc_is_locked(void) {
+    return false;
+}
+
+void gc_collect_ptr(void *ptr) {
+}
+
+uint64_t supervisor_ticks_ms64(void) {
+    return 0;
+}
+
+void supervisor_start_terminal(uint16_t width_px, uint16_t height_px) {
+}
+
+NORETURN void mp_raise_ValueError(mp_rom_error_text_t msg) {
+    printf("ValueError\n");
+    exit(1);
+}
+
+NORETURN void mp_raise_RuntimeError(mp_rom_error_text_t msg) {
+    printf("RuntimeError\n");
+    exit(1);
+}
+
+NORETURN void mp_raise_NotImplementedError(mp_rom_error_text_t msg) {
+    printf("NotImplementedError\n");
+    exit(1);
+}
+
+NORETURN void mp_raise_ValueError_varg(mp_rom_error_text_t fmt, ...) {
+    printf("ValueError\n");
+    exit(1);
+}
+
+mp_obj_t mp_obj_cast_to_native_base(mp_obj_t self_in, mp_const_obj_t native_type) {
+    if (mp_obj_is_obj(self_in) && ((mp_obj_base_t *)MP_OBJ_TO_PTR(self_in))->type == native_type) {
+        return self_in;
+    }
+    return MP_OBJ_NULL;
+}
+
+// Only what a Group needs of a list.
+mp_obj_t mp_obj_new_list(size_t n, mp_obj_t *items) {
+    mp_obj_list_t *list = m_new_obj(mp_obj_list_t);
+    list->base.type = &mp_type_list;
+    list->alloc = 16;
+    list->len = 0;
+    list->items = m_new(mp_obj_t, list->alloc);
+    return MP_OBJ_FROM_PTR(list);
+}
+
+void mp_obj_list_insert(mp_obj_list_t *list, size_t i, mp_obj_t obj) {
+    if (list->len == list->alloc) {
+        printf("too many layers\n");
+        exit(1);
+    }
+    memmove(list->items + i + 1, list->items + i, (list->len - i) * sizeof(mp_obj_t));
+    list->items[i] = obj;
+    list->len++;
+}
+
+// Layers are only added.
+mp_obj_t mp_obj_list_pop(mp_obj_list_t *self, size_t index) {
+    printf("mp_obj_list_pop() not supported\n");
+    exit(1);
+}
+
+void mp_obj_list_store(mp_obj_t self_in, mp_obj_t index, mp_obj_t value) {
+    printf("mp_obj_list_store() not supported\n");
+    exit(1);
+}
+
+mp_obj_t mp_seq_index_obj(const mp_obj_t *items, size_t len, size_t n_args, const mp_obj_t *args) {
+    printf("mp_seq_index_obj() not supported\n");
+    exit(1);
+}
+
+uint32_t common_hal_displayio_ondiskbitmap_get_pixel(displayio_ondiskbitmap_t *bitmap, int16_t x, int16_t y) {
+    return 0;
+}
+
+static displayio_palette_t *new_palette(uint16_t count, bool transparent) {
+    displayio_palette_t *palette = m_new_obj(displayio_palette_t);
+    palette->base.type = &displayio_palette_type;
+    common_hal_displayio_palette_construct(palette, count, false);
+    for (uint16_t i = 0; i < count; i++) {
+        common_hal_displayio_palette_set_color(palette, i, next_random() << 8 ^ next_random());
+    }
+    if (transparent) {
+        common_hal_displayio_palette_make_transparent(palette, 0);
+    }
+    return palette;
+}
+
+// Mostly the given value with random pixels in between.
+static displayio_bitmap_t *new_bitmap(uint16_t width, uint16_t height, uint32_t bits, uint32_t fill) {
+    displayio_bitmap_t *bitmap = m_new_obj(displayio_bitmap_t);
+    bitmap->base.type = &displayio_bitmap_type;
+    common_hal_displayio_bitmap_construct(bitmap, width, height, bits);
+    for (uint16_t py = 0; py < height; py++) {
+        for (uint16_t px = 0; px < width; px++) {
+            uint32_t value = next_random() % 3 == 0 ? next_random() : fill;
+            common_hal_displayio_bitmap_set_pixel(bitmap, px, py, value & ((1u << bits) - 1));
+        }
+    }
+    return bitmap;
+}
+
+static displayio_tilegrid_t *new_tilegrid(displayio_group_t *group, displayio_bitmap_t *bitmap, mp_obj_t shader,
+    uint16_t width, uint16_t height, uint16_t tile_size, int16_t x, int16_t y, bool render_cache) {
+    displayio_tilegrid_t *tilegrid = m_new_obj(displayio_tilegrid_t);
+    tilegrid->base.type = &displayio_tilegrid_type;
+    uint16_t tiles_wide = bitmap->width / tile_size;
+    common_hal_displayio_tilegrid_construct(tilegrid, MP_OBJ_FROM_PTR(bitmap), tiles_wide, bitmap->height / tile_size,
+        shader, width, height, tile_size, tile_size, 0, 0, 0);
+    for (uint16_t ty = 0; ty < height; ty++) {
+        for (uint16_t tx = 0; tx < width; tx++) {
+            common_hal_displayio_tilegrid_set_tile(tilegrid, tx, ty, next_random() % (tiles_wide * (bitmap->height / tile_size)));
+        }
+    }
+    common_hal_displayio_tilegrid_set_x(tilegrid, x);
+    common_hal_displayio_tilegrid_set_y(tilegrid, y);
+    common_hal_displayio_tilegrid_set_render_cache(tilegrid, render_cache);
+    common_hal_displayio_group_insert(group, group->members->len, MP_OBJ_FROM_PTR(tilegrid));
+    return tilegrid;
+}
+
+static displayio_group_t *new_group(uint32_t scale, int16_t x, int16_t y) {
+    displayio_group_t *group = m_new_obj(displayio_group_t);
+    group->base.type = &displayio_group_type;
+    common_hal_displayio_group_construct(group, scale, x, y);
+    return group;
+}
+
+static displayio_group_t *build(void) {
+    displayio_group_t *root = new_group(1, 0, 0);
+    displayio_bitmap_t *tiles = new_bitmap(16, 16, 2, 1);
+    displayio_bitmap_t *sprite = new_bitmap(10, 10, 2, 0);
+
+    // An opaque background for the rest to be drawn over.
+    new_tilegrid(root, tiles, MP_OBJ_FROM_PTR(new_palette(4, false)), WIDTH / 8, HEIGHT / 8, 8, 0, 0, true);
+
+    displayio_palette_t *transparent = new_palette(4, true);
+    new_tilegrid(root, sprite, MP_OBJ_FROM_PTR(transparent), 3, 2, 5, 5, 7, true);
+    displayio_tilegrid_t *flipped = new_tilegrid(root, sprite, MP_OBJ_FROM_PTR(transparent), 4, 3, 5, 30, 3, false);
+    common_hal_displayio_tilegrid_set_flip_x(flipped, true);
+    displayio_tilegrid_t *turned = new_tilegrid(root, sprite, MP_OBJ_FROM_PTR(transparent), 2, 4, 5, 50, 20, true);
+    common_hal_displayio_tilegrid_set_transpose_xy(turned, true);
+    common_hal_displayio_tilegrid_set_flip_y(turned, true);
+    displayio_tilegrid_t *hidden = new_tilegrid(root, tiles, MP_OBJ_FROM_PTR(new_palette(4, false)), 4, 4, 8, 8, 8, true);
+    common_hal_displayio_tilegrid_set_hidden(hidden, true);
+
+    // Covers the rest of the screen, so for areas within it its layers draw from the bottom up.
+    displayio_group_t *page = new_group(2, 0, 16);
+    new_tilegrid(page, tiles, MP_OBJ_FROM_PTR(new_palette(4, false)), WIDTH / 16, HEIGHT / 16, 8, 0, 0, false);
+    new_tilegrid(page, sprite, MP_OBJ_FROM_PTR(transparent), 8, 4, 5, 2, 1, true);
+    displayio_tilegrid_t *page_flipped = new_tilegrid(page, sprite, MP_OBJ_FROM_PTR(transparent), 2, 1, 5, 7, 3, false);
+    common_hal_displayio_tilegrid_set_flip_x(page_flipped, true);
+    displayio_tilegrid_t *page_turned = new_tilegrid(page, sprite, MP_OBJ_FROM_PTR(transparent), 1, 2, 5, 30, 2, true);
+    common_hal_displayio_tilegrid_set_transpose_xy(page_turned, true);
+    common_hal_displayio_group_insert(root, 1, MP_OBJ_FROM_PTR(page));
+
+    // Opaque and scaled so rows repeat, partly off screen.
+    displayio_group_t *large = new_group(3, WIDTH - 26, HEIGHT - 24);
+    new_tilegrid(large, tiles, MP_OBJ_FROM_PTR(new_palette(4, false)), 2, 2, 8, 0, 0, true);
+    new_tilegrid(large, sprite, MP_OBJ_FROM_PTR(transparent), 1, 1, 10, 2, 2, false);
+    common_hal_displayio_group_insert(root, root->members->len, MP_OBJ_FROM_PTR(large));
+
+    // Dithered colors aren't cached.
+    displayio_colorconverter_t *converter = m_new_obj(displayio_colorconverter_t);
+    converter->base.type = &displayio_colorconverter_type;
+    common_hal_displayio_colorconverter_construct(converter, true, DISPLAYIO_COLORSPACE_RGB565);
+    new_tilegrid(root, new_bitmap(20, 20, 16, 0x1234), MP_OBJ_FROM_PTR(converter), 1, 1, 20, -4, HEIGHT - 14, true);
+    return root;
+}
+
+static void set_colorspace(displayio_display_core_t *core, uint8_t depth) {
+    memset(&core->colorspace, 0, sizeof(core->colorspace));
+    core->colorspace.depth = depth;
+    core->colorspace.grayscale = depth == 8;
+    core->colorspace.grayscale_bit = 8 - depth;
+    core->colorspace.bytes_per_cell = 1;
+}
+
+static void random_area(const displayio_area_t *screen, displayio_area_t *area) {
+    area->x1 = next_random() % screen->x2;
+    area->y1 = next_random() % screen->y2;
+    area->x2 = area->x1 + 1 + next_random() % (screen->x2 - area->x1);
+    area->y2 = area->y1 + 1 + next_random() % (screen->y2 - area->y1);
+    area->next = NULL;
+}
+
+static size_t buffer_words(const displayio_area_t *area, uint8_t depth) {
+    return (displayio_area_size(area) * depth + 31) / 32;
+}
+
+// Returns whether the area was rendered from the bottom up.
+static bool check_area(displayio_group_t *root, const _displayio_colorspace_t *colorspace, const displayio_area_t *area, const char *label) {
+    size_t words = buffer_words(area, colorspace->depth);
+    size_t mask_words = (displayio_area_size(area) + 31) / 32;
+    uint32_t *bottom_up = calloc(words, sizeof(uint32_t));
+    uint32_t *top_down = calloc(words, sizeof(uint32_t));
+    uint32_t *mask = calloc(mask_words, sizeof(uint32_t));
+
+    bool from_bottom = _group_fill_area(root, colorspace, area, mask, bottom_up, true);
+    memset(mask, 0, mask_words * sizeof(uint32_t));
+    _group_fill_area(root, colorspace, area, mask, top_down, false);
+    if (from_bottom && memcmp(bottom_up, top_down, words * sizeof(uint32_t)) != 0) {
+        printf("%s: area %d,%d %d,%d renders differently bottom up\n", label, area->x1, area->y1, area->x2, area->y2);
+        exit(1);
+    }
+    free(bottom_up);
+    free(top_down);
+    free(mask);
+    return from_bottom;
+}
+
+int main(void) {
+    displayio_group_t *root = build();
+    static const uint8_t depths[] = { 8, 16, 32 };
+    static const int rotations[] = { 0, 90, 180, 270 };
+    displayio_display_core_t core = { .width = WIDTH, .height = HEIGHT };
+
+    printf("  %ux%u, %zu layers\n", WIDTH, HEIGHT, root->members->len);
+    printf("  depth   rotation   areas drawn bottom up\n");
+    for (size_t d = 0; d < sizeof(depths) / sizeof(depths[0]); d++) {
+        set_colorspace(&core, depths[d]);
+        for (size_t r = 0; r < sizeof(rotations) / sizeof(rotations[0]); r++) {
+            char label[32];
+            snprintf(label, sizeof(label), "%u bit at %d", depths[d], rotations[r]);
+            displayio_display_core_set_rotation(&core, rotations[r]);
+            displayio_group_update_transform(root, &core.transform);
+
+            size_t drawn = check_area(root, &core.colorspace, &core.area, label);
+            for (int i = 0; i < AREAS; i++) {
+                displayio_area_t area;
+                random_area(&core.area, &area);
+                drawn += check_area(root, &core.colorspace, &area, label);
+            }
+            printf("  %5u   %8d   %10zu of %d\n", depths[d], rotations[r], drawn, AREAS + 1);
+        }
+    }
+    return 0;
+}
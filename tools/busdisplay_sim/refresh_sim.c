@@ -0,0 +1,359 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+// Refreshes a 320x240 16-bit display with BusDisplay's refresh code over a fake FourWire bus, for
+// each refresh buffer size with and without double_buffer. Time is simulated. Sending costs what
+// it would over SPI and rendering costs a fixed time per pixel, standing in for a Group. The fake
+// display keeps its memory the way an ILI9341 does and every frame is checked pixel by pixel.
+//
+// A bus that sends in the background, like SPI with DMA on RP2040, only reads a buffer when the
+// send ends so that a buffer rendered into too early shows up as wrong pixels. A blocking bus,
+// which is what most ports have, sends everything in start_send.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "py/gc.h"
+#include "py/runtime.h"
+#include "shared-bindings/busdisplay/BusDisplay.h"
+#include "shared-bindings/fourwire/FourWire.h"
+#include "shared-module/displayio/__init__.h"
+#include "supervisor/port_heap.h"
+#include "supervisor/usb.h"
+
+#define WIDTH (320)
+#define HEIGHT (240)
+#define FRAMES (10)
+
+// Estimated costs in nanoseconds. 24 MHz SPI takes 333 ns a byte. Each send costs a little more
+// to toggle the pins and start the transfer.
+#define SEND_NS (2000)
+#define BYTE_NS (333)
+#define RENDER_PIXEL_NS (500)
+
+#define CMD_CASET (0x2a)
+#define CMD_RASET (0x2b)
+#define CMD_RAMWR (0x2c)
+
+// 64 bytes is less than a row so the buffer is made bigger.
+static const size_t buffer_sizes[] = { 64, 512, 1024, 2048 };
+
+primary_display_t displays[CIRCUITPY_DISPLAY_LIMIT];
+displayio_group_t circuitpython_splash;
+const mp_obj_type_t fourwire_fourwire_type;
+const mp_obj_type_t digitalio_digitalinout_type;
+const mp_obj_type_t mp_type_NoneType;
+const mp_obj_type_t mp_type_bool;
+const mp_obj_type_t mp_type_int;
+const mp_obj_type_t mp_type_str;
+
+static fourwire_fourwire_obj_t bus = { .base = { &fourwire_fourwire_type } };
+static bool background_bus;
+
+static uint64_t clock_ns;
+static uint64_t bus_busy_until_ns;
+static size_t heap_used;
+static bool heap_full;
+
+// What the bus is still sending.
+static const uint8_t *pending_data;
+static uint32_t pending_length;
+static bool in_transaction;
+
+// The display's memory and where writes go.
+static uint16_t ram[HEIGHT][WIDTH];
+static uint8_t command;
+static uint8_t params[4];
+static uint32_t param_count;
+static uint16_t x1, x2, y1, y2, x, y;
+
+static uint32_t frame;
+static displayio_area_t screen = { .x1 = 0, .y1 = 0, .x2 = WIDTH, .y2 = HEIGHT };
+
+static uint16_t pattern(uint32_t f, uint16_t px, uint16_t py) {
+    return px * 7 + py * 13 + f * 31;
+}
+
+uint64_t common_hal_time_monotonic_ns(void) {
+    return clock_ns;
+}
+
+uint64_t supervisor_ticks_ms64(void) {
+    return clock_ns / 1000000;
+}
+
+void common_hal_time_delay_ms(uint32_t delay) {
+    clock_ns += delay * 1000000ULL;
+}
+
+// Each allocation starts with its size so it can be taken off when it's freed.
+void *port_malloc(size_t size, bool dma_capable) {
+    if (heap_full) {
+        return NULL;
+    }
+    size_t *ptr = malloc(sizeof(size_t) + size);
+    *ptr = size;
+    heap_used += size;
+    return ptr + 1;
+}
+
+void port_free(void *ptr) {
+    if (ptr == NULL) {
+        return;
+    }
+    size_t *start = (size_t *)ptr - 1;
+    heap_used -= *start;
+    free(start);
+}
+
+void gc_collect_ptr(void *ptr) {
+}
+
+NORETURN void m_malloc_fail(size_t num_bytes) {
+    printf("couldn't allocate %zu bytes\n", num_bytes);
+    exit(1);
+}
+
+NORETURN void mp_raise_ValueError(mp_rom_error_text_t msg) {
+    printf("ValueError\n");
+    exit(1);
+}
+
+NORETURN void mp_raise_RuntimeError(mp_rom_error_text_t msg) {
+    printf("RuntimeError\n");
+    exit(1);
+}
+
+bool common_hal_mcu_pin_is_free(const mcu_pin_obj_t *pin) {
+    return true;
+}
+
+void common_hal_never_reset_pin(const mcu_pin_obj_t *pin) {
+}
+
+digitalinout_result_t common_hal_digitalio_digitalinout_construct(digitalio_digitalinout_obj_t *self, const mcu_pin_obj_t *pin) {
+    return DIGITALINOUT_OK;
+}
+
+void common_hal_digitalio_digitalinout_deinit(digitalio_digitalinout_obj_t *self) {
+}
+
+void common_hal_digitalio_digitalinout_set_value(digitalio_digitalinout_obj_t *self, bool value) {
+}
+
+// Background work may use the bus, so the refresh must not hold it while this runs.
+void usb_background(void) {
+    if (in_transaction) {
+        printf("usb_background() called with the display bus in a transaction\n");
+        exit(1);
+    }
+}
+
+void supervisor_start_terminal(uint16_t width_px, uint16_t height_px) {
+}
+
+void supervisor_stop_terminal(void) {
+}
+
+void supervisor_enable_tick(void) {
+}
+
+void supervisor_disable_tick(void) {
+}
+
+// The root group draws a new pattern over the whole screen every frame.
+void displayio_group_update_transform(displayio_group_t *group, const displayio_buffer_transform_t *parent_transform) {
+}
+
+bool displayio_group_fill_area(displayio_group_t *group, const _displayio_colorspace_t *colorspace, const displayio_area_t *area, uint32_t *mask, uint32_t *buffer) {
+    uint16_t *pixels = (uint16_t *)buffer;
+    for (int16_t py = area->y1; py < area->y2; py++) {
+        for (int16_t px = area->x1; px < area->x2; px++) {
+            *pixels++ = pattern(frame, px, py);
+        }
+    }
+    clock_ns += displayio_area_size(area) * RENDER_PIXEL_NS;
+    return true;
+}
+
+displayio_area_t *displayio_group_get_refresh_areas(displayio_group_t *self, displayio_area_t *tail) {
+    screen.next = tail;
+    return &screen;
+}
+
+void displayio_group_finish_refresh(displayio_group_t *self) {
+}
+
+bool displayio_group_only_moved_by(displayio_group_t *self, int16_t dy) {
+    return false;
+}
+
+displayio_tilegrid_t *displayio_group_get_scrolled_tilegrid(displayio_group_t *self, displayio_area_t *area, int16_t *dy) {
+    return NULL;
+}
+
+void displayio_group_finish_scroll(displayio_group_t *self) {
+}
+
+void displayio_tilegrid_finish_scroll(displayio_tilegrid_t *self) {
+}
+
+static void receive(display_byte_type_t byte_type, const uint8_t *data, uint32_t length) {
+    if (byte_type == DISPLAY_COMMAND) {
+        command = data[0];
+        param_count = 0;
+        if (command == CMD_RAMWR) {
+            x = x1;
+            y = y1;
+        }
+        return;
+    }
+    for (uint32_t i = 0; i < length; i++) {
+        if (command == CMD_RAMWR) {
+            if (param_count % 2 == 1) {
+                if (y > y2) {
+                    printf("write past the end of the region\n");
+                    exit(1);
+                }
+                ram[y][x] = params[0] | (data[i] << 8);
+                if (x++ == x2) {
+                    x = x1;
+                    y++;
+                }
+            } else {
+                params[0] = data[i];
+            }
+            param_count++;
+        } else if (param_count < 4) {
+            params[param_count++] = data[i];
+            if (param_count == 4 && command == CMD_CASET) {
+                x1 = params[0] << 8 | params[1];
+                x2 = params[2] << 8 | params[3];
+            } else if (param_count == 4 && command == CMD_RASET) {
+                y1 = params[0] << 8 | params[1];
+                y2 = params[2] << 8 | params[3];
+            }
+        }
+    }
+}
+
+// Waits for the bus to finish sending. Only then is a background send read from its buffer.
+static void finish_send(void) {
+    if (clock_ns < bus_busy_until_ns) {
+        clock_ns = bus_busy_until_ns;
+    }
+    if (pending_data != NULL) {
+        receive(DISPLAY_DATA, pending_data, pending_length);
+        pending_data = NULL;
+    }
+}
+
+bool common_hal_fourwire_fourwire_reset(mp_obj_t obj) {
+    return true;
+}
+
+bool common_hal_fourwire_fourwire_bus_free(mp_obj_t obj) {
+    return !in_transaction;
+}
+
+bool common_hal_fourwire_fourwire_begin_transaction(mp_obj_t obj) {
+    if (in_transaction) {
+        return false;
+    }
+    in_transaction = true;
+    return true;
+}
+
+void common_hal_fourwire_fourwire_send(mp_obj_t obj, display_byte_type_t byte_type,
+    display_chip_select_behavior_t chip_select, const uint8_t *data, uint32_t data_length) {
+    finish_send();
+    receive(byte_type, data, data_length);
+    clock_ns += SEND_NS + data_length * BYTE_NS;
+}
+
+void common_hal_fourwire_fourwire_start_send(mp_obj_t obj, display_byte_type_t byte_type,
+    display_chip_select_behavior_t chip_select, const uint8_t *data, uint32_t data_length) {
+    if (!background_bus || byte_type != DISPLAY_DATA) {
+        common_hal_fourwire_fourwire_send(obj, byte_type, chip_select, data, data_length);
+        return;
+    }
+    finish_send();
+    clock_ns += SEND_NS;
+    bus_busy_until_ns = clock_ns + data_length * BYTE_NS;
+    pending_data = data;
+    pending_length = data_length;
+}
+
+void common_hal_fourwire_fourwire_end_transaction(mp_obj_t obj) {
+    finish_send();
+    in_transaction = false;
+}
+
+void common_hal_fourwire_fourwire_collect_ptrs(mp_obj_t obj) {
+}
+
+static void check(uint32_t f, const char *label) {
+    for (uint16_t py = 0; py < HEIGHT; py++) {
+        for (uint16_t px = 0; px < WIDTH; px++) {
+            if (ram[py][px] != pattern(f, px, py)) {
+                printf("%s: pixel %u,%u of frame %u is wrong\n", label, px, py, f);
+                exit(1);
+            }
+        }
+    }
+}
+
+// Returns frames per second.
+static double refresh(busdisplay_busdisplay_obj_t *display, const char *label) {
+    uint64_t start_ns = clock_ns;
+    for (uint32_t i = 0; i < FRAMES; i++) {
+        frame++;
+        common_hal_busdisplay_busdisplay_refresh(display, NO_FPS_LIMIT, 0);
+        check(frame, label);
+    }
+    return FRAMES / ((clock_ns - start_ns) / 1e9);
+}
+
+static double run(busdisplay_busdisplay_obj_t *display, uint16_t buffer_size, bool double_buffer, bool background, const char *label) {
+    common_hal_busdisplay_busdisplay_set_refresh_buffer(display, buffer_size, double_buffer);
+    background_bus = background;
+    return refresh(display, label);
+}
+
+static void construct(busdisplay_busdisplay_obj_t *display) {
+    common_hal_busdisplay_busdisplay_construct(display, MP_OBJ_FROM_PTR(&bus), WIDTH, HEIGHT, 0, 0, 0,
+        16, false, false, 1, false, false, CMD_CASET, CMD_RASET, CMD_RAMWR, NULL, 0, NULL,
+        NO_BRIGHTNESS_COMMAND, 1.0, false, false, false, 60, true, false, 0);
+}
+
+int main(void) {
+    busdisplay_busdisplay_obj_t *display = &displays[0].display;
+    construct(display);
+
+    printf("  %ux%u 16-bit, %u ns per byte sent, %u ns per pixel rendered\n", WIDTH, HEIGHT, BYTE_NS, RENDER_PIXEL_NS);
+    printf("  buffer   single buffer   double_buffer on a blocking bus   on a background bus\n");
+    for (size_t i = 0; i < sizeof(buffer_sizes) / sizeof(buffer_sizes[0]); i++) {
+        double single = run(display, buffer_sizes[i], false, true, "single buffer");
+        double blocking = run(display, buffer_sizes[i], true, false, "blocking bus");
+        double background = run(display, buffer_sizes[i], true, true, "background bus");
+        printf("  %6zu   %6.1f fps      %6.1f fps                        %6.1f fps, %zu bytes of port heap\n",
+            buffer_sizes[i], single, blocking, background, heap_used);
+    }
+
+    release_busdisplay(display);
+    if (heap_used != 0) {
+        printf("%zu bytes of port heap not freed\n", heap_used);
+        return 1;
+    }
+
+    // Without room for the buffers, a display is refreshed from a small buffer on the stack.
+    heap_full = true;
+    construct(display);
+    printf("  port heap full: %.1f fps\n", refresh(display, "port heap full"));
+    release_busdisplay(display);
+    return 0;
+}
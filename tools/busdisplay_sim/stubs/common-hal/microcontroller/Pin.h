@@ -0,0 +1,15 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "py/obj.h"
+
+// Only what the display code refers to.
+typedef struct {
+    mp_obj_base_t base;
+    uint8_t number;
+} mcu_pin_obj_t;
@@ -0,0 +1,238 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+// A NOR flash chip in RAM for running the external flash code on the host. Programming can only
+// clear bits and erasing sets a whole sector back to 0xff, as on the real chips, and both are
+// counted. Every workload checks that each block reads back what was last written to it.
+//
+// Time on the bus and in the chip is estimated from the commands issued, using typical figures for
+// a quad SPI part at 40 MHz, to compare the throughput of ways of driving it.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "supervisor/flash.h"
+#include "supervisor/spi_flash_api.h"
+#include "supervisor/shared/external_flash/common_commands.h"
+
+#define FLASH_SIZE (1 << 20)
+
+// Estimated costs in nanoseconds
+#define COMMAND_NS (1000) // instruction, address and dummy cycles, and chip select
+#define BYTE_NS (50) // four bits per clock
+#define PAGE_PROGRAM_NS (700 * 1000)
+#define SECTOR_ERASE_NS (45 * 1000 * 1000)
+
+// Like a USB mass storage host, which moves 8 blocks at a time starting one block into an erase
+// sector because of the partition table.
+#define TRANSFER_BLOCKS (8)
+#define SEQUENTIAL_START (7)
+#define SEQUENTIAL_BLOCKS (1024)
+
+static uint8_t flash[FLASH_SIZE];
+static bool write_enabled;
+static uint32_t erase_count;
+static uint32_t program_count;
+static uint64_t elapsed_ns;
+// Bytes of port heap held by the caches, now and at most.
+static size_t heap_used, heap_peak;
+
+// What each block should read back as.
+static uint8_t expected[FLASH_SIZE];
+
+void common_hal_mcu_delay_us(uint32_t delay) {
+}
+
+// Each allocation starts with its size so it can be taken off when it's freed.
+void *port_malloc(size_t size, bool dma_capable) {
+    size_t *ptr = malloc(sizeof(size_t) + size);
+    *ptr = size;
+    heap_used += size;
+    if (heap_used > heap_peak) {
+        heap_peak = heap_used;
+    }
+    return ptr + 1;
+}
+
+void port_free(void *ptr) {
+    if (ptr == NULL) {
+        return;
+    }
+    size_t *start = (size_t *)ptr - 1;
+    heap_used -= *start;
+    free(start);
+}
+
+bool spi_flash_command(uint8_t command) {
+    elapsed_ns += COMMAND_NS;
+    if (command == CMD_ENABLE_WRITE) {
+        write_enabled = true;
+    } else if (command == CMD_DISABLE_WRITE) {
+        write_enabled = false;
+    }
+    return true;
+}
+
+bool spi_flash_read_command(uint8_t command, uint8_t *response, uint32_t length) {
+    elapsed_ns += COMMAND_NS + length * BYTE_NS;
+    memset(response, 0, length);
+    if (command == CMD_READ_JEDEC_ID) {
+        response[0] = 0xef;
+        response[1] = 0x40;
+        response[2] = 0x14;
+    }
+    return true;
+}
+
+bool spi_flash_write_command(uint8_t command, uint8_t *data, uint32_t length) {
+    return true;
+}
+
+static void require_write_enable(void) {
+    if (!write_enabled) {
+        printf("erase or program without write enable\n");
+        exit(1);
+    }
+    write_enabled = false;
+}
+
+bool spi_flash_sector_command(uint8_t command, uint32_t address) {
+    require_write_enable();
+    memset(flash + (address & ~(SPI_FLASH_ERASE_SIZE - 1)), 0xff, SPI_FLASH_ERASE_SIZE);
+    erase_count++;
+    elapsed_ns += COMMAND_NS + SECTOR_ERASE_NS;
+    return true;
+}
+
+bool spi_flash_write_data(uint32_t address, uint8_t *data, uint32_t data_length) {
+    require_write_enable();
+    for (uint32_t i = 0; i < data_length; i++) {
+        flash[address + i] &= data[i];
+    }
+    program_count++;
+    elapsed_ns += COMMAND_NS + data_length * BYTE_NS + PAGE_PROGRAM_NS;
+    return true;
+}
+
+bool spi_flash_read_data(uint32_t address, uint8_t *data, uint32_t data_length) {
+    memcpy(data, flash + address, data_length);
+    elapsed_ns += COMMAND_NS + data_length * BYTE_NS;
+    return true;
+}
+
+void spi_flash_init(void) {
+}
+
+void spi_flash_init_device(const external_flash_device *device) {
+}
+
+static void write_blocks(uint32_t block, uint32_t count, uint32_t seed) {
+    uint8_t *data = expected + block * FILESYSTEM_BLOCK_SIZE;
+    for (size_t i = 0; i < count * FILESYSTEM_BLOCK_SIZE; i++) {
+        data[i] = seed * 31 + i * 7;
+    }
+    if (supervisor_flash_write_blocks(data, block, count) != 0) {
+        printf("write of block %u failed\n", block);
+        exit(1);
+    }
+}
+
+static void write_block(uint32_t block, uint32_t seed) {
+    write_blocks(block, 1, seed);
+}
+
+static void check(const char *workload) {
+    uint8_t data[FILESYSTEM_BLOCK_SIZE];
+    uint64_t start_ns = elapsed_ns;
+    for (uint32_t block = 0; block < supervisor_flash_get_block_count(); block++) {
+        if (supervisor_flash_read_blocks(data, block, 1) != 0 ||
+            memcmp(data, expected + block * FILESYSTEM_BLOCK_SIZE, FILESYSTEM_BLOCK_SIZE) != 0) {
+            printf("%s: block %u reads back wrong\n", workload, block);
+            exit(1);
+        }
+    }
+    // Checking doesn't count.
+    elapsed_ns = start_ns;
+}
+
+static void report(const char *workload) {
+    supervisor_flash_flush();
+    check(workload);
+    printf("  %-16s %6u erases %7u page programs %8.1f ms, heap %5zu bytes at most, %5zu when idle\n",
+        workload, erase_count, program_count, elapsed_ns / 1e6, heap_peak, heap_used);
+    heap_peak = heap_used;
+    erase_count = 0;
+    program_count = 0;
+    elapsed_ns = 0;
+}
+
+static void report_rate(const char *workload) {
+    double kib = SEQUENTIAL_BLOCKS * FILESYSTEM_BLOCK_SIZE / 1024.0;
+    printf("  %-16s %8.0f KiB/s\n", workload, kib / (elapsed_ns / 1e9));
+    erase_count = 0;
+    program_count = 0;
+    elapsed_ns = 0;
+}
+
+void supervisor_flash_flush(void) {
+    supervisor_external_flash_flush();
+}
+
+int main(void) {
+    memset(flash, 0xff, sizeof(flash));
+    memset(expected, 0xff, sizeof(expected));
+    supervisor_flash_init();
+
+    // Start full so rewrites need erasing.
+    for (uint32_t block = 0; block < SEQUENTIAL_START + SEQUENTIAL_BLOCKS; block++) {
+        write_block(block, block);
+    }
+    report("fill");
+
+    // Appending to a file writes a data block, its FAT entry and the directory entry in turn. The
+    // filesystem is flushed every so often as by the idle flush.
+    for (uint32_t i = 0; i < 400; i++) {
+        write_block(100 + i, i);
+        write_block(2 + i / 128, i);
+        write_block(40, i);
+        if (i % 50 == 49) {
+            supervisor_flash_flush();
+        }
+    }
+    report("append");
+
+    srand(1);
+    for (uint32_t i = 0; i < 20000; i++) {
+        write_block(rand() % 512, i);
+        if (rand() % 300 == 0) {
+            supervisor_flash_flush();
+        }
+        if (rand() % 1000 == 0) {
+            supervisor_flash_release_cache();
+        }
+        if (rand() % 2000 == 0) {
+            check("random");
+        }
+    }
+    report("random");
+
+    // Sequential transfers of a file's worth of blocks, over data that needs erasing.
+    uint8_t buffer[TRANSFER_BLOCKS * FILESYSTEM_BLOCK_SIZE];
+    for (uint32_t i = 0; i < SEQUENTIAL_BLOCKS; i += TRANSFER_BLOCKS) {
+        write_blocks(SEQUENTIAL_START + i, TRANSFER_BLOCKS, i);
+    }
+    supervisor_flash_flush();
+    report_rate("write");
+    for (uint32_t i = 0; i < SEQUENTIAL_BLOCKS; i += TRANSFER_BLOCKS) {
+        supervisor_flash_read_blocks(buffer, SEQUENTIAL_START + i, TRANSFER_BLOCKS);
+    }
+    report_rate("read");
+    check("sequential");
+
+    supervisor_flash_release_cache();
+    return 0;
+}
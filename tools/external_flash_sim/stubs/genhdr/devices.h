@@ -0,0 +1,18 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+// Stands in for the generated list of flash chips. The simulated chip is 1 MiB.
+#define SIM_FLASH { \
+        .total_size = (1 << 20), \
+        .start_up_time_us = 0, \
+        .manufacturer_id = 0xef, \
+        .memory_type = 0x40, \
+        .capacity = 0x14, \
+        .max_clock_speed_mhz = 104, \
+        .single_status_byte = true, \
+}
@@ -0,0 +1,273 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+// Feeds recorded requests through the web workflow's request parser from a fake socket. Each one
+// arrives in pieces of several sizes, with "no data yet" between them, and must parse the same way
+// every time. Bodies must be read out of the request's own buffer without being copied.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "py/mperrno.h"
+#include "py/misc.h"
+#include "supervisor/shared/web_workflow/request.h"
+
+// base64 of ":passw0rd"
+#define API_PASSWORD "OnBhc3N3MHJk"
+#define BODY_SIZE (5000)
+
+static const size_t chunks[] = { 1, 7, 100, 1460, 100000 };
+
+typedef struct {
+    const char *name;
+    const char *headers;
+    size_t body_length;
+    bool close_at_end;
+    web_workflow_request_status_t status;
+    const char *method;
+    const char *path;
+    const char *host;
+    const char *origin;
+    const char *range;
+    const char *destination;
+    uint64_t timestamp_ms;
+    bool redirect;
+    bool authenticated;
+    bool expect;
+    bool json;
+    bool websocket;
+    const char *websocket_key;
+} recording_t;
+
+static const recording_t recordings[] = {
+    {
+        .name = "browser GET",
+        .headers =
+            "GET /fs/lib/ HTTP/1.1\r\n"
+            "Host: circuitpython.local:80\r\n"
+            "User-Agent: Mozilla/5.0 (X11; Linux x86_64; rv:128.0) Gecko/20100101 Firefox/128.0\r\n"
+            "Accept: application/json\r\n"
+            "Accept-Language: en-US,en;q=0.5\r\n"
+            "Accept-Encoding: gzip, deflate\r\n"
+            "Authorization: Basic " API_PASSWORD "\r\n"
+            "Connection: keep-alive\r\n"
+            "Referer: http://circuitpython.local/fs/\r\n"
+            "\r\n",
+        .status = WEB_WORKFLOW_REQUEST_DONE,
+        .method = "GET", .path = "/fs/lib/", .host = "circuitpython.local:80", .origin = "", .range = "",
+        .redirect = true, .authenticated = true, .json = true,
+    },
+    {
+        .name = "resumed download",
+        .headers =
+            "GET /fs/log.txt HTTP/1.1\r\n"
+            "Host: cpy-f57ce8.local\r\n"
+            "Range: bytes=1048576-\r\n"
+            "Authorization: Basic Ondyb25n\r\n"
+            "Accept: */*\r\n"
+            "\r\n",
+        .status = WEB_WORKFLOW_REQUEST_DONE,
+        .method = "GET", .path = "/fs/log.txt", .host = "cpy-f57ce8.local", .origin = "", .range = "bytes=1048576-",
+    },
+    {
+        .name = "curl PUT",
+        .headers =
+            "PUT /fs/lib/adafruit_bus_device/i2c_device.mpy HTTP/1.1\r\n"
+            "Host: 192.168.1.42\r\n"
+            "Authorization: Basic " API_PASSWORD "\r\n"
+            "User-Agent: curl/8.5.0\r\n"
+            "Accept: */*\r\n"
+            "X-Timestamp: 1760788800000\r\n"
+            "Content-Length: 5000\r\n"
+            "Expect: 100-continue\r\n"
+            "\r\n",
+        .body_length = BODY_SIZE,
+        .status = WEB_WORKFLOW_REQUEST_DONE,
+        .method = "PUT", .path = "/fs/lib/adafruit_bus_device/i2c_device.mpy", .host = "192.168.1.42", .origin = "", .range = "",
+        .timestamp_ms = 1760788800000ULL, .authenticated = true, .expect = true,
+    },
+    {
+        .name = "cross origin MOVE",
+        .headers =
+            "MOVE /fs/old.py HTTP/1.1\r\n"
+            "Host: circuitpython.local\r\n"
+            "Origin: http://code.circuitpython.org\r\n"
+            "X-Destination: /fs/new.py\r\n"
+            "Authorization: Basic " API_PASSWORD "\r\n"
+            "\r\n",
+        .status = WEB_WORKFLOW_REQUEST_DONE,
+        .method = "MOVE", .path = "/fs/old.py", .host = "circuitpython.local", .origin = "http://code.circuitpython.org",
+        .range = "", .destination = "/fs/new.py", .redirect = true, .authenticated = true,
+    },
+    {
+        .name = "websocket upgrade",
+        .headers =
+            "GET /cp/serial/ HTTP/1.1\r\n"
+            "Host: circuitpython.local\r\n"
+            "Upgrade: websocket\r\n"
+            "Connection: Upgrade\r\n"
+            "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n"
+            "Sec-WebSocket-Version: 13\r\n"
+            "\r\n",
+        .status = WEB_WORKFLOW_REQUEST_DONE,
+        .method = "GET", .path = "/cp/serial/", .host = "circuitpython.local", .origin = "", .range = "",
+        .redirect = true, .websocket = true, .websocket_key = "dGhlIHNhbXBsZSBub25jZQ==",
+    },
+    {
+        .name = "overlong fields",
+        .headers =
+            "REALLYLONGMETHOD /" "0123456789012345678901234567890123456789012345678901234567890123"
+            "0123456789012345678901234567890123456789012345678901234567890123"
+            "0123456789012345678901234567890123456789012345678901234567890123"
+            "0123456789012345678901234567890123456789012345678901234567890123 HTTP/1.1\r\n"
+            "X-A-Header-Key-That-Is-Much-Longer-Than-Sixty-Four-Characters-Which-Gets-Cut: 1\r\n"
+            "Host: circuitpython.local\r\n"
+            "\r\n",
+        .status = WEB_WORKFLOW_REQUEST_DONE,
+        .method = "REALLYL", .path = "/0123456789012345678901234567890123456789012345678901234567890123"
+            "0123456789012345678901234567890123456789012345678901234567890123"
+            "0123456789012345678901234567890123456789012345678901234567890123"
+            "01234567890123456789012345678901234567890123456789012345678901",
+        .host = "circuitpython.local", .origin = "", .range = "", .redirect = true,
+    },
+    {
+        .name = "HTTP/1.0",
+        .headers = "GET / HTTP/1.0\r\n\r\n",
+        .status = WEB_WORKFLOW_REQUEST_INVALID,
+    },
+    {
+        .name = "missing header space",
+        .headers = "GET / HTTP/1.1\r\nHost:circuitpython.local\r\n\r\n",
+        .status = WEB_WORKFLOW_REQUEST_INVALID,
+    },
+    {
+        .name = "disconnect",
+        .headers = "GET /fs/ HTTP/1.1\r\nHost: circ",
+        .close_at_end = true,
+        .status = WEB_WORKFLOW_REQUEST_CLOSED,
+    },
+};
+
+static web_workflow_request_t request;
+static char input[4096 + BODY_SIZE];
+static uint8_t body[BODY_SIZE];
+static bool failed;
+
+bool common_hal_socketpool_socket_get_connected(socketpool_socket_obj_t *self) {
+    return true;
+}
+
+int socketpool_socket_recv_into(socketpool_socket_obj_t *self, const uint8_t *buf, uint32_t len) {
+    if (self->again) {
+        self->again = false;
+        return -MP_EAGAIN;
+    }
+    if (self->input_offset == self->input_length) {
+        return self->close_at_end ? 0 : -MP_EAGAIN;
+    }
+    size_t n = MIN(len, MIN(self->chunk, self->input_length - self->input_offset));
+    memcpy((uint8_t *)buf, self->input + self->input_offset, n);
+    self->input_offset += n;
+    self->again = true;
+    self->recv_count++;
+    return n;
+}
+
+static void check_str(const recording_t *r, size_t chunk, const char *field, const char *actual, const char *expected) {
+    if (expected != NULL && strcmp(actual, expected) != 0) {
+        printf("%s in %zu byte pieces: %s is \"%s\" not \"%s\"\n", r->name, chunk, field, actual, expected);
+        failed = true;
+    }
+}
+
+static void check(const recording_t *r, size_t chunk, const char *field, uint64_t actual, uint64_t expected) {
+    if (actual != expected) {
+        printf("%s in %zu byte pieces: %s is %llu not %llu\n", r->name, chunk, field,
+            (unsigned long long)actual, (unsigned long long)expected);
+        failed = true;
+    }
+}
+
+// Returns the number of receives it took.
+static uint32_t feed(const recording_t *r, size_t chunk) {
+    size_t header_length = strlen(r->headers);
+    memcpy(input, r->headers, header_length);
+    for (size_t i = 0; i < r->body_length; i++) {
+        input[header_length + i] = i * 7 + i / 251;
+    }
+    socketpool_socket_obj_t socket = {
+        .input = input,
+        .input_length = header_length + r->body_length,
+        .chunk = chunk,
+        .close_at_end = r->close_at_end,
+    };
+
+    web_workflow_request_reset(&request);
+    web_workflow_request_status_t status;
+    size_t calls = 0;
+    while ((status = web_workflow_request_parse(&socket, &request, API_PASSWORD)) == WEB_WORKFLOW_REQUEST_INCOMPLETE) {
+        if (++calls > 2 * socket.input_length + 2) {
+            break;
+        }
+    }
+    check(r, chunk, "status", status, r->status);
+    if (status != WEB_WORKFLOW_REQUEST_DONE || r->status != WEB_WORKFLOW_REQUEST_DONE) {
+        return socket.recv_count;
+    }
+
+    check_str(r, chunk, "method", request.method, r->method);
+    check_str(r, chunk, "path", request.path, r->path);
+    check_str(r, chunk, "host", request.host, r->host);
+    check_str(r, chunk, "origin", request.origin, r->origin);
+    check_str(r, chunk, "range", request.range, r->range);
+    check_str(r, chunk, "destination", request.destination, r->destination);
+    check_str(r, chunk, "websocket_key", request.websocket_key, r->websocket_key);
+    check(r, chunk, "content_length", request.content_length, r->body_length);
+    check(r, chunk, "timestamp_ms", request.timestamp_ms, r->timestamp_ms);
+    check(r, chunk, "redirect", request.redirect, r->redirect);
+    check(r, chunk, "authenticated", request.authenticated, r->authenticated);
+    check(r, chunk, "expect", request.expect, r->expect);
+    check(r, chunk, "json", request.json, r->json);
+    check(r, chunk, "websocket", request.websocket, r->websocket);
+
+    size_t total_read = 0;
+    while (total_read < request.content_length) {
+        uint8_t *data;
+        int len = web_workflow_request_read_body(&socket, &request, &data, request.content_length - total_read);
+        if (len == -MP_EAGAIN) {
+            continue;
+        }
+        if (len <= 0 || data < request.buffer || data + len > request.buffer + sizeof(request.buffer)) {
+            check(r, chunk, "body read", len, 0);
+            return socket.recv_count;
+        }
+        memcpy(body + total_read, data, len);
+        total_read += len;
+    }
+    check(r, chunk, "body", memcmp(body, input + header_length, r->body_length), 0);
+    check(r, chunk, "unread", socket.input_length - socket.input_offset, 0);
+    return socket.recv_count;
+}
+
+int main(void) {
+    for (size_t i = 0; i < sizeof(recordings) / sizeof(recordings[0]); i++) {
+        for (size_t j = 0; j < sizeof(chunks) / sizeof(chunks[0]); j++) {
+            uint32_t recv_count = feed(&recordings[i], chunks[j]);
+            if (chunks[j] == 1460 && recordings[i].body_length > 0) {
+                // Previously headers were received a byte at a time and bodies 64 bytes at a time.
+                size_t header_length = strlen(recordings[i].headers);
+                printf("%s: %u receives, was %zu\n", recordings[i].name, recv_count,
+                    header_length + (recordings[i].body_length + 63) / 64);
+            }
+        }
+    }
+    if (failed) {
+        return 1;
+    }
+    printf("%zu recorded requests ok\n", sizeof(recordings) / sizeof(recordings[0]));
+    return 0;
+}
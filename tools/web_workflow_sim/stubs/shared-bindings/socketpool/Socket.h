@@ -0,0 +1,29 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct {
+    // One end of a loopback TCP connection to send to.
+    int fd;
+    bool connected;
+    // A recorded request to receive, handed out at most chunk bytes at a time with "no data yet"
+    // in between.
+    const char *input;
+    size_t input_length;
+    size_t input_offset;
+    size_t chunk;
+    bool again;
+    bool close_at_end;
+    uint32_t recv_count;
+} socketpool_socket_obj_t;
+
+bool common_hal_socketpool_socket_get_connected(socketpool_socket_obj_t *self);
+int socketpool_socket_recv_into(socketpool_socket_obj_t *self, const uint8_t *buf, uint32_t len);
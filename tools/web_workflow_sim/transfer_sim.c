@@ -0,0 +1,269 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+// Serves a file from a FAT filesystem in RAM with the web workflow's file transfer code and sends
+// it over a loopback TCP connection to a reader thread that checks every byte. The time until the
+// last byte arrives is measured. The sends and sector reads are counted and the time the reads
+// would take on external flash is estimated, using the same figures as tools/external_flash_sim.
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "lib/oofatfs/ff.h"
+#include "lib/oofatfs/diskio.h"
+#include "py/mperrno.h"
+#include "py/misc.h"
+#include "supervisor/shared/web_workflow/file_transfer.h"
+
+#define SECTOR_SIZE (512)
+#define DISK_SECTORS (4096)
+#define FILE_SIZE (1024 * 1024)
+#define ROUNDS (5)
+
+// Estimated costs of reading external flash in nanoseconds
+#define COMMAND_NS (1000)
+#define BYTE_NS (50)
+
+static uint8_t disk[DISK_SECTORS * SECTOR_SIZE];
+static uint8_t contents[FILE_SIZE];
+static uint8_t received[FILE_SIZE];
+static size_t received_length;
+
+static uint32_t send_count;
+static uint32_t read_count;
+static uint64_t read_ns;
+
+static uint64_t now_ns(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1000000000ULL + t.tv_nsec;
+}
+
+uint32_t supervisor_ticks_ms32(void) {
+    return now_ns() / 1000000;
+}
+
+void *port_malloc(size_t size, bool dma_capable) {
+    return malloc(size);
+}
+
+void port_free(void *ptr) {
+    free(ptr);
+}
+
+DWORD get_fattime(void) {
+    return 0;
+}
+
+DRESULT disk_read(void *drv, BYTE *buff, DWORD sector, UINT count) {
+    memcpy(buff, disk + sector * SECTOR_SIZE, count * SECTOR_SIZE);
+    read_count++;
+    read_ns += COMMAND_NS + count * SECTOR_SIZE * BYTE_NS;
+    return RES_OK;
+}
+
+DRESULT disk_write(void *drv, const BYTE *buff, DWORD sector, UINT count) {
+    memcpy(disk + sector * SECTOR_SIZE, buff, count * SECTOR_SIZE);
+    return RES_OK;
+}
+
+DRESULT disk_ioctl(void *drv, BYTE cmd, void *buff) {
+    switch (cmd) {
+        case CTRL_SYNC:
+            return RES_OK;
+        case GET_SECTOR_COUNT:
+            *((DWORD *)buff) = DISK_SECTORS;
+            return RES_OK;
+        case GET_SECTOR_SIZE:
+            *((WORD *)buff) = SECTOR_SIZE;
+            return RES_OK;
+        case GET_BLOCK_SIZE:
+            *((DWORD *)buff) = 1;
+            return RES_OK;
+        case IOCTL_INIT:
+        case IOCTL_STATUS:
+            *((DSTATUS *)buff) = 0;
+            return RES_OK;
+    }
+    return RES_PARERR;
+}
+
+bool common_hal_socketpool_socket_get_connected(socketpool_socket_obj_t *self) {
+    return self->connected;
+}
+
+int socketpool_socket_recv_into(socketpool_socket_obj_t *self, const uint8_t *buf, uint32_t len) {
+    return -MP_ENOTCONN;
+}
+
+// Like the real one, this turns off Nagle's algorithm while flushing.
+void web_workflow_send_raw(socketpool_socket_obj_t *socket, bool flush, const uint8_t *buf, int len) {
+    int nodelay = flush;
+    if (flush) {
+        setsockopt(socket->fd, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+    }
+    int total_sent = 0;
+    while (socket->connected && total_sent < len) {
+        send_count++;
+        ssize_t sent = send(socket->fd, buf + total_sent, len - total_sent, 0);
+        if (sent < 0) {
+            socket->connected = false;
+        } else {
+            total_sent += sent;
+        }
+    }
+    if (flush) {
+        nodelay = 0;
+        setsockopt(socket->fd, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+    }
+}
+
+static void *receive(void *arg) {
+    int fd = *(int *)arg;
+    received_length = 0;
+    ssize_t n;
+    while ((n = recv(fd, received + received_length, sizeof(received) - received_length, 0)) > 0) {
+        received_length += n;
+    }
+    return NULL;
+}
+
+// Connects a pair of sockets over loopback.
+static void connect_loopback(int *server, int *client) {
+    int listener = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in address = { .sin_family = AF_INET, .sin_addr.s_addr = htonl(INADDR_LOOPBACK) };
+    socklen_t address_length = sizeof(address);
+    if (listener < 0 ||
+        bind(listener, (struct sockaddr *)&address, sizeof(address)) != 0 ||
+        listen(listener, 1) != 0 ||
+        getsockname(listener, (struct sockaddr *)&address, &address_length) != 0) {
+        perror("listen");
+        exit(1);
+    }
+    *client = socket(AF_INET, SOCK_STREAM, 0);
+    if (connect(*client, (struct sockaddr *)&address, sizeof(address)) != 0) {
+        perror("connect");
+        exit(1);
+    }
+    *server = accept(listener, NULL, NULL);
+    close(listener);
+}
+
+
+// Sends length bytes from start and checks what arrives. Returns the time taken for all of it to arrive.
+static uint64_t transfer(FIL *file, uint32_t start, uint32_t length) {
+    int server, client;
+    connect_loopback(&server, &client);
+    pthread_t reader;
+    pthread_create(&reader, NULL, receive, &client);
+
+    socketpool_socket_obj_t socket = { .fd = server, .connected = true };
+    f_lseek(file, start);
+    uint64_t begin = now_ns();
+    bool ok = web_workflow_send_file(&socket, file, length);
+    shutdown(server, SHUT_WR);
+    pthread_join(reader, NULL);
+    uint64_t elapsed = now_ns() - begin;
+    close(server);
+    close(client);
+
+    if (!ok || received_length != length || memcmp(received, contents + start, length) != 0) {
+        printf("bytes %u-%u didn't arrive intact\n", start, start + length - 1);
+        exit(1);
+    }
+    return elapsed;
+}
+
+static const struct {
+    const char *value;
+    uint32_t size;
+    web_workflow_range_t result;
+    uint32_t start, length;
+} ranges[] = {
+    { "", 1000, WEB_WORKFLOW_RANGE_NONE, 0, 0 },
+    { "bytes=0-499", 1000, WEB_WORKFLOW_RANGE_OK, 0, 500 },
+    { "bytes=500-", 1000, WEB_WORKFLOW_RANGE_OK, 500, 500 },
+    { "bytes=-300", 1000, WEB_WORKFLOW_RANGE_OK, 700, 300 },
+    { "bytes=-3000", 1000, WEB_WORKFLOW_RANGE_OK, 0, 1000 },
+    { "bytes=900-5000", 1000, WEB_WORKFLOW_RANGE_OK, 900, 100 },
+    { "bytes=999-999", 1000, WEB_WORKFLOW_RANGE_OK, 999, 1 },
+    { "bytes=1000-", 1000, WEB_WORKFLOW_RANGE_UNSATISFIABLE, 0, 0 },
+    { "bytes=99999999999-", 1000, WEB_WORKFLOW_RANGE_UNSATISFIABLE, 0, 0 },
+    { "bytes=-0", 1000, WEB_WORKFLOW_RANGE_UNSATISFIABLE, 0, 0 },
+    { "bytes=0-", 0, WEB_WORKFLOW_RANGE_UNSATISFIABLE, 0, 0 },
+    { "bytes=-5", 0, WEB_WORKFLOW_RANGE_UNSATISFIABLE, 0, 0 },
+    { "bytes=5-4", 1000, WEB_WORKFLOW_RANGE_NONE, 0, 0 },
+    { "bytes=0-1,5-6", 1000, WEB_WORKFLOW_RANGE_NONE, 0, 0 },
+    { "bytes=-", 1000, WEB_WORKFLOW_RANGE_NONE, 0, 0 },
+    { "bytes= 1-2", 1000, WEB_WORKFLOW_RANGE_NONE, 0, 0 },
+    { "bytes=+1-2", 1000, WEB_WORKFLOW_RANGE_NONE, 0, 0 },
+    { "lines=1-2", 1000, WEB_WORKFLOW_RANGE_NONE, 0, 0 },
+};
+
+static void check_ranges(void) {
+    for (size_t i = 0; i < sizeof(ranges) / sizeof(ranges[0]); i++) {
+        uint32_t start = 0, length = 0;
+        web_workflow_range_t result = web_workflow_parse_range(ranges[i].value, ranges[i].size, &start, &length);
+        if (result != ranges[i].result ||
+            (result == WEB_WORKFLOW_RANGE_OK && (start != ranges[i].start || length != ranges[i].length))) {
+            printf("\"%s\" of %u bytes resolved to %d %u+%u\n", ranges[i].value, ranges[i].size, result, start, length);
+            exit(1);
+        }
+    }
+}
+
+int main(void) {
+    static FATFS fs;
+    static uint8_t work[FF_MAX_SS];
+    fs.drv = disk;
+    if (f_mkfs(&fs, FM_FAT | FM_SFD, 0, work, sizeof(work)) != FR_OK || f_mount(&fs) != FR_OK) {
+        printf("couldn't make the filesystem\n");
+        return 1;
+    }
+
+    FIL file;
+    srand(1);
+    for (size_t i = 0; i < FILE_SIZE; i++) {
+        contents[i] = rand();
+    }
+    UINT written;
+    f_open(&fs, &file, "/log.txt", FA_WRITE | FA_CREATE_ALWAYS);
+    for (size_t i = 0; i < FILE_SIZE; i += 1000) {
+        f_write(&file, contents + i, MIN(1000, FILE_SIZE - i), &written);
+    }
+    f_close(&file);
+    f_open(&fs, &file, "/log.txt", FA_READ);
+
+    uint64_t best = UINT64_MAX;
+    for (int i = 0; i < ROUNDS; i++) {
+        send_count = 0;
+        read_count = 0;
+        read_ns = 0;
+        uint64_t elapsed = transfer(&file, 0, FILE_SIZE);
+        if (elapsed < best) {
+            best = elapsed;
+        }
+    }
+    printf("  %u KiB in %.1f ms (%.0f KiB/s) over loopback, %u sends\n",
+        FILE_SIZE / 1024, best / 1e6, FILE_SIZE / 1024 / (best / 1e9), send_count);
+    printf("  %u sector reads, %.1f ms on external flash\n", read_count, read_ns / 1e6);
+
+    check_ranges();
+    transfer(&file, 1000, 300000);
+    transfer(&file, 4096, 8192);
+    transfer(&file, FILE_SIZE - 1, 1);
+    printf("  ranges ok\n");
+
+    f_close(&file);
+    return 0;
+}
@@ -0,0 +1,217 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+// Uploads a 1 MiB file with the web workflow's request parser and file receiving code, the way
+// a PUT is handled, onto a FAT filesystem in RAM. Time is simulated. The file's data arrives
+// over WiFi at a steady rate, but the sender stops when the TCP window is full and waits for it
+// to be read. Sector reads and writes cost what they would on external flash, using the figures
+// from tools/external_flash_sim. Every upload is checked byte for byte.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lib/oofatfs/ff.h"
+#include "lib/oofatfs/diskio.h"
+#include "py/mperrno.h"
+#include "py/misc.h"
+#include "supervisor/shared/web_workflow/file_transfer.h"
+
+#define SECTOR_SIZE (512)
+#define DISK_SECTORS (16384)
+#define FILE_SIZE (1024 * 1024)
+
+// The network, in nanoseconds. A segment takes 584 us at 20 Mbit/s. The window is the default
+// in ESP-IDF.
+#define SEGMENT_SIZE (1460)
+#define SEGMENT_NS (584 * 1000)
+#define WINDOW_SIZE (5744)
+
+// Estimated costs of external flash in nanoseconds. A write of a 512 byte sector programs two
+// pages and, eventually, erases an eighth of a 4 kiB sector.
+#define COMMAND_NS (1000)
+#define BYTE_NS (50)
+#define PAGE_PROGRAM_NS (700 * 1000)
+#define SECTOR_ERASE_NS (45 * 1000 * 1000)
+#define SECTOR_WRITE_NS (2 * PAGE_PROGRAM_NS + SECTOR_ERASE_NS / 8)
+
+static const char headers[] =
+    "PUT /fs/log.bin HTTP/1.1\r\n"
+    "Host: circuitpython.local\r\n"
+    "Content-Length: 1048576\r\n"
+    "\r\n";
+
+static uint8_t disk[DISK_SECTORS * SECTOR_SIZE];
+static char input[sizeof(headers) - 1 + FILE_SIZE];
+static uint8_t written[FILE_SIZE];
+static web_workflow_request_t request;
+
+static uint64_t clock_ns;
+static bool heap_full;
+static uint32_t read_count, write_count, sectors_read, sectors_written;
+
+// What the sender has put on the air and what has been read from the socket.
+static size_t arrived, consumed;
+static uint64_t next_arrival_ns;
+#define STALLED UINT64_MAX
+
+uint32_t supervisor_ticks_ms32(void) {
+    return clock_ns / 1000000;
+}
+
+void *port_malloc(size_t size, bool dma_capable) {
+    return heap_full ? NULL : malloc(size);
+}
+
+void port_free(void *ptr) {
+    free(ptr);
+}
+
+DWORD get_fattime(void) {
+    return 0;
+}
+
+DRESULT disk_read(void *drv, BYTE *buff, DWORD sector, UINT count) {
+    memcpy(buff, disk + sector * SECTOR_SIZE, count * SECTOR_SIZE);
+    read_count++;
+    sectors_read += count;
+    clock_ns += COMMAND_NS + count * SECTOR_SIZE * BYTE_NS;
+    return RES_OK;
+}
+
+DRESULT disk_write(void *drv, const BYTE *buff, DWORD sector, UINT count) {
+    memcpy(disk + sector * SECTOR_SIZE, buff, count * SECTOR_SIZE);
+    write_count++;
+    sectors_written += count;
+    clock_ns += COMMAND_NS + count * (SECTOR_SIZE * BYTE_NS + SECTOR_WRITE_NS);
+    return RES_OK;
+}
+
+DRESULT disk_ioctl(void *drv, BYTE cmd, void *buff) {
+    switch (cmd) {
+        case CTRL_SYNC:
+            return RES_OK;
+        case GET_SECTOR_COUNT:
+            *((DWORD *)buff) = DISK_SECTORS;
+            return RES_OK;
+        case GET_SECTOR_SIZE:
+            *((WORD *)buff) = SECTOR_SIZE;
+            return RES_OK;
+        case GET_BLOCK_SIZE:
+            *((DWORD *)buff) = 1;
+            return RES_OK;
+        case IOCTL_INIT:
+        case IOCTL_STATUS:
+            *((DSTATUS *)buff) = 0;
+            return RES_OK;
+    }
+    return RES_PARERR;
+}
+
+bool common_hal_socketpool_socket_get_connected(socketpool_socket_obj_t *self) {
+    return true;
+}
+
+void web_workflow_send_raw(socketpool_socket_obj_t *socket, bool flush, const uint8_t *buf, int len) {
+}
+
+static void send_segments(void) {
+    while (arrived < sizeof(input) && next_arrival_ns <= clock_ns) {
+        arrived = MIN(arrived + SEGMENT_SIZE, sizeof(input));
+        if (arrived - consumed + SEGMENT_SIZE <= WINDOW_SIZE) {
+            next_arrival_ns += SEGMENT_NS;
+        } else {
+            next_arrival_ns = STALLED;
+        }
+    }
+}
+
+// Blocks until something has arrived, like a socket with a timeout.
+int socketpool_socket_recv_into(socketpool_socket_obj_t *self, const uint8_t *buf, uint32_t len) {
+    send_segments();
+    if (arrived == consumed) {
+        if (arrived == sizeof(input)) {
+            return -MP_ENOTCONN;
+        }
+        clock_ns = next_arrival_ns;
+        send_segments();
+    }
+    size_t n = MIN(len, arrived - consumed);
+    memcpy((uint8_t *)buf, input + consumed, n);
+    consumed += n;
+    // Reading made room in the window so the sender carries on.
+    if (next_arrival_ns == STALLED && arrived - consumed + SEGMENT_SIZE <= WINDOW_SIZE) {
+        next_arrival_ns = clock_ns + SEGMENT_NS;
+    }
+    return n;
+}
+
+static void upload(FATFS *fs, const char *label) {
+    arrived = 0;
+    consumed = 0;
+    next_arrival_ns = 0;
+    clock_ns = 0;
+    read_count = write_count = sectors_read = sectors_written = 0;
+
+    socketpool_socket_obj_t socket = { 0 };
+    web_workflow_request_reset(&request);
+    if (web_workflow_request_parse(&socket, &request, "") != WEB_WORKFLOW_REQUEST_DONE) {
+        printf("couldn't parse the request\n");
+        exit(1);
+    }
+
+    // As _write_file_and_reply does.
+    FIL file;
+    f_open(fs, &file, "/log.bin", FA_WRITE | FA_OPEN_ALWAYS);
+    f_lseek(&file, request.content_length);
+    f_truncate(&file);
+    f_rewind(&file);
+    uint64_t start_ns = clock_ns;
+    size_t received;
+    web_workflow_receive_time_t timing;
+    bool ok = web_workflow_receive_file(&socket, &request, &file, request.content_length, &received, &timing);
+    uint32_t close_start = supervisor_ticks_ms32();
+    f_close(&file);
+    timing.flash_ms += supervisor_ticks_ms32() - close_start;
+    double seconds = (clock_ns - start_ns) / 1e9;
+    printf("  %s: %.1f s (%.0f KB/s), waiting on network %u ms, flash %u ms\n",
+        label, seconds, FILE_SIZE / 1000 / seconds, timing.network_ms, timing.flash_ms);
+    printf("    %u writes of %u sectors, %u reads of %u sectors\n",
+        write_count, sectors_written, read_count, sectors_read);
+
+    UINT read;
+    f_open(fs, &file, "/log.bin", FA_READ);
+    f_read(&file, written, sizeof(written), &read);
+    f_close(&file);
+    f_unlink(fs, "/log.bin");
+    if (!ok || received != FILE_SIZE || read != FILE_SIZE ||
+        memcmp(written, input + sizeof(headers) - 1, FILE_SIZE) != 0) {
+        printf("%s: the upload didn't arrive intact\n", label);
+        exit(1);
+    }
+}
+
+int main(void) {
+    static FATFS fs;
+    static uint8_t work[FF_MAX_SS];
+    fs.drv = disk;
+    if (f_mkfs(&fs, FM_FAT | FM_SFD, 0, work, sizeof(work)) != FR_OK || f_mount(&fs) != FR_OK) {
+        printf("couldn't make the filesystem\n");
+        return 1;
+    }
+    printf("  %u byte clusters\n", fs.csize * SECTOR_SIZE);
+
+    memcpy(input, headers, sizeof(headers) - 1);
+    srand(1);
+    for (size_t i = sizeof(headers) - 1; i < sizeof(input); i++) {
+        input[i] = rand();
+    }
+
+    upload(&fs, "transfer buffer");
+    heap_full = true;
+    upload(&fs, "port heap full");
+    return 0;
+}